@@ -258,6 +258,77 @@ static inline void neon_fill_f32(float* ALIGN_NEON dst, float value, size_t size
 }
 
 
+#ifdef __aarch64__
+/**
+ * Fast memory copy cho double (float64x2_t chỉ có trên AArch64)
+ * Giống neon_memory_f32 nhưng mỗi Q register chỉ chứa 2 doubles
+ *
+ * @param size: Số elements (double)
+*/
+static inline void neon_memory_f64(double* ALIGN_NEON dst, const double* ALIGN_NEON src, size_t size) {
+    if (!IS_ALIGNED(dst) || !IS_ALIGNED(src)) {
+        memcpy(dst, src, size * sizeof(double));
+        return;
+    }
+
+    size_t i = 0;
+
+    // Process 8 doubles per iteration (4 NEON registers)
+    for (; i + 8 <= size; i += 8) {
+        float64x2_t v0 = vld1q_f64(src + i);
+        float64x2_t v1 = vld1q_f64(src + i + 2);
+        float64x2_t v2 = vld1q_f64(src + i + 4);
+        float64x2_t v3 = vld1q_f64(src + i + 6);
+
+        vst1q_f64(dst + i, v0);
+        vst1q_f64(dst + i + 2, v1);
+        vst1q_f64(dst + i + 4, v2);
+        vst1q_f64(dst + i + 6, v3);
+    }
+
+    for (; i + 2 <= size; i += 2) {
+        vst1q_f64(dst + i, vld1q_f64(src + i));
+    }
+
+    for (; i < size; i++) {
+        dst[i] = src[i];
+    }
+}
+
+
+/**
+ * Fill array double với một giá trị
+*/
+static inline void neon_fill_f64(double* ALIGN_NEON dst, double value, size_t size) {
+    if (!IS_ALIGNED(dst)) {
+        for (size_t i = 0; i < size; i++) {
+            dst[i] = value;
+        }
+        return;
+    }
+
+    float64x2_t v = vdupq_n_f64(value);
+
+    size_t i = 0;
+
+    for (; i + 8 <= size; i += 8) {
+        vst1q_f64(dst + i, v);
+        vst1q_f64(dst + i + 2, v);
+        vst1q_f64(dst + i + 4, v);
+        vst1q_f64(dst + i + 6, v);
+    }
+
+    for (; i + 2 <= size; i += 2) {
+        vst1q_f64(dst + i, v);
+    }
+
+    for (; i < size; i++) {
+        dst[i] = value;
+    }
+}
+#endif // __aarch64__
+
+
 
 // ALIGNMENT CHECK UTILITIES
 /**
@@ -0,0 +1,324 @@
+#ifndef NEON_ACCUMULATE_H
+#define NEON_ACCUMULATE_H
+
+#include "neon_types.h"
+#include "neon_utils.h"
+
+
+/**
+ * MIXED-PRECISION / COMPENSATED ACCUMULATION
+ *
+ * VẤN ĐỀ: cộng dồn fp32 cho array dài (100M+ elements)
+ *   - fp32 chỉ có 24 bit mantissa (~7 chữ số)
+ *   - Khi sum lớn, mỗi phép cộng x nhỏ bị làm tròn → sai số tích lũy O(n * eps)
+ *   - Ví dụ: sum(1.0f) với n = 2^25 → kết quả fp32 dừng ở 2^24 = 16777216!
+ *
+ * CÁC GIẢI PHÁP (từ nhanh → chính xác):
+ *
+ * 1. neon_sum_f32          : fp32 thuần, 4 accumulators        sai số O(n * eps)
+ * 2. neon_sum_f32_pairwise : cộng theo block + cây nhị phân    sai số O(log n * eps)
+ * 3. neon_sum_f32_kahan    : Kahan/compensated trong fp32      sai số O(eps), ~4x số lệnh
+ * 4. neon_sum_f32_f64acc   : widen lên float64x2_t (AArch64)   sai số O(n * eps64)
+ *
+ * SỐ LỆNH trong loop chính / 4 elements (thời gian thực đo bằng tests/bench_accumulate.c):
+ *   fp32          : 1 load + 1 add
+ *   pairwise      : 1 load + 1 add (+ cộng theo cây giữa các block)
+ *   kahan         : 1 load + 4 add/sub (latency chain dài hơn → dùng 2 chains)
+ *   f64 acc       : 1 load + 2 cvt + 2 add (double chỉ 2 lanes)
+ *
+ * LƯU Ý: KHÔNG compile với -ffast-math, compiler sẽ xoá phần compensation của Kahan!
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Block size cho pairwise summation
+ * Trong 1 block dùng fp32 accumulators, giữa các block cộng theo cây
+*/
+#define NEON_PAIRWISE_BLOCK 256
+
+
+
+// BASELINE FP32
+/**
+ * Tổng fp32 thuần - baseline để so sánh tốc độ/độ chính xác
+*/
+static inline float neon_sum_f32(const float* data, size_t size) {
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    float32x4_t acc2 = vdupq_n_f32(0.0f);
+    float32x4_t acc3 = vdupq_n_f32(0.0f);
+
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        acc0 = vaddq_f32(acc0, vld1q_f32(data + i));
+        acc1 = vaddq_f32(acc1, vld1q_f32(data + i + 4));
+        acc2 = vaddq_f32(acc2, vld1q_f32(data + i + 8));
+        acc3 = vaddq_f32(acc3, vld1q_f32(data + i + 12));
+    }
+
+    for (; i + 4 <= size; i += 4) {
+        acc0 = vaddq_f32(acc0, vld1q_f32(data + i));
+    }
+
+    float result = neon_sum_f32x4(vaddq_f32(vaddq_f32(acc0, acc1), vaddq_f32(acc2, acc3)));
+
+    for (; i < size; i++) {
+        result += data[i];
+    }
+
+    return result;
+}
+
+
+
+// PAIRWISE SUMMATION
+/**
+ * Pairwise (cascade) summation
+ *
+ * sum(data[0..n)) = sum(data[0..n/2)) + sum(data[n/2..n))
+ * Dừng đệ quy khi n <= NEON_PAIRWISE_BLOCK và dùng neon_sum_f32
+ *
+ * Sai số O(log(n/256) * eps) thay vì O(n * eps), tốc độ gần như bằng fp32
+*/
+static inline float neon_sum_f32_pairwise(const float* data, size_t size) {
+    if (size <= NEON_PAIRWISE_BLOCK) {
+        return neon_sum_f32(data, size);
+    }
+
+    // Chia đôi tại bội số của 4 để nửa trái luôn chạy full vector
+    size_t half = (size / 2) & ~(size_t)3;
+    return neon_sum_f32_pairwise(data, half) + neon_sum_f32_pairwise(data + half, size - half);
+}
+
+
+
+// COMPENSATED (KAHAN) SUMMATION
+/**
+ * Kahan step cho 4 lanes:
+ *   y = x - c
+ *   t = sum + y
+ *   c = (t - sum) - y     ← phần bị mất khi làm tròn
+ *   sum = t
+*/
+static NEON_INLINE void neon_kahan_add_f32x4(float32x4_t* sum, float32x4_t* comp, float32x4_t x) {
+    float32x4_t y = vsubq_f32(x, *comp);
+    float32x4_t t = vaddq_f32(*sum, y);
+    *comp = vsubq_f32(vsubq_f32(t, *sum), y);
+    *sum = t;
+}
+
+
+/**
+ * Kahan summation với fp32 registers
+ * 2 chains độc lập (sum0/comp0, sum1/comp1) để che latency
+*/
+static inline float neon_sum_f32_kahan(const float* data, size_t size) {
+    float32x4_t sum0 = vdupq_n_f32(0.0f), comp0 = vdupq_n_f32(0.0f);
+    float32x4_t sum1 = vdupq_n_f32(0.0f), comp1 = vdupq_n_f32(0.0f);
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        neon_kahan_add_f32x4(&sum0, &comp0, vld1q_f32(data + i));
+        neon_kahan_add_f32x4(&sum1, &comp1, vld1q_f32(data + i + 4));
+    }
+
+    for (; i + 4 <= size; i += 4) {
+        neon_kahan_add_f32x4(&sum0, &comp0, vld1q_f32(data + i));
+    }
+
+    // Gộp 8 lanes: cộng phần compensation vào trước rồi mới reduce (dùng double cho bước cuối)
+    float sums[8] ALIGN_NEON;
+    vst1q_f32(sums, vsubq_f32(sum0, comp0));
+    vst1q_f32(sums + 4, vsubq_f32(sum1, comp1));
+
+    double result = 0.0;
+    for (int k = 0; k < 8; k++) {
+        result += sums[k];
+    }
+
+    for (; i < size; i++) {
+        result += data[i];
+    }
+
+    return (float)result;
+}
+
+
+/**
+ * Compensated dot product (thuật toán Dot2, Ogita-Rump-Oishi)
+ *
+ * Mỗi bước:
+ *   p  = a * b,  ep = fma(a, b, -p)   ← lỗi làm tròn của phép nhân (chính xác tuyệt đối)
+ *   TwoSum(s, p) → s mới + lỗi làm tròn của phép cộng
+ *   comp += ep + lỗi cộng
+ *
+ * Kết quả chính xác như tính với 2x precision rồi làm tròn về fp32
+*/
+static inline float neon_dot_product_kahan(const float* a, const float* b, size_t size) {
+    float32x4_t s = vdupq_n_f32(0.0f);
+    float32x4_t comp = vdupq_n_f32(0.0f);
+
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        float32x4_t va = vld1q_f32(a + i);
+        float32x4_t vb = vld1q_f32(b + i);
+
+        float32x4_t p = vmulq_f32(va, vb);
+        float32x4_t ep = vfmaq_f32(vnegq_f32(p), va, vb);
+
+        // TwoSum (Knuth): không cần |s| >= |p|
+        float32x4_t t = vaddq_f32(s, p);
+        float32x4_t z = vsubq_f32(t, s);
+        float32x4_t es = vaddq_f32(vsubq_f32(s, vsubq_f32(t, z)), vsubq_f32(p, z));
+
+        comp = vaddq_f32(comp, vaddq_f32(ep, es));
+        s = t;
+    }
+
+    float lanes[8] ALIGN_NEON;
+    vst1q_f32(lanes, s);
+    vst1q_f32(lanes + 4, comp);
+
+    double result = 0.0;
+    for (int k = 0; k < 8; k++) {
+        result += lanes[k];
+    }
+
+    for (; i < size; i++) {
+        result += (double)a[i] * (double)b[i];
+    }
+
+    return (float)result;
+}
+
+
+
+#ifdef __aarch64__
+// FP64 ACCUMULATION (AArch64)
+/**
+ * Tổng fp32 với accumulator float64x2_t
+ *
+ * vcvt_f64_f32(low)       : [x0, x1]       → 2 doubles
+ * vcvt_high_f64_f32(vec)  : [x2, x3]       → 2 doubles
+ *
+ * Trả về double để caller không mất chính xác khi tính tiếp (mean, variance, ...)
+*/
+static inline double neon_sum_f32_f64acc(const float* data, size_t size) {
+    float64x2_t acc0 = vdupq_n_f64(0.0);
+    float64x2_t acc1 = vdupq_n_f64(0.0);
+    float64x2_t acc2 = vdupq_n_f64(0.0);
+    float64x2_t acc3 = vdupq_n_f64(0.0);
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        float32x4_t v0 = vld1q_f32(data + i);
+        float32x4_t v1 = vld1q_f32(data + i + 4);
+
+        acc0 = vaddq_f64(acc0, vcvt_f64_f32(vget_low_f32(v0)));
+        acc1 = vaddq_f64(acc1, vcvt_high_f64_f32(v0));
+        acc2 = vaddq_f64(acc2, vcvt_f64_f32(vget_low_f32(v1)));
+        acc3 = vaddq_f64(acc3, vcvt_high_f64_f32(v1));
+    }
+
+    for (; i + 4 <= size; i += 4) {
+        float32x4_t v = vld1q_f32(data + i);
+        acc0 = vaddq_f64(acc0, vcvt_f64_f32(vget_low_f32(v)));
+        acc1 = vaddq_f64(acc1, vcvt_high_f64_f32(v));
+    }
+
+    double result = vaddvq_f64(vaddq_f64(vaddq_f64(acc0, acc1), vaddq_f64(acc2, acc3)));
+
+    for (; i < size; i++) {
+        result += data[i];
+    }
+
+    return result;
+}
+
+
+/**
+ * Dot product fp32 với accumulator float64x2_t
+ * Widen a, b trước khi nhân → tích a*b chính xác tuyệt đối trong double
+*/
+static inline double neon_dot_product_f64acc(const float* a, const float* b, size_t size) {
+    float64x2_t acc0 = vdupq_n_f64(0.0);
+    float64x2_t acc1 = vdupq_n_f64(0.0);
+    float64x2_t acc2 = vdupq_n_f64(0.0);
+    float64x2_t acc3 = vdupq_n_f64(0.0);
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        float32x4_t a0 = vld1q_f32(a + i);
+        float32x4_t b0 = vld1q_f32(b + i);
+        float32x4_t a1 = vld1q_f32(a + i + 4);
+        float32x4_t b1 = vld1q_f32(b + i + 4);
+
+        acc0 = vfmaq_f64(acc0, vcvt_f64_f32(vget_low_f32(a0)), vcvt_f64_f32(vget_low_f32(b0)));
+        acc1 = vfmaq_f64(acc1, vcvt_high_f64_f32(a0), vcvt_high_f64_f32(b0));
+        acc2 = vfmaq_f64(acc2, vcvt_f64_f32(vget_low_f32(a1)), vcvt_f64_f32(vget_low_f32(b1)));
+        acc3 = vfmaq_f64(acc3, vcvt_high_f64_f32(a1), vcvt_high_f64_f32(b1));
+    }
+
+    for (; i + 4 <= size; i += 4) {
+        float32x4_t va = vld1q_f32(a + i);
+        float32x4_t vb = vld1q_f32(b + i);
+        acc0 = vfmaq_f64(acc0, vcvt_f64_f32(vget_low_f32(va)), vcvt_f64_f32(vget_low_f32(vb)));
+        acc1 = vfmaq_f64(acc1, vcvt_high_f64_f32(va), vcvt_high_f64_f32(vb));
+    }
+
+    double result = vaddvq_f64(vaddq_f64(vaddq_f64(acc0, acc1), vaddq_f64(acc2, acc3)));
+
+    for (; i < size; i++) {
+        result += (double)a[i] * (double)b[i];
+    }
+
+    return result;
+}
+
+
+/**
+ * Mean + variance fp32 input, tính hoàn toàn trong double
+ * Two-pass: mean trước, rồi sum((x - mean)^2)
+*/
+static inline void neon_mean_variance_f64acc(const float* data, size_t size, double* mean, double* variance) {
+    if (size == 0) {
+        *mean = 0.0;
+        *variance = 0.0;
+        return;
+    }
+
+    double m = neon_sum_f32_f64acc(data, size) / (double)size;
+    float64x2_t vm = vdupq_n_f64(m);
+    float64x2_t acc0 = vdupq_n_f64(0.0);
+    float64x2_t acc1 = vdupq_n_f64(0.0);
+
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        float32x4_t v = vld1q_f32(data + i);
+        float64x2_t d0 = vsubq_f64(vcvt_f64_f32(vget_low_f32(v)), vm);
+        float64x2_t d1 = vsubq_f64(vcvt_high_f64_f32(v), vm);
+        acc0 = vfmaq_f64(acc0, d0, d0);
+        acc1 = vfmaq_f64(acc1, d1, d1);
+    }
+
+    double ss = vaddvq_f64(vaddq_f64(acc0, acc1));
+    for (; i < size; i++) {
+        double d = data[i] - m;
+        ss += d * d;
+    }
+
+    *mean = m;
+    *variance = ss / (double)size;
+}
+#endif // __aarch64__
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_ACCUMULATE_H
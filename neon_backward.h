@@ -0,0 +1,852 @@
+#ifndef NEON_BACKWARD_H
+#define NEON_BACKWARD_H
+
+#include "neon_types.h"
+#include "memory_align.h"
+#include "neon_thread.h"
+#include <math.h>
+#include <string.h>
+
+
+/**
+ * TRAINING KERNELS: FORWARD (lưu cache) + BACKWARD (on-device fine-tuning)
+ *
+ * Quy ước: row-major, batch m hàng x d (hoặc n) cột, gradient ký hiệu dX = ∂loss / ∂X
+ *
+ * ACTIVATIONS (elementwise): ReLU, GELU (tanh approximation), SiLU
+ *   Backward đọc lại input x (không lưu output) → dx = dy * f'(x), dx có thể trùng dy
+ *
+ * SOFTMAX + CROSS-ENTROPY FUSED:
+ *   loss = logsumexp(z) - z[label],  dz = (softmax(z) - onehot) / m
+ *   → 1 pass tính max, 1 pass exp + sum, 1 pass ghi gradient, không cần lưu softmax
+ *
+ * LAYERNORM / RMSNORM: forward lưu mean / rstd mỗi hàng
+ *   LN:  dx = rstd * (g - mean(g) - x̂ * mean(g * x̂)),  g = dy * gamma
+ *   RMS: dx = rstd * (g - x̂ * mean(g * x̂))
+ *   dgamma, dbeta cộng dồn (accumulate) qua batch
+ *
+ * GEMM GRADIENT (Y = X * W): dX = dY * W^T, dW = X^T * dY, db = Σ_rows dY
+ *   neon_sgemm_update: pack + micro-kernel 4x8 (8 accumulators, vfmaq_laneq_f32), chia hàng cho threads
+ *
+ * exp dùng range reduction (sai số ~1e-7), neon_exp_f32x4 (Taylor bậc 4) không đủ chính xác cho gradient check
+ *
+ * GRADIENT CHECK: central difference (f(x + h) - f(x - h)) / 2h so với gradient analytic
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define NEON_SGEMM_KC 256
+#define NEON_SGEMM_MIN_ROWS 32
+
+
+
+// PRECISE EXP
+/**
+ * exp(x) f32, sai số tương đối ~1e-7
+ * x = n * ln2 + r, |r| <= ln2 / 2 → exp(r) Horner bậc 6, 2^n ghi thẳng vào exponent bits
+*/
+static NEON_INLINE float32x4_t neon_exp_precise_f32x4(float32x4_t x) {
+    x = vminq_f32(x, vdupq_n_f32(88.0f));
+    x = vmaxq_f32(x, vdupq_n_f32(-87.0f));
+
+    float32x4_t n = vrndnq_f32(vmulq_f32(x, vdupq_n_f32(1.44269504f)));
+    float32x4_t r = vfmsq_f32(x, n, vdupq_n_f32(0.693359375f));
+    r = vfmsq_f32(r, n, vdupq_n_f32(-2.12194440e-4f));
+
+    float32x4_t p = vdupq_n_f32(1.0f / 720.0f);
+    p = vfmaq_f32(vdupq_n_f32(1.0f / 120.0f), p, r);
+    p = vfmaq_f32(vdupq_n_f32(1.0f / 24.0f), p, r);
+    p = vfmaq_f32(vdupq_n_f32(1.0f / 6.0f), p, r);
+    p = vfmaq_f32(vdupq_n_f32(0.5f), p, r);
+    p = vfmaq_f32(vdupq_n_f32(1.0f), p, r);
+    p = vfmaq_f32(vdupq_n_f32(1.0f), p, r);
+
+    int32x4_t e = vshlq_n_s32(vaddq_s32(vcvtq_s32_f32(n), vdupq_n_s32(127)), 23);
+    return vmulq_f32(p, vreinterpretq_f32_s32(e));
+}
+
+
+/**
+ * sigmoid(x) = 1 / (1 + exp(-x))
+*/
+static NEON_INLINE float32x4_t neon_sigmoid_f32x4(float32x4_t x) {
+    float32x4_t e = neon_exp_precise_f32x4(vnegq_f32(x));
+    return vdivq_f32(vdupq_n_f32(1.0f), vaddq_f32(vdupq_n_f32(1.0f), e));
+}
+
+
+/**
+ * tanh(x) = 2 * sigmoid(2x) - 1
+*/
+static NEON_INLINE float32x4_t neon_tanh_f32x4(float32x4_t x) {
+    float32x4_t s = neon_sigmoid_f32x4(vaddq_f32(x, x));
+    return vfmaq_f32(vdupq_n_f32(-1.0f), s, vdupq_n_f32(2.0f));
+}
+
+
+static NEON_INLINE float neon_sigmoid_f32(float x) {
+    return 1.0f / (1.0f + expf(-x));
+}
+
+
+
+// ACTIVATIONS
+/**
+ * y = max(x, 0)
+*/
+static inline void neon_relu_f32(const float* x, float* y, size_t n) {
+    float32x4_t zero = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) vst1q_f32(y + i, vmaxq_f32(vld1q_f32(x + i), zero));
+    for (; i < n; i++) y[i] = x[i] > 0.0f ? x[i] : 0.0f;
+}
+
+
+/**
+ * dx = dy * (x > 0)
+*/
+static inline void neon_relu_backward_f32(const float* x, const float* dy, float* dx, size_t n) {
+    float32x4_t zero = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        uint32x4_t pos = vcgtq_f32(vld1q_f32(x + i), zero);
+        vst1q_f32(dx + i, vreinterpretq_f32_u32(vandq_u32(pos, vreinterpretq_u32_f32(vld1q_f32(dy + i)))));
+    }
+    for (; i < n; i++) dx[i] = x[i] > 0.0f ? dy[i] : 0.0f;
+}
+
+
+#define NEON_GELU_K0 0.7978845608f // sqrt(2 / π)
+#define NEON_GELU_K1 0.044715f
+
+
+/**
+ * GELU (tanh approximation): y = 0.5 * x * (1 + tanh(k0 * (x + k1 * x³)))
+*/
+static inline void neon_gelu_f32(const float* x, float* y, size_t n) {
+    float32x4_t k0 = vdupq_n_f32(NEON_GELU_K0);
+    float32x4_t k1 = vdupq_n_f32(NEON_GELU_K1);
+    float32x4_t half = vdupq_n_f32(0.5f);
+    float32x4_t one = vdupq_n_f32(1.0f);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t v = vld1q_f32(x + i);
+        float32x4_t u = vmulq_f32(k0, vfmaq_f32(v, k1, vmulq_f32(v, vmulq_f32(v, v))));
+        float32x4_t t = neon_tanh_f32x4(u);
+        vst1q_f32(y + i, vmulq_f32(vmulq_f32(half, v), vaddq_f32(one, t)));
+    }
+    for (; i < n; i++) {
+        float v = x[i];
+        float t = tanhf(NEON_GELU_K0 * (v + NEON_GELU_K1 * v * v * v));
+        y[i] = 0.5f * v * (1.0f + t);
+    }
+}
+
+
+/**
+ * dx = dy * (0.5 * (1 + t) + 0.5 * x * (1 - t²) * k0 * (1 + 3 * k1 * x²))
+*/
+static inline void neon_gelu_backward_f32(const float* x, const float* dy, float* dx, size_t n) {
+    float32x4_t k0 = vdupq_n_f32(NEON_GELU_K0);
+    float32x4_t k1 = vdupq_n_f32(NEON_GELU_K1);
+    float32x4_t k13 = vdupq_n_f32(3.0f * NEON_GELU_K1);
+    float32x4_t half = vdupq_n_f32(0.5f);
+    float32x4_t one = vdupq_n_f32(1.0f);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t v = vld1q_f32(x + i);
+        float32x4_t v2 = vmulq_f32(v, v);
+        float32x4_t t = neon_tanh_f32x4(vmulq_f32(k0, vfmaq_f32(v, k1, vmulq_f32(v, v2))));
+        float32x4_t du = vmulq_f32(k0, vfmaq_f32(one, k13, v2));
+        float32x4_t sech2 = vfmsq_f32(one, t, t);
+        float32x4_t g = vfmaq_f32(vaddq_f32(one, t), vmulq_f32(v, sech2), du);
+        vst1q_f32(dx + i, vmulq_f32(vld1q_f32(dy + i), vmulq_f32(half, g)));
+    }
+    for (; i < n; i++) {
+        float v = x[i];
+        float t = tanhf(NEON_GELU_K0 * (v + NEON_GELU_K1 * v * v * v));
+        float du = NEON_GELU_K0 * (1.0f + 3.0f * NEON_GELU_K1 * v * v);
+        dx[i] = dy[i] * 0.5f * ((1.0f + t) + v * (1.0f - t * t) * du);
+    }
+}
+
+
+/**
+ * SiLU (swish): y = x * sigmoid(x)
+*/
+static inline void neon_silu_f32(const float* x, float* y, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t v = vld1q_f32(x + i);
+        vst1q_f32(y + i, vmulq_f32(v, neon_sigmoid_f32x4(v)));
+    }
+    for (; i < n; i++) y[i] = x[i] * neon_sigmoid_f32(x[i]);
+}
+
+
+/**
+ * dx = dy * s * (1 + x * (1 - s)), s = sigmoid(x)
+*/
+static inline void neon_silu_backward_f32(const float* x, const float* dy, float* dx, size_t n) {
+    float32x4_t one = vdupq_n_f32(1.0f);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t v = vld1q_f32(x + i);
+        float32x4_t s = neon_sigmoid_f32x4(v);
+        float32x4_t g = vmulq_f32(s, vfmaq_f32(one, v, vsubq_f32(one, s)));
+        vst1q_f32(dx + i, vmulq_f32(vld1q_f32(dy + i), g));
+    }
+    for (; i < n; i++) {
+        float s = neon_sigmoid_f32(x[i]);
+        dx[i] = dy[i] * s * (1.0f + x[i] * (1.0f - s));
+    }
+}
+
+
+
+// BIAS
+/**
+ * y[i][j] += b[j], y [m x n]
+*/
+static inline void neon_bias_add_f32(float* y, const float* b, size_t m, size_t n) {
+    for (size_t i = 0; i < m; i++) {
+        float* row = y + i * n;
+        size_t j = 0;
+        for (; j + 4 <= n; j += 4) vst1q_f32(row + j, vaddq_f32(vld1q_f32(row + j), vld1q_f32(b + j)));
+        for (; j < n; j++) row[j] += b[j];
+    }
+}
+
+
+/**
+ * db[j] += Σ_i dy[i][j] (cộng dồn, caller zero db trước mỗi step)
+*/
+static inline void neon_bias_backward_f32(const float* dy, float* db, size_t m, size_t n) {
+    for (size_t i = 0; i < m; i++) {
+        const float* row = dy + i * n;
+        size_t j = 0;
+        for (; j + 4 <= n; j += 4) vst1q_f32(db + j, vaddq_f32(vld1q_f32(db + j), vld1q_f32(row + j)));
+        for (; j < n; j++) db[j] += row[j];
+    }
+}
+
+
+
+// SOFTMAX
+static inline float neon_row_max_f32(const float* x, size_t n) {
+    float32x4_t vm = vdupq_n_f32(-INFINITY);
+    size_t j = 0;
+    for (; j + 4 <= n; j += 4) vm = vmaxq_f32(vm, vld1q_f32(x + j));
+    float mx = vmaxvq_f32(vm);
+    for (; j < n; j++) mx = MAX(mx, x[j]);
+    return mx;
+}
+
+
+/**
+ * y = exp(x - shift), trả về Σ y
+*/
+static inline float neon_row_exp_sum_f32(const float* x, float* y, size_t n, float shift) {
+    float32x4_t vs = vdupq_n_f32(shift);
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    size_t j = 0;
+    for (; j + 4 <= n; j += 4) {
+        float32x4_t e = neon_exp_precise_f32x4(vsubq_f32(vld1q_f32(x + j), vs));
+        vst1q_f32(y + j, e);
+        acc = vaddq_f32(acc, e);
+    }
+    float s = vaddvq_f32(acc);
+    for (; j < n; j++) {
+        y[j] = expf(x[j] - shift);
+        s += y[j];
+    }
+    return s;
+}
+
+
+static inline void neon_row_scale_f32(float* y, size_t n, float scale) {
+    size_t j = 0;
+    for (; j + 4 <= n; j += 4) vst1q_f32(y + j, vmulq_n_f32(vld1q_f32(y + j), scale));
+    for (; j < n; j++) y[j] *= scale;
+}
+
+
+/**
+ * Softmax từng hàng, x [m x n] → y (y có thể trùng x)
+*/
+static inline void neon_softmax_f32(const float* x, float* y, size_t m, size_t n) {
+    for (size_t i = 0; i < m; i++) {
+        float mx = neon_row_max_f32(x + i * n, n);
+        float s = neon_row_exp_sum_f32(x + i * n, y + i * n, n, mx);
+        neon_row_scale_f32(y + i * n, n, 1.0f / s);
+    }
+}
+
+
+/**
+ * dx = y * (dy - Σ_j dy_j * y_j) (y = output của softmax), dx có thể trùng dy
+*/
+static inline void neon_softmax_backward_f32(const float* y, const float* dy, float* dx, size_t m, size_t n) {
+    for (size_t i = 0; i < m; i++) {
+        const float* yr = y + i * n;
+        const float* gr = dy + i * n;
+        float* dr = dx + i * n;
+
+        float32x4_t acc = vdupq_n_f32(0.0f);
+        size_t j = 0;
+        for (; j + 4 <= n; j += 4) acc = vfmaq_f32(acc, vld1q_f32(yr + j), vld1q_f32(gr + j));
+        float dot = vaddvq_f32(acc);
+        for (; j < n; j++) dot += yr[j] * gr[j];
+
+        float32x4_t vd = vdupq_n_f32(dot);
+        j = 0;
+        for (; j + 4 <= n; j += 4) {
+            vst1q_f32(dr + j, vmulq_f32(vld1q_f32(yr + j), vsubq_f32(vld1q_f32(gr + j), vd)));
+        }
+        for (; j < n; j++) dr[j] = yr[j] * (gr[j] - dot);
+    }
+}
+
+
+/**
+ * Fused softmax + cross-entropy, logits [m x c], labels [m]
+ *
+ * @param dlogits: [m x c] gradient của mean loss, NULL = chỉ tính loss (có thể trùng logits)
+ * @return: mean loss, NAN nếu label ngoài [0, c)
+*/
+static inline float neon_softmax_cross_entropy_f32(
+    const float* logits,
+    const int32_t* labels,
+    size_t m,
+    size_t c,
+    float* dlogits
+) {
+    double total = 0.0;
+    float inv_m = 1.0f / (float)m;
+
+    for (size_t i = 0; i < m; i++) {
+        const float* z = logits + i * c;
+        int32_t label = labels[i];
+        if (label < 0 || (size_t)label >= c) return NAN;
+
+        float mx = neon_row_max_f32(z, c);
+        float z_label = z[label];
+
+        if (dlogits != NULL) {
+            float* g = dlogits + i * c;
+            float s = neon_row_exp_sum_f32(z, g, c, mx);
+            neon_row_scale_f32(g, c, inv_m / s);
+            g[label] -= inv_m;
+            total += (double)(logf(s) + mx - z_label);
+        } else {
+            float32x4_t vs = vdupq_n_f32(mx);
+            float32x4_t acc = vdupq_n_f32(0.0f);
+            size_t j = 0;
+            for (; j + 4 <= c; j += 4) acc = vaddq_f32(acc, neon_exp_precise_f32x4(vsubq_f32(vld1q_f32(z + j), vs)));
+            float s = vaddvq_f32(acc);
+            for (; j < c; j++) s += expf(z[j] - mx);
+            total += (double)(logf(s) + mx - z_label);
+        }
+    }
+
+    return (float)(total / (double)m);
+}
+
+
+
+// LAYERNORM / RMSNORM
+static inline float neon_row_sum_f32(const float* x, size_t n) {
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    size_t j = 0;
+    for (; j + 4 <= n; j += 4) acc = vaddq_f32(acc, vld1q_f32(x + j));
+    float s = vaddvq_f32(acc);
+    for (; j < n; j++) s += x[j];
+    return s;
+}
+
+
+/**
+ * Σ (x - shift)²
+*/
+static inline float neon_row_sq_dev_f32(const float* x, size_t n, float shift) {
+    float32x4_t vs = vdupq_n_f32(shift);
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    size_t j = 0;
+    for (; j + 4 <= n; j += 4) {
+        float32x4_t d = vsubq_f32(vld1q_f32(x + j), vs);
+        acc = vfmaq_f32(acc, d, d);
+    }
+    float s = vaddvq_f32(acc);
+    for (; j < n; j++) s += (x[j] - shift) * (x[j] - shift);
+    return s;
+}
+
+
+/**
+ * y = (x - mean) * rstd * gamma + beta (beta có thể NULL), mỗi hàng d phần tử
+ * @param mean, rstd: [m] cache cho backward
+*/
+static inline void neon_layernorm_f32(
+    const float* x,
+    const float* gamma,
+    const float* beta,
+    float eps,
+    float* y,
+    float* mean,
+    float* rstd,
+    size_t m,
+    size_t d
+) {
+    for (size_t i = 0; i < m; i++) {
+        const float* xr = x + i * d;
+        float* yr = y + i * d;
+        float mu = neon_row_sum_f32(xr, d) / (float)d;
+        float rs = 1.0f / sqrtf(neon_row_sq_dev_f32(xr, d, mu) / (float)d + eps);
+        mean[i] = mu;
+        rstd[i] = rs;
+
+        float32x4_t vmu = vdupq_n_f32(mu);
+        size_t j = 0;
+        for (; j + 4 <= d; j += 4) {
+            float32x4_t xh = vmulq_n_f32(vsubq_f32(vld1q_f32(xr + j), vmu), rs);
+            float32x4_t b = beta ? vld1q_f32(beta + j) : vdupq_n_f32(0.0f);
+            vst1q_f32(yr + j, vfmaq_f32(b, xh, vld1q_f32(gamma + j)));
+        }
+        for (; j < d; j++) yr[j] = (xr[j] - mu) * rs * gamma[j] + (beta ? beta[j] : 0.0f);
+    }
+}
+
+
+/**
+ * LayerNorm backward
+ * dx = rstd * (g - mean(g) - x̂ * mean(g * x̂)), g = dy * gamma
+ * dgamma += Σ dy * x̂, dbeta += Σ dy (dbeta có thể NULL)
+*/
+static inline void neon_layernorm_backward_f32(
+    const float* dy,
+    const float* x,
+    const float* gamma,
+    const float* mean,
+    const float* rstd,
+    float* dx,
+    float* dgamma,
+    float* dbeta,
+    size_t m,
+    size_t d
+) {
+    for (size_t i = 0; i < m; i++) {
+        const float* gr = dy + i * d;
+        const float* xr = x + i * d;
+        float* dr = dx + i * d;
+        float32x4_t vmu = vdupq_n_f32(mean[i]);
+        float rs = rstd[i];
+
+        float32x4_t sg = vdupq_n_f32(0.0f), sgx = vdupq_n_f32(0.0f);
+        size_t j = 0;
+        for (; j + 4 <= d; j += 4) {
+            float32x4_t vdy = vld1q_f32(gr + j);
+            float32x4_t xh = vmulq_n_f32(vsubq_f32(vld1q_f32(xr + j), vmu), rs);
+            float32x4_t g = vmulq_f32(vdy, vld1q_f32(gamma + j));
+            sg = vaddq_f32(sg, g);
+            sgx = vfmaq_f32(sgx, g, xh);
+            vst1q_f32(dgamma + j, vfmaq_f32(vld1q_f32(dgamma + j), vdy, xh));
+            if (dbeta) vst1q_f32(dbeta + j, vaddq_f32(vld1q_f32(dbeta + j), vdy));
+        }
+        float sum_g = vaddvq_f32(sg), sum_gx = vaddvq_f32(sgx);
+        for (; j < d; j++) {
+            float xh = (xr[j] - mean[i]) * rs;
+            float g = gr[j] * gamma[j];
+            sum_g += g;
+            sum_gx += g * xh;
+            dgamma[j] += gr[j] * xh;
+            if (dbeta) dbeta[j] += gr[j];
+        }
+
+        float mg = sum_g / (float)d, mgx = sum_gx / (float)d;
+        float32x4_t vmg = vdupq_n_f32(mg), vmgx = vdupq_n_f32(mgx);
+        j = 0;
+        for (; j + 4 <= d; j += 4) {
+            float32x4_t xh = vmulq_n_f32(vsubq_f32(vld1q_f32(xr + j), vmu), rs);
+            float32x4_t g = vmulq_f32(vld1q_f32(gr + j), vld1q_f32(gamma + j));
+            float32x4_t t = vfmsq_f32(vsubq_f32(g, vmg), xh, vmgx);
+            vst1q_f32(dr + j, vmulq_n_f32(t, rs));
+        }
+        for (; j < d; j++) {
+            float xh = (xr[j] - mean[i]) * rs;
+            float g = gr[j] * gamma[j];
+            dr[j] = rs * (g - mg - xh * mgx);
+        }
+    }
+}
+
+
+/**
+ * y = x * rstd * gamma, rstd = 1 / sqrt(mean(x²) + eps)
+*/
+static inline void neon_rmsnorm_f32(
+    const float* x,
+    const float* gamma,
+    float eps,
+    float* y,
+    float* rstd,
+    size_t m,
+    size_t d
+) {
+    for (size_t i = 0; i < m; i++) {
+        const float* xr = x + i * d;
+        float* yr = y + i * d;
+        float rs = 1.0f / sqrtf(neon_row_sq_dev_f32(xr, d, 0.0f) / (float)d + eps);
+        rstd[i] = rs;
+
+        size_t j = 0;
+        for (; j + 4 <= d; j += 4) {
+            vst1q_f32(yr + j, vmulq_f32(vmulq_n_f32(vld1q_f32(xr + j), rs), vld1q_f32(gamma + j)));
+        }
+        for (; j < d; j++) yr[j] = xr[j] * rs * gamma[j];
+    }
+}
+
+
+/**
+ * RMSNorm backward
+ * dx = rstd * (g - x̂ * mean(g * x̂)), g = dy * gamma, x̂ = x * rstd
+ * dgamma += Σ dy * x̂
+*/
+static inline void neon_rmsnorm_backward_f32(
+    const float* dy,
+    const float* x,
+    const float* gamma,
+    const float* rstd,
+    float* dx,
+    float* dgamma,
+    size_t m,
+    size_t d
+) {
+    for (size_t i = 0; i < m; i++) {
+        const float* gr = dy + i * d;
+        const float* xr = x + i * d;
+        float* dr = dx + i * d;
+        float rs = rstd[i];
+
+        float32x4_t sgx = vdupq_n_f32(0.0f);
+        size_t j = 0;
+        for (; j + 4 <= d; j += 4) {
+            float32x4_t vdy = vld1q_f32(gr + j);
+            float32x4_t xh = vmulq_n_f32(vld1q_f32(xr + j), rs);
+            sgx = vfmaq_f32(sgx, vmulq_f32(vdy, vld1q_f32(gamma + j)), xh);
+            vst1q_f32(dgamma + j, vfmaq_f32(vld1q_f32(dgamma + j), vdy, xh));
+        }
+        float sum_gx = vaddvq_f32(sgx);
+        for (; j < d; j++) {
+            float xh = xr[j] * rs;
+            sum_gx += gr[j] * gamma[j] * xh;
+            dgamma[j] += gr[j] * xh;
+        }
+
+        float mgx = sum_gx / (float)d;
+        float32x4_t vmgx = vdupq_n_f32(mgx);
+        j = 0;
+        for (; j + 4 <= d; j += 4) {
+            float32x4_t xh = vmulq_n_f32(vld1q_f32(xr + j), rs);
+            float32x4_t g = vmulq_f32(vld1q_f32(gr + j), vld1q_f32(gamma + j));
+            vst1q_f32(dr + j, vmulq_n_f32(vfmsq_f32(g, xh, vmgx), rs));
+        }
+        for (; j < d; j++) {
+            float xh = xr[j] * rs;
+            dr[j] = rs * (gr[j] * gamma[j] - xh * mgx);
+        }
+    }
+}
+
+
+
+// SGEMM
+/**
+ * Micro-kernel 4x8: tile[4 x 8] = A_panel * B_panel
+ * A_panel: packed k x 4, B_panel: packed k x 8
+ * 8 accumulators, mỗi k: 1 load A + 2 loads B, 8 FMAs (broadcast lane của A)
+*/
+static NEON_INLINE void neon_sgemm_kernel_4x8(const float* a_panel, const float* b_panel, size_t k, float* tile) {
+    float32x4_t c00 = vdupq_n_f32(0.0f), c01 = vdupq_n_f32(0.0f);
+    float32x4_t c10 = vdupq_n_f32(0.0f), c11 = vdupq_n_f32(0.0f);
+    float32x4_t c20 = vdupq_n_f32(0.0f), c21 = vdupq_n_f32(0.0f);
+    float32x4_t c30 = vdupq_n_f32(0.0f), c31 = vdupq_n_f32(0.0f);
+
+    for (size_t p = 0; p < k; p++) {
+        float32x4_t a = vld1q_f32(a_panel + p * 4);
+        float32x4_t b0 = vld1q_f32(b_panel + p * 8);
+        float32x4_t b1 = vld1q_f32(b_panel + p * 8 + 4);
+
+        c00 = vfmaq_laneq_f32(c00, b0, a, 0);
+        c01 = vfmaq_laneq_f32(c01, b1, a, 0);
+        c10 = vfmaq_laneq_f32(c10, b0, a, 1);
+        c11 = vfmaq_laneq_f32(c11, b1, a, 1);
+        c20 = vfmaq_laneq_f32(c20, b0, a, 2);
+        c21 = vfmaq_laneq_f32(c21, b1, a, 2);
+        c30 = vfmaq_laneq_f32(c30, b0, a, 3);
+        c31 = vfmaq_laneq_f32(c31, b1, a, 3);
+    }
+
+    vst1q_f32(tile, c00);
+    vst1q_f32(tile + 4, c01);
+    vst1q_f32(tile + 8, c10);
+    vst1q_f32(tile + 12, c11);
+    vst1q_f32(tile + 16, c20);
+    vst1q_f32(tile + 20, c21);
+    vst1q_f32(tile + 24, c30);
+    vst1q_f32(tile + 28, c31);
+}
+
+
+/**
+ * C[m x n] (+)= op(A) * op(B), single thread
+ *
+ * op(A)[i][p] = trans_a ? A[p * lda + i] : A[i * lda + p]
+ * op(B)[p][j] = trans_b ? B[j * ldb + p] : B[p * ldb + j]
+ * @param accumulate: 0 = ghi đè C, 1 = cộng vào C
+*/
+static inline int neon_sgemm_serial(
+    int trans_a,
+    int trans_b,
+    size_t m,
+    size_t n,
+    size_t k,
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    int accumulate
+) {
+    if (!accumulate) {
+        for (size_t i = 0; i < m; i++) memset(C + i * ldc, 0, n * sizeof(float));
+    }
+    if (m == 0 || n == 0 || k == 0) return NEON_SUCCESS;
+
+    size_t kc_max = MIN(k, (size_t)NEON_SGEMM_KC);
+    size_t n_panels = (n + 7) / 8;
+    float* b_packed = (float*)neon_malloc((n_panels * kc_max * 8 + 4) * sizeof(float));
+    float* a_packed = (float*)neon_malloc((kc_max * 4 + 4) * sizeof(float));
+
+    if (b_packed == NULL || a_packed == NULL) {
+        neon_free(b_packed);
+        neon_free(a_packed);
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    float tile[32] ALIGN_NEON;
+
+    for (size_t p0 = 0; p0 < k; p0 += kc_max) {
+        size_t kc = MIN(kc_max, k - p0);
+
+        for (size_t jp = 0; jp < n_panels; jp++) {
+            float* dst = b_packed + jp * kc * 8;
+            for (size_t p = 0; p < kc; p++) {
+                for (size_t jj = 0; jj < 8; jj++) {
+                    size_t j = jp * 8 + jj;
+                    if (j >= n) {
+                        dst[p * 8 + jj] = 0.0f;
+                    } else {
+                        dst[p * 8 + jj] = trans_b ? B[j * ldb + p0 + p] : B[(p0 + p) * ldb + j];
+                    }
+                }
+            }
+        }
+
+        for (size_t i = 0; i < m; i += 4) {
+            size_t rows = MIN(4, m - i);
+
+            for (size_t p = 0; p < kc; p++) {
+                for (size_t ii = 0; ii < 4; ii++) {
+                    if (ii >= rows) {
+                        a_packed[p * 4 + ii] = 0.0f;
+                    } else {
+                        a_packed[p * 4 + ii] = trans_a ? A[(p0 + p) * lda + i + ii] : A[(i + ii) * lda + p0 + p];
+                    }
+                }
+            }
+
+            for (size_t jp = 0; jp < n_panels; jp++) {
+                size_t j = jp * 8;
+                size_t cols = MIN(8, n - j);
+
+                neon_sgemm_kernel_4x8(a_packed, b_packed + jp * kc * 8, kc, tile);
+
+                for (size_t ii = 0; ii < rows; ii++) {
+                    float* c = C + (i + ii) * ldc + j;
+                    if (cols == 8) {
+                        vst1q_f32(c, vaddq_f32(vld1q_f32(c), vld1q_f32(tile + ii * 8)));
+                        vst1q_f32(c + 4, vaddq_f32(vld1q_f32(c + 4), vld1q_f32(tile + ii * 8 + 4)));
+                    } else {
+                        for (size_t jj = 0; jj < cols; jj++) c[jj] += tile[ii * 8 + jj];
+                    }
+                }
+            }
+        }
+    }
+
+    neon_free(a_packed);
+    neon_free(b_packed);
+    return NEON_SUCCESS;
+}
+
+
+typedef struct {
+    int trans_a;
+    int trans_b;
+    size_t n;
+    size_t k;
+    const float* A;
+    size_t lda;
+    const float* B;
+    size_t ldb;
+    float* C;
+    size_t ldc;
+    int accumulate;
+    int error[NEON_MAX_THREADS];
+} NeonSgemmCtx;
+
+
+static void neon_sgemm_worker(void* arg, size_t begin, size_t end, int tid) {
+    NeonSgemmCtx* ctx = (NeonSgemmCtx*)arg;
+    const float* a = ctx->trans_a ? ctx->A + begin : ctx->A + begin * ctx->lda;
+
+    ctx->error[tid] = neon_sgemm_serial(ctx->trans_a, ctx->trans_b, end - begin, ctx->n, ctx->k,
+                                        a, ctx->lda, ctx->B, ctx->ldb,
+                                        ctx->C + begin * ctx->ldc, ctx->ldc, ctx->accumulate);
+}
+
+
+/**
+ * C (+)= op(A) * op(B), hàng của C chia cho threads (mỗi thread pack B riêng)
+*/
+static inline int neon_sgemm(
+    int trans_a,
+    int trans_b,
+    size_t m,
+    size_t n,
+    size_t k,
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    int accumulate,
+    int num_threads
+) {
+    if (A == NULL || B == NULL || C == NULL) return NEON_ERROR_NULL_POINTER;
+    if (m == 0 || n == 0) return NEON_SUCCESS;
+
+    NeonSgemmCtx ctx;
+    ctx.trans_a = trans_a;
+    ctx.trans_b = trans_b;
+    ctx.n = n;
+    ctx.k = k;
+    ctx.A = A;
+    ctx.lda = lda;
+    ctx.B = B;
+    ctx.ldb = ldb;
+    ctx.C = C;
+    ctx.ldc = ldc;
+    ctx.accumulate = accumulate;
+    memset(ctx.error, 0, sizeof(ctx.error));
+
+    num_threads = neon_threads_for(m, num_threads, NEON_SGEMM_MIN_ROWS);
+    neon_parallel_for(m, num_threads, neon_sgemm_worker, &ctx);
+
+    for (int t = 0; t < num_threads; t++) {
+        if (ctx.error[t] != NEON_SUCCESS) return ctx.error[t];
+    }
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * Linear layer backward, forward Y [m x n] = X [m x k] * W [k x n] + b
+ *
+ * dX = dY * W^T (ghi đè), dW += X^T * dY, db += Σ_rows dY
+ * dX / dW / db = NULL → bỏ qua gradient đó (ví dụ layer đầu không cần dX)
+*/
+static inline int neon_linear_backward_f32(
+    const float* dY,
+    const float* X,
+    const float* W,
+    float* dX,
+    float* dW,
+    float* db,
+    size_t m,
+    size_t k,
+    size_t n,
+    int num_threads
+) {
+    if (dY == NULL) return NEON_ERROR_NULL_POINTER;
+
+    int err = NEON_SUCCESS;
+    if (dX != NULL) {
+        err = neon_sgemm(0, 1, m, k, n, dY, n, W, n, dX, k, 0, num_threads);
+        if (err != NEON_SUCCESS) return err;
+    }
+    if (dW != NULL) {
+        err = neon_sgemm(1, 0, k, n, m, X, k, dY, n, dW, n, 1, num_threads);
+        if (err != NEON_SUCCESS) return err;
+    }
+    if (db != NULL) neon_bias_backward_f32(dY, db, m, n);
+    return NEON_SUCCESS;
+}
+
+
+
+// GRADIENT CHECK
+typedef float (*NeonLossFn)(void* ctx, const float* x);
+
+
+/**
+ * So sánh grad analytic với central difference (f(x + h) - f(x - h)) / 2h
+ *
+ * @param x: [n] input (bị thay đổi tạm thời, được trả lại giá trị cũ)
+ * @param max_checks: số phần tử kiểm tra (rải đều trên [0, n)), 0 = tất cả
+ * @return: max |g_num - g| / max(1, |g_num| + |g|)
+*/
+static inline float neon_gradient_check(
+    NeonLossFn fn,
+    void* ctx,
+    float* x,
+    size_t n,
+    const float* grad,
+    float h,
+    size_t max_checks
+) {
+    size_t checks = (max_checks == 0 || max_checks > n) ? n : max_checks;
+    float worst = 0.0f;
+
+    for (size_t c = 0; c < checks; c++) {
+        size_t i = (checks == n) ? c : c * n / checks;
+        float saved = x[i];
+
+        x[i] = saved + h;
+        double fp = fn(ctx, x);
+        x[i] = saved - h;
+        double fm = fn(ctx, x);
+        x[i] = saved;
+
+        float num = (float)((fp - fm) / (2.0 * (double)h));
+        float err = fabsf(num - grad[i]) / MAX(1.0f, fabsf(num) + fabsf(grad[i]));
+        worst = MAX(worst, err);
+    }
+
+    return worst;
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_BACKWARD_H
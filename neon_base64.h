@@ -0,0 +1,402 @@
+#ifndef NEON_BASE64_H
+#define NEON_BASE64_H
+
+#include "neon_types.h"
+#include "memory_align.h"
+
+
+/**
+ * BASE64 & HEX ENCODE / DECODE
+ *
+ * BASE64 ENCODE (48 bytes → 64 chars mỗi vòng):
+ *   vld3q_u8 tách 48 bytes thành a, b, c (mỗi vector 16 bytes, byte thứ 0/1/2 của mỗi nhóm 3)
+ *     i0 = a >> 2
+ *     i1 = (a & 0x03) << 4 | b >> 4
+ *     i2 = (b & 0x0F) << 2 | c >> 6
+ *     i3 = c & 0x3F
+ *   vqtbl4q_u8(alphabet 64 bytes, i) → ký tự, vst4q_u8 interleave lại
+ *
+ * BASE64 DECODE (64 chars → 48 bytes):
+ *   vld4q_u8 → 4 vectors ký tự
+ *   Bảng 128 entries (0xFF = không hợp lệ): vqtbl4q_u8 cho ký tự 0-63, vqtbx4q_u8 cho 64-127
+ *   Lỗi: giá trị 0xFF hoặc ký tự >= 0x80 → bit 7 của (value | char) → OR tích lũy, kiểm tra 1 lần / block
+ *   vst3q_u8 ghép lại 3 bytes
+ *
+ * HEX: vqtbl1q_u8("0123456789abcdef", nibble), vst2q_u8 interleave nibble cao / thấp
+ *
+ * Padding '=' và phần đuôi xử lý scalar
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+typedef enum {
+    BASE64_STANDARD = 0, // A-Z a-z 0-9 + /, có padding '='
+    BASE64_URL = 1 // A-Z a-z 0-9 - _, không padding
+} Base64Alphabet;
+
+
+static const uint8_t NEON_BASE64_ENC_STD[64] ALIGN_NEON = {
+    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
+    'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f',
+    'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v',
+    'w', 'x', 'y', 'z', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/'
+};
+
+static const uint8_t NEON_BASE64_ENC_URL[64] ALIGN_NEON = {
+    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
+    'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f',
+    'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v',
+    'w', 'x', 'y', 'z', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '-', '_'
+};
+
+static const uint8_t NEON_BASE64_DEC_STD[128] ALIGN_NEON = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+static const uint8_t NEON_BASE64_DEC_URL[128] ALIGN_NEON = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0x3F,
+    0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+
+static NEON_INLINE uint8x16x4_t neon_load_table64(const uint8_t* t) {
+    uint8x16x4_t r;
+    r.val[0] = vld1q_u8(t);
+    r.val[1] = vld1q_u8(t + 16);
+    r.val[2] = vld1q_u8(t + 32);
+    r.val[3] = vld1q_u8(t + 48);
+    return r;
+}
+
+
+
+// BASE64 ENCODE
+/**
+ * Số ký tự output cho n bytes
+*/
+static inline size_t neon_base64_encoded_length(size_t n, Base64Alphabet alphabet) {
+    if (alphabet == BASE64_URL) {
+        return (n / 3) * 4 + ((n % 3) ? (n % 3) + 1 : 0);
+    }
+    return ((n + 2) / 3) * 4;
+}
+
+
+/**
+ * @param dst: tối thiểu neon_base64_encoded_length(n) bytes (không ghi '\0')
+ * @return: số ký tự đã ghi
+*/
+static inline size_t neon_base64_encode(const uint8_t* src, size_t n, char* dst, Base64Alphabet alphabet) {
+    const uint8_t* enc = (alphabet == BASE64_URL) ? NEON_BASE64_ENC_URL : NEON_BASE64_ENC_STD;
+    const uint8x16x4_t table = neon_load_table64(enc);
+    const uint8x16_t mask3 = vdupq_n_u8(0x03);
+    const uint8x16_t mask15 = vdupq_n_u8(0x0F);
+    const uint8x16_t mask63 = vdupq_n_u8(0x3F);
+
+    uint8_t* out = (uint8_t*)dst;
+    size_t i = 0;
+
+    for (; i + 48 <= n; i += 48, out += 64) {
+        NEON_PREFETCH(src + i + 256);
+
+        uint8x16x3_t in = vld3q_u8(src + i);
+        uint8x16_t a = in.val[0];
+        uint8x16_t b = in.val[1];
+        uint8x16_t c = in.val[2];
+
+        uint8x16x4_t idx;
+        idx.val[0] = vshrq_n_u8(a, 2);
+        idx.val[1] = vorrq_u8(vshlq_n_u8(vandq_u8(a, mask3), 4), vshrq_n_u8(b, 4));
+        idx.val[2] = vorrq_u8(vshlq_n_u8(vandq_u8(b, mask15), 2), vshrq_n_u8(c, 6));
+        idx.val[3] = vandq_u8(c, mask63);
+
+        uint8x16x4_t chars;
+        chars.val[0] = vqtbl4q_u8(table, idx.val[0]);
+        chars.val[1] = vqtbl4q_u8(table, idx.val[1]);
+        chars.val[2] = vqtbl4q_u8(table, idx.val[2]);
+        chars.val[3] = vqtbl4q_u8(table, idx.val[3]);
+
+        vst4q_u8(out, chars);
+    }
+
+    for (; i + 3 <= n; i += 3, out += 4) {
+        uint32_t v = ((uint32_t)src[i] << 16) | ((uint32_t)src[i + 1] << 8) | src[i + 2];
+        out[0] = enc[(v >> 18) & 0x3F];
+        out[1] = enc[(v >> 12) & 0x3F];
+        out[2] = enc[(v >> 6) & 0x3F];
+        out[3] = enc[v & 0x3F];
+    }
+
+    size_t rem = n - i;
+    if (rem > 0) {
+        uint32_t v = (uint32_t)src[i] << 16;
+        if (rem == 2) v |= (uint32_t)src[i + 1] << 8;
+
+        *out++ = enc[(v >> 18) & 0x3F];
+        *out++ = enc[(v >> 12) & 0x3F];
+        if (rem == 2) {
+            *out++ = enc[(v >> 6) & 0x3F];
+        }
+        if (alphabet == BASE64_STANDARD) {
+            if (rem == 1) *out++ = '=';
+            *out++ = '=';
+        }
+    }
+
+    return (size_t)(out - (uint8_t*)dst);
+}
+
+
+
+// BASE64 DECODE
+/**
+ * Số bytes tối đa khi decode n ký tự
+*/
+static inline size_t neon_base64_decoded_max_length(size_t n) {
+    return (n / 4) * 3 + 2;
+}
+
+
+/**
+ * @param dst: tối thiểu neon_base64_decoded_max_length(n) bytes
+ * @param out_len: số bytes đã ghi
+ * @return: NEON_SUCCESS hoặc NEON_ERROR_INVALID_PARAM (ký tự lạ, padding sai, độ dài sai)
+*/
+static inline int neon_base64_decode(
+    const char* src,
+    size_t n,
+    uint8_t* dst,
+    size_t* out_len,
+    Base64Alphabet alphabet
+) {
+    if (src == NULL || dst == NULL || out_len == NULL) return NEON_ERROR_NULL_POINTER;
+
+    const uint8_t* dec = (alphabet == BASE64_URL) ? NEON_BASE64_DEC_URL : NEON_BASE64_DEC_STD;
+    const uint8_t* in = (const uint8_t*)src;
+    *out_len = 0;
+
+    // Bỏ padding ở cuối (tối đa 2 ký tự '='), độ dài có padding phải chia hết cho 4
+    size_t len = n;
+    if (len > 0 && in[len - 1] == '=') {
+        if (n % 4 != 0) return NEON_ERROR_INVALID_PARAM;
+        len--;
+        if (len > 0 && in[len - 1] == '=') len--;
+    }
+    if (len % 4 == 1) return NEON_ERROR_INVALID_PARAM;
+
+    const uint8x16x4_t tbl_lo = neon_load_table64(dec);
+    const uint8x16x4_t tbl_hi = neon_load_table64(dec + 64);
+    const uint8x16_t v64 = vdupq_n_u8(64);
+
+    uint8_t* out = dst;
+    size_t i = 0;
+
+    for (; i + 64 <= len; i += 64, out += 48) {
+        NEON_PREFETCH(in + i + 256);
+
+        uint8x16x4_t c = vld4q_u8(in + i);
+        uint8x16x4_t v;
+        uint8x16_t err = vdupq_n_u8(0);
+
+        for (int k = 0; k < 4; k++) {
+            v.val[k] = vqtbl4q_u8(tbl_lo, c.val[k]);
+            v.val[k] = vqtbx4q_u8(v.val[k], tbl_hi, vsubq_u8(c.val[k], v64));
+            err = vorrq_u8(err, vorrq_u8(v.val[k], c.val[k]));
+        }
+
+        if (UNLIKELY(vmaxvq_u8(err) >= 0x80)) return NEON_ERROR_INVALID_PARAM;
+
+        uint8x16x3_t o;
+        o.val[0] = vorrq_u8(vshlq_n_u8(v.val[0], 2), vshrq_n_u8(v.val[1], 4));
+        o.val[1] = vorrq_u8(vshlq_n_u8(v.val[1], 4), vshrq_n_u8(v.val[2], 2));
+        o.val[2] = vorrq_u8(vshlq_n_u8(v.val[2], 6), v.val[3]);
+
+        vst3q_u8(out, o);
+    }
+
+    // Scalar: các quantum 4 ký tự còn lại + quantum cuối 2-3 ký tự
+    uint32_t bits = 0;
+    int count = 0;
+    for (; i < len; i++) {
+        uint8_t ch = in[i];
+        uint8_t v = (ch < 128) ? dec[ch] : 0xFF;
+        if (v == 0xFF) return NEON_ERROR_INVALID_PARAM;
+
+        bits = (bits << 6) | v;
+        if (++count == 4) {
+            *out++ = (uint8_t)(bits >> 16);
+            *out++ = (uint8_t)(bits >> 8);
+            *out++ = (uint8_t)bits;
+            bits = 0;
+            count = 0;
+        }
+    }
+
+    if (count == 2) {
+        if (bits & 0x0F) return NEON_ERROR_INVALID_PARAM; // bit thừa phải = 0
+        *out++ = (uint8_t)(bits >> 4);
+    } else if (count == 3) {
+        if (bits & 0x03) return NEON_ERROR_INVALID_PARAM;
+        *out++ = (uint8_t)(bits >> 10);
+        *out++ = (uint8_t)(bits >> 2);
+    }
+
+    *out_len = (size_t)(out - dst);
+    return NEON_SUCCESS;
+}
+
+
+
+// ALIGNED BUFFER
+/**
+ * Encode buffer->size floats (raw bytes, little-endian)
+*/
+static inline size_t neon_base64_encode_buffer(const AlignedBuffer* buffer, char* dst, Base64Alphabet alphabet) {
+    return neon_base64_encode((const uint8_t*)buffer->data, buffer->size * sizeof(float), dst, alphabet);
+}
+
+
+/**
+ * Decode vào AlignedBuffer (resize nếu cần), kết quả phải là bội của sizeof(float)
+ * Decode qua vùng tạm, chỉ ghi vào buffer khi thành công → lỗi thì buffer giữ nguyên
+*/
+static inline int neon_base64_decode_buffer(
+    const char* src,
+    size_t n,
+    AlignedBuffer* buffer,
+    Base64Alphabet alphabet
+) {
+    if (buffer == NULL) return NEON_ERROR_NULL_POINTER;
+
+    size_t max_bytes = neon_base64_decoded_max_length(n);
+    uint8_t* tmp = (uint8_t*)neon_malloc(max_bytes > 0 ? max_bytes : 1);
+    if (tmp == NULL) return NEON_ERROR_OUT_OF_MEMORY;
+
+    size_t bytes;
+    int err = neon_base64_decode(src, n, tmp, &bytes, alphabet);
+    if (err == NEON_SUCCESS && bytes % sizeof(float) != 0) err = NEON_ERROR_INVALID_SIZE;
+    if (err == NEON_SUCCESS) err = aligned_buffer_resize(buffer, bytes / sizeof(float));
+
+    if (err == NEON_SUCCESS) {
+        if (bytes > 0) memcpy(buffer->data, tmp, bytes);
+        buffer->size = bytes / sizeof(float);
+    }
+
+    neon_free(tmp);
+    return err;
+}
+
+
+
+// HEX
+/**
+ * n bytes → 2n ký tự hex
+*/
+static inline void neon_hex_encode(const uint8_t* src, size_t n, char* dst, int uppercase) {
+    static const uint8_t LOWER[16] ALIGN_NEON = {
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'
+    };
+    static const uint8_t UPPER[16] ALIGN_NEON = {
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+    };
+
+    const uint8_t* digits = uppercase ? UPPER : LOWER;
+    const uint8x16_t table = vld1q_u8(digits);
+    const uint8x16_t mask15 = vdupq_n_u8(0x0F);
+    uint8_t* out = (uint8_t*)dst;
+
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t v = vld1q_u8(src + i);
+        uint8x16x2_t hex;
+        hex.val[0] = vqtbl1q_u8(table, vshrq_n_u8(v, 4));
+        hex.val[1] = vqtbl1q_u8(table, vandq_u8(v, mask15));
+        vst2q_u8(out + 2 * i, hex);
+    }
+
+    for (; i < n; i++) {
+        out[2 * i] = digits[src[i] >> 4];
+        out[2 * i + 1] = digits[src[i] & 0x0F];
+    }
+}
+
+
+/**
+ * 16 ký tự hex → 16 nibbles, *err |= 0x80 ở lane không hợp lệ
+ *   digit:  c - '0' <= 9
+ *   letter: (c | 0x20) - 'a' <= 5  → + 10   (chấp nhận cả hoa và thường)
+*/
+static NEON_INLINE uint8x16_t neon_hex_nibbles(uint8x16_t c, uint8x16_t* err) {
+    uint8x16_t d = vsubq_u8(c, vdupq_n_u8('0'));
+    uint8x16_t l = vsubq_u8(vorrq_u8(c, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+
+    uint8x16_t is_digit = vcleq_u8(d, vdupq_n_u8(9));
+    uint8x16_t is_letter = vcleq_u8(l, vdupq_n_u8(5));
+
+    *err = vorrq_u8(*err, vmvnq_u8(vorrq_u8(is_digit, is_letter)));
+    return vbslq_u8(is_digit, d, vaddq_u8(l, vdupq_n_u8(10)));
+}
+
+
+static NEON_INLINE int neon_hex_value(uint8_t c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    c |= 0x20;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+
+/**
+ * 2n ký tự hex → n bytes
+ * @param n_chars: phải chẵn
+ * @return: NEON_SUCCESS, NEON_ERROR_INVALID_SIZE (lẻ), NEON_ERROR_INVALID_PARAM (ký tự lạ)
+*/
+static inline int neon_hex_decode(const char* src, size_t n_chars, uint8_t* dst) {
+    if (n_chars % 2 != 0) return NEON_ERROR_INVALID_SIZE;
+
+    const uint8_t* in = (const uint8_t*)src;
+    size_t n = n_chars / 2;
+    uint8x16_t err = vdupq_n_u8(0);
+
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8x16x2_t c = vld2q_u8(in + 2 * i);
+        uint8x16_t hi = neon_hex_nibbles(c.val[0], &err);
+        uint8x16_t lo = neon_hex_nibbles(c.val[1], &err);
+        vst1q_u8(dst + i, vorrq_u8(vshlq_n_u8(hi, 4), lo));
+    }
+
+    if (vmaxvq_u8(err) != 0) return NEON_ERROR_INVALID_PARAM;
+
+    for (; i < n; i++) {
+        int hi = neon_hex_value(in[2 * i]);
+        int lo = neon_hex_value(in[2 * i + 1]);
+        if (hi < 0 || lo < 0) return NEON_ERROR_INVALID_PARAM;
+        dst[i] = (uint8_t)((hi << 4) | lo);
+    }
+
+    return NEON_SUCCESS;
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_BASE64_H
@@ -0,0 +1,311 @@
+#ifndef NEON_BYTES_H
+#define NEON_BYTES_H
+
+#include "neon_types.h"
+#include <string.h>
+
+
+/**
+ * BYTE-LEVEL PRIMITIVES (text / CSV / log parsing)
+ *
+ * Pattern chung: so sánh 16 bytes 1 lần bằng vceqq_u8 → mỗi lane 0x00 hoặc 0xFF
+ *
+ * MASK EXTRACTION (NEON không có movemask như SSE):
+ *   eq (16 x u8) --reinterpret--> 8 x u16 --vshrn_n_u16(.., 4)--> 8 x u8 = 64 bit
+ *   → mỗi byte input thành 1 nibble (0x0 hoặc 0xF) trong uint64
+ *   → vị trí match đầu tiên = ctz(mask) / 4
+ *
+ * Loop chính xử lý 64 bytes: OR 4 kết quả so sánh, vmaxvq_u8 == 0 → không có match, bỏ qua
+ * Chỉ khi có match mới extract mask từng block 16 bytes
+ *
+ * So với glibc (memchr / memcmp đã tối ưu NEON sẵn, đo bằng tests/bench_bytes.c):
+ *   - memchr 1 byte: inline được, tránh function call với buffer nhỏ
+ *   - memchr 2-3 delimiters, find-any-of: glibc không có (strpbrk dừng ở '\0')
+ *   - count byte: glibc không có, thay cho loop scalar
+ *
+ * Quy ước: hàm tìm kiếm trả về index của match đầu tiên, hoặc n nếu không có
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+// MASK HELPERS
+/**
+ * 16 lanes 0x00/0xFF → uint64, 4 bit / lane
+*/
+static NEON_INLINE uint64_t neon_mask_u8x16(neon_i8x16 eq) {
+    uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+}
+
+
+/**
+ * Index của lane match đầu tiên (mask != 0)
+*/
+static NEON_INLINE size_t neon_mask_first(uint64_t mask) {
+    return (size_t)(__builtin_ctzll(mask) >> 2);
+}
+
+
+/**
+ * Có lane nào khác 0 không
+*/
+static NEON_INLINE int neon_any_u8x16(neon_i8x16 v) {
+    return vmaxvq_u8(v) != 0;
+}
+
+
+
+// MEMCHR (1, 2, 3 DELIMITERS)
+/**
+ * Macro sinh memchr cho các predicate khác nhau
+ * MATCH(v) phải trả về neon_i8x16 (0xFF ở lane match), SCALAR(c) trả về int
+*/
+#define NEON_BYTES_SCAN_IMPL(MATCH, SCALAR)                                         \
+    size_t i = 0;                                                                   \
+    for (; i + 64 <= n; i += 64) {                                                  \
+        NEON_PREFETCH(s + i + 256);                                                 \
+        neon_i8x16 m0 = MATCH(vld1q_u8(s + i));                                     \
+        neon_i8x16 m1 = MATCH(vld1q_u8(s + i + 16));                                \
+        neon_i8x16 m2 = MATCH(vld1q_u8(s + i + 32));                                \
+        neon_i8x16 m3 = MATCH(vld1q_u8(s + i + 48));                                \
+        neon_i8x16 any = vorrq_u8(vorrq_u8(m0, m1), vorrq_u8(m2, m3));              \
+        if (LIKELY(!neon_any_u8x16(any))) continue;                                 \
+        uint64_t mask = neon_mask_u8x16(m0);                                        \
+        if (mask) return i + neon_mask_first(mask);                                 \
+        mask = neon_mask_u8x16(m1);                                                 \
+        if (mask) return i + 16 + neon_mask_first(mask);                            \
+        mask = neon_mask_u8x16(m2);                                                 \
+        if (mask) return i + 32 + neon_mask_first(mask);                            \
+        return i + 48 + neon_mask_first(neon_mask_u8x16(m3));                       \
+    }                                                                               \
+    for (; i + 16 <= n; i += 16) {                                                  \
+        uint64_t mask = neon_mask_u8x16(MATCH(vld1q_u8(s + i)));                    \
+        if (mask) return i + neon_mask_first(mask);                                 \
+    }                                                                               \
+    for (; i < n; i++) {                                                            \
+        if (SCALAR(s[i])) return i;                                                 \
+    }                                                                               \
+    return n;
+
+
+/**
+ * Tìm byte c đầu tiên trong s[0..n)
+ * @return: index, hoặc n nếu không có
+*/
+static inline size_t neon_memchr(const uint8_t* s, uint8_t c, size_t n) {
+    const neon_i8x16 vc = vdupq_n_u8(c);
+#define NEON_MATCH1(v) vceqq_u8((v), vc)
+#define NEON_SCALAR1(x) ((x) == c)
+    NEON_BYTES_SCAN_IMPL(NEON_MATCH1, NEON_SCALAR1)
+#undef NEON_MATCH1
+#undef NEON_SCALAR1
+}
+
+
+/**
+ * Tìm byte đầu tiên bằng c0 hoặc c1 (ví dụ ',' và '\n')
+*/
+static inline size_t neon_memchr2(const uint8_t* s, uint8_t c0, uint8_t c1, size_t n) {
+    const neon_i8x16 v0 = vdupq_n_u8(c0);
+    const neon_i8x16 v1 = vdupq_n_u8(c1);
+#define NEON_MATCH2(v) vorrq_u8(vceqq_u8((v), v0), vceqq_u8((v), v1))
+#define NEON_SCALAR2(x) ((x) == c0 || (x) == c1)
+    NEON_BYTES_SCAN_IMPL(NEON_MATCH2, NEON_SCALAR2)
+#undef NEON_MATCH2
+#undef NEON_SCALAR2
+}
+
+
+/**
+ * Tìm byte đầu tiên bằng c0, c1 hoặc c2 (ví dụ ',' '"' '\n')
+*/
+static inline size_t neon_memchr3(const uint8_t* s, uint8_t c0, uint8_t c1, uint8_t c2, size_t n) {
+    const neon_i8x16 v0 = vdupq_n_u8(c0);
+    const neon_i8x16 v1 = vdupq_n_u8(c1);
+    const neon_i8x16 v2 = vdupq_n_u8(c2);
+#define NEON_MATCH3(v) vorrq_u8(vorrq_u8(vceqq_u8((v), v0), vceqq_u8((v), v1)), vceqq_u8((v), v2))
+#define NEON_SCALAR3(x) ((x) == c0 || (x) == c1 || (x) == c2)
+    NEON_BYTES_SCAN_IMPL(NEON_MATCH3, NEON_SCALAR3)
+#undef NEON_MATCH3
+#undef NEON_SCALAR3
+}
+
+
+
+// FIND ANY OF SET (nibble lookup)
+/**
+ * Tập byte bất kỳ (tối đa 256 giá trị), kiểm tra bằng 2 lần vqtbl1q_u8:
+ *
+ *   byte b = [hi nibble | lo nibble]
+ *   row  = (b < 0x80) ? lo_tab0 : lo_tab1     (chọn theo bit 7)
+ *   bits = row[lo]                              (bit k = có byte (hi & 7) == k)
+ *   match = bits & (1 << (hi & 7))
+ *
+ * → chính xác cho mọi byte, không false positive
+*/
+typedef struct
+{
+    uint8_t lo_tab0[16]; // hi nibble 0x0-0x7
+    uint8_t lo_tab1[16]; // hi nibble 0x8-0xF
+} NeonByteSet;
+
+
+static inline void neon_byteset_init(NeonByteSet* set, const uint8_t* chars, size_t count) {
+    memset(set, 0, sizeof(NeonByteSet));
+    for (size_t k = 0; k < count; k++) {
+        uint8_t b = chars[k];
+        uint8_t bit = (uint8_t)(1u << ((b >> 4) & 7));
+        if (b < 0x80) {
+            set->lo_tab0[b & 15] |= bit;
+        } else {
+            set->lo_tab1[b & 15] |= bit;
+        }
+    }
+}
+
+
+static NEON_INLINE int neon_byteset_contains(const NeonByteSet* set, uint8_t b) {
+    const uint8_t* row = (b < 0x80) ? set->lo_tab0 : set->lo_tab1;
+    return (row[b & 15] >> ((b >> 4) & 7)) & 1;
+}
+
+
+/**
+ * 16 bytes → 0xFF ở lane thuộc set
+*/
+static NEON_INLINE neon_i8x16 neon_byteset_match(
+    neon_i8x16 tab0, neon_i8x16 tab1, neon_i8x16 hibits, neon_i8x16 v
+) {
+    neon_i8x16 lo = vandq_u8(v, vdupq_n_u8(0x0F));
+    neon_i8x16 hi = vshrq_n_u8(v, 4);
+
+    neon_i8x16 row0 = vqtbl1q_u8(tab0, lo);
+    neon_i8x16 row1 = vqtbl1q_u8(tab1, lo);
+    neon_i8x16 high_half = vcgeq_u8(v, vdupq_n_u8(0x80));
+    neon_i8x16 bits = vbslq_u8(high_half, row1, row0);
+
+    return vtstq_u8(bits, vqtbl1q_u8(hibits, hi));
+}
+
+
+/**
+ * Tìm byte đầu tiên thuộc set
+ * @return: index, hoặc n nếu không có
+*/
+static inline size_t neon_find_any_of(const uint8_t* s, size_t n, const NeonByteSet* set) {
+    static const uint8_t HIBITS[16] ALIGN_NEON = {
+        0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+        0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80
+    };
+
+    const neon_i8x16 tab0 = vld1q_u8(set->lo_tab0);
+    const neon_i8x16 tab1 = vld1q_u8(set->lo_tab1);
+    const neon_i8x16 hibits = vld1q_u8(HIBITS);
+#define NEON_MATCHSET(v) neon_byteset_match(tab0, tab1, hibits, (v))
+#define NEON_SCALARSET(x) neon_byteset_contains(set, (x))
+    NEON_BYTES_SCAN_IMPL(NEON_MATCHSET, NEON_SCALARSET)
+#undef NEON_MATCHSET
+#undef NEON_SCALARSET
+}
+
+
+
+// COUNT
+/**
+ * Đếm số byte == c
+ *
+ * vceqq_u8 cho 0xFF (= -1) → acc = acc - eq tăng 1 mỗi match
+ * Accumulator u8 tràn sau 255 lần → mỗi 255 iterations cộng dồn bằng vaddlvq_u8
+*/
+static inline size_t neon_count_byte(const uint8_t* s, uint8_t c, size_t n) {
+    const neon_i8x16 vc = vdupq_n_u8(c);
+    size_t total = 0;
+    size_t i = 0;
+
+    while (i + 64 <= n) {
+        neon_i8x16 acc0 = vdupq_n_u8(0);
+        neon_i8x16 acc1 = vdupq_n_u8(0);
+        neon_i8x16 acc2 = vdupq_n_u8(0);
+        neon_i8x16 acc3 = vdupq_n_u8(0);
+
+        size_t blocks = MIN((n - i) / 64, (size_t)255);
+        for (size_t b = 0; b < blocks; b++, i += 64) {
+            NEON_PREFETCH(s + i + 256);
+            acc0 = vsubq_u8(acc0, vceqq_u8(vld1q_u8(s + i), vc));
+            acc1 = vsubq_u8(acc1, vceqq_u8(vld1q_u8(s + i + 16), vc));
+            acc2 = vsubq_u8(acc2, vceqq_u8(vld1q_u8(s + i + 32), vc));
+            acc3 = vsubq_u8(acc3, vceqq_u8(vld1q_u8(s + i + 48), vc));
+        }
+
+        total += vaddlvq_u8(acc0) + vaddlvq_u8(acc1) + vaddlvq_u8(acc2) + vaddlvq_u8(acc3);
+    }
+
+    for (; i + 16 <= n; i += 16) {
+        neon_i8x16 eq = vceqq_u8(vld1q_u8(s + i), vc);
+        total += vaddlvq_u8(vshrq_n_u8(eq, 7));
+    }
+
+    for (; i < n; i++) {
+        total += (s[i] == c);
+    }
+
+    return total;
+}
+
+
+/**
+ * Đếm số dòng ('\n')
+*/
+static inline size_t neon_count_newlines(const uint8_t* s, size_t n) {
+    return neon_count_byte(s, '\n', n);
+}
+
+
+
+// MEMCMP
+/**
+ * So sánh a[0..n) và b[0..n) như memcmp
+ * @return: < 0, 0, > 0 theo byte khác nhau đầu tiên (unsigned)
+*/
+static inline int neon_memcmp(const uint8_t* a, const uint8_t* b, size_t n) {
+    size_t i = 0;
+
+    for (; i + 64 <= n; i += 64) {
+        neon_i8x16 e0 = vceqq_u8(vld1q_u8(a + i), vld1q_u8(b + i));
+        neon_i8x16 e1 = vceqq_u8(vld1q_u8(a + i + 16), vld1q_u8(b + i + 16));
+        neon_i8x16 e2 = vceqq_u8(vld1q_u8(a + i + 32), vld1q_u8(b + i + 32));
+        neon_i8x16 e3 = vceqq_u8(vld1q_u8(a + i + 48), vld1q_u8(b + i + 48));
+        neon_i8x16 all = vandq_u8(vandq_u8(e0, e1), vandq_u8(e2, e3));
+        if (LIKELY(vminvq_u8(all) == 0xFF)) continue;
+        break;
+    }
+
+    for (; i + 16 <= n; i += 16) {
+        neon_i8x16 ne = vmvnq_u8(vceqq_u8(vld1q_u8(a + i), vld1q_u8(b + i)));
+        uint64_t mask = neon_mask_u8x16(ne);
+        if (mask) {
+            size_t j = i + neon_mask_first(mask);
+            return (int)a[j] - (int)b[j];
+        }
+    }
+
+    for (; i < n; i++) {
+        if (a[i] != b[i]) return (int)a[i] - (int)b[i];
+    }
+
+    return 0;
+}
+
+
+#undef NEON_BYTES_SCAN_IMPL
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_BYTES_H
@@ -0,0 +1,509 @@
+#ifndef NEON_CHECKSUM_H
+#define NEON_CHECKSUM_H
+
+#include "neon_types.h"
+#include "memory_align.h"
+#include <string.h>
+
+#if defined(__ARM_FEATURE_CRC32)
+    #include <arm_acle.h>
+    #define NEON_HAS_CRC32 1
+#else
+    #define NEON_HAS_CRC32 0
+#endif
+
+// PMULL (vmull_p64) thuộc Crypto extension; reduction cuối vẫn dùng CRC instructions
+#if NEON_HAS_CRC32 && (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES))
+    #define NEON_HAS_PMULL 1
+#else
+    #define NEON_HAS_PMULL 0
+#endif
+
+
+/**
+ * CHECKSUMS & HASHING (integrity của weight files / cached tensors)
+ *
+ * 1. CRC32 (IEEE, zlib/gzip) và CRC32C (Castagnoli, iSCSI/ext4/RocksDB)
+ *
+ *    a) ARMv8 CRC instructions: __crc32cd xử lý 8 bytes / lệnh
+ *       Latency 3 cycles, throughput 1/cycle → 1 chuỗi phụ thuộc chỉ dùng 1/3 throughput
+ *       → 3-WAY INTERLEAVE: chia buffer thành 3 đoạn, 3 CRC độc lập chạy song song
+ *         ghép lại: crc = shift(shift(crcA, L) ^ crcB, L) ^ crcC
+ *         shift(c, L) = c * x^(8L) mod P (nhân đa thức GF(2), tính 1 lần mỗi call)
+ *
+ *    b) PMULL FOLDING (buffer lớn): 4 x 128-bit accumulators
+ *       X * x^F mod P = X_hi * (x^(64+F) mod P) ^ X_lo * (x^F mod P)
+ *       → mỗi 64 bytes: 8 x vmull_p64 + XOR, không có chuỗi phụ thuộc dài
+ *       Cuối cùng 128 bits còn lại reduce bằng 2 x __crc32cd
+ *
+ *    c) Không có CRC extension: bitwise fallback (chậm, chỉ để đúng)
+ *
+ *    API giống zlib: crc = neon_crc32c(0, data, n); crc = neon_crc32c(crc, more, m) để nối tiếp
+ *
+ * 2. neon_hash64: hash 64-bit kiểu xxHash (cấu trúc accumulate của XXH3)
+ *    8 accumulators u64 (4 x uint64x2_t), mỗi stripe 64 bytes:
+ *      dk = data ^ key;  acc += lo32(dk) * hi32(dk)  (vmlal_u32)  + swap(data)
+ *    Mỗi 512 bytes: scramble (acc ^= acc >> 47, ^= key, *= prime)
+ *    Không tương thích bit-for-bit với XXH3 (secret sinh từ seed), chỉ dùng trong project
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define NEON_CRC32_POLY 0xEDB88320u // reflected
+#define NEON_CRC32C_POLY 0x82F63B78u // reflected
+
+// Buffer nhỏ hơn → 1 chuỗi CRC (chi phí tính shift không đáng)
+#define NEON_CRC_3WAY_MIN 4096
+#define NEON_CRC_PMULL_MIN 1024
+
+
+
+// GF(2) POLYNOMIAL HELPERS (reflected, bit 31 = x^0)
+/**
+ * a * b mod P
+*/
+static inline uint32_t neon_crc_multmodp(uint32_t a, uint32_t b, uint32_t poly) {
+    uint32_t m = 1u << 31;
+    uint32_t p = 0;
+
+    for (;;) {
+        if (a & m) {
+            p ^= b;
+            if ((a & (m - 1)) == 0) break;
+        }
+        m >>= 1;
+        b = (b >> 1) ^ (poly & (0u - (b & 1)));
+    }
+
+    return p;
+}
+
+
+/**
+ * x^(8n) mod P (square-and-multiply)
+*/
+static inline uint32_t neon_crc_xpow8n(size_t n, uint32_t poly) {
+    uint32_t result = 1u << 31; // x^0
+    uint32_t base = neon_crc_multmodp(1u << 30, 1u << 30, poly); // x^2
+    base = neon_crc_multmodp(base, base, poly); // x^4
+    base = neon_crc_multmodp(base, base, poly); // x^8
+
+    while (n) {
+        if (n & 1) result = neon_crc_multmodp(base, result, poly);
+        base = neon_crc_multmodp(base, base, poly);
+        n >>= 1;
+    }
+
+    return result;
+}
+
+
+/**
+ * CRC (raw state, không đảo bit) sau khi nối thêm n bytes 0
+*/
+static NEON_INLINE uint32_t neon_crc_shift(uint32_t crc, size_t n, uint32_t poly) {
+    return neon_crc_multmodp(neon_crc_xpow8n(n, poly), crc, poly);
+}
+
+
+/**
+ * Bitwise fallback (raw state)
+*/
+static inline uint32_t neon_crc_sw(uint32_t crc, const uint8_t* p, size_t n, uint32_t poly) {
+    for (size_t i = 0; i < n; i++) {
+        crc ^= p[i];
+        for (int k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (poly & (0u - (crc & 1)));
+        }
+    }
+    return crc;
+}
+
+
+static NEON_INLINE uint64_t neon_load_u64(const uint8_t* p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+
+
+#if NEON_HAS_CRC32
+/**
+ * Sinh 3 tầng cho 1 loại CRC (raw state):
+ *   NAME_serial : 1 chuỗi __crc32*d
+ *   NAME_3way   : 3 chuỗi song song + ghép bằng shift
+*/
+#define NEON_CRC_DEFINE_HW(NAME, POLY, CRC_B, CRC_D)                                \
+static inline uint32_t NAME##_serial(uint32_t crc, const uint8_t* p, size_t n) {    \
+    while (n > 0 && ((uintptr_t)p & 7)) {                                           \
+        crc = CRC_B(crc, *p++);                                                     \
+        n--;                                                                        \
+    }                                                                               \
+    for (; n >= 32; n -= 32, p += 32) {                                             \
+        crc = CRC_D(crc, neon_load_u64(p));                                         \
+        crc = CRC_D(crc, neon_load_u64(p + 8));                                     \
+        crc = CRC_D(crc, neon_load_u64(p + 16));                                    \
+        crc = CRC_D(crc, neon_load_u64(p + 24));                                    \
+    }                                                                               \
+    for (; n >= 8; n -= 8, p += 8) {                                                \
+        crc = CRC_D(crc, neon_load_u64(p));                                         \
+    }                                                                               \
+    while (n-- > 0) {                                                               \
+        crc = CRC_B(crc, *p++);                                                     \
+    }                                                                               \
+    return crc;                                                                     \
+}                                                                                   \
+                                                                                    \
+static inline uint32_t NAME##_3way(uint32_t crc, const uint8_t* p, size_t n) {      \
+    if (n < NEON_CRC_3WAY_MIN) return NAME##_serial(crc, p, n);                     \
+                                                                                    \
+    size_t len = (n / 3) & ~(size_t)7;                                              \
+    const uint8_t* p0 = p;                                                          \
+    const uint8_t* p1 = p + len;                                                    \
+    const uint8_t* p2 = p + 2 * len;                                                \
+    uint32_t c0 = crc;                                                              \
+    uint32_t c1 = 0;                                                                \
+    uint32_t c2 = 0;                                                                \
+                                                                                    \
+    for (size_t i = 0; i < len; i += 8) {                                           \
+        c0 = CRC_D(c0, neon_load_u64(p0 + i));                                      \
+        c1 = CRC_D(c1, neon_load_u64(p1 + i));                                      \
+        c2 = CRC_D(c2, neon_load_u64(p2 + i));                                      \
+    }                                                                               \
+                                                                                    \
+    uint32_t k = neon_crc_xpow8n(len, POLY);                                        \
+    crc = neon_crc_multmodp(k, c0, POLY) ^ c1;                                      \
+    crc = neon_crc_multmodp(k, crc, POLY) ^ c2;                                     \
+                                                                                    \
+    return NAME##_serial(crc, p + 3 * len, n - 3 * len);                            \
+}
+
+NEON_CRC_DEFINE_HW(neon_crc32_hw, NEON_CRC32_POLY, __crc32b, __crc32d)
+NEON_CRC_DEFINE_HW(neon_crc32c_hw, NEON_CRC32C_POLY, __crc32cb, __crc32cd)
+
+#undef NEON_CRC_DEFINE_HW
+#endif // NEON_HAS_CRC32
+
+
+
+#if NEON_HAS_PMULL
+/**
+ * Hằng số folding cho fold distance F bits:
+ *   hi = (x^(64+F-1) mod P) << 32, lo = (x^(F-1) mod P) << 32   (reflected)
+ *   (-1 vì vmull_p64 trên giá trị reflected cho kết quả dịch 1 bit)
+ * Thứ tự: F = 512, 384, 256, 128
+*/
+static const uint64_t NEON_CRC32_FOLD_K[8] = {
+    0x653d982200000000ull, 0xcad38e8f00000000ull,
+    0x69ccfc0d00000000ull, 0x2a28386200000000ull,
+    0x9570d49500000000ull, 0x01b5fd1d00000000ull,
+    0x65673b4600000000ull, 0x9ba54c6f00000000ull
+};
+
+static const uint64_t NEON_CRC32C_FOLD_K[8] = {
+    0x1c19243b00000000ull, 0x75bba45b00000000ull,
+    0xa46ef4aa00000000ull, 0x6051243f00000000ull,
+    0x33ccbbbc00000000ull, 0xa2158b3400000000ull,
+    0x3743f7bd00000000ull, 0x3171d43000000000ull
+};
+
+
+/**
+ * x (128 bits, byte đầu = bậc cao nhất) → x * x^F mod P (vẫn 128 bits)
+*/
+static NEON_INLINE uint8x16_t neon_crc_fold(uint8x16_t x, const uint64_t* k) {
+    uint64x2_t v = vreinterpretq_u64_u8(x);
+    poly128_t hi = vmull_p64((poly64_t)vgetq_lane_u64(v, 0), (poly64_t)k[0]);
+    poly128_t lo = vmull_p64((poly64_t)vgetq_lane_u64(v, 1), (poly64_t)k[1]);
+    return veorq_u8(vreinterpretq_u8_p128(hi), vreinterpretq_u8_p128(lo));
+}
+
+
+#define NEON_CRC_DEFINE_PMULL(NAME, HW, FOLD_K, CRC_D)                              \
+static inline uint32_t NAME(uint32_t crc, const uint8_t* p, size_t n) {             \
+    if (n < NEON_CRC_PMULL_MIN) return HW##_3way(crc, p, n);                        \
+                                                                                    \
+    /* State ban đầu = XOR vào 4 bytes đầu của message */                           \
+    uint8x16_t x0 = veorq_u8(vld1q_u8(p),                                           \
+        vreinterpretq_u8_u32(vsetq_lane_u32(crc, vdupq_n_u32(0), 0)));              \
+    uint8x16_t x1 = vld1q_u8(p + 16);                                               \
+    uint8x16_t x2 = vld1q_u8(p + 32);                                               \
+    uint8x16_t x3 = vld1q_u8(p + 48);                                               \
+    p += 64;                                                                        \
+    n -= 64;                                                                        \
+                                                                                    \
+    for (; n >= 64; n -= 64, p += 64) {                                             \
+        NEON_PREFETCH(p + 512);                                                     \
+        x0 = veorq_u8(neon_crc_fold(x0, FOLD_K), vld1q_u8(p));                      \
+        x1 = veorq_u8(neon_crc_fold(x1, FOLD_K), vld1q_u8(p + 16));                 \
+        x2 = veorq_u8(neon_crc_fold(x2, FOLD_K), vld1q_u8(p + 32));                 \
+        x3 = veorq_u8(neon_crc_fold(x3, FOLD_K), vld1q_u8(p + 48));                 \
+    }                                                                               \
+                                                                                    \
+    /* 4 → 1: x0 dịch 384 bits, x1 dịch 256, x2 dịch 128 */                         \
+    uint8x16_t x = veorq_u8(                                                        \
+        veorq_u8(neon_crc_fold(x0, FOLD_K + 2), neon_crc_fold(x1, FOLD_K + 4)),     \
+        veorq_u8(neon_crc_fold(x2, FOLD_K + 6), x3));                               \
+                                                                                    \
+    for (; n >= 16; n -= 16, p += 16) {                                             \
+        x = veorq_u8(neon_crc_fold(x, FOLD_K + 6), vld1q_u8(p));                    \
+    }                                                                               \
+                                                                                    \
+    uint64x2_t v = vreinterpretq_u64_u8(x);                                         \
+    crc = CRC_D(0, vgetq_lane_u64(v, 0));                                           \
+    crc = CRC_D(crc, vgetq_lane_u64(v, 1));                                         \
+                                                                                    \
+    return HW##_serial(crc, p, n);                                                  \
+}
+
+NEON_CRC_DEFINE_PMULL(neon_crc32_pmull, neon_crc32_hw, NEON_CRC32_FOLD_K, __crc32d)
+NEON_CRC_DEFINE_PMULL(neon_crc32c_pmull, neon_crc32c_hw, NEON_CRC32C_FOLD_K, __crc32cd)
+
+#undef NEON_CRC_DEFINE_PMULL
+#endif // NEON_HAS_PMULL
+
+
+
+// PUBLIC CRC API
+/**
+ * CRC32 (IEEE 802.3, giống zlib crc32)
+ * @param crc: 0 cho buffer đầu tiên, hoặc kết quả lần gọi trước để nối tiếp
+*/
+static inline uint32_t neon_crc32(uint32_t crc, const void* data, size_t n) {
+    const uint8_t* p = (const uint8_t*)data;
+    crc = ~crc;
+#if NEON_HAS_PMULL
+    crc = neon_crc32_pmull(crc, p, n);
+#elif NEON_HAS_CRC32
+    crc = neon_crc32_hw_3way(crc, p, n);
+#else
+    crc = neon_crc_sw(crc, p, n, NEON_CRC32_POLY);
+#endif
+    return ~crc;
+}
+
+
+/**
+ * CRC32C (Castagnoli)
+*/
+static inline uint32_t neon_crc32c(uint32_t crc, const void* data, size_t n) {
+    const uint8_t* p = (const uint8_t*)data;
+    crc = ~crc;
+#if NEON_HAS_PMULL
+    crc = neon_crc32c_pmull(crc, p, n);
+#elif NEON_HAS_CRC32
+    crc = neon_crc32c_hw_3way(crc, p, n);
+#else
+    crc = neon_crc_sw(crc, p, n, NEON_CRC32C_POLY);
+#endif
+    return ~crc;
+}
+
+
+/**
+ * crc(A || B) từ crc(A), crc(B) và len(B) (ghép checksum các chunk tính song song)
+*/
+static inline uint32_t neon_crc32c_combine(uint32_t crc_a, uint32_t crc_b, size_t len_b) {
+    return neon_crc_shift(crc_a, len_b, NEON_CRC32C_POLY) ^ crc_b;
+}
+
+
+static inline uint32_t neon_crc32_combine(uint32_t crc_a, uint32_t crc_b, size_t len_b) {
+    return neon_crc_shift(crc_a, len_b, NEON_CRC32_POLY) ^ crc_b;
+}
+
+
+/**
+ * CRC32C của buffer->size floats
+*/
+static inline uint32_t neon_crc32c_buffer(const AlignedBuffer* buffer) {
+    return neon_crc32c(0, buffer->data, buffer->size * sizeof(float));
+}
+
+
+
+// XXHASH-STYLE 64-BIT HASH
+#define NEON_HASH_PRIME64_1 0x9E3779B185EBCA87ull
+#define NEON_HASH_PRIME64_2 0xC2B2AE3D27D4EB4Full
+#define NEON_HASH_PRIME64_3 0x165667B19E3779F9ull
+#define NEON_HASH_PRIME64_4 0x85EBCA77C2B2AE63ull
+#define NEON_HASH_PRIME64_5 0x27D4EB2F165667C5ull
+#define NEON_HASH_PRIME32_1 0x9E3779B1u
+
+#define NEON_HASH_STRIPE 64
+#define NEON_HASH_STRIPES_PER_BLOCK 8
+#define NEON_HASH_SECRET_WORDS 16
+
+
+static NEON_INLINE uint64_t neon_hash_rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+
+static NEON_INLINE uint64_t neon_hash_avalanche(uint64_t h) {
+    h ^= h >> 33;
+    h *= NEON_HASH_PRIME64_2;
+    h ^= h >> 29;
+    h *= NEON_HASH_PRIME64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+
+/**
+ * 64 x 64 → 128, XOR 2 nửa
+*/
+static NEON_INLINE uint64_t neon_hash_mul128_fold64(uint64_t a, uint64_t b) {
+    unsigned __int128 p = (unsigned __int128)a * b;
+    return (uint64_t)p ^ (uint64_t)(p >> 64);
+}
+
+
+/**
+ * Secret 16 words từ seed (splitmix64)
+*/
+static inline void neon_hash_make_secret(uint64_t seed, uint64_t* secret) {
+    uint64_t s = seed;
+    for (int i = 0; i < NEON_HASH_SECRET_WORDS; i++) {
+        s += NEON_HASH_PRIME64_1;
+        uint64_t z = s;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        secret[i] = z ^ (z >> 31);
+    }
+}
+
+
+/**
+ * 1 stripe 64 bytes vào 8 accumulators
+*/
+static NEON_INLINE void neon_hash_accumulate(uint64x2_t* acc, const uint8_t* p, const uint64_t* key) {
+    for (int l = 0; l < 4; l++) {
+        uint64x2_t d = vreinterpretq_u64_u8(vld1q_u8(p + 16 * l));
+        uint64x2_t dk = veorq_u64(d, vld1q_u64(key + 2 * l));
+
+        // lo32 * hi32 của mỗi lane 64-bit
+        acc[l] = vmlal_u32(acc[l], vmovn_u64(dk), vshrn_n_u64(dk, 32));
+        acc[l] = vaddq_u64(acc[l], vextq_u64(d, d, 1));
+    }
+}
+
+
+static NEON_INLINE void neon_hash_scramble(uint64x2_t* acc, const uint64_t* key) {
+    const uint32x2_t prime = vdup_n_u32(NEON_HASH_PRIME32_1);
+
+    for (int l = 0; l < 4; l++) {
+        uint64x2_t a = veorq_u64(acc[l], vshrq_n_u64(acc[l], 47));
+        a = veorq_u64(a, vld1q_u64(key + 2 * l));
+
+        // a * prime32 (mod 2^64) = lo * prime + (hi * prime) << 32
+        uint64x2_t hi = vmull_u32(vshrn_n_u64(a, 32), prime);
+        acc[l] = vmlal_u32(vshlq_n_u64(hi, 32), vmovn_u64(a), prime);
+    }
+}
+
+
+/**
+ * Input ngắn (< 64 bytes): vòng scalar kiểu XXH64
+*/
+static inline uint64_t neon_hash64_short(const uint8_t* p, size_t n, uint64_t seed) {
+    uint64_t h = seed + NEON_HASH_PRIME64_5 + (uint64_t)n;
+
+    for (; n >= 8; n -= 8, p += 8) {
+        uint64_t k = neon_load_u64(p) * NEON_HASH_PRIME64_2;
+        k = neon_hash_rotl64(k, 31) * NEON_HASH_PRIME64_1;
+        h ^= k;
+        h = neon_hash_rotl64(h, 27) * NEON_HASH_PRIME64_1 + NEON_HASH_PRIME64_4;
+    }
+    if (n >= 4) {
+        uint32_t w;
+        memcpy(&w, p, sizeof(w));
+        h ^= (uint64_t)w * NEON_HASH_PRIME64_1;
+        h = neon_hash_rotl64(h, 23) * NEON_HASH_PRIME64_2 + NEON_HASH_PRIME64_3;
+        p += 4;
+        n -= 4;
+    }
+    for (; n > 0; n--, p++) {
+        h ^= (uint64_t)(*p) * NEON_HASH_PRIME64_5;
+        h = neon_hash_rotl64(h, 11) * NEON_HASH_PRIME64_1;
+    }
+
+    return neon_hash_avalanche(h);
+}
+
+
+/**
+ * Hash 64-bit của n bytes
+*/
+static inline uint64_t neon_hash64(const void* data, size_t n, uint64_t seed) {
+    const uint8_t* p = (const uint8_t*)data;
+
+    if (n < NEON_HASH_STRIPE) {
+        return neon_hash64_short(p, n, seed);
+    }
+
+    uint64_t secret[NEON_HASH_SECRET_WORDS] ALIGN_NEON;
+    neon_hash_make_secret(seed, secret);
+
+    static const uint64_t ACC_INIT[8] ALIGN_NEON = {
+        NEON_HASH_PRIME32_1, NEON_HASH_PRIME64_1, NEON_HASH_PRIME64_2, NEON_HASH_PRIME64_3,
+        NEON_HASH_PRIME64_4, NEON_HASH_PRIME64_5, NEON_HASH_PRIME64_1, NEON_HASH_PRIME64_2
+    };
+
+    uint64x2_t acc[4];
+    for (int l = 0; l < 4; l++) {
+        acc[l] = vld1q_u64(ACC_INIT + 2 * l);
+    }
+
+    const size_t block = NEON_HASH_STRIPE * NEON_HASH_STRIPES_PER_BLOCK;
+    size_t i = 0;
+
+    for (; i + block <= n; i += block) {
+        NEON_PREFETCH(p + i + 2 * block);
+        for (int s = 0; s < NEON_HASH_STRIPES_PER_BLOCK; s++) {
+            neon_hash_accumulate(acc, p + i + (size_t)s * NEON_HASH_STRIPE, secret + s);
+        }
+        neon_hash_scramble(acc, secret + 8);
+    }
+
+    int s = 0;
+    for (; i + NEON_HASH_STRIPE <= n; i += NEON_HASH_STRIPE, s++) {
+        neon_hash_accumulate(acc, p + i, secret + s);
+    }
+
+    // Stripe cuối (chồng lên phần đã xử lý nếu cần) → mọi byte đều được hash
+    if (i < n) {
+        neon_hash_accumulate(acc, p + n - NEON_HASH_STRIPE, secret + 7);
+    }
+
+    uint64_t a[8] ALIGN_NEON;
+    for (int l = 0; l < 4; l++) {
+        vst1q_u64(a + 2 * l, acc[l]);
+    }
+
+    uint64_t h = (uint64_t)n * NEON_HASH_PRIME64_1;
+    for (int l = 0; l < 4; l++) {
+        h += neon_hash_mul128_fold64(a[2 * l] ^ secret[2 * l], a[2 * l + 1] ^ secret[2 * l + 1]);
+    }
+
+    return neon_hash_avalanche(h);
+}
+
+
+/**
+ * Hash của buffer->size floats
+*/
+static inline uint64_t neon_hash64_buffer(const AlignedBuffer* buffer, uint64_t seed) {
+    return neon_hash64(buffer->data, buffer->size * sizeof(float), seed);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_CHECKSUM_H
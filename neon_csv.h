@@ -0,0 +1,470 @@
+#ifndef NEON_CSV_H
+#define NEON_CSV_H
+
+#include "neon_types.h"
+#include "memory_align.h"
+#include "neon_bytes.h"
+#include <math.h>
+#include <stdlib.h>
+
+
+/**
+ * CSV / NUMBER PARSING → float columns (AlignedBuffer)
+ *
+ * 1. FIELD BOUNDARIES: 16 bytes 1 lần, vceqq_u8 với delimiter và '\n'
+ *    → mask (1 bit / byte, dạng nibble của neon_mask_u8x16), duyệt từng bit bằng ctz
+ *    Mask của block được giữ lại giữa các field → mỗi byte chỉ so sánh 1 lần
+ *
+ * 2. SIMD DIGIT ACCUMULATION: 8 digits → uint32 không có loop
+ *      "12345678" - '0'               = [1 2 3 4 5 6 7 8]
+ *      vmul_u8 x [10 1 10 1 ...]      → vpaddl_u8  = [12   34   56   78]     (u16)
+ *      vmul_u16 x [100 1 100 1]       → vpaddl_u16 = [1234      5678]       (u32)
+ *      lane0 * 10000 + lane1          = 12345678
+ *    16 digits: thêm 1 bước vmulq_u32 x [10000 1] → vpaddlq_u32 (u64)
+ *
+ * 3. FLOAT ROUNDING:
+ *    Fast path (mantissa m ≤ 2^53, |exp10| ≤ 22):
+ *      m và 10^k đều chính xác trong double → q = m * 10^k hoặc m / 10^k được round đúng 1 lần
+ *      (float)q round lần 2: chỉ sai khi q rơi đúng vào trung điểm giữa 2 float
+ *      (low 29 bits của double == 0x10000000) → khi đó chuyển sang slow path
+ *    Slow path: strtof (chính xác, chậm) cho mọi trường hợp còn lại
+ *
+ * Field rỗng → NAN (missing value), "nan" / "inf" / "infinity" được hỗ trợ
+ * Field có quote ("1.5") được bỏ quote, không hỗ trợ delimiter bên trong quote
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+// DIGIT CONVERSION
+/**
+ * 8 ASCII digits → uint32 (không kiểm tra, caller đảm bảo đều là digit)
+*/
+static NEON_INLINE uint32_t neon_parse_8digits(const uint8_t* p) {
+    static const uint8_t MUL10[8] = {10, 1, 10, 1, 10, 1, 10, 1};
+    static const uint16_t MUL100[4] = {100, 1, 100, 1};
+
+    uint8x8_t d = vsub_u8(vld1_u8(p), vdup_n_u8('0'));
+    uint16x4_t pairs = vpaddl_u8(vmul_u8(d, vld1_u8(MUL10)));
+    uint32x2_t quads = vpaddl_u16(vmul_u16(pairs, vld1_u16(MUL100)));
+
+    return vget_lane_u32(quads, 0) * 10000 + vget_lane_u32(quads, 1);
+}
+
+
+/**
+ * 16 ASCII digits → uint64
+*/
+static NEON_INLINE uint64_t neon_parse_16digits(const uint8_t* p) {
+    static const uint8_t MUL10[16] = {10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1};
+    static const uint16_t MUL100[8] = {100, 1, 100, 1, 100, 1, 100, 1};
+    static const uint32_t MUL10000[4] = {10000, 1, 10000, 1};
+
+    uint8x16_t d = vsubq_u8(vld1q_u8(p), vdupq_n_u8('0'));
+    uint16x8_t pairs = vpaddlq_u8(vmulq_u8(d, vld1q_u8(MUL10)));
+    uint32x4_t quads = vpaddlq_u16(vmulq_u16(pairs, vld1q_u16(MUL100)));
+    uint64x2_t octs = vpaddlq_u32(vmulq_u32(quads, vld1q_u32(MUL10000)));
+
+    return vgetq_lane_u64(octs, 0) * 100000000ull + vgetq_lane_u64(octs, 1);
+}
+
+
+/**
+ * Số digit liên tiếp từ p (tối đa 16), cần 16 bytes đọc được
+*/
+static NEON_INLINE size_t neon_digit_run16(const uint8_t* p) {
+    uint8x16_t d = vsubq_u8(vld1q_u8(p), vdupq_n_u8('0'));
+    uint64_t mask = neon_mask_u8x16(vcgtq_u8(d, vdupq_n_u8(9)));
+    return mask ? neon_mask_first(mask) : 16;
+}
+
+
+static const uint64_t NEON_POW10_U64[20] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+    100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull,
+    10000000000000ull, 100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+    100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull
+};
+
+
+static const double NEON_POW10_F64[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+
+/**
+ * Đọc 1 dãy digits từ p, cộng dồn vào *m (m = m * 10^k + value)
+ * *overflow = 1 nếu m vượt uint64 (kết quả phải đi slow path)
+ * @return: con trỏ sau digit cuối, *count += số digits
+*/
+static inline const uint8_t* neon_accumulate_digits(
+    const uint8_t* p,
+    const uint8_t* end,
+    uint64_t* m,
+    size_t* count,
+    int* overflow
+) {
+    uint64_t acc = *m;
+
+    for (;;) {
+        size_t k;
+        uint64_t v;
+
+        if (end - p >= 16) {
+            k = neon_digit_run16(p);
+            if (k == 16) {
+                v = neon_parse_16digits(p);
+            } else if (k >= 8) {
+                k = 8;
+                v = neon_parse_8digits(p);
+            } else {
+                v = 0;
+                for (size_t j = 0; j < k; j++) v = v * 10 + (uint64_t)(p[j] - '0');
+            }
+        } else {
+            k = 0;
+            v = 0;
+            while (p + k < end && (uint8_t)(p[k] - '0') <= 9) {
+                if (k == 16) break;
+                v = v * 10 + (uint64_t)(p[k] - '0');
+                k++;
+            }
+        }
+
+        if (k == 0) break;
+
+        if (acc > (UINT64_MAX - v) / NEON_POW10_U64[k]) {
+            *overflow = 1;
+        } else {
+            acc = acc * NEON_POW10_U64[k] + v;
+        }
+
+        p += k;
+        *count += k;
+        if (k < 8) break;
+    }
+
+    *m = acc;
+    return p;
+}
+
+
+
+// FLOAT PARSING
+static NEON_INLINE int neon_ascii_ieq(const uint8_t* p, const uint8_t* end, const char* word) {
+    size_t len = strlen(word);
+    if ((size_t)(end - p) != len) return 0;
+    for (size_t i = 0; i < len; i++) {
+        if ((p[i] | 0x20) != (uint8_t)word[i]) return 0;
+    }
+    return 1;
+}
+
+
+/**
+ * Slow path: strtof trên bản copy có '\0'
+*/
+static inline int neon_parse_f32_slow(const uint8_t* p, const uint8_t* end, float* out) {
+    size_t len = (size_t)(end - p);
+    char stack_buf[64];
+    char* buf = (len < sizeof(stack_buf)) ? stack_buf : (char*)malloc(len + 1);
+    if (buf == NULL) return 0;
+
+    memcpy(buf, p, len);
+    buf[len] = '\0';
+
+    char* stop = NULL;
+    *out = strtof(buf, &stop);
+    int ok = (stop == buf + len);
+
+    if (buf != stack_buf) free(buf);
+    return ok;
+}
+
+
+/**
+ * Parse toàn bộ [p, end) thành float (không có whitespace)
+ * @return: 1 nếu hợp lệ, 0 nếu không phải số
+*/
+static inline int neon_parse_f32(const uint8_t* p, const uint8_t* end, float* out) {
+    if (p == end) {
+        *out = NAN;
+        return 1;
+    }
+
+    const uint8_t* start = p;
+    int negative = 0;
+    if (*p == '-' || *p == '+') {
+        negative = (*p == '-');
+        p++;
+    }
+
+    uint64_t m = 0;
+    size_t int_digits = 0;
+    size_t frac_digits = 0;
+    int overflow = 0;
+
+    p = neon_accumulate_digits(p, end, &m, &int_digits, &overflow);
+
+    if (p < end && *p == '.') {
+        p++;
+        p = neon_accumulate_digits(p, end, &m, &frac_digits, &overflow);
+    }
+
+    if (int_digits + frac_digits == 0) {
+        if (neon_ascii_ieq(p, end, "nan")) {
+            *out = NAN;
+            return 1;
+        }
+        if (neon_ascii_ieq(p, end, "inf") || neon_ascii_ieq(p, end, "infinity")) {
+            *out = negative ? -INFINITY : INFINITY;
+            return 1;
+        }
+        return 0;
+    }
+
+    int64_t exp10 = -(int64_t)frac_digits;
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        int exp_negative = 0;
+        if (p < end && (*p == '-' || *p == '+')) {
+            exp_negative = (*p == '-');
+            p++;
+        }
+        if (p == end || (uint8_t)(*p - '0') > 9) return 0;
+
+        int64_t e = 0;
+        while (p < end && (uint8_t)(*p - '0') <= 9) {
+            if (e < 100000) e = e * 10 + (*p - '0');
+            p++;
+        }
+        exp10 += exp_negative ? -e : e;
+    }
+
+    if (p != end) return 0;
+
+    if (m == 0) {
+        *out = negative ? -0.0f : 0.0f;
+        return 1;
+    }
+
+    // Fast path
+    if (!overflow && m <= (1ull << 53) && exp10 >= -22 && exp10 <= 22) {
+        double q = (exp10 >= 0) ? (double)m * NEON_POW10_F64[exp10] : (double)m / NEON_POW10_F64[-exp10];
+
+        uint64_t bits;
+        memcpy(&bits, &q, sizeof(bits));
+        if ((bits & 0x1FFFFFFFull) != 0x10000000ull) {
+            float f = (float)q;
+            *out = negative ? -f : f;
+            return 1;
+        }
+    }
+
+    return neon_parse_f32_slow(start, end, out);
+}
+
+
+
+// CSV FIELD SCANNER
+/**
+ * Cursor trên buffer, giữ mask separator (delimiter | '\n') của block 16 bytes hiện tại
+ * Mask dạng nibble, chỉ giữ bit cao của mỗi nibble → 1 bit / byte tại vị trí 4*i + 3
+*/
+typedef struct
+{
+    const uint8_t* data;
+    size_t len;
+    size_t block; // vị trí bắt đầu block trong mask
+    uint64_t mask;
+    uint8_t delimiter;
+} NeonCsvScanner;
+
+
+static inline uint64_t neon_csv_block_mask(const NeonCsvScanner* sc, size_t pos) {
+    const uint8_t* p = sc->data + pos;
+
+    if (sc->len - pos >= 16) {
+        uint8x16_t v = vld1q_u8(p);
+        uint8x16_t sep = vorrq_u8(vceqq_u8(v, vdupq_n_u8(sc->delimiter)), vceqq_u8(v, vdupq_n_u8('\n')));
+        return neon_mask_u8x16(sep) & 0x8888888888888888ull;
+    }
+
+    uint64_t mask = 0;
+    for (size_t i = 0; pos + i < sc->len; i++) {
+        if (p[i] == sc->delimiter || p[i] == '\n') mask |= 8ull << (4 * i);
+    }
+    return mask;
+}
+
+
+static inline void neon_csv_scanner_init(NeonCsvScanner* sc, const uint8_t* data, size_t len, uint8_t delimiter) {
+    sc->data = data;
+    sc->len = len;
+    sc->delimiter = delimiter;
+    sc->block = 0;
+    sc->mask = (len > 0) ? neon_csv_block_mask(sc, 0) : 0;
+}
+
+
+/**
+ * Vị trí separator đầu tiên >= from, hoặc len nếu không còn
+*/
+static inline size_t neon_csv_next_sep(NeonCsvScanner* sc, size_t from) {
+    if (from >= sc->len) return sc->len;
+
+    if (from < sc->block || from >= sc->block + 16) {
+        sc->block = from;
+        sc->mask = neon_csv_block_mask(sc, from);
+    } else {
+        // Bỏ các separator trước from
+        sc->mask &= ~((1ull << (4 * (from - sc->block))) - 1);
+    }
+
+    while (sc->mask == 0) {
+        sc->block += 16;
+        if (sc->block >= sc->len) return sc->len;
+        NEON_PREFETCH(sc->data + sc->block + 256);
+        sc->mask = neon_csv_block_mask(sc, sc->block);
+    }
+
+    size_t pos = sc->block + neon_mask_first(sc->mask);
+    sc->mask &= sc->mask - 1;
+    return pos;
+}
+
+
+static NEON_INLINE int neon_csv_is_space(uint8_t c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+
+/**
+ * Append 1 giá trị vào AlignedBuffer (capacity x2 khi đầy)
+*/
+static inline int neon_csv_push(AlignedBuffer* buf, float v) {
+    if (buf->size == buf->capacity) {
+        int err = aligned_buffer_resize(buf, MAX(buf->capacity * 2, (size_t)1024));
+        if (err != NEON_SUCCESS) return err;
+    }
+    buf->data[buf->size++] = v;
+    return NEON_SUCCESS;
+}
+
+
+
+// CSV PARSER
+/**
+ * Parse CSV số vào các cột float
+ *
+ * @param data, len: nội dung CSV (không cần '\0')
+ * @param delimiter: ',' / ';' / '\t' ...
+ * @param skip_header: 1 = bỏ dòng đầu
+ * @param columns: [num_columns] AlignedBuffer (aligned_buffer_create trước), giá trị được append
+ *                 Cột thừa trong CSV bị bỏ qua, cột thiếu → NAN
+ *                 Dòng trống bị bỏ qua, trừ khi num_columns == 1 (→ 1 dòng NAN)
+ * @param num_rows: số dòng đã parse (kể cả khi lỗi)
+ * @return: NEON_SUCCESS, NEON_ERROR_INVALID_PARAM nếu có field không phải số
+ *          hoặc ký tự lạ sau quote đóng ("1.5"x), NEON_ERROR_OUT_OF_MEMORY
+ *
+ * Example:
+ *   AlignedBuffer cols[3] = {aligned_buffer_create(0), aligned_buffer_create(0), aligned_buffer_create(0)};
+ *   size_t rows;
+ *   neon_csv_parse_f32(text, text_len, ',', 1, cols, 3, &rows);
+*/
+static inline int neon_csv_parse_f32(
+    const char* data,
+    size_t len,
+    char delimiter,
+    int skip_header,
+    AlignedBuffer* columns,
+    size_t num_columns,
+    size_t* num_rows
+) {
+    if (data == NULL || columns == NULL || num_rows == NULL) return NEON_ERROR_NULL_POINTER;
+
+    const uint8_t* s = (const uint8_t*)data;
+    size_t pos = 0;
+    *num_rows = 0;
+
+    if (skip_header) {
+        size_t nl = neon_memchr(s, '\n', len);
+        pos = (nl < len) ? nl + 1 : len;
+    }
+
+    NeonCsvScanner sc;
+    neon_csv_scanner_init(&sc, s, len, (uint8_t)delimiter);
+
+    while (pos < len) {
+        size_t col = 0;
+
+        for (;;) {
+            size_t begin = pos;
+            size_t end;
+            size_t sep;
+
+            while (begin < len && (s[begin] == ' ' || s[begin] == '\t')) begin++;
+
+            if (begin < len && s[begin] == '"') {
+                size_t close = begin + 1 + neon_memchr(s + begin + 1, '"', len - begin - 1);
+                if (close >= len) return NEON_ERROR_INVALID_PARAM;
+                sep = neon_csv_next_sep(&sc, close + 1);
+
+                // Sau dấu đóng quote chỉ được có whitespace rồi delimiter / xuống dòng / EOF
+                for (size_t j = close + 1; j < sep; j++) {
+                    if (!neon_csv_is_space(s[j])) return NEON_ERROR_INVALID_PARAM;
+                }
+                begin = begin + 1;
+                end = close;
+            } else {
+                sep = neon_csv_next_sep(&sc, pos);
+                end = sep;
+            }
+
+            while (end > begin && neon_csv_is_space(s[end - 1])) end--;
+
+            int line_end = (sep >= len || s[sep] == '\n');
+
+            // Dòng trống (với 1 cột thì dòng trống là field rỗng → NAN, giữ đúng số dòng)
+            if (num_columns != 1 && col == 0 && line_end && end <= begin && s[pos] != '"') {
+                pos = sep + 1;
+                goto next_line;
+            }
+
+            if (col < num_columns) {
+                float v;
+                if (!neon_parse_f32(s + begin, s + end, &v)) return NEON_ERROR_INVALID_PARAM;
+
+                int err = neon_csv_push(&columns[col], v);
+                if (err != NEON_SUCCESS) return err;
+            }
+            col++;
+
+            pos = sep + 1;
+            if (line_end) break;
+        }
+
+        for (; col < num_columns; col++) {
+            int err = neon_csv_push(&columns[col], NAN);
+            if (err != NEON_SUCCESS) return err;
+        }
+        (*num_rows)++;
+
+    next_line:
+        ;
+    }
+
+    return NEON_SUCCESS;
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_CSV_H
@@ -0,0 +1,195 @@
+#ifndef NEON_DISTANCE_H
+#define NEON_DISTANCE_H
+
+#include "neon_types.h"
+#include "memory_align.h"
+#include "neon_thread.h"
+#include "neon_topk.h"
+
+
+/**
+ * VECTOR DISTANCE KERNELS (ANN index, k-means, brute-force kNN)
+ *
+ * L2²: Σ (a - b)²,  IP distance: 1 - Σ a * b (nhỏ = gần, giống cosine distance khi đã normalize)
+ *
+ * 4 accumulators độc lập x 4 lanes = 16 floats / vòng
+ *   → FMA latency 4 cycles, 1 accumulator sẽ phụ thuộc lẫn nhau, 4 chuỗi song song giữ pipeline đầy
+ *
+ * One-to-many (brute force): prefetch vector tiếp theo trong lúc tính vector hiện tại
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+typedef enum {
+    DISTANCE_L2 = 0,
+    DISTANCE_IP = 1
+} DistanceMetric;
+
+
+#define NEON_KNN_MIN_PER_THREAD 4096
+
+
+
+// PAIRWISE
+static inline float neon_l2_sq_f32(const float* a, const float* b, size_t d) {
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    float32x4_t acc2 = vdupq_n_f32(0.0f);
+    float32x4_t acc3 = vdupq_n_f32(0.0f);
+
+    size_t j = 0;
+    for (; j + 16 <= d; j += 16) {
+        float32x4_t d0 = vsubq_f32(vld1q_f32(a + j), vld1q_f32(b + j));
+        float32x4_t d1 = vsubq_f32(vld1q_f32(a + j + 4), vld1q_f32(b + j + 4));
+        float32x4_t d2 = vsubq_f32(vld1q_f32(a + j + 8), vld1q_f32(b + j + 8));
+        float32x4_t d3 = vsubq_f32(vld1q_f32(a + j + 12), vld1q_f32(b + j + 12));
+        acc0 = vfmaq_f32(acc0, d0, d0);
+        acc1 = vfmaq_f32(acc1, d1, d1);
+        acc2 = vfmaq_f32(acc2, d2, d2);
+        acc3 = vfmaq_f32(acc3, d3, d3);
+    }
+    for (; j + 4 <= d; j += 4) {
+        float32x4_t d0 = vsubq_f32(vld1q_f32(a + j), vld1q_f32(b + j));
+        acc0 = vfmaq_f32(acc0, d0, d0);
+    }
+
+    float s = vaddvq_f32(vaddq_f32(vaddq_f32(acc0, acc1), vaddq_f32(acc2, acc3)));
+    for (; j < d; j++) {
+        float diff = a[j] - b[j];
+        s += diff * diff;
+    }
+    return s;
+}
+
+
+static inline float neon_inner_product_f32(const float* a, const float* b, size_t d) {
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    float32x4_t acc2 = vdupq_n_f32(0.0f);
+    float32x4_t acc3 = vdupq_n_f32(0.0f);
+
+    size_t j = 0;
+    for (; j + 16 <= d; j += 16) {
+        acc0 = vfmaq_f32(acc0, vld1q_f32(a + j), vld1q_f32(b + j));
+        acc1 = vfmaq_f32(acc1, vld1q_f32(a + j + 4), vld1q_f32(b + j + 4));
+        acc2 = vfmaq_f32(acc2, vld1q_f32(a + j + 8), vld1q_f32(b + j + 8));
+        acc3 = vfmaq_f32(acc3, vld1q_f32(a + j + 12), vld1q_f32(b + j + 12));
+    }
+    for (; j + 4 <= d; j += 4) {
+        acc0 = vfmaq_f32(acc0, vld1q_f32(a + j), vld1q_f32(b + j));
+    }
+
+    float s = vaddvq_f32(vaddq_f32(vaddq_f32(acc0, acc1), vaddq_f32(acc2, acc3)));
+    for (; j < d; j++) {
+        s += a[j] * b[j];
+    }
+    return s;
+}
+
+
+static inline float neon_norm_sq_f32(const float* a, size_t d) {
+    return neon_inner_product_f32(a, a, d);
+}
+
+
+static NEON_INLINE float neon_distance_f32(DistanceMetric metric, const float* a, const float* b, size_t d) {
+    return (metric == DISTANCE_L2) ? neon_l2_sq_f32(a, b, d) : 1.0f - neon_inner_product_f32(a, b, d);
+}
+
+
+
+// ONE-TO-MANY
+/**
+ * out[i] = distance(q, base + i * stride)
+*/
+static inline void neon_distances_f32(
+    DistanceMetric metric,
+    const float* q,
+    const float* base,
+    size_t n,
+    size_t dim,
+    size_t stride,
+    float* out
+) {
+    for (size_t i = 0; i < n; i++) {
+        if (i + 1 < n) {
+            const float* next = base + (i + 1) * stride;
+            for (size_t off = 0; off < dim; off += 16) NEON_PREFETCH(next + off);
+        }
+        out[i] = neon_distance_f32(metric, q, base + i * stride, dim);
+    }
+}
+
+
+typedef struct {
+    DistanceMetric metric;
+    const float* q;
+    const float* base;
+    size_t dim;
+    float* scores; // [n], -distance
+} NeonKnnCtx;
+
+
+static void neon_knn_worker(void* arg, size_t begin, size_t end, int tid) {
+    (void)tid;
+    NeonKnnCtx* ctx = (NeonKnnCtx*)arg;
+
+    neon_distances_f32(ctx->metric, ctx->q, ctx->base + begin * ctx->dim, end - begin,
+                       ctx->dim, ctx->dim, ctx->scores + begin);
+    for (size_t i = begin; i < end; i++) {
+        ctx->scores[i] = -ctx->scores[i];
+    }
+}
+
+
+/**
+ * Exact kNN (ground truth để đo recall của ANN index)
+ *
+ * @param base: [n x dim]
+ * @param out_dist: [k] tăng dần
+ * @return: min(k, n), 0 nếu hết memory
+*/
+static inline size_t neon_knn_brute_force(
+    DistanceMetric metric,
+    const float* q,
+    const float* base,
+    size_t n,
+    size_t dim,
+    size_t k,
+    float* out_dist,
+    int32_t* out_ids,
+    int num_threads
+) {
+    if (k == 0 || n == 0) return 0;
+
+    float* scores = (float*)neon_malloc(n * sizeof(float));
+    if (scores == NULL) return 0;
+
+    NeonKnnCtx ctx;
+    ctx.metric = metric;
+    ctx.q = q;
+    ctx.base = base;
+    ctx.dim = dim;
+    ctx.scores = scores;
+
+    int threads = neon_threads_for(n, num_threads, NEON_KNN_MIN_PER_THREAD);
+    neon_parallel_for(n, threads, neon_knn_worker, &ctx);
+
+    size_t count = neon_topk_f32_parallel(scores, n, k, out_dist, out_ids, num_threads);
+    for (size_t i = 0; i < count; i++) {
+        out_dist[i] = -out_dist[i];
+    }
+
+    neon_free(scores);
+    return count;
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_DISTANCE_H
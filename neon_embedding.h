@@ -0,0 +1,260 @@
+#ifndef NEON_EMBEDDING_H
+#define NEON_EMBEDDING_H
+
+#include "neon_types.h"
+#include "memory_align.h"
+#include "neon_utils.h"
+
+
+/**
+ * EMBEDDING BAG (recommendation models)
+ *
+ * Với mỗi bag b:
+ *   out[b, :] = pool( w[k] * table[indices[k], :]  for k in [offsets[b], offsets[b+1]) )
+ *   pool = SUM hoặc MEAN
+ *
+ * ĐẶC ĐIỂM: memory-latency bound
+ *   - table rất lớn (GB), mỗi row đọc random → gần như luôn cache miss
+ *   - compute chỉ là 1 FMA / element → CPU chủ yếu ngồi chờ DRAM
+ *   → Software prefetch các row sắp dùng (NEON_EMBEDDING_PREFETCH_DISTANCE rows trước)
+ *     để nhiều cache miss chạy song song (memory-level parallelism)
+ *
+ * Table types:
+ *   EMBEDDING_F32 : float
+ *   EMBEDDING_F16 : __fp16, convert bằng vcvt_f32_f16
+ *   EMBEDDING_I8  : int8 symmetric, mỗi row có 1 scale (row_scales[row])
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Prefetch distance (số rows đi trước)
+ * Quá nhỏ: prefetch chưa kịp về; quá lớn: bị evict trước khi dùng
+ * 8-16 là hợp lý với DRAM latency ~100ns, tune theo máy bằng cách define trước khi include
+*/
+#ifndef NEON_EMBEDDING_PREFETCH_DISTANCE
+#define NEON_EMBEDDING_PREFETCH_DISTANCE 8
+#endif
+
+
+typedef enum {
+    EMBEDDING_POOL_SUM = 0,
+    EMBEDDING_POOL_MEAN = 1
+} EmbeddingPoolMode;
+
+
+typedef enum {
+    EMBEDDING_F32 = 0,
+    EMBEDDING_F16 = 1,
+    EMBEDDING_I8 = 2
+} EmbeddingDType;
+
+
+static NEON_INLINE size_t neon_embedding_elem_size(EmbeddingDType dtype) {
+    return dtype == EMBEDDING_F32 ? sizeof(float) : (dtype == EMBEDDING_F16 ? 2 : 1);
+}
+
+
+/**
+ * Prefetch toàn bộ 1 row (từng cache line)
+*/
+static NEON_INLINE void neon_embedding_prefetch_row(const void* row, size_t row_bytes) {
+    const char* p = (const char*)row;
+    for (size_t b = 0; b < row_bytes; b += NEON_CACHE_LINE) {
+        NEON_PREFETCH(p + b);
+    }
+}
+
+
+
+// ROW ACCUMULATE: acc[0..dim) += w * row[0..dim)
+static inline void neon_embedding_accum_f32(float* acc, const float* row, float w, size_t dim) {
+    size_t j = 0;
+    for (; j + 8 <= dim; j += 8) {
+        vst1q_f32(acc + j, vfmaq_n_f32(vld1q_f32(acc + j), vld1q_f32(row + j), w));
+        vst1q_f32(acc + j + 4, vfmaq_n_f32(vld1q_f32(acc + j + 4), vld1q_f32(row + j + 4), w));
+    }
+    for (; j + 4 <= dim; j += 4) {
+        vst1q_f32(acc + j, vfmaq_n_f32(vld1q_f32(acc + j), vld1q_f32(row + j), w));
+    }
+    for (; j < dim; j++) {
+        acc[j] += w * row[j];
+    }
+}
+
+
+static inline void neon_embedding_accum_f16(float* acc, const __fp16* row, float w, size_t dim) {
+    size_t j = 0;
+    for (; j + 8 <= dim; j += 8) {
+        float16x8_t h = vld1q_f16(row + j);
+        float32x4_t lo = vcvt_f32_f16(vget_low_f16(h));
+        float32x4_t hi = vcvt_high_f32_f16(h);
+        vst1q_f32(acc + j, vfmaq_n_f32(vld1q_f32(acc + j), lo, w));
+        vst1q_f32(acc + j + 4, vfmaq_n_f32(vld1q_f32(acc + j + 4), hi, w));
+    }
+    for (; j < dim; j++) {
+        acc[j] += w * (float)row[j];
+    }
+}
+
+
+/**
+ * int8 → f32: vmovl_s8 (s8 → s16) → vmovl_s16 (s16 → s32) → vcvtq_f32_s32
+ * w đã nhân sẵn row scale
+*/
+static inline void neon_embedding_accum_i8(float* acc, const int8_t* row, float w, size_t dim) {
+    size_t j = 0;
+    for (; j + 16 <= dim; j += 16) {
+        int8x16_t q = vld1q_s8(row + j);
+        int16x8_t lo16 = vmovl_s8(vget_low_s8(q));
+        int16x8_t hi16 = vmovl_high_s8(q);
+
+        float32x4_t f0 = vcvtq_f32_s32(vmovl_s16(vget_low_s16(lo16)));
+        float32x4_t f1 = vcvtq_f32_s32(vmovl_high_s16(lo16));
+        float32x4_t f2 = vcvtq_f32_s32(vmovl_s16(vget_low_s16(hi16)));
+        float32x4_t f3 = vcvtq_f32_s32(vmovl_high_s16(hi16));
+
+        vst1q_f32(acc + j, vfmaq_n_f32(vld1q_f32(acc + j), f0, w));
+        vst1q_f32(acc + j + 4, vfmaq_n_f32(vld1q_f32(acc + j + 4), f1, w));
+        vst1q_f32(acc + j + 8, vfmaq_n_f32(vld1q_f32(acc + j + 8), f2, w));
+        vst1q_f32(acc + j + 12, vfmaq_n_f32(vld1q_f32(acc + j + 12), f3, w));
+    }
+    for (; j < dim; j++) {
+        acc[j] += w * (float)row[j];
+    }
+}
+
+
+
+/**
+ * Embedding bag (generic table type)
+ *
+ * @param table: [num_rows x dim], kiểu theo dtype
+ * @param row_scales: scale mỗi row (chỉ dùng cho EMBEDDING_I8, NULL với f32/f16)
+ * @param indices: [num_indices] row index
+ * @param offsets: [num_bags + 1], bag b = indices[offsets[b] .. offsets[b+1])
+ * @param weights: [num_indices] per-sample weights, NULL = tất cả bằng 1
+ * @param out: [num_bags x dim] float
+ * @return: NEON_SUCCESS, hoặc NEON_ERROR_INVALID_PARAM nếu có index ngoài [0, num_rows)
+*/
+static inline int neon_embedding_bag(
+    const void* table,
+    EmbeddingDType dtype,
+    const float* row_scales,
+    int64_t num_rows,
+    size_t dim,
+    const int64_t* indices,
+    const int64_t* offsets,
+    size_t num_bags,
+    const float* weights,
+    EmbeddingPoolMode mode,
+    float* out
+) {
+    if (table == NULL || indices == NULL || offsets == NULL || out == NULL) {
+        return NEON_ERROR_NULL_POINTER;
+    }
+    if (dtype == EMBEDDING_I8 && row_scales == NULL) {
+        return NEON_ERROR_NULL_POINTER;
+    }
+
+    const char* base = (const char*)table;
+    size_t row_bytes = dim * neon_embedding_elem_size(dtype);
+    int64_t total = offsets[num_bags];
+
+    for (size_t b = 0; b < num_bags; b++) {
+        float* acc = out + b * dim;
+        neon_fill_f32(acc, 0.0f, dim);
+
+        int64_t start = offsets[b];
+        int64_t end = offsets[b + 1];
+
+        for (int64_t k = start; k < end; k++) {
+            // Prefetch row ở xa phía trước (kể cả sang bag sau)
+            int64_t pf = k + NEON_EMBEDDING_PREFETCH_DISTANCE;
+            if (pf < total) {
+                int64_t pf_row = indices[pf];
+                if (LIKELY(pf_row >= 0 && pf_row < num_rows)) {
+                    neon_embedding_prefetch_row(base + (size_t)pf_row * row_bytes, row_bytes);
+                }
+            }
+
+            int64_t row = indices[k];
+            if (UNLIKELY(row < 0 || row >= num_rows)) {
+                return NEON_ERROR_INVALID_PARAM;
+            }
+
+            float w = (weights != NULL) ? weights[k] : 1.0f;
+            const void* row_ptr = base + (size_t)row * row_bytes;
+
+            switch (dtype) {
+                case EMBEDDING_F32:
+                    neon_embedding_accum_f32(acc, (const float*)row_ptr, w, dim);
+                    break;
+                case EMBEDDING_F16:
+                    neon_embedding_accum_f16(acc, (const __fp16*)row_ptr, w, dim);
+                    break;
+                case EMBEDDING_I8:
+                    neon_embedding_accum_i8(acc, (const int8_t*)row_ptr, w * row_scales[row], dim);
+                    break;
+                default:
+                    return NEON_ERROR_INVALID_PARAM;
+            }
+        }
+
+        if (mode == EMBEDDING_POOL_MEAN && end > start) {
+            float inv = 1.0f / (float)(end - start);
+            float32x4_t vinv = vdupq_n_f32(inv);
+
+            size_t j = 0;
+            for (; j + 4 <= dim; j += 4) {
+                vst1q_f32(acc + j, vmulq_f32(vld1q_f32(acc + j), vinv));
+            }
+            for (; j < dim; j++) {
+                acc[j] *= inv;
+            }
+        }
+    }
+
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * Convenience wrappers cho từng table type
+*/
+static inline int neon_embedding_bag_f32(
+    const float* table, int64_t num_rows, size_t dim,
+    const int64_t* indices, const int64_t* offsets, size_t num_bags,
+    const float* weights, EmbeddingPoolMode mode, float* out
+) {
+    return neon_embedding_bag(table, EMBEDDING_F32, NULL, num_rows, dim,
+                              indices, offsets, num_bags, weights, mode, out);
+}
+
+static inline int neon_embedding_bag_f16(
+    const __fp16* table, int64_t num_rows, size_t dim,
+    const int64_t* indices, const int64_t* offsets, size_t num_bags,
+    const float* weights, EmbeddingPoolMode mode, float* out
+) {
+    return neon_embedding_bag(table, EMBEDDING_F16, NULL, num_rows, dim,
+                              indices, offsets, num_bags, weights, mode, out);
+}
+
+static inline int neon_embedding_bag_i8(
+    const int8_t* table, const float* row_scales, int64_t num_rows, size_t dim,
+    const int64_t* indices, const int64_t* offsets, size_t num_bags,
+    const float* weights, EmbeddingPoolMode mode, float* out
+) {
+    return neon_embedding_bag(table, EMBEDDING_I8, row_scales, num_rows, dim,
+                              indices, offsets, num_bags, weights, mode, out);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_EMBEDDING_H
@@ -0,0 +1,618 @@
+#ifndef NEON_F64_H
+#define NEON_F64_H
+
+#include "neon_types.h"
+#include "memory_align.h"
+#include "neon_utils.h"
+#include <math.h>
+
+
+/**
+ * DOUBLE PRECISION (float64x2_t) KERNELS
+ *
+ * Các kernel giống hệt neon_utils.h nhưng cho double:
+ *   neon_add_f32x4  →  neon_add_f64x2
+ *   neon_sum_f32x4  →  neon_sum_f64x2
+ *   ...
+ *
+ * LƯU Ý:
+ * - float64x2_t chỉ có trên ARMv8 (AArch64), ARMv7 NEON không hỗ trợ double
+ * - 1 Q register chỉ chứa 2 doubles → throughput bằng 1/2 so với float32
+ * - Dùng cho scientific/finance code cần độ chính xác ~1e-16
+*/
+
+#ifndef __aarch64__
+    #error "neon_f64.h requires AArch64 (float64x2_t)"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+// NEON LOAD/STORE (f64)
+static NEON_INLINE float64x2_t neon_load_f64x2(const double* ptr) {
+    return vld1q_f64(ptr);
+}
+
+static NEON_INLINE void neon_store_f64x2(double* ptr, float64x2_t vec) {
+    vst1q_f64(ptr, vec);
+}
+
+
+// NEON ARITHMETIC (f64)
+/**
+ * Vector addition: result = a + b
+*/
+static NEON_INLINE float64x2_t neon_add_f64x2(float64x2_t a, float64x2_t b) {
+    return vaddq_f64(a, b);
+}
+
+/**
+ * Vector subtraction: result = a - b
+*/
+static NEON_INLINE float64x2_t neon_sub_f64x2(float64x2_t a, float64x2_t b) {
+    return vsubq_f64(a, b);
+}
+
+/**
+ * Vector multiplication: result = a * b
+*/
+static NEON_INLINE float64x2_t neon_mul_f64x2(float64x2_t a, float64x2_t b) {
+    return vmulq_f64(a, b);
+}
+
+/**
+ * Fused Multiply-Add: result = a * b + c
+ * AArch64 luôn có FMA cho double
+*/
+static NEON_INLINE float64x2_t neon_fma_f64x2(float64x2_t a, float64x2_t b, float64x2_t c) {
+    return vfmaq_f64(c, a, b);
+}
+
+/**
+ * Vector division: result = a / b
+*/
+static NEON_INLINE float64x2_t neon_div_f64x2(float64x2_t a, float64x2_t b) {
+    return vdivq_f64(a, b);
+}
+
+
+// NEON REDUCTION OPERATIONS (f64)
+/**
+ * Horizontal sum: [a, b] → a + b
+*/
+static NEON_INLINE double neon_sum_f64x2(float64x2_t vec) {
+    return vaddvq_f64(vec);
+}
+
+/**
+ * Horizontal max: [a, b] → max(a, b)
+*/
+static NEON_INLINE double neon_max_f64x2(float64x2_t vec) {
+    return vmaxvq_f64(vec);
+}
+
+/**
+ * Horizontal min: [a, b] → min(a, b)
+*/
+static NEON_INLINE double neon_min_f64x2(float64x2_t vec) {
+    return vminvq_f64(vec);
+}
+
+static NEON_INLINE float64x2_t neon_vmax_f64x2(float64x2_t a, float64x2_t b) {
+    return vmaxq_f64(a, b);
+}
+
+static NEON_INLINE float64x2_t neon_vmin_f64x2(float64x2_t a, float64x2_t b) {
+    return vminq_f64(a, b);
+}
+
+/**
+ * Clamp vector: result[i] = clamp(vec[i], min_val, max_val)
+*/
+static NEON_INLINE float64x2_t neon_clamp_f64x2(
+    float64x2_t vec,
+    double min_val,
+    double max_val
+) {
+    return vminq_f64(vmaxq_f64(vec, vdupq_n_f64(min_val)), vdupq_n_f64(max_val));
+}
+
+/**
+ * Compare greater than: mask[i] = (a[i] > b[i]) ? 0xFFFFFFFFFFFFFFFF : 0
+*/
+static NEON_INLINE uint64x2_t neon_cmpgt_f64x2(float64x2_t a, float64x2_t b) {
+    return vcgtq_f64(a, b);
+}
+
+/**
+ * Select/Blend: result[i] = mask[i] ? a[i] : b[i]
+*/
+static NEON_INLINE float64x2_t neon_select_f64x2(
+    uint64x2_t mask,
+    float64x2_t a,
+    float64x2_t b
+) {
+    return vbslq_f64(mask, a, b);
+}
+
+static NEON_INLINE float64x2_t neon_broadcast_f64(double value) {
+    return vdupq_n_f64(value);
+}
+
+static NEON_INLINE float64x2_t neon_sqrt_f64x2(float64x2_t x) {
+    return vsqrtq_f64(x); // AArch64 có hardware sqrt, chính xác tuyệt đối
+}
+
+static NEON_INLINE double neon_dot_f64x2(float64x2_t a, float64x2_t b) {
+    return vaddvq_f64(vmulq_f64(a, b));
+}
+
+
+
+// NEON TRANSCENDENTAL FUNCTIONS (f64)
+/**
+ * exp() cho double, sai số ~1 ulp (khác với neon_exp_f32x4 chỉ ~0.1%)
+ *
+ * Range reduction:
+ *   x = n * ln2 + r,  |r| <= ln2 / 2
+ *   exp(x) = 2^n * exp(r)
+ *
+ * exp(r) dùng Taylor bậc 13 (Horner), 2^n tạo bằng cách ghi thẳng exponent bits
+*/
+static NEON_INLINE float64x2_t neon_exp_f64x2(float64x2_t x) {
+    // Clamp để 2^n không overflow/underflow exponent field
+    x = vminq_f64(x, vdupq_n_f64(709.0));
+    x = vmaxq_f64(x, vdupq_n_f64(-708.0));
+
+    // n = round(x / ln2)
+    float64x2_t n = vrndnq_f64(vmulq_f64(x, vdupq_n_f64(1.4426950408889634)));
+
+    // r = x - n * ln2 (ln2 tách hi/lo để không mất chính xác)
+    float64x2_t r = vfmsq_f64(x, n, vdupq_n_f64(6.93147180369123816490e-01));
+    r = vfmsq_f64(r, n, vdupq_n_f64(1.90821492927058770002e-10));
+
+    // Horner: 1 + r(1 + r/2(1 + r/3(...)))
+    float64x2_t p = vdupq_n_f64(1.0 / 6227020800.0); // 1/13!
+    p = vfmaq_f64(vdupq_n_f64(1.0 / 479001600.0), p, r);
+    p = vfmaq_f64(vdupq_n_f64(1.0 / 39916800.0), p, r);
+    p = vfmaq_f64(vdupq_n_f64(1.0 / 3628800.0), p, r);
+    p = vfmaq_f64(vdupq_n_f64(1.0 / 362880.0), p, r);
+    p = vfmaq_f64(vdupq_n_f64(1.0 / 40320.0), p, r);
+    p = vfmaq_f64(vdupq_n_f64(1.0 / 5040.0), p, r);
+    p = vfmaq_f64(vdupq_n_f64(1.0 / 720.0), p, r);
+    p = vfmaq_f64(vdupq_n_f64(1.0 / 120.0), p, r);
+    p = vfmaq_f64(vdupq_n_f64(1.0 / 24.0), p, r);
+    p = vfmaq_f64(vdupq_n_f64(1.0 / 6.0), p, r);
+    p = vfmaq_f64(vdupq_n_f64(0.5), p, r);
+    p = vfmaq_f64(vdupq_n_f64(1.0), p, r);
+    p = vfmaq_f64(vdupq_n_f64(1.0), p, r);
+
+    // 2^n: (n + 1023) << 52
+    int64x2_t e = vshlq_n_s64(vaddq_s64(vcvtq_s64_f64(n), vdupq_n_s64(1023)), 52);
+
+    return vmulq_f64(p, vreinterpretq_f64_s64(e));
+}
+
+
+/**
+ * log() cho double (x > 0)
+ *
+ * x = 2^e * m,  m ∈ [sqrt(1/2), sqrt(2))
+ * log(x) = e * ln2 + log(m)
+ * log(m) = 2 * atanh(s),  s = (m - 1) / (m + 1),  |s| <= 0.172
+ *        = 2 * (s + s^3/3 + s^5/5 + ... + s^21/21)
+ *
+ * x <= 0, denormal, inf, nan: không xử lý (giống neon_exp_f32x4 không check)
+*/
+static NEON_INLINE float64x2_t neon_log_f64x2(float64x2_t x) {
+    int64x2_t bits = vreinterpretq_s64_f64(x);
+
+    // Tách exponent và mantissa (mantissa đưa về [1, 2))
+    int64x2_t e = vsubq_s64(vshrq_n_s64(bits, 52), vdupq_n_s64(1023));
+    int64x2_t mbits = vorrq_s64(
+        vandq_s64(bits, vdupq_n_s64(0x000FFFFFFFFFFFFFLL)),
+        vdupq_n_s64(0x3FF0000000000000LL)
+    );
+    float64x2_t m = vreinterpretq_f64_s64(mbits);
+
+    // m >= sqrt(2) → m /= 2, e += 1 (để |s| nhỏ nhất)
+    uint64x2_t big = vcgtq_f64(m, vdupq_n_f64(1.4142135623730951));
+    m = vbslq_f64(big, vmulq_f64(m, vdupq_n_f64(0.5)), m);
+    e = vsubq_s64(e, vreinterpretq_s64_u64(big)); // mask = -1 → e + 1
+
+    float64x2_t s = vdivq_f64(vsubq_f64(m, vdupq_n_f64(1.0)), vaddq_f64(m, vdupq_n_f64(1.0)));
+    float64x2_t s2 = vmulq_f64(s, s);
+
+    float64x2_t p = vdupq_n_f64(1.0 / 21.0);
+    p = vfmaq_f64(vdupq_n_f64(1.0 / 19.0), p, s2);
+    p = vfmaq_f64(vdupq_n_f64(1.0 / 17.0), p, s2);
+    p = vfmaq_f64(vdupq_n_f64(1.0 / 15.0), p, s2);
+    p = vfmaq_f64(vdupq_n_f64(1.0 / 13.0), p, s2);
+    p = vfmaq_f64(vdupq_n_f64(1.0 / 11.0), p, s2);
+    p = vfmaq_f64(vdupq_n_f64(1.0 / 9.0), p, s2);
+    p = vfmaq_f64(vdupq_n_f64(1.0 / 7.0), p, s2);
+    p = vfmaq_f64(vdupq_n_f64(1.0 / 5.0), p, s2);
+    p = vfmaq_f64(vdupq_n_f64(1.0 / 3.0), p, s2);
+    p = vfmaq_f64(vdupq_n_f64(1.0), p, s2);
+
+    float64x2_t log_m = vmulq_f64(vaddq_f64(s, s), p);
+
+    float64x2_t ef = vcvtq_f64_s64(e);
+    float64x2_t result = vfmaq_f64(log_m, ef, vdupq_n_f64(1.90821492927058770002e-10));
+    return vfmaq_f64(result, ef, vdupq_n_f64(6.93147180369123816490e-01));
+}
+
+
+
+// ARRAY KERNELS (f64)
+/**
+ * Dot product của 2 arrays double
+ * 4 accumulators độc lập để che latency của FMA (4 cycles)
+*/
+static inline double neon_dot_product_f64(const double* a, const double* b, size_t size) {
+    float64x2_t acc0 = vdupq_n_f64(0.0);
+    float64x2_t acc1 = vdupq_n_f64(0.0);
+    float64x2_t acc2 = vdupq_n_f64(0.0);
+    float64x2_t acc3 = vdupq_n_f64(0.0);
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        acc0 = vfmaq_f64(acc0, vld1q_f64(a + i), vld1q_f64(b + i));
+        acc1 = vfmaq_f64(acc1, vld1q_f64(a + i + 2), vld1q_f64(b + i + 2));
+        acc2 = vfmaq_f64(acc2, vld1q_f64(a + i + 4), vld1q_f64(b + i + 4));
+        acc3 = vfmaq_f64(acc3, vld1q_f64(a + i + 6), vld1q_f64(b + i + 6));
+    }
+
+    for (; i + 2 <= size; i += 2) {
+        acc0 = vfmaq_f64(acc0, vld1q_f64(a + i), vld1q_f64(b + i));
+    }
+
+    double result = vaddvq_f64(vaddq_f64(vaddq_f64(acc0, acc1), vaddq_f64(acc2, acc3)));
+
+    for (; i < size; i++) {
+        result += a[i] * b[i];
+    }
+
+    return result;
+}
+
+
+/**
+ * Tổng của array double
+*/
+static inline double neon_sum_f64(const double* data, size_t size) {
+    float64x2_t acc0 = vdupq_n_f64(0.0);
+    float64x2_t acc1 = vdupq_n_f64(0.0);
+    float64x2_t acc2 = vdupq_n_f64(0.0);
+    float64x2_t acc3 = vdupq_n_f64(0.0);
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        acc0 = vaddq_f64(acc0, vld1q_f64(data + i));
+        acc1 = vaddq_f64(acc1, vld1q_f64(data + i + 2));
+        acc2 = vaddq_f64(acc2, vld1q_f64(data + i + 4));
+        acc3 = vaddq_f64(acc3, vld1q_f64(data + i + 6));
+    }
+
+    for (; i + 2 <= size; i += 2) {
+        acc0 = vaddq_f64(acc0, vld1q_f64(data + i));
+    }
+
+    double result = vaddvq_f64(vaddq_f64(vaddq_f64(acc0, acc1), vaddq_f64(acc2, acc3)));
+
+    for (; i < size; i++) {
+        result += data[i];
+    }
+
+    return result;
+}
+
+
+/**
+ * Max của array double (size > 0)
+*/
+static inline double neon_max_f64(const double* data, size_t size) {
+    if (size < 2) return size == 1 ? data[0] : -INFINITY;
+
+    float64x2_t vmax = vld1q_f64(data);
+
+    size_t i = 2;
+    for (; i + 2 <= size; i += 2) {
+        vmax = vmaxq_f64(vmax, vld1q_f64(data + i));
+    }
+
+    double result = vmaxvq_f64(vmax);
+    for (; i < size; i++) {
+        result = MAX(result, data[i]);
+    }
+
+    return result;
+}
+
+
+/**
+ * Min của array double (size > 0)
+*/
+static inline double neon_min_f64(const double* data, size_t size) {
+    if (size < 2) return size == 1 ? data[0] : INFINITY;
+
+    float64x2_t vmin = vld1q_f64(data);
+
+    size_t i = 2;
+    for (; i + 2 <= size; i += 2) {
+        vmin = vminq_f64(vmin, vld1q_f64(data + i));
+    }
+
+    double result = vminvq_f64(vmin);
+    for (; i < size; i++) {
+        result = MIN(result, data[i]);
+    }
+
+    return result;
+}
+
+
+/**
+ * Calculate mean của array double
+*/
+static inline double neon_mean_f64(const double* data, size_t size) {
+    if (size == 0) return 0.0;
+    return neon_sum_f64(data, size) / (double)size;
+}
+
+
+/**
+ * Calculate variance của array double (population variance)
+ * var = sum((x - mean)^2) / size
+*/
+static inline double neon_variance_f64(const double* data, size_t size, double mean) {
+    if (size == 0) return 0.0;
+
+    float64x2_t vmean = vdupq_n_f64(mean);
+    float64x2_t acc0 = vdupq_n_f64(0.0);
+    float64x2_t acc1 = vdupq_n_f64(0.0);
+
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        float64x2_t d0 = vsubq_f64(vld1q_f64(data + i), vmean);
+        float64x2_t d1 = vsubq_f64(vld1q_f64(data + i + 2), vmean);
+        acc0 = vfmaq_f64(acc0, d0, d0);
+        acc1 = vfmaq_f64(acc1, d1, d1);
+    }
+
+    for (; i + 2 <= size; i += 2) {
+        float64x2_t d = vsubq_f64(vld1q_f64(data + i), vmean);
+        acc0 = vfmaq_f64(acc0, d, d);
+    }
+
+    double result = vaddvq_f64(vaddq_f64(acc0, acc1));
+    for (; i < size; i++) {
+        double d = data[i] - mean;
+        result += d * d;
+    }
+
+    return result / (double)size;
+}
+
+
+/**
+ * Elementwise ops: dst[i] = a[i] (op) b[i]
+ * dst có thể trùng với a hoặc b (in-place)
+*/
+#define NEON_F64_BINARY_OP(name, vec_op, scalar_op)                                  \
+static inline void name(double* dst, const double* a, const double* b, size_t size) { \
+    size_t i = 0;                                                                   \
+    for (; i + 4 <= size; i += 4) {                                                 \
+        float64x2_t r0 = vec_op(vld1q_f64(a + i), vld1q_f64(b + i));                \
+        float64x2_t r1 = vec_op(vld1q_f64(a + i + 2), vld1q_f64(b + i + 2));        \
+        vst1q_f64(dst + i, r0);                                                     \
+        vst1q_f64(dst + i + 2, r1);                                                 \
+    }                                                                               \
+    for (; i + 2 <= size; i += 2) {                                                 \
+        vst1q_f64(dst + i, vec_op(vld1q_f64(a + i), vld1q_f64(b + i)));             \
+    }                                                                               \
+    for (; i < size; i++) {                                                         \
+        dst[i] = a[i] scalar_op b[i];                                               \
+    }                                                                               \
+}
+
+NEON_F64_BINARY_OP(neon_add_f64, vaddq_f64, +)
+NEON_F64_BINARY_OP(neon_sub_f64, vsubq_f64, -)
+NEON_F64_BINARY_OP(neon_mul_f64, vmulq_f64, *)
+NEON_F64_BINARY_OP(neon_div_f64, vdivq_f64, /)
+
+#undef NEON_F64_BINARY_OP
+
+
+/**
+ * AXPY: y[i] = alpha * x[i] + y[i]
+*/
+static inline void neon_axpy_f64(double* y, double alpha, const double* x, size_t size) {
+    float64x2_t va = vdupq_n_f64(alpha);
+
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        vst1q_f64(y + i, vfmaq_f64(vld1q_f64(y + i), vld1q_f64(x + i), va));
+        vst1q_f64(y + i + 2, vfmaq_f64(vld1q_f64(y + i + 2), vld1q_f64(x + i + 2), va));
+    }
+
+    for (; i + 2 <= size; i += 2) {
+        vst1q_f64(y + i, vfmaq_f64(vld1q_f64(y + i), vld1q_f64(x + i), va));
+    }
+
+    for (; i < size; i++) {
+        y[i] += alpha * x[i];
+    }
+}
+
+
+/**
+ * dst[i] = exp(src[i])
+*/
+static inline void neon_exp_f64(double* dst, const double* src, size_t size) {
+    size_t i = 0;
+    for (; i + 2 <= size; i += 2) {
+        vst1q_f64(dst + i, neon_exp_f64x2(vld1q_f64(src + i)));
+    }
+
+    if (i < size) {
+        double tmp[2] = {src[i], 0.0};
+        vst1q_f64(tmp, neon_exp_f64x2(vld1q_f64(tmp)));
+        dst[i] = tmp[0];
+    }
+}
+
+
+/**
+ * dst[i] = log(src[i]),  src[i] > 0
+*/
+static inline void neon_log_f64(double* dst, const double* src, size_t size) {
+    size_t i = 0;
+    for (; i + 2 <= size; i += 2) {
+        vst1q_f64(dst + i, neon_log_f64x2(vld1q_f64(src + i)));
+    }
+
+    if (i < size) {
+        double tmp[2] = {src[i], 1.0};
+        vst1q_f64(tmp, neon_log_f64x2(vld1q_f64(tmp)));
+        dst[i] = tmp[0];
+    }
+}
+
+
+
+// DGEMM
+/**
+ * DGEMM micro-kernel 4x4: C[4x4] = A_panel * B_panel
+ *
+ * A_panel: packed K x 4 (cột của 4 hàng A liên tiếp theo k)
+ * B_panel: packed K x 4 (4 cột B liên tiếp theo k)
+ * C: row-major, leading dimension ldc
+ *
+ * REGISTER BLOCKING:
+ *   8 accumulators (4 hàng x 2 float64x2_t) + 2 A + 2 B = 12 Q registers
+ *   Mỗi k: 2 loads A, 2 loads B, 8 FMA (vfmaq_laneq_f64 broadcast từ lane)
+*/
+static NEON_INLINE void neon_dgemm_kernel_4x4(
+    const double* a_panel,
+    const double* b_panel,
+    size_t k,
+    double* c,
+    size_t ldc
+) {
+    float64x2_t c00 = vdupq_n_f64(0.0), c01 = vdupq_n_f64(0.0);
+    float64x2_t c10 = vdupq_n_f64(0.0), c11 = vdupq_n_f64(0.0);
+    float64x2_t c20 = vdupq_n_f64(0.0), c21 = vdupq_n_f64(0.0);
+    float64x2_t c30 = vdupq_n_f64(0.0), c31 = vdupq_n_f64(0.0);
+
+    for (size_t p = 0; p < k; p++) {
+        float64x2_t a01 = vld1q_f64(a_panel + p * 4);
+        float64x2_t a23 = vld1q_f64(a_panel + p * 4 + 2);
+        float64x2_t b0 = vld1q_f64(b_panel + p * 4);
+        float64x2_t b1 = vld1q_f64(b_panel + p * 4 + 2);
+
+        c00 = vfmaq_laneq_f64(c00, b0, a01, 0);
+        c01 = vfmaq_laneq_f64(c01, b1, a01, 0);
+        c10 = vfmaq_laneq_f64(c10, b0, a01, 1);
+        c11 = vfmaq_laneq_f64(c11, b1, a01, 1);
+        c20 = vfmaq_laneq_f64(c20, b0, a23, 0);
+        c21 = vfmaq_laneq_f64(c21, b1, a23, 0);
+        c30 = vfmaq_laneq_f64(c30, b0, a23, 1);
+        c31 = vfmaq_laneq_f64(c31, b1, a23, 1);
+    }
+
+    vst1q_f64(c, c00);
+    vst1q_f64(c + 2, c01);
+    vst1q_f64(c + ldc, c10);
+    vst1q_f64(c + ldc + 2, c11);
+    vst1q_f64(c + 2 * ldc, c20);
+    vst1q_f64(c + 2 * ldc + 2, c21);
+    vst1q_f64(c + 3 * ldc, c30);
+    vst1q_f64(c + 3 * ldc + 2, c31);
+}
+
+
+/**
+ * DGEMM: C[M x N] = A[M x K] * B[K x N] (row-major)
+ *
+ * Pack B thành các panel 4 cột và A thành panel 4 hàng (pad 0 ở biên),
+ * sau đó chạy neon_dgemm_kernel_4x4. Tile ở biên ghi qua buffer tạm.
+ *
+ * @return: NEON_SUCCESS hoặc error code
+*/
+static inline int neon_dgemm(
+    const double* A,
+    const double* B,
+    double* C,
+    size_t M,
+    size_t N,
+    size_t K
+) {
+    if (A == NULL || B == NULL || C == NULL) return NEON_ERROR_NULL_POINTER;
+    if (M == 0 || N == 0) return NEON_SUCCESS;
+
+    size_t n_panels = (N + 3) / 4;
+    double* b_packed = (double*)neon_malloc((n_panels * K * 4 + 2) * sizeof(double));
+    double* a_packed = (double*)neon_malloc((K * 4 + 2) * sizeof(double));
+
+    if (b_packed == NULL || a_packed == NULL) {
+        neon_free(b_packed);
+        neon_free(a_packed);
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    // Pack B: panel j chứa cột [4j, 4j+4) theo thứ tự k
+    for (size_t jp = 0; jp < n_panels; jp++) {
+        double* dst = b_packed + jp * K * 4;
+        for (size_t p = 0; p < K; p++) {
+            for (size_t jj = 0; jj < 4; jj++) {
+                size_t j = jp * 4 + jj;
+                dst[p * 4 + jj] = (j < N) ? B[p * N + j] : 0.0;
+            }
+        }
+    }
+
+    double tile[16] ALIGN_NEON;
+
+    for (size_t i = 0; i < M; i += 4) {
+        size_t rows = MIN(4, M - i);
+
+        // Pack A: 4 hàng [i, i+4) theo thứ tự k
+        for (size_t p = 0; p < K; p++) {
+            for (size_t ii = 0; ii < 4; ii++) {
+                a_packed[p * 4 + ii] = (ii < rows) ? A[(i + ii) * K + p] : 0.0;
+            }
+        }
+
+        for (size_t jp = 0; jp < n_panels; jp++) {
+            size_t j = jp * 4;
+            size_t cols = MIN(4, N - j);
+
+            if (rows == 4 && cols == 4) {
+                neon_dgemm_kernel_4x4(a_packed, b_packed + jp * K * 4, K, C + i * N + j, N);
+            } else {
+                neon_dgemm_kernel_4x4(a_packed, b_packed + jp * K * 4, K, tile, 4);
+                for (size_t ii = 0; ii < rows; ii++) {
+                    for (size_t jj = 0; jj < cols; jj++) {
+                        C[(i + ii) * N + j + jj] = tile[ii * 4 + jj];
+                    }
+                }
+            }
+        }
+    }
+
+    neon_free(a_packed);
+    neon_free(b_packed);
+
+    return NEON_SUCCESS;
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_F64_H
@@ -0,0 +1,618 @@
+#ifndef NEON_HISTOGRAM_H
+#define NEON_HISTOGRAM_H
+
+#include "neon_types.h"
+#include "memory_align.h"
+#include "neon_utils.h"
+#include "neon_thread.h"
+
+
+/**
+ * HISTOGRAM & QUANTILE SKETCH (monitoring distribution của inputs/outputs)
+ *
+ * 1. NeonHistogram: bin edges cố định [lo, hi), num_bins bins đều nhau
+ *    bin = clamp((int)(x * scale + bias), 0, num_bins - 1)
+ *        scale = num_bins / (hi - lo), bias = -lo * scale
+ *    → 1 vfmaq_f32 + 1 vcvtq_s32_f32 + vmax/vmin cho 4 phần tử, không có branch
+ *    Giá trị ngoài [lo, hi) bị clamp vào bin đầu/cuối, NaN được đếm riêng
+ *
+ * 2. NeonQuantileSketch: log-linear buckets trên bit pattern của float
+ *    |x| dương → bits tăng đơn điệu theo giá trị
+ *    key = (bits & 0x7FFFFFFF) >> (23 - NEON_SKETCH_MANTISSA_BITS)
+ *        = exponent + NEON_SKETCH_MANTISSA_BITS bit đầu của mantissa
+ *    → relative error ≤ 2^-(NEON_SKETCH_MANTISSA_BITS + 1) (~1.6%), range không cần biết trước
+ *    Chỉ dùng integer ops (shift, min, max, bsl), merge = cộng counts
+ *
+ * SCATTER-INCREMENT:
+ *   counts[idx]++ liên tiếp cùng bin → store-to-load forwarding stall mỗi lần
+ *   → mỗi lane j ghi vào 1 bản copy counts riêng (NEON_HIST_COPIES = 4),
+ *     cộng lại khi đọc (neon_histogram_count, quantile, merge)
+ *
+ * Multi-thread: mỗi thread 1 instance riêng, merge ở cuối (không có atomic)
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define NEON_HIST_COPIES 4
+
+
+/**
+ * Scatter-increment 4 indices, lane j vào copy j
+*/
+static NEON_INLINE void neon_hist_scatter4(uint64_t* counts, size_t stride, int32x4_t vidx) {
+    int32_t idx[4] ALIGN_NEON;
+    vst1q_s32(idx, vidx);
+    counts[idx[0]]++;
+    counts[stride + idx[1]]++;
+    counts[2 * stride + idx[2]]++;
+    counts[3 * stride + idx[3]]++;
+}
+
+
+/**
+ * dst[i] += src[i] (uint64)
+*/
+static inline void neon_hist_add_counts(uint64_t* dst, const uint64_t* src, size_t n) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        vst1q_u64(dst + i, vaddq_u64(vld1q_u64(dst + i), vld1q_u64(src + i)));
+    }
+    for (; i < n; i++) {
+        dst[i] += src[i];
+    }
+}
+
+
+
+// FIXED-EDGE HISTOGRAM
+typedef struct
+{
+    float lo;
+    float hi;
+    int32_t num_bins;
+    float scale; // num_bins / (hi - lo)
+    float bias; // -lo * scale
+    uint64_t* counts; // [NEON_HIST_COPIES * num_bins]
+    uint64_t total; // không tính NaN
+    uint64_t nan_count;
+    float min;
+    float max;
+} NeonHistogram;
+
+
+/**
+ * @return: NEON_SUCCESS hoặc error code
+*/
+static inline int neon_histogram_create(NeonHistogram* h, float lo, float hi, int32_t num_bins) {
+    if (h == NULL) return NEON_ERROR_NULL_POINTER;
+    if (num_bins <= 0) return NEON_ERROR_INVALID_SIZE;
+    if (!(hi > lo)) return NEON_ERROR_INVALID_PARAM;
+
+    size_t bytes = (size_t)NEON_HIST_COPIES * (size_t)num_bins * sizeof(uint64_t);
+    h->counts = (uint64_t*)neon_malloc(bytes);
+    if (h->counts == NULL) return NEON_ERROR_OUT_OF_MEMORY;
+    memset(h->counts, 0, bytes);
+
+    h->lo = lo;
+    h->hi = hi;
+    h->num_bins = num_bins;
+    h->scale = (float)num_bins / (hi - lo);
+    h->bias = -lo * h->scale;
+    h->total = 0;
+    h->nan_count = 0;
+    h->min = INFINITY;
+    h->max = -INFINITY;
+
+    return NEON_SUCCESS;
+}
+
+
+static inline void neon_histogram_destroy(NeonHistogram* h) {
+    if (h == NULL) return;
+
+    neon_free(h->counts);
+    h->counts = NULL;
+    h->num_bins = 0;
+}
+
+
+/**
+ * Xóa counts, giữ nguyên bin edges (dùng lại cho batch tiếp theo)
+*/
+static inline void neon_histogram_reset(NeonHistogram* h) {
+    memset(h->counts, 0, (size_t)NEON_HIST_COPIES * (size_t)h->num_bins * sizeof(uint64_t));
+    h->total = 0;
+    h->nan_count = 0;
+    h->min = INFINITY;
+    h->max = -INFINITY;
+}
+
+
+static NEON_INLINE int32_t neon_histogram_bin_scalar(const NeonHistogram* h, float x) {
+    float f = fmaf(x, h->scale, h->bias);
+    if (!(f > 0.0f)) return 0;
+    if (f >= (float)h->num_bins) return h->num_bins - 1;
+    return (int32_t)f;
+}
+
+
+/**
+ * Thêm n giá trị vào histogram
+*/
+static inline void neon_histogram_add_f32(NeonHistogram* h, const float* data, size_t n) {
+    const size_t stride = (size_t)h->num_bins;
+    const float32x4_t vscale = vdupq_n_f32(h->scale);
+    const float32x4_t vbias = vdupq_n_f32(h->bias);
+    const int32x4_t vzero = vdupq_n_s32(0);
+    const int32x4_t vlast = vdupq_n_s32(h->num_bins - 1);
+
+    float32x4_t vmin = vdupq_n_f32(h->min);
+    float32x4_t vmax = vdupq_n_f32(h->max);
+    uint64_t nans = 0;
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        NEON_PREFETCH(data + i + 64);
+
+        float32x4_t x0 = vld1q_f32(data + i);
+        float32x4_t x1 = vld1q_f32(data + i + 4);
+
+        // x == x false ↔ NaN
+        uint32x4_t ok = vandq_u32(vceqq_f32(x0, x0), vceqq_f32(x1, x1));
+        if (UNLIKELY(vminvq_u32(ok) == 0)) {
+            for (size_t j = i; j < i + 8; j++) {
+                float x = data[j];
+                if (x != x) {
+                    nans++;
+                    continue;
+                }
+                h->counts[neon_histogram_bin_scalar(h, x)]++;
+                vmin = vminq_f32(vmin, vdupq_n_f32(x));
+                vmax = vmaxq_f32(vmax, vdupq_n_f32(x));
+            }
+            continue;
+        }
+
+        // vcvtq_s32_f32 truncate về 0 và saturate (±inf → INT_MIN/INT_MAX), clamp sau đó
+        int32x4_t b0 = vcvtq_s32_f32(vfmaq_f32(vbias, x0, vscale));
+        int32x4_t b1 = vcvtq_s32_f32(vfmaq_f32(vbias, x1, vscale));
+        b0 = vminq_s32(vmaxq_s32(b0, vzero), vlast);
+        b1 = vminq_s32(vmaxq_s32(b1, vzero), vlast);
+
+        neon_hist_scatter4(h->counts, stride, b0);
+        neon_hist_scatter4(h->counts, stride, b1);
+
+        vmin = vminq_f32(vmin, vminq_f32(x0, x1));
+        vmax = vmaxq_f32(vmax, vmaxq_f32(x0, x1));
+    }
+
+    for (; i < n; i++) {
+        float x = data[i];
+        if (x != x) {
+            nans++;
+            continue;
+        }
+        h->counts[neon_histogram_bin_scalar(h, x)]++;
+        vmin = vminq_f32(vmin, vdupq_n_f32(x));
+        vmax = vmaxq_f32(vmax, vdupq_n_f32(x));
+    }
+
+    h->min = vminvq_f32(vmin);
+    h->max = vmaxvq_f32(vmax);
+    h->nan_count += nans;
+    h->total += (uint64_t)n - nans;
+}
+
+
+/**
+ * Count của bin b (cộng các copy)
+*/
+static NEON_INLINE uint64_t neon_histogram_count(const NeonHistogram* h, int32_t b) {
+    size_t stride = (size_t)h->num_bins;
+    return h->counts[b] + h->counts[stride + b] + h->counts[2 * stride + b] + h->counts[3 * stride + b];
+}
+
+
+/**
+ * Ghi counts đã cộng các copy ra out[num_bins]
+*/
+static inline void neon_histogram_counts(const NeonHistogram* h, uint64_t* out) {
+    size_t stride = (size_t)h->num_bins;
+    memcpy(out, h->counts, stride * sizeof(uint64_t));
+    for (int c = 1; c < NEON_HIST_COPIES; c++) {
+        neon_hist_add_counts(out, h->counts + c * stride, stride);
+    }
+}
+
+
+/**
+ * dst += src (cùng lo, hi, num_bins)
+ * @return: NEON_SUCCESS hoặc NEON_ERROR_INVALID_PARAM nếu bin edges khác nhau
+*/
+static inline int neon_histogram_merge(NeonHistogram* dst, const NeonHistogram* src) {
+    if (dst == NULL || src == NULL) return NEON_ERROR_NULL_POINTER;
+    if (dst->num_bins != src->num_bins || dst->lo != src->lo || dst->hi != src->hi) {
+        return NEON_ERROR_INVALID_PARAM;
+    }
+
+    neon_hist_add_counts(dst->counts, src->counts, (size_t)NEON_HIST_COPIES * (size_t)dst->num_bins);
+    dst->total += src->total;
+    dst->nan_count += src->nan_count;
+    dst->min = MIN(dst->min, src->min);
+    dst->max = MAX(dst->max, src->max);
+
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * Quantile q ∈ [0, 1], nội suy tuyến tính trong bin, kẹp vào [min, max] đã thấy
+ * @return: NAN nếu histogram rỗng
+*/
+static inline float neon_histogram_quantile(const NeonHistogram* h, float q) {
+    if (h->total == 0) return NAN;
+
+    q = CLAMP(q, 0.0f, 1.0f);
+    double rank = (double)q * (double)h->total;
+    double width = ((double)h->hi - (double)h->lo) / (double)h->num_bins;
+
+    uint64_t cum = 0;
+    for (int32_t b = 0; b < h->num_bins; b++) {
+        uint64_t c = neon_histogram_count(h, b);
+        if (c > 0 && (double)(cum + c) >= rank) {
+            double frac = (rank - (double)cum) / (double)c;
+            float v = (float)((double)h->lo + ((double)b + frac) * width);
+            return CLAMP(v, h->min, h->max);
+        }
+        cum += c;
+    }
+
+    return h->max;
+}
+
+
+
+// LOG-LINEAR QUANTILE SKETCH
+/**
+ * Cấu hình:
+ *   NEON_SKETCH_MANTISSA_BITS: số bit mantissa giữ lại (5 → 32 buckets / octave, ~1.6%)
+ *   |x| ∈ [2^-32, 2^32): buckets chính xác; nhỏ hơn → bucket gần 0, lớn hơn → bucket cuối
+ *
+ * Layout counts (tăng dần theo giá trị):
+ *   [0, B)   : âm, index = B - 1 - key(|x|)
+ *   [B, 2B)  : dương, index = B + key(|x|)
+*/
+#define NEON_SKETCH_MANTISSA_BITS 5
+#define NEON_SKETCH_SHIFT (23 - NEON_SKETCH_MANTISSA_BITS)
+#define NEON_SKETCH_KEY_MIN ((127u - 32u) << NEON_SKETCH_MANTISSA_BITS)
+#define NEON_SKETCH_KEYS (64u << NEON_SKETCH_MANTISSA_BITS)
+#define NEON_SKETCH_BINS (2 * NEON_SKETCH_KEYS)
+
+
+typedef struct
+{
+    uint64_t* counts; // [NEON_HIST_COPIES * NEON_SKETCH_BINS]
+    uint64_t total;
+    uint64_t nan_count;
+    float min;
+    float max;
+} NeonQuantileSketch;
+
+
+static inline int neon_quantile_sketch_create(NeonQuantileSketch* s) {
+    if (s == NULL) return NEON_ERROR_NULL_POINTER;
+
+    size_t bytes = (size_t)NEON_HIST_COPIES * NEON_SKETCH_BINS * sizeof(uint64_t);
+    s->counts = (uint64_t*)neon_malloc(bytes);
+    if (s->counts == NULL) return NEON_ERROR_OUT_OF_MEMORY;
+    memset(s->counts, 0, bytes);
+
+    s->total = 0;
+    s->nan_count = 0;
+    s->min = INFINITY;
+    s->max = -INFINITY;
+
+    return NEON_SUCCESS;
+}
+
+
+static inline void neon_quantile_sketch_destroy(NeonQuantileSketch* s) {
+    if (s == NULL) return;
+
+    neon_free(s->counts);
+    s->counts = NULL;
+}
+
+
+/**
+ * Bucket index của 4 giá trị (không NaN)
+*/
+static NEON_INLINE int32x4_t neon_sketch_index_f32x4(float32x4_t x) {
+    uint32x4_t bits = vreinterpretq_u32_f32(x);
+    uint32x4_t key = vshrq_n_u32(vandq_u32(bits, vdupq_n_u32(0x7FFFFFFF)), NEON_SKETCH_SHIFT);
+
+    key = vmaxq_u32(key, vdupq_n_u32(NEON_SKETCH_KEY_MIN));
+    key = vminq_u32(key, vdupq_n_u32(NEON_SKETCH_KEY_MIN + NEON_SKETCH_KEYS - 1));
+    key = vsubq_u32(key, vdupq_n_u32(NEON_SKETCH_KEY_MIN));
+
+    // Sign bit → nửa âm (đảo thứ tự) hoặc nửa dương
+    uint32x4_t neg = vcltq_s32(vreinterpretq_s32_u32(bits), vdupq_n_s32(0));
+    uint32x4_t idx_neg = vsubq_u32(vdupq_n_u32(NEON_SKETCH_KEYS - 1), key);
+    uint32x4_t idx_pos = vaddq_u32(vdupq_n_u32(NEON_SKETCH_KEYS), key);
+
+    return vreinterpretq_s32_u32(vbslq_u32(neg, idx_neg, idx_pos));
+}
+
+
+static NEON_INLINE int32_t neon_sketch_index_scalar(float x) {
+    return vgetq_lane_s32(neon_sketch_index_f32x4(vdupq_n_f32(x)), 0);
+}
+
+
+/**
+ * Giá trị đại diện của bucket: trung điểm khoảng [lower, upper) của key
+ * Bucket sát 0 (key = 0) đại diện bởi 0
+*/
+static inline float neon_sketch_bucket_value(int32_t index) {
+    int negative = index < (int32_t)NEON_SKETCH_KEYS;
+    uint32_t key = negative ? (NEON_SKETCH_KEYS - 1 - (uint32_t)index) : ((uint32_t)index - NEON_SKETCH_KEYS);
+    if (key == 0) return 0.0f;
+
+    uint32_t lo_bits = (key + NEON_SKETCH_KEY_MIN) << NEON_SKETCH_SHIFT;
+    uint32_t hi_bits = (key + NEON_SKETCH_KEY_MIN + 1) << NEON_SKETCH_SHIFT;
+    float lo, hi;
+    memcpy(&lo, &lo_bits, sizeof(float));
+    memcpy(&hi, &hi_bits, sizeof(float));
+
+    float mid = 0.5f * lo + 0.5f * hi;
+    return negative ? -mid : mid;
+}
+
+
+static inline void neon_quantile_sketch_add_f32(NeonQuantileSketch* s, const float* data, size_t n) {
+    const size_t stride = NEON_SKETCH_BINS;
+
+    float32x4_t vmin = vdupq_n_f32(s->min);
+    float32x4_t vmax = vdupq_n_f32(s->max);
+    uint64_t nans = 0;
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        NEON_PREFETCH(data + i + 64);
+
+        float32x4_t x0 = vld1q_f32(data + i);
+        float32x4_t x1 = vld1q_f32(data + i + 4);
+
+        uint32x4_t ok = vandq_u32(vceqq_f32(x0, x0), vceqq_f32(x1, x1));
+        if (UNLIKELY(vminvq_u32(ok) == 0)) {
+            for (size_t j = i; j < i + 8; j++) {
+                float x = data[j];
+                if (x != x) {
+                    nans++;
+                    continue;
+                }
+                s->counts[neon_sketch_index_scalar(x)]++;
+                vmin = vminq_f32(vmin, vdupq_n_f32(x));
+                vmax = vmaxq_f32(vmax, vdupq_n_f32(x));
+            }
+            continue;
+        }
+
+        neon_hist_scatter4(s->counts, stride, neon_sketch_index_f32x4(x0));
+        neon_hist_scatter4(s->counts, stride, neon_sketch_index_f32x4(x1));
+
+        vmin = vminq_f32(vmin, vminq_f32(x0, x1));
+        vmax = vmaxq_f32(vmax, vmaxq_f32(x0, x1));
+    }
+
+    for (; i < n; i++) {
+        float x = data[i];
+        if (x != x) {
+            nans++;
+            continue;
+        }
+        s->counts[neon_sketch_index_scalar(x)]++;
+        vmin = vminq_f32(vmin, vdupq_n_f32(x));
+        vmax = vmaxq_f32(vmax, vdupq_n_f32(x));
+    }
+
+    s->min = vminvq_f32(vmin);
+    s->max = vmaxvq_f32(vmax);
+    s->nan_count += nans;
+    s->total += (uint64_t)n - nans;
+}
+
+
+/**
+ * Feed sketch từ 1 histogram (per-batch histogram → sketch dài hạn)
+ * Mỗi bin được coi như count giá trị tại tâm bin (kẹp vào [min, max] của histogram)
+*/
+static inline void neon_quantile_sketch_add_histogram(NeonQuantileSketch* s, const NeonHistogram* h) {
+    if (h->total == 0) {
+        s->nan_count += h->nan_count;
+        return;
+    }
+
+    double width = ((double)h->hi - (double)h->lo) / (double)h->num_bins;
+
+    for (int32_t b = 0; b < h->num_bins; b++) {
+        uint64_t c = neon_histogram_count(h, b);
+        if (c == 0) continue;
+
+        float center = (float)((double)h->lo + ((double)b + 0.5) * width);
+        center = CLAMP(center, h->min, h->max);
+        s->counts[neon_sketch_index_scalar(center)] += c;
+    }
+
+    s->total += h->total;
+    s->nan_count += h->nan_count;
+    s->min = MIN(s->min, h->min);
+    s->max = MAX(s->max, h->max);
+}
+
+
+static inline int neon_quantile_sketch_merge(NeonQuantileSketch* dst, const NeonQuantileSketch* src) {
+    if (dst == NULL || src == NULL) return NEON_ERROR_NULL_POINTER;
+
+    neon_hist_add_counts(dst->counts, src->counts, (size_t)NEON_HIST_COPIES * NEON_SKETCH_BINS);
+    dst->total += src->total;
+    dst->nan_count += src->nan_count;
+    dst->min = MIN(dst->min, src->min);
+    dst->max = MAX(dst->max, src->max);
+
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * Quantiles (q tăng dần) trong 1 lần duyệt
+ * @param qs: [m] ∈ [0, 1], tăng dần
+ * @param out: [m], NAN nếu sketch rỗng
+*/
+static inline void neon_quantile_sketch_quantiles(
+    const NeonQuantileSketch* s,
+    const float* qs,
+    size_t m,
+    float* out
+) {
+    if (s->total == 0) {
+        for (size_t j = 0; j < m; j++) out[j] = NAN;
+        return;
+    }
+
+    const size_t stride = NEON_SKETCH_BINS;
+    uint64_t cum = 0;
+    size_t j = 0;
+
+    for (size_t b = 0; b < NEON_SKETCH_BINS && j < m; b++) {
+        uint64_t c = s->counts[b] + s->counts[stride + b] + s->counts[2 * stride + b] + s->counts[3 * stride + b];
+        if (c == 0) continue;
+        cum += c;
+
+        // rank (0-based) của q = q * (total - 1)
+        while (j < m && (double)CLAMP(qs[j], 0.0f, 1.0f) * (double)(s->total - 1) < (double)cum) {
+            // 2 bucket ngoài cùng gom cả giá trị |x| >= 2^32 → dùng min/max thật
+            float v = (b == 0) ? s->min : (b == NEON_SKETCH_BINS - 1) ? s->max : neon_sketch_bucket_value((int32_t)b);
+            out[j++] = CLAMP(v, s->min, s->max);
+        }
+    }
+
+    for (; j < m; j++) out[j] = s->max;
+}
+
+
+static inline float neon_quantile_sketch_quantile(const NeonQuantileSketch* s, float q) {
+    float v;
+    neon_quantile_sketch_quantiles(s, &q, 1, &v);
+    return v;
+}
+
+
+
+// PARALLEL (per-thread instance, merge ở cuối)
+typedef struct {
+    const float* data;
+    NeonHistogram* hists; // [num_threads], hists[0] = output
+    NeonQuantileSketch* sketches; // [num_threads], sketches[0] = output
+} NeonHistParallelCtx;
+
+
+static void neon_histogram_parallel_worker(void* arg, size_t begin, size_t end, int tid) {
+    NeonHistParallelCtx* ctx = (NeonHistParallelCtx*)arg;
+    neon_histogram_add_f32(&ctx->hists[tid], ctx->data + begin, end - begin);
+}
+
+
+static void neon_quantile_sketch_parallel_worker(void* arg, size_t begin, size_t end, int tid) {
+    NeonHistParallelCtx* ctx = (NeonHistParallelCtx*)arg;
+    neon_quantile_sketch_add_f32(&ctx->sketches[tid], ctx->data + begin, end - begin);
+}
+
+
+/**
+ * Thêm n giá trị vào h bằng nhiều thread (mỗi thread 1 histogram tạm, merge vào h)
+ * @return: NEON_SUCCESS hoặc error code
+*/
+static inline int neon_histogram_add_f32_parallel(NeonHistogram* h, const float* data, size_t n, int num_threads) {
+    if (h == NULL || data == NULL) return NEON_ERROR_NULL_POINTER;
+
+    // Merge tốn O(num_bins) mỗi thread → cần đủ dữ liệu mỗi thread
+    num_threads = neon_threads_for(n, num_threads, MAX((size_t)h->num_bins * 16, (size_t)65536));
+    if (num_threads <= 1) {
+        neon_histogram_add_f32(h, data, n);
+        return NEON_SUCCESS;
+    }
+
+    NeonHistogram hists[NEON_MAX_THREADS];
+    hists[0] = *h;
+
+    int t = 1;
+    for (; t < num_threads; t++) {
+        if (neon_histogram_create(&hists[t], h->lo, h->hi, h->num_bins) != NEON_SUCCESS) break;
+    }
+    if (t < num_threads) {
+        for (int i = 1; i < t; i++) neon_histogram_destroy(&hists[i]);
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    NeonHistParallelCtx ctx;
+    ctx.data = data;
+    ctx.hists = hists;
+    ctx.sketches = NULL;
+    neon_parallel_for(n, num_threads, neon_histogram_parallel_worker, &ctx);
+
+    for (t = 1; t < num_threads; t++) {
+        neon_histogram_merge(&hists[0], &hists[t]);
+        neon_histogram_destroy(&hists[t]);
+    }
+    *h = hists[0];
+
+    return NEON_SUCCESS;
+}
+
+
+static inline int neon_quantile_sketch_add_f32_parallel(NeonQuantileSketch* s, const float* data, size_t n, int num_threads) {
+    if (s == NULL || data == NULL) return NEON_ERROR_NULL_POINTER;
+
+    num_threads = neon_threads_for(n, num_threads, (size_t)NEON_SKETCH_BINS * 16);
+    if (num_threads <= 1) {
+        neon_quantile_sketch_add_f32(s, data, n);
+        return NEON_SUCCESS;
+    }
+
+    NeonQuantileSketch sketches[NEON_MAX_THREADS];
+    sketches[0] = *s;
+
+    int t = 1;
+    for (; t < num_threads; t++) {
+        if (neon_quantile_sketch_create(&sketches[t]) != NEON_SUCCESS) break;
+    }
+    if (t < num_threads) {
+        for (int i = 1; i < t; i++) neon_quantile_sketch_destroy(&sketches[i]);
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    NeonHistParallelCtx ctx;
+    ctx.data = data;
+    ctx.hists = NULL;
+    ctx.sketches = sketches;
+    neon_parallel_for(n, num_threads, neon_quantile_sketch_parallel_worker, &ctx);
+
+    for (t = 1; t < num_threads; t++) {
+        neon_quantile_sketch_merge(&sketches[0], &sketches[t]);
+        neon_quantile_sketch_destroy(&sketches[t]);
+    }
+    *s = sketches[0];
+
+    return NEON_SUCCESS;
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_HISTOGRAM_H
@@ -0,0 +1,886 @@
+#ifndef NEON_HNSW_H
+#define NEON_HNSW_H
+
+#include "neon_types.h"
+#include "memory_align.h"
+#include "neon_thread.h"
+#include "neon_distance.h"
+#include <math.h>
+#include <string.h>
+
+
+/**
+ * HNSW (Hierarchical Navigable Small World) APPROXIMATE NEAREST NEIGHBOR
+ *
+ * Brute force: n distance / query → không scale quá vài triệu vectors
+ * HNSW: đồ thị nhiều tầng, tầng trên thưa (nhảy xa), tầng 0 chứa mọi node
+ *   Search: greedy từ entry point xuống từng tầng, tầng 0 beam search với ef candidates
+ *   → ~ O(log n) distance / query, recall điều chỉnh bằng ef
+ *
+ * MEMORY LAYOUT (phần lớn thời gian là cache miss khi nhảy node):
+ *   vectors: stride bội của 16 floats → mỗi vector bắt đầu ở đầu cache line
+ *   links tầng 0: [count, id0, id1, ...] stride bội của 64 bytes, liền nhau theo node id
+ *   links tầng >= 1: mảng riêng cho số ít node có level > 0
+ *   Khi mở rộng 1 node: prefetch vector + visited tag của neighbor kế tiếp
+ *     trong lúc tính distance của neighbor hiện tại
+ *
+ * DISTANCE: neon_distance.h (L2² hoặc 1 - dot, 16 floats / vòng)
+ *
+ * BUILD MULTI-THREAD: mỗi thread insert 1 đoạn ids, lock theo node khi đọc / sửa links,
+ *   global lock chỉ khi node mới có level cao hơn max_level (đổi entry point)
+ *
+ * ĐO RECALL / QPS: tests/bench_hnsw.c
+ *   neon_knn_brute_force (neon_distance.h) làm ground truth, quét ef cho neon_hnsw_search_batch,
+ *   in recall@k (neon_hnsw_recall), QPS và tỉ lệ so với brute force
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define NEON_HNSW_MAX_LEVEL 16
+#define NEON_HNSW_MIN_PER_THREAD 256
+
+
+typedef struct
+{
+    float* key;
+    uint32_t* id;
+    size_t size;
+    size_t capacity;
+} NeonHnswHeap; // min-heap theo key
+
+
+typedef struct
+{
+    uint32_t* visited; // [capacity] tag = epoch khi đã thăm
+    uint32_t epoch;
+    NeonHnswHeap candidates; // key = dist (gần nhất ở top)
+    NeonHnswHeap results; // key = -dist (xa nhất ở top)
+    float* sorted_d; // kết quả search_layer tăng dần
+    uint32_t* sorted_id;
+    size_t sorted_size;
+    size_t sorted_capacity;
+    uint32_t* links; // bản copy neighbor list
+} NeonHnswScratch;
+
+
+typedef struct
+{
+    size_t dim;
+    size_t stride; // floats / vector
+    DistanceMetric metric;
+    size_t M; // max neighbors tầng >= 1
+    size_t M0; // max neighbors tầng 0 (= 2M)
+    size_t ef_construction;
+    size_t capacity;
+    size_t count;
+    float* vectors; // [capacity x stride]
+    uint32_t* links0; // [capacity x links0_stride]
+    size_t links0_stride; // uint32 / node
+    uint32_t** links_upper; // [capacity], tầng l >= 1 tại (l - 1) * (M + 1)
+    int8_t* levels;
+    int32_t entry_point; // -1 = rỗng
+    int max_level;
+    double level_mult;
+    uint64_t seed;
+#if NEON_HAS_PTHREAD
+    pthread_mutex_t* locks; // [capacity]
+    pthread_mutex_t global_lock;
+#endif
+} NeonHnsw;
+
+
+
+// HEAP
+static inline int neon_hnsw_heap_init(NeonHnswHeap* h, size_t capacity) {
+    h->key = (float*)neon_malloc(capacity * sizeof(float));
+    h->id = (uint32_t*)neon_malloc(capacity * sizeof(uint32_t));
+    h->size = 0;
+    h->capacity = capacity;
+    if (h->key == NULL || h->id == NULL) {
+        neon_free(h->key);
+        neon_free(h->id);
+        h->key = NULL;
+        h->id = NULL;
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+    return NEON_SUCCESS;
+}
+
+
+static inline void neon_hnsw_heap_free(NeonHnswHeap* h) {
+    neon_free(h->key);
+    neon_free(h->id);
+    h->key = NULL;
+    h->id = NULL;
+    h->size = 0;
+}
+
+
+static inline int neon_hnsw_heap_push(NeonHnswHeap* h, float key, uint32_t id) {
+    if (h->size == h->capacity) {
+        NeonHnswHeap bigger;
+        if (neon_hnsw_heap_init(&bigger, h->capacity * 2) != NEON_SUCCESS) return NEON_ERROR_OUT_OF_MEMORY;
+        memcpy(bigger.key, h->key, h->size * sizeof(float));
+        memcpy(bigger.id, h->id, h->size * sizeof(uint32_t));
+        bigger.size = h->size;
+        neon_hnsw_heap_free(h);
+        *h = bigger;
+    }
+
+    size_t pos = h->size++;
+    while (pos > 0) {
+        size_t parent = (pos - 1) / 2;
+        if (!(key < h->key[parent])) break;
+        h->key[pos] = h->key[parent];
+        h->id[pos] = h->id[parent];
+        pos = parent;
+    }
+    h->key[pos] = key;
+    h->id[pos] = id;
+    return NEON_SUCCESS;
+}
+
+
+static inline void neon_hnsw_heap_pop(NeonHnswHeap* h) {
+    float key = h->key[--h->size];
+    uint32_t id = h->id[h->size];
+    size_t n = h->size;
+    size_t pos = 0;
+
+    for (;;) {
+        size_t child = 2 * pos + 1;
+        if (child >= n) break;
+        if (child + 1 < n && h->key[child + 1] < h->key[child]) child++;
+        if (!(h->key[child] < key)) break;
+        h->key[pos] = h->key[child];
+        h->id[pos] = h->id[child];
+        pos = child;
+    }
+    if (n > 0) {
+        h->key[pos] = key;
+        h->id[pos] = id;
+    }
+}
+
+
+
+// NODE ACCESS
+static NEON_INLINE const float* neon_hnsw_vector(const NeonHnsw* h, uint32_t id) {
+    return h->vectors + (size_t)id * h->stride;
+}
+
+
+static NEON_INLINE uint32_t* neon_hnsw_links(const NeonHnsw* h, uint32_t id, int level) {
+    if (level == 0) return h->links0 + (size_t)id * h->links0_stride;
+    return h->links_upper[id] + (size_t)(level - 1) * (h->M + 1);
+}
+
+
+static NEON_INLINE void neon_hnsw_lock(NeonHnsw* h, uint32_t id) {
+#if NEON_HAS_PTHREAD
+    pthread_mutex_lock(&h->locks[id]);
+#else
+    (void)h;
+    (void)id;
+#endif
+}
+
+
+static NEON_INLINE void neon_hnsw_unlock(NeonHnsw* h, uint32_t id) {
+#if NEON_HAS_PTHREAD
+    pthread_mutex_unlock(&h->locks[id]);
+#else
+    (void)h;
+    (void)id;
+#endif
+}
+
+
+static NEON_INLINE float neon_hnsw_dist(const NeonHnsw* h, const float* q, uint32_t id) {
+    return neon_distance_f32(h->metric, q, neon_hnsw_vector(h, id), h->dim);
+}
+
+
+static NEON_INLINE void neon_hnsw_prefetch_node(const NeonHnsw* h, const NeonHnswScratch* s, uint32_t id) {
+    const float* v = neon_hnsw_vector(h, id);
+    NEON_PREFETCH(v);
+    NEON_PREFETCH(v + 16);
+    NEON_PREFETCH(&s->visited[id]);
+}
+
+
+
+// CREATE / DESTROY
+/**
+ * @param M: số neighbors mỗi tầng (12-48), tầng 0 dùng 2M
+ * @param ef_construction: beam width khi build (100-400)
+ * @param capacity: số vectors tối đa
+*/
+static inline int neon_hnsw_create(
+    NeonHnsw* h,
+    size_t dim,
+    DistanceMetric metric,
+    size_t M,
+    size_t ef_construction,
+    size_t capacity,
+    uint64_t seed
+) {
+    if (h == NULL) return NEON_ERROR_NULL_POINTER;
+    if (dim == 0 || capacity == 0 || capacity > 0x7FFFFFFF) return NEON_ERROR_INVALID_SIZE;
+    if (M < 2 || M > 256) return NEON_ERROR_INVALID_PARAM;
+
+    memset(h, 0, sizeof(*h));
+    h->dim = dim;
+    h->stride = (dim + 15) & ~(size_t)15;
+    h->metric = metric;
+    h->M = M;
+    h->M0 = 2 * M;
+    h->ef_construction = MAX(ef_construction, M);
+    h->capacity = capacity;
+    h->links0_stride = (1 + h->M0 + 15) & ~(size_t)15;
+    h->entry_point = -1;
+    h->max_level = -1;
+    h->level_mult = 1.0 / log((double)M);
+    h->seed = seed;
+
+    h->vectors = (float*)aligned_malloc(capacity * h->stride * sizeof(float), NEON_CACHE_LINE);
+    h->links0 = (uint32_t*)aligned_malloc(capacity * h->links0_stride * sizeof(uint32_t), NEON_CACHE_LINE);
+    h->links_upper = (uint32_t**)neon_malloc(capacity * sizeof(uint32_t*));
+    h->levels = (int8_t*)neon_malloc(capacity);
+#if NEON_HAS_PTHREAD
+    h->locks = (pthread_mutex_t*)neon_malloc(capacity * sizeof(pthread_mutex_t));
+#endif
+
+    if (h->vectors == NULL || h->links0 == NULL || h->links_upper == NULL || h->levels == NULL
+#if NEON_HAS_PTHREAD
+        || h->locks == NULL
+#endif
+    ) {
+        aligned_free(h->vectors);
+        aligned_free(h->links0);
+        neon_free(h->links_upper);
+        neon_free(h->levels);
+#if NEON_HAS_PTHREAD
+        neon_free(h->locks);
+#endif
+        memset(h, 0, sizeof(*h));
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    memset(h->links_upper, 0, capacity * sizeof(uint32_t*));
+#if NEON_HAS_PTHREAD
+    for (size_t i = 0; i < capacity; i++) pthread_mutex_init(&h->locks[i], NULL);
+    pthread_mutex_init(&h->global_lock, NULL);
+#endif
+
+    return NEON_SUCCESS;
+}
+
+
+static inline void neon_hnsw_destroy(NeonHnsw* h) {
+    if (h == NULL || h->vectors == NULL) return;
+
+    for (size_t i = 0; i < h->count; i++) {
+        neon_free(h->links_upper[i]);
+    }
+#if NEON_HAS_PTHREAD
+    for (size_t i = 0; i < h->capacity; i++) pthread_mutex_destroy(&h->locks[i]);
+    pthread_mutex_destroy(&h->global_lock);
+    neon_free(h->locks);
+#endif
+
+    aligned_free(h->vectors);
+    aligned_free(h->links0);
+    neon_free(h->links_upper);
+    neon_free(h->levels);
+    memset(h, 0, sizeof(*h));
+}
+
+
+/**
+ * Scratch cho 1 thread search / insert (không dùng chung giữa các threads)
+*/
+static inline int neon_hnsw_scratch_create(const NeonHnsw* h, NeonHnswScratch* s) {
+    if (h == NULL || s == NULL) return NEON_ERROR_NULL_POINTER;
+
+    memset(s, 0, sizeof(*s));
+    size_t cap = MAX(h->ef_construction, (size_t)64) + 1;
+
+    s->visited = (uint32_t*)neon_malloc(h->capacity * sizeof(uint32_t));
+    s->sorted_d = (float*)neon_malloc(cap * sizeof(float));
+    s->sorted_id = (uint32_t*)neon_malloc(cap * sizeof(uint32_t));
+    s->links = (uint32_t*)neon_malloc((h->M0 + 2) * sizeof(uint32_t));
+    int e1 = neon_hnsw_heap_init(&s->candidates, cap);
+    int e2 = neon_hnsw_heap_init(&s->results, cap);
+
+    if (s->visited == NULL || s->sorted_d == NULL || s->sorted_id == NULL || s->links == NULL
+        || e1 != NEON_SUCCESS || e2 != NEON_SUCCESS) {
+        neon_free(s->visited);
+        neon_free(s->sorted_d);
+        neon_free(s->sorted_id);
+        neon_free(s->links);
+        neon_hnsw_heap_free(&s->candidates);
+        neon_hnsw_heap_free(&s->results);
+        memset(s, 0, sizeof(*s));
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    memset(s->visited, 0, h->capacity * sizeof(uint32_t));
+    s->epoch = 0;
+    s->sorted_capacity = cap;
+    return NEON_SUCCESS;
+}
+
+
+static inline void neon_hnsw_scratch_destroy(NeonHnswScratch* s) {
+    if (s == NULL) return;
+
+    neon_free(s->visited);
+    neon_free(s->sorted_d);
+    neon_free(s->sorted_id);
+    neon_free(s->links);
+    neon_hnsw_heap_free(&s->candidates);
+    neon_hnsw_heap_free(&s->results);
+    memset(s, 0, sizeof(*s));
+}
+
+
+
+// SEARCH LAYER
+/**
+ * Copy neighbor list (có lock khi đang build song song)
+ * @return: số neighbors, ids trong s->links
+*/
+static inline size_t neon_hnsw_copy_links(NeonHnsw* h, NeonHnswScratch* s, uint32_t id, int level, int locked) {
+    if (locked) neon_hnsw_lock(h, id);
+
+    const uint32_t* links = neon_hnsw_links(h, id, level);
+    size_t n = links[0];
+    memcpy(s->links, links + 1, n * sizeof(uint32_t));
+
+    if (locked) neon_hnsw_unlock(h, id);
+    return n;
+}
+
+
+/**
+ * Greedy ở tầng cao: nhảy tới neighbor gần hơn cho tới khi không cải thiện được
+*/
+static inline uint32_t neon_hnsw_greedy(NeonHnsw* h, NeonHnswScratch* s, const float* q, uint32_t cur, int level, int locked) {
+    float cur_d = neon_hnsw_dist(h, q, cur);
+
+    for (int changed = 1; changed;) {
+        changed = 0;
+        size_t n = neon_hnsw_copy_links(h, s, cur, level, locked);
+
+        for (size_t j = 0; j < n; j++) {
+            if (j + 1 < n) NEON_PREFETCH(neon_hnsw_vector(h, s->links[j + 1]));
+
+            float d = neon_hnsw_dist(h, q, s->links[j]);
+            if (d < cur_d) {
+                cur_d = d;
+                cur = s->links[j];
+                changed = 1;
+            }
+        }
+    }
+
+    return cur;
+}
+
+
+/**
+ * Beam search tầng level từ entry, giữ ef kết quả gần nhất
+ * Kết quả tăng dần trong s->sorted_d / s->sorted_id (s->sorted_size)
+*/
+static inline int neon_hnsw_search_layer(
+    NeonHnsw* h,
+    NeonHnswScratch* s,
+    const float* q,
+    uint32_t entry,
+    size_t ef,
+    int level,
+    int locked
+) {
+    if (++s->epoch == 0) {
+        memset(s->visited, 0, h->capacity * sizeof(uint32_t));
+        s->epoch = 1;
+    }
+
+    NeonHnswHeap* cand = &s->candidates;
+    NeonHnswHeap* res = &s->results;
+    cand->size = 0;
+    res->size = 0;
+
+    float d0 = neon_hnsw_dist(h, q, entry);
+    s->visited[entry] = s->epoch;
+    if (neon_hnsw_heap_push(cand, d0, entry) != NEON_SUCCESS) return NEON_ERROR_OUT_OF_MEMORY;
+    if (neon_hnsw_heap_push(res, -d0, entry) != NEON_SUCCESS) return NEON_ERROR_OUT_OF_MEMORY;
+
+    while (cand->size > 0) {
+        float cd = cand->key[0];
+        uint32_t c = cand->id[0];
+        if (cd > -res->key[0] && res->size >= ef) break;
+        neon_hnsw_heap_pop(cand);
+
+        size_t n = neon_hnsw_copy_links(h, s, c, level, locked);
+        if (n > 0) neon_hnsw_prefetch_node(h, s, s->links[0]);
+
+        for (size_t j = 0; j < n; j++) {
+            uint32_t nb = s->links[j];
+            if (j + 1 < n) neon_hnsw_prefetch_node(h, s, s->links[j + 1]);
+
+            if (s->visited[nb] == s->epoch) continue;
+            s->visited[nb] = s->epoch;
+
+            float d = neon_hnsw_dist(h, q, nb);
+            if (res->size < ef || d < -res->key[0]) {
+                if (neon_hnsw_heap_push(cand, d, nb) != NEON_SUCCESS) return NEON_ERROR_OUT_OF_MEMORY;
+                if (neon_hnsw_heap_push(res, -d, nb) != NEON_SUCCESS) return NEON_ERROR_OUT_OF_MEMORY;
+                if (res->size > ef) neon_hnsw_heap_pop(res);
+            }
+        }
+    }
+
+    if (res->size > s->sorted_capacity) {
+        float* d = (float*)neon_malloc(res->size * sizeof(float));
+        uint32_t* ids = (uint32_t*)neon_malloc(res->size * sizeof(uint32_t));
+        if (d == NULL || ids == NULL) {
+            neon_free(d);
+            neon_free(ids);
+            return NEON_ERROR_OUT_OF_MEMORY;
+        }
+        neon_free(s->sorted_d);
+        neon_free(s->sorted_id);
+        s->sorted_d = d;
+        s->sorted_id = ids;
+        s->sorted_capacity = res->size;
+    }
+
+    // results pop ra xa nhất trước → ghi ngược để được tăng dần
+    s->sorted_size = res->size;
+    for (size_t i = res->size; i-- > 0;) {
+        s->sorted_d[i] = -res->key[0];
+        s->sorted_id[i] = res->id[0];
+        neon_hnsw_heap_pop(res);
+    }
+
+    return NEON_SUCCESS;
+}
+
+
+
+// NEIGHBOR SELECTION
+/**
+ * Heuristic: duyệt candidates tăng dần, giữ c nếu c gần q hơn mọi neighbor đã chọn
+ * (tránh dồn hết neighbors vào 1 cụm → đồ thị giữ được cạnh "đi xa")
+ *
+ * @param d, ids: [n] tăng dần, kết quả ghi đè lên đầu mảng
+ * @return: số neighbors giữ lại (<= max_n)
+*/
+static inline size_t neon_hnsw_select(const NeonHnsw* h, float* d, uint32_t* ids, size_t n, size_t max_n) {
+    size_t kept = 0;
+
+    for (size_t i = 0; i < n && kept < max_n; i++) {
+        const float* v = neon_hnsw_vector(h, ids[i]);
+        int good = 1;
+
+        for (size_t j = 0; j < kept; j++) {
+            if (neon_distance_f32(h->metric, v, neon_hnsw_vector(h, ids[j]), h->dim) < d[i]) {
+                good = 0;
+                break;
+            }
+        }
+
+        if (good) {
+            d[kept] = d[i];
+            ids[kept] = ids[i];
+            kept++;
+        }
+    }
+
+    return kept;
+}
+
+
+/**
+ * Thêm back-link id → node (đã lock node); đầy thì chọn lại bằng heuristic
+*/
+static inline void neon_hnsw_add_link(NeonHnsw* h, uint32_t node, uint32_t id, int level) {
+    uint32_t* links = neon_hnsw_links(h, node, level);
+    size_t max_n = (level == 0) ? h->M0 : h->M;
+    size_t n = links[0];
+
+    if (n < max_n) {
+        links[1 + n] = id;
+        links[0] = (uint32_t)(n + 1);
+        return;
+    }
+
+    // n + 1 candidates, sort tăng dần theo distance tới node (insertion sort, n nhỏ)
+    float d[2 * 256 + 1];
+    uint32_t ids[2 * 256 + 1];
+    const float* v = neon_hnsw_vector(h, node);
+
+    for (size_t i = 0; i <= n; i++) {
+        uint32_t c = (i < n) ? links[1 + i] : id;
+        float dc = neon_distance_f32(h->metric, v, neon_hnsw_vector(h, c), h->dim);
+
+        size_t pos = i;
+        while (pos > 0 && d[pos - 1] > dc) {
+            d[pos] = d[pos - 1];
+            ids[pos] = ids[pos - 1];
+            pos--;
+        }
+        d[pos] = dc;
+        ids[pos] = c;
+    }
+
+    size_t kept = neon_hnsw_select(h, d, ids, n + 1, max_n);
+    memcpy(links + 1, ids, kept * sizeof(uint32_t));
+    links[0] = (uint32_t)kept;
+}
+
+
+
+// INSERT
+static inline int neon_hnsw_random_level(const NeonHnsw* h, size_t id) {
+    uint64_t z = h->seed + (uint64_t)(id + 1) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+
+    double u = ((double)(z >> 11) + 1.0) * (1.0 / 9007199254740992.0); // (0, 1]
+    int level = (int)(-log(u) * h->level_mult);
+    return MIN(level, NEON_HNSW_MAX_LEVEL - 1);
+}
+
+
+/**
+ * Nối node id (vector + level đã có) vào đồ thị
+*/
+static inline int neon_hnsw_insert(NeonHnsw* h, NeonHnswScratch* s, uint32_t id) {
+    const float* q = neon_hnsw_vector(h, id);
+    int level = h->levels[id];
+
+#if NEON_HAS_PTHREAD
+    pthread_mutex_lock(&h->global_lock);
+#endif
+    int max_level = h->max_level;
+    int32_t entry = h->entry_point;
+
+    if (entry < 0) {
+        h->entry_point = (int32_t)id;
+        h->max_level = level;
+#if NEON_HAS_PTHREAD
+        pthread_mutex_unlock(&h->global_lock);
+#endif
+        return NEON_SUCCESS;
+    }
+
+    // Giữ global lock suốt quá trình nếu node này sẽ thành entry point mới
+    int hold_global = (level > max_level);
+#if NEON_HAS_PTHREAD
+    if (!hold_global) pthread_mutex_unlock(&h->global_lock);
+#endif
+
+    uint32_t cur = (uint32_t)entry;
+    for (int l = max_level; l > level; l--) {
+        cur = neon_hnsw_greedy(h, s, q, cur, l, 1);
+    }
+
+    int err = NEON_SUCCESS;
+    for (int l = MIN(level, max_level); l >= 0; l--) {
+        err = neon_hnsw_search_layer(h, s, q, cur, h->ef_construction, l, 1);
+        if (err != NEON_SUCCESS) break;
+
+        cur = s->sorted_id[0];
+        size_t kept = neon_hnsw_select(h, s->sorted_d, s->sorted_id, s->sorted_size, h->M);
+
+        neon_hnsw_lock(h, id);
+        uint32_t* links = neon_hnsw_links(h, id, l);
+        memcpy(links + 1, s->sorted_id, kept * sizeof(uint32_t));
+        links[0] = (uint32_t)kept;
+        neon_hnsw_unlock(h, id);
+
+        for (size_t i = 0; i < kept; i++) {
+            uint32_t nb = s->sorted_id[i];
+            neon_hnsw_lock(h, nb);
+            neon_hnsw_add_link(h, nb, id, l);
+            neon_hnsw_unlock(h, nb);
+        }
+    }
+
+    if (hold_global) {
+        h->entry_point = (int32_t)id;
+        h->max_level = level;
+#if NEON_HAS_PTHREAD
+        pthread_mutex_unlock(&h->global_lock);
+#endif
+    }
+
+    return err;
+}
+
+
+typedef struct {
+    NeonHnsw* h;
+    NeonHnswScratch* scratch; // [num_threads]
+    size_t first;
+    int error[NEON_MAX_THREADS];
+} NeonHnswBuildCtx;
+
+
+static void neon_hnsw_build_worker(void* arg, size_t begin, size_t end, int tid) {
+    NeonHnswBuildCtx* ctx = (NeonHnswBuildCtx*)arg;
+
+    for (size_t i = begin; i < end; i++) {
+        int err = neon_hnsw_insert(ctx->h, &ctx->scratch[tid], (uint32_t)(ctx->first + i));
+        if (err != NEON_SUCCESS) ctx->error[tid] = err;
+    }
+}
+
+
+/**
+ * Thêm data [n x dim], id = thứ tự thêm vào
+*/
+static inline int neon_hnsw_add(NeonHnsw* h, const float* data, size_t n, int num_threads) {
+    if (h == NULL || data == NULL) return NEON_ERROR_NULL_POINTER;
+    if (h->count + n > h->capacity) return NEON_ERROR_INVALID_SIZE;
+    if (n == 0) return NEON_SUCCESS;
+
+    size_t first = h->count;
+
+    // Copy vectors + cấp phát links trước → các thread chỉ còn sửa links
+    for (size_t i = 0; i < n; i++) {
+        size_t id = first + i;
+        float* v = h->vectors + id * h->stride;
+        memcpy(v, data + i * h->dim, h->dim * sizeof(float));
+        memset(v + h->dim, 0, (h->stride - h->dim) * sizeof(float));
+
+        int level = neon_hnsw_random_level(h, id);
+        h->levels[id] = (int8_t)level;
+        h->links0[id * h->links0_stride] = 0;
+
+        if (level > 0) {
+            size_t words = (size_t)level * (h->M + 1);
+            h->links_upper[id] = (uint32_t*)neon_malloc(words * sizeof(uint32_t));
+            if (h->links_upper[id] == NULL) {
+                for (size_t j = first; j <= id; j++) {
+                    neon_free(h->links_upper[j]);
+                    h->links_upper[j] = NULL;
+                }
+                return NEON_ERROR_OUT_OF_MEMORY;
+            }
+            for (int l = 0; l < level; l++) h->links_upper[id][(size_t)l * (h->M + 1)] = 0;
+        }
+    }
+    h->count = first + n;
+
+    num_threads = neon_threads_for(n, num_threads, NEON_HNSW_MIN_PER_THREAD);
+
+    NeonHnswScratch scratch[NEON_MAX_THREADS];
+    int err = NEON_SUCCESS;
+    int created = 0;
+    for (; created < num_threads; created++) {
+        err = neon_hnsw_scratch_create(h, &scratch[created]);
+        if (err != NEON_SUCCESS) break;
+    }
+
+    if (err == NEON_SUCCESS) {
+        NeonHnswBuildCtx ctx;
+        ctx.h = h;
+        ctx.scratch = scratch;
+        ctx.first = first;
+        memset(ctx.error, 0, sizeof(ctx.error));
+
+        // Node đầu tiên chạy tuần tự để có entry point trước khi chia threads
+        size_t start = 0;
+        if (h->entry_point < 0) {
+            neon_hnsw_build_worker(&ctx, 0, 1, 0);
+            start = 1;
+        }
+
+        ctx.first = first + start;
+        neon_parallel_for(n - start, num_threads, neon_hnsw_build_worker, &ctx);
+        for (int t = 0; t < num_threads && err == NEON_SUCCESS; t++) err = ctx.error[t];
+    }
+
+    for (int t = 0; t < created; t++) {
+        neon_hnsw_scratch_destroy(&scratch[t]);
+    }
+    return err;
+}
+
+
+
+// SEARCH
+/**
+ * k vectors gần query nhất
+ *
+ * @param scratch: NULL = tự cấp phát (chậm hơn khi gọi nhiều lần)
+ * @param ef: beam width (>= k, lớn hơn = recall cao hơn)
+ * @param out_dist: [k] tăng dần
+ * @param out_count: số kết quả (<= k)
+*/
+static inline int neon_hnsw_search(
+    const NeonHnsw* h,
+    NeonHnswScratch* scratch,
+    const float* query,
+    size_t k,
+    size_t ef,
+    float* out_dist,
+    int32_t* out_ids,
+    size_t* out_count
+) {
+    if (h == NULL || query == NULL || out_dist == NULL || out_ids == NULL || out_count == NULL) {
+        return NEON_ERROR_NULL_POINTER;
+    }
+
+    *out_count = 0;
+    if (h->entry_point < 0 || k == 0) return NEON_SUCCESS;
+
+    NeonHnswScratch local;
+    NeonHnswScratch* s = scratch;
+    if (s == NULL) {
+        int err = neon_hnsw_scratch_create(h, &local);
+        if (err != NEON_SUCCESS) return err;
+        s = &local;
+    }
+
+    // Search không sửa index, bỏ const để dùng chung hàm với build (locked = 0)
+    NeonHnsw* hm = (NeonHnsw*)h;
+    uint32_t cur = (uint32_t)h->entry_point;
+    for (int l = h->max_level; l > 0; l--) {
+        cur = neon_hnsw_greedy(hm, s, query, cur, l, 0);
+    }
+
+    int err = neon_hnsw_search_layer(hm, s, query, cur, MAX(ef, k), 0, 0);
+    if (err == NEON_SUCCESS) {
+        size_t count = MIN(k, s->sorted_size);
+        for (size_t i = 0; i < count; i++) {
+            out_dist[i] = s->sorted_d[i];
+            out_ids[i] = (int32_t)s->sorted_id[i];
+        }
+        *out_count = count;
+    }
+
+    if (s == &local) neon_hnsw_scratch_destroy(&local);
+    return err;
+}
+
+
+typedef struct {
+    const NeonHnsw* h;
+    NeonHnswScratch* scratch;
+    const float* queries;
+    size_t k;
+    size_t ef;
+    float* out_dist;
+    int32_t* out_ids;
+    int error[NEON_MAX_THREADS];
+} NeonHnswBatchCtx;
+
+
+static void neon_hnsw_batch_worker(void* arg, size_t begin, size_t end, int tid) {
+    NeonHnswBatchCtx* ctx = (NeonHnswBatchCtx*)arg;
+
+    for (size_t i = begin; i < end; i++) {
+        size_t count;
+        float* d = ctx->out_dist + i * ctx->k;
+        int32_t* ids = ctx->out_ids + i * ctx->k;
+
+        int err = neon_hnsw_search(ctx->h, &ctx->scratch[tid], ctx->queries + i * ctx->h->dim,
+                                   ctx->k, ctx->ef, d, ids, &count);
+        if (err != NEON_SUCCESS) ctx->error[tid] = err;
+
+        for (size_t j = count; j < ctx->k; j++) {
+            d[j] = INFINITY;
+            ids[j] = -1;
+        }
+    }
+}
+
+
+/**
+ * Search nq queries song song
+ * @param out_dist, out_ids: [nq x k], thiếu kết quả → id = -1
+*/
+static inline int neon_hnsw_search_batch(
+    const NeonHnsw* h,
+    const float* queries,
+    size_t nq,
+    size_t k,
+    size_t ef,
+    float* out_dist,
+    int32_t* out_ids,
+    int num_threads
+) {
+    if (h == NULL || queries == NULL || out_dist == NULL || out_ids == NULL) return NEON_ERROR_NULL_POINTER;
+    if (nq == 0 || k == 0) return NEON_SUCCESS;
+
+    num_threads = neon_threads_for(nq, num_threads, 4);
+
+    NeonHnswScratch scratch[NEON_MAX_THREADS];
+    int err = NEON_SUCCESS;
+    int created = 0;
+    for (; created < num_threads; created++) {
+        err = neon_hnsw_scratch_create(h, &scratch[created]);
+        if (err != NEON_SUCCESS) break;
+    }
+
+    if (err == NEON_SUCCESS) {
+        NeonHnswBatchCtx ctx;
+        ctx.h = h;
+        ctx.scratch = scratch;
+        ctx.queries = queries;
+        ctx.k = k;
+        ctx.ef = ef;
+        ctx.out_dist = out_dist;
+        ctx.out_ids = out_ids;
+        memset(ctx.error, 0, sizeof(ctx.error));
+
+        neon_parallel_for(nq, num_threads, neon_hnsw_batch_worker, &ctx);
+        for (int t = 0; t < num_threads && err == NEON_SUCCESS; t++) err = ctx.error[t];
+    }
+
+    for (int t = 0; t < created; t++) {
+        neon_hnsw_scratch_destroy(&scratch[t]);
+    }
+    return err;
+}
+
+
+/**
+ * Recall@k: tỉ lệ ids exact (brute force) có trong kết quả approx
+ * @param approx, exact: [nq x k]
+*/
+static inline float neon_hnsw_recall(const int32_t* approx, const int32_t* exact, size_t nq, size_t k) {
+    if (nq == 0 || k == 0) return 0.0f;
+
+    size_t hits = 0;
+    for (size_t q = 0; q < nq; q++) {
+        const int32_t* a = approx + q * k;
+        const int32_t* e = exact + q * k;
+        for (size_t i = 0; i < k; i++) {
+            for (size_t j = 0; j < k; j++) {
+                if (e[i] >= 0 && a[j] == e[i]) {
+                    hits++;
+                    break;
+                }
+            }
+        }
+    }
+
+    return (float)hits / (float)(nq * k);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_HNSW_H
@@ -0,0 +1,611 @@
+#ifndef NEON_KMEANS_H
+#define NEON_KMEANS_H
+
+#include "neon_types.h"
+#include "memory_align.h"
+#include "neon_thread.h"
+#include "neon_distance.h"
+#include <math.h>
+#include <string.h>
+
+
+/**
+ * K-MEANS (PQ codebooks, dedup, segmentation)
+ *
+ * ASSIGNMENT (phần tốn nhất: n x k distances mỗi iteration):
+ *   ||x - c||² = ||x||² - 2 x·c + ||c||²  → argmin chỉ cần ||c||² - 2 x·c
+ *   → bài toán thành GEMM X * C^T, tính theo register block 4 points x 4 centroids:
+ *     16 accumulators float32x4, mỗi 4 dims: 8 loads cho 16 FMAs (thay vì 2 loads / FMA)
+ *   Tile 64 points x 128 centroids để centroids tile nằm trong L1/L2 khi k lớn
+ *
+ * UPDATE: mỗi thread cộng dồn sums [k x dim] + counts [k] riêng (không lock, không atomic),
+ *   cùng 1 lần đọc data với assignment, cuối iteration cộng các threads lại
+ *   Cluster rỗng → lấy point xa centroid của nó nhất
+ *
+ * INIT: k-means++ (D² sampling), cập nhật min distance song song
+ *
+ * MINI-BATCH (n rất lớn): mỗi bước b samples ngẫu nhiên,
+ *   c += (x - c) / count(c) → hội tụ gần Lloyd với chi phí O(b * k) / bước
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define NEON_KMEANS_POINT_TILE 64
+#define NEON_KMEANS_CENTROID_TILE 128
+#define NEON_KMEANS_MIN_PER_THREAD 1024
+
+
+typedef struct
+{
+    float* centroids; // [k x dim]
+    float* norms; // [k] ||c||²
+    size_t k;
+    size_t dim;
+    double inertia; // Σ ||x - c(x)||² sau lần fit cuối
+    int iterations; // số iterations đã chạy
+} NeonKMeans;
+
+
+
+// HELPERS
+static NEON_INLINE uint64_t neon_kmeans_rand(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+
+/**
+ * Uniform [0, 1)
+*/
+static NEON_INLINE double neon_kmeans_uniform(uint64_t* state) {
+    return (double)(neon_kmeans_rand(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+
+static inline void neon_kmeans_update_norms(NeonKMeans* km) {
+    for (size_t c = 0; c < km->k; c++) {
+        km->norms[c] = neon_norm_sq_f32(km->centroids + c * km->dim, km->dim);
+    }
+}
+
+
+/**
+ * out[r * 4 + s] = x_r · c_s, 4 points x 4 centroids
+*/
+static inline void neon_kmeans_dot_4x4(
+    const float* x,
+    const float* c,
+    size_t dim,
+    float* out
+) {
+    const float* x0 = x;
+    const float* x1 = x + dim;
+    const float* x2 = x + 2 * dim;
+    const float* x3 = x + 3 * dim;
+    const float* c0 = c;
+    const float* c1 = c + dim;
+    const float* c2 = c + 2 * dim;
+    const float* c3 = c + 3 * dim;
+
+    float32x4_t a00 = vdupq_n_f32(0.0f), a01 = vdupq_n_f32(0.0f), a02 = vdupq_n_f32(0.0f), a03 = vdupq_n_f32(0.0f);
+    float32x4_t a10 = vdupq_n_f32(0.0f), a11 = vdupq_n_f32(0.0f), a12 = vdupq_n_f32(0.0f), a13 = vdupq_n_f32(0.0f);
+    float32x4_t a20 = vdupq_n_f32(0.0f), a21 = vdupq_n_f32(0.0f), a22 = vdupq_n_f32(0.0f), a23 = vdupq_n_f32(0.0f);
+    float32x4_t a30 = vdupq_n_f32(0.0f), a31 = vdupq_n_f32(0.0f), a32 = vdupq_n_f32(0.0f), a33 = vdupq_n_f32(0.0f);
+
+    size_t j = 0;
+    for (; j + 4 <= dim; j += 4) {
+        float32x4_t vx0 = vld1q_f32(x0 + j), vx1 = vld1q_f32(x1 + j);
+        float32x4_t vx2 = vld1q_f32(x2 + j), vx3 = vld1q_f32(x3 + j);
+        float32x4_t vc0 = vld1q_f32(c0 + j), vc1 = vld1q_f32(c1 + j);
+        float32x4_t vc2 = vld1q_f32(c2 + j), vc3 = vld1q_f32(c3 + j);
+
+        a00 = vfmaq_f32(a00, vx0, vc0); a01 = vfmaq_f32(a01, vx0, vc1);
+        a02 = vfmaq_f32(a02, vx0, vc2); a03 = vfmaq_f32(a03, vx0, vc3);
+        a10 = vfmaq_f32(a10, vx1, vc0); a11 = vfmaq_f32(a11, vx1, vc1);
+        a12 = vfmaq_f32(a12, vx1, vc2); a13 = vfmaq_f32(a13, vx1, vc3);
+        a20 = vfmaq_f32(a20, vx2, vc0); a21 = vfmaq_f32(a21, vx2, vc1);
+        a22 = vfmaq_f32(a22, vx2, vc2); a23 = vfmaq_f32(a23, vx2, vc3);
+        a30 = vfmaq_f32(a30, vx3, vc0); a31 = vfmaq_f32(a31, vx3, vc1);
+        a32 = vfmaq_f32(a32, vx3, vc2); a33 = vfmaq_f32(a33, vx3, vc3);
+    }
+
+    out[0] = vaddvq_f32(a00); out[1] = vaddvq_f32(a01); out[2] = vaddvq_f32(a02); out[3] = vaddvq_f32(a03);
+    out[4] = vaddvq_f32(a10); out[5] = vaddvq_f32(a11); out[6] = vaddvq_f32(a12); out[7] = vaddvq_f32(a13);
+    out[8] = vaddvq_f32(a20); out[9] = vaddvq_f32(a21); out[10] = vaddvq_f32(a22); out[11] = vaddvq_f32(a23);
+    out[12] = vaddvq_f32(a30); out[13] = vaddvq_f32(a31); out[14] = vaddvq_f32(a32); out[15] = vaddvq_f32(a33);
+
+    for (; j < dim; j++) {
+        for (int r = 0; r < 4; r++) {
+            for (int s = 0; s < 4; s++) {
+                out[r * 4 + s] += x[r * dim + j] * c[s * dim + j];
+            }
+        }
+    }
+}
+
+
+/**
+ * Centroid gần nhất cho points [0, np) (np <= NEON_KMEANS_POINT_TILE)
+ * @param dists: ||x - c||² (clamp >= 0)
+*/
+static inline void neon_kmeans_assign_tile(
+    const NeonKMeans* km,
+    const float* x,
+    size_t np,
+    int32_t* labels,
+    float* dists
+) {
+    const size_t dim = km->dim;
+    const size_t k = km->k;
+    float best[NEON_KMEANS_POINT_TILE];
+    int32_t best_idx[NEON_KMEANS_POINT_TILE];
+    float dots[16];
+
+    for (size_t p = 0; p < np; p++) {
+        best[p] = INFINITY;
+        best_idx[p] = 0;
+    }
+
+    for (size_t c0 = 0; c0 < k; c0 += NEON_KMEANS_CENTROID_TILE) {
+        size_t c1 = MIN(c0 + NEON_KMEANS_CENTROID_TILE, k);
+
+        size_t p = 0;
+        for (; p + 4 <= np; p += 4) {
+            size_t c = c0;
+            for (; c + 4 <= c1; c += 4) {
+                neon_kmeans_dot_4x4(x + p * dim, km->centroids + c * dim, dim, dots);
+                for (int r = 0; r < 4; r++) {
+                    for (int s = 0; s < 4; s++) {
+                        float score = km->norms[c + s] - 2.0f * dots[r * 4 + s];
+                        if (score < best[p + r]) {
+                            best[p + r] = score;
+                            best_idx[p + r] = (int32_t)(c + s);
+                        }
+                    }
+                }
+            }
+            for (; c < c1; c++) {
+                for (int r = 0; r < 4; r++) {
+                    float score = km->norms[c] - 2.0f * neon_inner_product_f32(x + (p + r) * dim, km->centroids + c * dim, dim);
+                    if (score < best[p + r]) {
+                        best[p + r] = score;
+                        best_idx[p + r] = (int32_t)c;
+                    }
+                }
+            }
+        }
+        for (; p < np; p++) {
+            for (size_t c = c0; c < c1; c++) {
+                float score = km->norms[c] - 2.0f * neon_inner_product_f32(x + p * dim, km->centroids + c * dim, dim);
+                if (score < best[p]) {
+                    best[p] = score;
+                    best_idx[p] = (int32_t)c;
+                }
+            }
+        }
+    }
+
+    for (size_t p = 0; p < np; p++) {
+        labels[p] = best_idx[p];
+        if (dists != NULL) {
+            dists[p] = MAX(best[p] + neon_norm_sq_f32(x + p * dim, dim), 0.0f);
+        }
+    }
+}
+
+
+
+// CREATE / DESTROY
+static inline int neon_kmeans_create(NeonKMeans* km, size_t k, size_t dim) {
+    if (km == NULL) return NEON_ERROR_NULL_POINTER;
+    if (k == 0 || dim == 0 || k > 0x7FFFFFFF) return NEON_ERROR_INVALID_SIZE;
+
+    km->centroids = (float*)neon_malloc(k * dim * sizeof(float));
+    km->norms = (float*)neon_malloc(k * sizeof(float));
+    if (km->centroids == NULL || km->norms == NULL) {
+        neon_free(km->centroids);
+        neon_free(km->norms);
+        km->centroids = NULL;
+        km->norms = NULL;
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    memset(km->centroids, 0, k * dim * sizeof(float));
+    memset(km->norms, 0, k * sizeof(float));
+    km->k = k;
+    km->dim = dim;
+    km->inertia = 0.0;
+    km->iterations = 0;
+    return NEON_SUCCESS;
+}
+
+
+static inline void neon_kmeans_destroy(NeonKMeans* km) {
+    if (km == NULL) return;
+
+    neon_free(km->centroids);
+    neon_free(km->norms);
+    km->centroids = NULL;
+    km->norms = NULL;
+    km->k = 0;
+}
+
+
+
+// ASSIGNMENT (+ ACCUMULATE)
+typedef struct {
+    const NeonKMeans* km;
+    const float* data;
+    int32_t* labels;
+    float* dists;
+    float* sums; // [num_threads x k x dim], NULL = chỉ assign
+    size_t* counts; // [num_threads x k]
+    double* inertia; // [num_threads]
+} NeonKMeansAssignCtx;
+
+
+static void neon_kmeans_assign_worker(void* arg, size_t begin, size_t end, int tid) {
+    NeonKMeansAssignCtx* ctx = (NeonKMeansAssignCtx*)arg;
+    const NeonKMeans* km = ctx->km;
+    const size_t dim = km->dim;
+    double inertia = 0.0;
+
+    for (size_t p = begin; p < end; p += NEON_KMEANS_POINT_TILE) {
+        size_t np = MIN((size_t)NEON_KMEANS_POINT_TILE, end - p);
+        neon_kmeans_assign_tile(km, ctx->data + p * dim, np, ctx->labels + p, ctx->dists + p);
+
+        for (size_t i = p; i < p + np; i++) {
+            inertia += ctx->dists[i];
+        }
+
+        if (ctx->sums == NULL) continue;
+
+        float* sums = ctx->sums + (size_t)tid * km->k * dim;
+        size_t* counts = ctx->counts + (size_t)tid * km->k;
+        for (size_t i = p; i < p + np; i++) {
+            const float* x = ctx->data + i * dim;
+            float* s = sums + (size_t)ctx->labels[i] * dim;
+            size_t j = 0;
+            for (; j + 4 <= dim; j += 4) {
+                vst1q_f32(s + j, vaddq_f32(vld1q_f32(s + j), vld1q_f32(x + j)));
+            }
+            for (; j < dim; j++) s[j] += x[j];
+            counts[ctx->labels[i]]++;
+        }
+    }
+
+    ctx->inertia[tid] += inertia;
+}
+
+
+/**
+ * labels[i] = centroid gần nhất của data[i], dists[i] = ||x - c||² (dists có thể NULL)
+ * @return: NEON_SUCCESS hoặc error code
+*/
+static inline int neon_kmeans_assign(
+    const NeonKMeans* km,
+    const float* data,
+    size_t n,
+    int32_t* labels,
+    float* dists,
+    int num_threads
+) {
+    if (km == NULL || data == NULL || labels == NULL) return NEON_ERROR_NULL_POINTER;
+    if (n == 0) return NEON_SUCCESS;
+
+    float* tmp = NULL;
+    if (dists == NULL) {
+        tmp = (float*)neon_malloc(n * sizeof(float));
+        if (tmp == NULL) return NEON_ERROR_OUT_OF_MEMORY;
+        dists = tmp;
+    }
+
+    double inertia[NEON_MAX_THREADS] = {0};
+    NeonKMeansAssignCtx ctx;
+    ctx.km = km;
+    ctx.data = data;
+    ctx.labels = labels;
+    ctx.dists = dists;
+    ctx.sums = NULL;
+    ctx.counts = NULL;
+    ctx.inertia = inertia;
+
+    num_threads = neon_threads_for(n, num_threads, NEON_KMEANS_MIN_PER_THREAD);
+    neon_parallel_for(n, num_threads, neon_kmeans_assign_worker, &ctx);
+
+    neon_free(tmp);
+    return NEON_SUCCESS;
+}
+
+
+
+// K-MEANS++ INIT
+typedef struct {
+    const float* data;
+    const float* centroid;
+    size_t dim;
+    float* min_d;
+} NeonKMeansPPCtx;
+
+
+static void neon_kmeans_pp_worker(void* arg, size_t begin, size_t end, int tid) {
+    (void)tid;
+    NeonKMeansPPCtx* ctx = (NeonKMeansPPCtx*)arg;
+
+    for (size_t i = begin; i < end; i++) {
+        float d = neon_l2_sq_f32(ctx->data + i * ctx->dim, ctx->centroid, ctx->dim);
+        if (d < ctx->min_d[i]) ctx->min_d[i] = d;
+    }
+}
+
+
+/**
+ * k-means++: centroid tiếp theo chọn với xác suất tỉ lệ D(x)² tới centroid gần nhất
+*/
+static inline int neon_kmeans_init_plusplus(NeonKMeans* km, const float* data, size_t n, uint64_t seed, int num_threads) {
+    if (km == NULL || data == NULL) return NEON_ERROR_NULL_POINTER;
+    if (n < km->k) return NEON_ERROR_INVALID_SIZE;
+
+    float* min_d = (float*)neon_malloc(n * sizeof(float));
+    if (min_d == NULL) return NEON_ERROR_OUT_OF_MEMORY;
+
+    const size_t dim = km->dim;
+    uint64_t rng = seed;
+    for (size_t i = 0; i < n; i++) min_d[i] = INFINITY;
+
+    NeonKMeansPPCtx ctx;
+    ctx.data = data;
+    ctx.dim = dim;
+    ctx.min_d = min_d;
+    num_threads = neon_threads_for(n, num_threads, NEON_KMEANS_MIN_PER_THREAD);
+
+    size_t pick = (size_t)(neon_kmeans_rand(&rng) % n);
+    for (size_t c = 0; c < km->k; c++) {
+        if (c > 0) {
+            double total = 0.0;
+            for (size_t i = 0; i < n; i++) total += min_d[i];
+
+            if (total > 0.0) {
+                double r = neon_kmeans_uniform(&rng) * total;
+                pick = n - 1;
+                for (size_t i = 0; i < n; i++) {
+                    r -= min_d[i];
+                    if (r < 0.0) {
+                        pick = i;
+                        break;
+                    }
+                }
+            } else {
+                pick = (size_t)(neon_kmeans_rand(&rng) % n); // mọi điểm trùng centroid
+            }
+        }
+
+        float* cent = km->centroids + c * dim;
+        memcpy(cent, data + pick * dim, dim * sizeof(float));
+
+        ctx.centroid = cent;
+        neon_parallel_for(n, num_threads, neon_kmeans_pp_worker, &ctx);
+    }
+
+    neon_kmeans_update_norms(km);
+    neon_free(min_d);
+    return NEON_SUCCESS;
+}
+
+
+
+// LLOYD
+/**
+ * Cluster rỗng: đặt centroid = point xa nhất (dists[i] = 0 sau khi dùng để không chọn lại)
+*/
+static inline void neon_kmeans_fix_empty(NeonKMeans* km, const float* data, size_t n, const size_t* counts, float* dists) {
+    for (size_t c = 0; c < km->k; c++) {
+        if (counts[c] > 0) continue;
+
+        size_t far = 0;
+        for (size_t i = 1; i < n; i++) {
+            if (dists[i] > dists[far]) far = i;
+        }
+        memcpy(km->centroids + c * km->dim, data + far * km->dim, km->dim * sizeof(float));
+        dists[far] = 0.0f;
+    }
+}
+
+
+/**
+ * Lloyd k-means trên data [n x dim] (k-means++ init)
+ *
+ * @param max_iter: số iterations tối đa
+ * @param tol: dừng khi inertia giảm < tol (tương đối)
+ * @param labels: [n] output, có thể NULL
+*/
+static inline int neon_kmeans_fit(
+    NeonKMeans* km,
+    const float* data,
+    size_t n,
+    int max_iter,
+    float tol,
+    uint64_t seed,
+    int32_t* labels,
+    int num_threads
+) {
+    if (km == NULL || data == NULL) return NEON_ERROR_NULL_POINTER;
+    if (n < km->k) return NEON_ERROR_INVALID_SIZE;
+
+    int err = neon_kmeans_init_plusplus(km, data, n, seed, num_threads);
+    if (err != NEON_SUCCESS) return err;
+
+    const size_t k = km->k;
+    const size_t dim = km->dim;
+    num_threads = neon_threads_for(n, num_threads, NEON_KMEANS_MIN_PER_THREAD);
+
+    int32_t* lab = (int32_t*)neon_malloc(n * sizeof(int32_t));
+    float* dists = (float*)neon_malloc(n * sizeof(float));
+    float* sums = (float*)neon_malloc((size_t)num_threads * k * dim * sizeof(float));
+    size_t* counts = (size_t*)neon_malloc((size_t)num_threads * k * sizeof(size_t));
+
+    if (lab == NULL || dists == NULL || sums == NULL || counts == NULL) {
+        neon_free(lab);
+        neon_free(dists);
+        neon_free(sums);
+        neon_free(counts);
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    NeonKMeansAssignCtx ctx;
+    ctx.km = km;
+    ctx.data = data;
+    ctx.labels = lab;
+    ctx.dists = dists;
+    ctx.sums = sums;
+    ctx.counts = counts;
+
+    double prev = INFINITY;
+    km->iterations = 0;
+
+    for (int it = 0; it < max_iter; it++) {
+        double inertia[NEON_MAX_THREADS] = {0};
+        ctx.inertia = inertia;
+        memset(sums, 0, (size_t)num_threads * k * dim * sizeof(float));
+        memset(counts, 0, (size_t)num_threads * k * sizeof(size_t));
+
+        neon_parallel_for(n, num_threads, neon_kmeans_assign_worker, &ctx);
+        km->iterations = it + 1;
+
+        double total = 0.0;
+        for (int t = 0; t < num_threads; t++) total += inertia[t];
+        km->inertia = total;
+
+        // Cộng accumulators của các threads vào thread 0
+        for (int t = 1; t < num_threads; t++) {
+            const float* st = sums + (size_t)t * k * dim;
+            for (size_t j = 0; j < k * dim; j++) sums[j] += st[j];
+            for (size_t c = 0; c < k; c++) counts[c] += counts[(size_t)t * k + c];
+        }
+
+        for (size_t c = 0; c < k; c++) {
+            if (counts[c] == 0) continue;
+            float inv = 1.0f / (float)counts[c];
+            float* cent = km->centroids + c * dim;
+            const float* s = sums + c * dim;
+            size_t j = 0;
+            for (; j + 4 <= dim; j += 4) vst1q_f32(cent + j, vmulq_n_f32(vld1q_f32(s + j), inv));
+            for (; j < dim; j++) cent[j] = s[j] * inv;
+        }
+        neon_kmeans_fix_empty(km, data, n, counts, dists);
+        neon_kmeans_update_norms(km);
+
+        if (prev - total <= (double)tol * total) break;
+        prev = total;
+    }
+
+    if (labels != NULL) {
+        neon_kmeans_assign(km, data, n, labels, NULL, num_threads);
+    }
+
+    neon_free(lab);
+    neon_free(dists);
+    neon_free(sums);
+    neon_free(counts);
+    return NEON_SUCCESS;
+}
+
+
+
+// MINI-BATCH
+/**
+ * Mini-batch k-means (Sculley): mỗi bước batch_size samples ngẫu nhiên
+ * Init k-means++ trên 1 sample min(n, 16k + batch_size) points
+ * Cuối cùng 1 lần assign toàn bộ data để tính inertia (và labels nếu != NULL)
+*/
+static inline int neon_kmeans_fit_minibatch(
+    NeonKMeans* km,
+    const float* data,
+    size_t n,
+    size_t batch_size,
+    int max_iter,
+    uint64_t seed,
+    int32_t* labels,
+    int num_threads
+) {
+    if (km == NULL || data == NULL) return NEON_ERROR_NULL_POINTER;
+    if (n < km->k || batch_size == 0) return NEON_ERROR_INVALID_SIZE;
+
+    const size_t k = km->k;
+    const size_t dim = km->dim;
+    uint64_t rng = seed ^ 0x5851F42D4C957F2Dull;
+
+    size_t init_n = MIN(n, 16 * k + batch_size);
+    size_t buf_n = MAX(init_n, batch_size);
+    float* buf = (float*)neon_malloc(buf_n * dim * sizeof(float));
+    int32_t* lab = (int32_t*)neon_malloc(MAX(batch_size, n) * sizeof(int32_t));
+    float* dists = (float*)neon_malloc(MAX(batch_size, n) * sizeof(float));
+    size_t* counts = (size_t*)neon_malloc(k * sizeof(size_t));
+
+    if (buf == NULL || lab == NULL || dists == NULL || counts == NULL) {
+        neon_free(buf);
+        neon_free(lab);
+        neon_free(dists);
+        neon_free(counts);
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    for (size_t i = 0; i < init_n; i++) {
+        size_t src = (init_n == n) ? i : (size_t)(neon_kmeans_rand(&rng) % n);
+        memcpy(buf + i * dim, data + src * dim, dim * sizeof(float));
+    }
+
+    int err = neon_kmeans_init_plusplus(km, buf, init_n, seed, num_threads);
+    if (err == NEON_SUCCESS) {
+        memset(counts, 0, k * sizeof(size_t));
+
+        for (int it = 0; it < max_iter; it++) {
+            for (size_t i = 0; i < batch_size; i++) {
+                size_t src = (size_t)(neon_kmeans_rand(&rng) % n);
+                memcpy(buf + i * dim, data + src * dim, dim * sizeof(float));
+            }
+
+            neon_kmeans_assign(km, buf, batch_size, lab, dists, num_threads);
+
+            // c += (x - c) / count(c)
+            for (size_t i = 0; i < batch_size; i++) {
+                size_t c = (size_t)lab[i];
+                float eta = 1.0f / (float)(++counts[c]);
+                float* cent = km->centroids + c * dim;
+                const float* x = buf + i * dim;
+
+                size_t j = 0;
+                for (; j + 4 <= dim; j += 4) {
+                    float32x4_t vc = vld1q_f32(cent + j);
+                    vst1q_f32(cent + j, vfmaq_n_f32(vc, vsubq_f32(vld1q_f32(x + j), vc), eta));
+                }
+                for (; j < dim; j++) cent[j] += (x[j] - cent[j]) * eta;
+            }
+            neon_kmeans_update_norms(km);
+            km->iterations = it + 1;
+        }
+
+        err = neon_kmeans_assign(km, data, n, labels ? labels : lab, dists, num_threads);
+        double total = 0.0;
+        for (size_t i = 0; i < n; i++) total += dists[i];
+        km->inertia = total;
+    }
+
+    neon_free(buf);
+    neon_free(lab);
+    neon_free(dists);
+    neon_free(counts);
+    return err;
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_KMEANS_H
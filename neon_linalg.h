@@ -0,0 +1,442 @@
+#ifndef NEON_LINALG_H
+#define NEON_LINALG_H
+
+#include "neon_types.h"
+#include "memory_align.h"
+#include "neon_f64.h"
+#include <math.h>
+#include <string.h>
+
+
+/**
+ * DENSE LINEAR ALGEBRA (f64, row-major): CHOLESKY, LU, TRSM
+ *
+ * Gaussian process / Kalman filter: ma trận 64 - 2048, cần double
+ *
+ * BLOCKED RIGHT-LOOKING (block NB = 64):
+ *   Mỗi bước chỉ factor 1 panel NB cột (unblocked, O(n * NB²))
+ *   → phần còn lại (trailing matrix) cập nhật bằng 1 GEMM lớn: A22 -= L21 * U12
+ *   → ~O(n³) flops chạy trong neon_dgemm_kernel_4x4 (8 FMAs / 4 loads) thay vì axpy (1 FMA / 2 loads)
+ *
+ * Row-major:
+ *   - Hàng liên tục → dot product / axpy theo hàng vectorize được (neon_dot_product_f64, neon_axpy_f64)
+ *   - Row swap của LU pivoting = swap 2 đoạn memory liên tục
+ *
+ * n <= NB: chỉ chạy unblocked path (không pack, không malloc)
+ *
+ * CHOLESKY: A = L * L^T, chỉ đọc lower triangle, upper triangle được set 0
+ * LU: P * A = L * U, L unit lower, piv[i] = hàng đã swap với hàng i (như LAPACK, 0-based)
+ * TRSM: op(T) * X = B (T triangular, op = T hoặc T^T), B [n x nrhs] bị ghi đè bởi X
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define NEON_LINALG_BLOCK 64
+#define NEON_LINALG_KC 256
+
+
+typedef enum {
+    TRIANGLE_LOWER = 0,
+    TRIANGLE_UPPER = 1
+} TriangleType;
+
+
+
+// GEMM UPDATE
+/**
+ * C[m x n] += alpha * op(A) * op(B)
+ *
+ * op(A)[i][p] = trans_a ? A[p * lda + i] : A[i * lda + p]
+ * op(B)[p][j] = trans_b ? B[j * ldb + p] : B[p * ldb + j]
+ *
+ * Pack theo khối KC hàng k (panel B nằm trong L2), tile 4x4 tính bằng neon_dgemm_kernel_4x4
+ * rồi cộng vào C (C += alpha * tile)
+*/
+static inline int neon_dgemm_update(
+    int trans_a,
+    int trans_b,
+    size_t m,
+    size_t n,
+    size_t k,
+    double alpha,
+    const double* A,
+    size_t lda,
+    const double* B,
+    size_t ldb,
+    double* C,
+    size_t ldc
+) {
+    if (A == NULL || B == NULL || C == NULL) return NEON_ERROR_NULL_POINTER;
+    if (m == 0 || n == 0 || k == 0) return NEON_SUCCESS;
+
+    size_t kc_max = MIN(k, (size_t)NEON_LINALG_KC);
+    size_t n_panels = (n + 3) / 4;
+    double* b_packed = (double*)neon_malloc((n_panels * kc_max * 4 + 2) * sizeof(double));
+    double* a_packed = (double*)neon_malloc((kc_max * 4 + 2) * sizeof(double));
+
+    if (b_packed == NULL || a_packed == NULL) {
+        neon_free(b_packed);
+        neon_free(a_packed);
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    double tile[16] ALIGN_NEON;
+    float64x2_t va = vdupq_n_f64(alpha);
+
+    for (size_t p0 = 0; p0 < k; p0 += kc_max) {
+        size_t kc = MIN(kc_max, k - p0);
+
+        for (size_t jp = 0; jp < n_panels; jp++) {
+            double* dst = b_packed + jp * kc * 4;
+            for (size_t p = 0; p < kc; p++) {
+                for (size_t jj = 0; jj < 4; jj++) {
+                    size_t j = jp * 4 + jj;
+                    if (j >= n) {
+                        dst[p * 4 + jj] = 0.0;
+                    } else {
+                        dst[p * 4 + jj] = trans_b ? B[j * ldb + p0 + p] : B[(p0 + p) * ldb + j];
+                    }
+                }
+            }
+        }
+
+        for (size_t i = 0; i < m; i += 4) {
+            size_t rows = MIN(4, m - i);
+
+            for (size_t p = 0; p < kc; p++) {
+                for (size_t ii = 0; ii < 4; ii++) {
+                    if (ii >= rows) {
+                        a_packed[p * 4 + ii] = 0.0;
+                    } else {
+                        a_packed[p * 4 + ii] = trans_a ? A[(p0 + p) * lda + i + ii] : A[(i + ii) * lda + p0 + p];
+                    }
+                }
+            }
+
+            for (size_t jp = 0; jp < n_panels; jp++) {
+                size_t j = jp * 4;
+                size_t cols = MIN(4, n - j);
+
+                neon_dgemm_kernel_4x4(a_packed, b_packed + jp * kc * 4, kc, tile, 4);
+
+                if (cols == 4) {
+                    for (size_t ii = 0; ii < rows; ii++) {
+                        double* c = C + (i + ii) * ldc + j;
+                        vst1q_f64(c, vfmaq_f64(vld1q_f64(c), vld1q_f64(tile + ii * 4), va));
+                        vst1q_f64(c + 2, vfmaq_f64(vld1q_f64(c + 2), vld1q_f64(tile + ii * 4 + 2), va));
+                    }
+                } else {
+                    for (size_t ii = 0; ii < rows; ii++) {
+                        for (size_t jj = 0; jj < cols; jj++) {
+                            C[(i + ii) * ldc + j + jj] += alpha * tile[ii * 4 + jj];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    neon_free(a_packed);
+    neon_free(b_packed);
+    return NEON_SUCCESS;
+}
+
+
+
+// TRSM
+/**
+ * Unblocked: op(T) * X = B cho n <= NB
+ * Mỗi hàng X = (B_i - Σ_j op(T)[i][j] * X_j) / op(T)[i][i] → axpy trên hàng nrhs liên tục
+*/
+static inline void neon_trsm_unblocked(
+    TriangleType uplo,
+    int trans,
+    int unit_diag,
+    size_t n,
+    size_t nrhs,
+    const double* T,
+    size_t ldt,
+    double* B,
+    size_t ldb
+) {
+    int lower = (uplo == TRIANGLE_LOWER) != (trans != 0);
+
+    for (size_t s = 0; s < n; s++) {
+        size_t i = lower ? s : n - 1 - s;
+        double* bi = B + i * ldb;
+
+        size_t j0 = lower ? 0 : i + 1;
+        size_t j1 = lower ? i : n;
+        for (size_t j = j0; j < j1; j++) {
+            double t = trans ? T[j * ldt + i] : T[i * ldt + j];
+            if (t != 0.0) neon_axpy_f64(bi, -t, B + j * ldb, nrhs);
+        }
+
+        if (!unit_diag) {
+            double inv = 1.0 / T[i * ldt + i];
+            size_t c = 0;
+            for (; c + 2 <= nrhs; c += 2) vst1q_f64(bi + c, vmulq_n_f64(vld1q_f64(bi + c), inv));
+            for (; c < nrhs; c++) bi[c] *= inv;
+        }
+    }
+}
+
+
+/**
+ * op(T) * X = B, T [n x n] triangular, B [n x nrhs] → X
+ *
+ * @param uplo: T là lower hay upper (chỉ đọc triangle đó)
+ * @param trans: != 0 → giải T^T * X = B
+ * @param unit_diag: != 0 → đường chéo = 1 (không đọc)
+ * @return: NEON_SUCCESS hoặc error code
+*/
+static inline int neon_trsm(
+    TriangleType uplo,
+    int trans,
+    int unit_diag,
+    size_t n,
+    size_t nrhs,
+    const double* T,
+    size_t ldt,
+    double* B,
+    size_t ldb
+) {
+    if (T == NULL || B == NULL) return NEON_ERROR_NULL_POINTER;
+    if (n == 0 || nrhs == 0) return NEON_SUCCESS;
+
+    if (n <= NEON_LINALG_BLOCK) {
+        neon_trsm_unblocked(uplo, trans, unit_diag, n, nrhs, T, ldt, B, ldb);
+        return NEON_SUCCESS;
+    }
+
+    int lower = (uplo == TRIANGLE_LOWER) != (trans != 0);
+    size_t n_blocks = (n + NEON_LINALG_BLOCK - 1) / NEON_LINALG_BLOCK;
+
+    for (size_t s = 0; s < n_blocks; s++) {
+        size_t bidx = lower ? s : n_blocks - 1 - s;
+        size_t i0 = bidx * NEON_LINALG_BLOCK;
+        size_t i1 = MIN(i0 + NEON_LINALG_BLOCK, n);
+        size_t nb = i1 - i0;
+
+        neon_trsm_unblocked(uplo, trans, unit_diag, nb, nrhs, T + i0 * ldt + i0, ldt, B + i0 * ldb, ldb);
+
+        // Phần còn lại: B_rest -= op(T)[rest, i0:i1] * X[i0:i1]
+        size_t r0 = lower ? i1 : 0;
+        size_t r1 = lower ? n : i0;
+        if (r0 == r1) continue;
+
+        const double* a = trans ? T + i0 * ldt + r0 : T + r0 * ldt + i0;
+        int err = neon_dgemm_update(trans, 0, r1 - r0, nrhs, nb, -1.0, a, ldt, B + i0 * ldb, ldb, B + r0 * ldb, ldb);
+        if (err != NEON_SUCCESS) return err;
+    }
+
+    return NEON_SUCCESS;
+}
+
+
+
+// CHOLESKY
+/**
+ * Unblocked Cholesky (Crout theo hàng), chỉ đọc / ghi lower triangle
+ *   L[i][j] = (A[i][j] - L[i][0:j] · L[j][0:j]) / L[j][j]
+ * @return: NEON_ERROR_INVALID_PARAM nếu không positive definite
+*/
+static inline int neon_cholesky_unblocked(double* A, size_t n, size_t lda) {
+    for (size_t i = 0; i < n; i++) {
+        double* ai = A + i * lda;
+
+        for (size_t j = 0; j < i; j++) {
+            const double* aj = A + j * lda;
+            ai[j] = (ai[j] - neon_dot_product_f64(ai, aj, j)) / aj[j];
+        }
+
+        double d = ai[i] - neon_dot_product_f64(ai, ai, i);
+        if (!(d > 0.0)) return NEON_ERROR_INVALID_PARAM;
+        ai[i] = sqrt(d);
+    }
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * L21 = A21 * L11^-T: mỗi hàng x của A21 giải L11 * x^T = a^T (forward substitution)
+*/
+static inline void neon_cholesky_solve_panel(const double* L11, size_t nb, double* A21, size_t m, size_t lda) {
+    for (size_t r = 0; r < m; r++) {
+        double* x = A21 + r * lda;
+        for (size_t j = 0; j < nb; j++) {
+            const double* lj = L11 + j * lda;
+            x[j] = (x[j] - neon_dot_product_f64(x, lj, j)) / lj[j];
+        }
+    }
+}
+
+
+/**
+ * A = L * L^T in place (A symmetric positive definite [n x n], leading dimension lda)
+ *
+ * Mỗi block NB: factor A11, L21 = A21 * L11^-T, A22 -= L21 * L21^T (chỉ các block
+ * cột thuộc lower triangle → 1/2 flops của GEMM đầy đủ)
+ *
+ * @return: NEON_SUCCESS, NEON_ERROR_INVALID_PARAM nếu không positive definite
+*/
+static inline int neon_cholesky(double* A, size_t n, size_t lda) {
+    if (A == NULL) return NEON_ERROR_NULL_POINTER;
+    if (lda < n) return NEON_ERROR_INVALID_SIZE;
+
+    int err = NEON_SUCCESS;
+
+    for (size_t k0 = 0; k0 < n && err == NEON_SUCCESS; k0 += NEON_LINALG_BLOCK) {
+        size_t k1 = MIN(k0 + NEON_LINALG_BLOCK, n);
+        size_t nb = k1 - k0;
+        double* a11 = A + k0 * lda + k0;
+
+        err = neon_cholesky_unblocked(a11, nb, lda);
+        if (err != NEON_SUCCESS || k1 == n) break;
+
+        double* a21 = A + k1 * lda + k0;
+        neon_cholesky_solve_panel(a11, nb, a21, n - k1, lda);
+
+        for (size_t j0 = k1; j0 < n && err == NEON_SUCCESS; j0 += NEON_LINALG_BLOCK) {
+            size_t j1 = MIN(j0 + NEON_LINALG_BLOCK, n);
+            // A[j0:n, j0:j1] -= L21[j0:n] * L21[j0:j1]^T
+            err = neon_dgemm_update(0, 1, n - j0, j1 - j0, nb, -1.0,
+                                    A + j0 * lda + k0, lda, A + j0 * lda + k0, lda,
+                                    A + j0 * lda + j0, lda);
+        }
+    }
+
+    if (err != NEON_SUCCESS) return err;
+
+    for (size_t i = 0; i + 1 < n; i++) {
+        memset(A + i * lda + i + 1, 0, (n - i - 1) * sizeof(double));
+    }
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * Giải A * X = B với L từ neon_cholesky: L * Y = B, L^T * X = Y
+*/
+static inline int neon_cholesky_solve(const double* L, size_t n, size_t lda, double* B, size_t nrhs, size_t ldb) {
+    int err = neon_trsm(TRIANGLE_LOWER, 0, 0, n, nrhs, L, lda, B, ldb);
+    if (err != NEON_SUCCESS) return err;
+    return neon_trsm(TRIANGLE_LOWER, 1, 0, n, nrhs, L, lda, B, ldb);
+}
+
+
+/**
+ * log det(A) = 2 * Σ log L[i][i] (log marginal likelihood của GP)
+*/
+static inline double neon_cholesky_logdet(const double* L, size_t n, size_t lda) {
+    double s = 0.0;
+    for (size_t i = 0; i < n; i++) s += log(L[i * lda + i]);
+    return 2.0 * s;
+}
+
+
+
+// LU (PARTIAL PIVOTING)
+static NEON_INLINE void neon_lu_swap_rows(double* a, double* b, size_t n) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        float64x2_t va = vld1q_f64(a + i);
+        vst1q_f64(a + i, vld1q_f64(b + i));
+        vst1q_f64(b + i, va);
+    }
+    for (; i < n; i++) {
+        double t = a[i];
+        a[i] = b[i];
+        b[i] = t;
+    }
+}
+
+
+/**
+ * Factor panel A[k0:n, k0:k1] (unblocked), swap cả hàng [0, ncols)
+*/
+static inline int neon_lu_panel(double* A, size_t n, size_t ncols, size_t lda, size_t k0, size_t k1, int32_t* piv) {
+    for (size_t j = k0; j < k1; j++) {
+        size_t p = j;
+        double best = fabs(A[j * lda + j]);
+        for (size_t i = j + 1; i < n; i++) {
+            double v = fabs(A[i * lda + j]);
+            if (v > best) {
+                best = v;
+                p = i;
+            }
+        }
+
+        piv[j] = (int32_t)p;
+        if (best == 0.0) return NEON_ERROR_INVALID_PARAM;
+        if (p != j) neon_lu_swap_rows(A + j * lda, A + p * lda, ncols);
+
+        const double* aj = A + j * lda;
+        double inv = 1.0 / aj[j];
+        for (size_t i = j + 1; i < n; i++) {
+            double* ai = A + i * lda;
+            ai[j] *= inv;
+            neon_axpy_f64(ai + j + 1, -ai[j], aj + j + 1, k1 - j - 1);
+        }
+    }
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * P * A = L * U in place, A [n x n]
+ *
+ * Mỗi block NB: factor panel (pivot trên cả cột, swap toàn bộ hàng),
+ * U12 = L11^-1 * A12 (TRSM unit lower), A22 -= L21 * U12 (GEMM)
+ *
+ * @param piv: [n], hàng i đã được swap với hàng piv[i] (theo thứ tự i tăng dần)
+ * @return: NEON_SUCCESS, NEON_ERROR_INVALID_PARAM nếu singular
+*/
+static inline int neon_lu(double* A, size_t n, size_t lda, int32_t* piv) {
+    if (A == NULL || piv == NULL) return NEON_ERROR_NULL_POINTER;
+    if (lda < n || n > 0x7FFFFFFF) return NEON_ERROR_INVALID_SIZE;
+
+    for (size_t k0 = 0; k0 < n; k0 += NEON_LINALG_BLOCK) {
+        size_t k1 = MIN(k0 + NEON_LINALG_BLOCK, n);
+
+        int err = neon_lu_panel(A, n, n, lda, k0, k1, piv);
+        if (err != NEON_SUCCESS) return err;
+        if (k1 == n) break;
+
+        neon_trsm_unblocked(TRIANGLE_LOWER, 0, 1, k1 - k0, n - k1, A + k0 * lda + k0, lda, A + k0 * lda + k1, lda);
+
+        err = neon_dgemm_update(0, 0, n - k1, n - k1, k1 - k0, -1.0,
+                                A + k1 * lda + k0, lda, A + k0 * lda + k1, lda,
+                                A + k1 * lda + k1, lda);
+        if (err != NEON_SUCCESS) return err;
+    }
+
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * Giải A * X = B với (LU, piv) từ neon_lu: swap hàng B, L * Y = P * B, U * X = Y
+*/
+static inline int neon_lu_solve(const double* LU, size_t n, size_t lda, const int32_t* piv, double* B, size_t nrhs, size_t ldb) {
+    if (LU == NULL || piv == NULL || B == NULL) return NEON_ERROR_NULL_POINTER;
+
+    for (size_t i = 0; i < n; i++) {
+        size_t p = (size_t)piv[i];
+        if (p != i) neon_lu_swap_rows(B + i * ldb, B + p * ldb, nrhs);
+    }
+
+    int err = neon_trsm(TRIANGLE_LOWER, 0, 1, n, nrhs, LU, lda, B, ldb);
+    if (err != NEON_SUCCESS) return err;
+    return neon_trsm(TRIANGLE_UPPER, 0, 0, n, nrhs, LU, lda, B, ldb);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_LINALG_H
@@ -0,0 +1,531 @@
+#ifndef NEON_OPTIM_H
+#define NEON_OPTIM_H
+
+#include "neon_types.h"
+#include "memory_align.h"
+#include "neon_thread.h"
+#include <math.h>
+#include <string.h>
+
+
+/**
+ * FUSED OPTIMIZER STEP (SGD-momentum, Adam, AdamW, LAMB)
+ *
+ * Adam viết thành nhiều pass elementwise (g *= clip, m = .., v = .., w -= ..):
+ *   mỗi pass đọc + ghi lại cả array → traffic gấp nhiều lần mức tối thiểu
+ * FUSED: 1 pass đọc w, g, m, v và ghi w, m, v (16 bytes đọc + 12 bytes ghi / param)
+ *   - clip by global norm gộp vào như 1 hệ số nhân g (không ghi lại grads)
+ *   - bias correction gộp vào step_size = lr / (1 - β1^t) và 1 / sqrt(1 - β2^t)
+ *
+ * DENOMINATOR: 1 / (sqrt(v̂) + eps) không dùng vsqrtq / vdivq (latency cao, không pipeline trên core nhỏ)
+ *   sqrt(v̂) = v̂ * rsqrt(v̂)  (vrsqrteq_f32 + 2 bước Newton vrsqrtsq_f32)
+ *   1 / d    = vrecpeq_f32 + 2 bước Newton vrecpsq_f32
+ *
+ * GLOBAL NORM: ||g|| trên mọi groups, tổng bình phương từng thread (double) rồi cộng lại
+ *   → thêm 1 pass chỉ đọc grads, chỉ khi max_grad_norm > 0
+ *
+ * LAMB: trust ratio ||w|| / ||r|| theo từng group (layer) → cần norm của update trước khi ghi w:
+ *   pass 1 cập nhật m, v + tính ||w||, ||r||, pass 2 tính lại r từ m, v và ghi w
+ *
+ * Mỗi group chia đều cho threads (neon_parallel_for)
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define NEON_OPTIM_MIN_PER_THREAD 16384
+
+
+typedef enum {
+    OPTIM_SGD = 0,
+    OPTIM_ADAM = 1,
+    OPTIM_ADAMW = 2,
+    OPTIM_LAMB = 3
+} OptimizerType;
+
+
+typedef struct
+{
+    float lr;
+    float beta1; // SGD: momentum
+    float beta2;
+    float eps;
+    float weight_decay; // SGD / Adam: L2 cộng vào g, AdamW / LAMB: decoupled
+    float max_grad_norm; // <= 0: không clip
+    int nesterov; // chỉ SGD
+} NeonOptimConfig;
+
+
+typedef struct
+{
+    OptimizerType type;
+    NeonOptimConfig config;
+    int64_t step;
+    float last_grad_norm; // ||g|| trước khi clip (chỉ khi max_grad_norm > 0)
+
+    AlignedBuffer** params;
+    AlignedBuffer** grads;
+    float** m; // SGD: momentum buffer
+    float** v; // NULL với SGD
+    size_t n_groups;
+    size_t group_capacity;
+} NeonOptimizer;
+
+
+
+// CONFIG
+static inline NeonOptimConfig neon_optim_default_config(OptimizerType type) {
+    NeonOptimConfig c;
+    c.lr = (type == OPTIM_SGD) ? 0.01f : 1e-3f;
+    c.beta1 = 0.9f;
+    c.beta2 = 0.999f;
+    c.eps = (type == OPTIM_LAMB) ? 1e-6f : 1e-8f;
+    c.weight_decay = (type == OPTIM_ADAMW || type == OPTIM_LAMB) ? 0.01f : 0.0f;
+    c.max_grad_norm = 0.0f;
+    c.nesterov = 0;
+    return c;
+}
+
+
+
+// CREATE / DESTROY
+static inline int neon_optim_create(NeonOptimizer* opt, OptimizerType type, const NeonOptimConfig* config) {
+    if (opt == NULL || config == NULL) return NEON_ERROR_NULL_POINTER;
+    if (!(config->lr >= 0.0f) || config->beta1 < 0.0f || config->beta1 >= 1.0f ||
+        config->beta2 < 0.0f || config->beta2 >= 1.0f) {
+        return NEON_ERROR_INVALID_PARAM;
+    }
+
+    opt->type = type;
+    opt->config = *config;
+    opt->step = 0;
+    opt->last_grad_norm = 0.0f;
+    opt->params = NULL;
+    opt->grads = NULL;
+    opt->m = NULL;
+    opt->v = NULL;
+    opt->n_groups = 0;
+    opt->group_capacity = 0;
+    return NEON_SUCCESS;
+}
+
+
+static inline void neon_optim_destroy(NeonOptimizer* opt) {
+    if (opt == NULL) return;
+
+    for (size_t i = 0; i < opt->n_groups; i++) {
+        neon_free(opt->m[i]);
+        if (opt->v != NULL) neon_free(opt->v[i]);
+    }
+    neon_free(opt->params);
+    neon_free(opt->grads);
+    neon_free(opt->m);
+    neon_free(opt->v);
+    opt->params = NULL;
+    opt->grads = NULL;
+    opt->m = NULL;
+    opt->v = NULL;
+    opt->n_groups = 0;
+    opt->group_capacity = 0;
+}
+
+
+static inline int neon_optim_grow(NeonOptimizer* opt) {
+    size_t cap = MAX(opt->group_capacity * 2, (size_t)8);
+
+    AlignedBuffer** params = (AlignedBuffer**)neon_malloc(cap * sizeof(AlignedBuffer*));
+    AlignedBuffer** grads = (AlignedBuffer**)neon_malloc(cap * sizeof(AlignedBuffer*));
+    float** m = (float**)neon_malloc(cap * sizeof(float*));
+    float** v = (float**)neon_malloc(cap * sizeof(float*));
+
+    if (params == NULL || grads == NULL || m == NULL || v == NULL) {
+        neon_free(params);
+        neon_free(grads);
+        neon_free(m);
+        neon_free(v);
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    if (opt->n_groups > 0) {
+        memcpy(params, opt->params, opt->n_groups * sizeof(AlignedBuffer*));
+        memcpy(grads, opt->grads, opt->n_groups * sizeof(AlignedBuffer*));
+        memcpy(m, opt->m, opt->n_groups * sizeof(float*));
+        memcpy(v, opt->v, opt->n_groups * sizeof(float*));
+    }
+    neon_free(opt->params);
+    neon_free(opt->grads);
+    neon_free(opt->m);
+    neon_free(opt->v);
+
+    opt->params = params;
+    opt->grads = grads;
+    opt->m = m;
+    opt->v = v;
+    opt->group_capacity = cap;
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * Thêm 1 parameter group (thường 1 layer), dùng params->size phần tử
+ * Optimizer không sở hữu params / grads, chỉ tạo state m (và v) = 0
+*/
+static inline int neon_optim_add_group(NeonOptimizer* opt, AlignedBuffer* params, AlignedBuffer* grads) {
+    if (opt == NULL || params == NULL || grads == NULL) return NEON_ERROR_NULL_POINTER;
+    if (grads->size != params->size) return NEON_ERROR_INVALID_SIZE;
+
+    if (opt->n_groups == opt->group_capacity) {
+        int err = neon_optim_grow(opt);
+        if (err != NEON_SUCCESS) return err;
+    }
+
+    size_t n = params->size;
+    float* m = (float*)neon_malloc(MAX(n, (size_t)1) * sizeof(float));
+    float* v = NULL;
+    if (opt->type != OPTIM_SGD) v = (float*)neon_malloc(MAX(n, (size_t)1) * sizeof(float));
+
+    if (m == NULL || (opt->type != OPTIM_SGD && v == NULL)) {
+        neon_free(m);
+        neon_free(v);
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    memset(m, 0, n * sizeof(float));
+    if (v != NULL) memset(v, 0, n * sizeof(float));
+
+    size_t i = opt->n_groups++;
+    opt->params[i] = params;
+    opt->grads[i] = grads;
+    opt->m[i] = m;
+    opt->v[i] = v;
+    return NEON_SUCCESS;
+}
+
+
+
+// GLOBAL GRAD NORM
+typedef struct {
+    const float* data;
+    double partial[NEON_MAX_THREADS];
+} NeonOptimNormCtx;
+
+
+static void neon_optim_norm_worker(void* arg, size_t begin, size_t end, int tid) {
+    NeonOptimNormCtx* ctx = (NeonOptimNormCtx*)arg;
+    const float* g = ctx->data;
+
+    float32x4_t a0 = vdupq_n_f32(0.0f), a1 = vdupq_n_f32(0.0f);
+    double total = 0.0;
+    size_t i = begin;
+
+    // Flush accumulator float sang double mỗi 4096 phần tử để không mất chính xác
+    while (i + 8 <= end) {
+        size_t stop = MIN(end, i + 4096);
+        for (; i + 8 <= stop; i += 8) {
+            float32x4_t g0 = vld1q_f32(g + i);
+            float32x4_t g1 = vld1q_f32(g + i + 4);
+            a0 = vfmaq_f32(a0, g0, g0);
+            a1 = vfmaq_f32(a1, g1, g1);
+        }
+        total += (double)vaddvq_f32(vaddq_f32(a0, a1));
+        a0 = vdupq_n_f32(0.0f);
+        a1 = vdupq_n_f32(0.0f);
+    }
+    for (; i < end; i++) total += (double)g[i] * g[i];
+
+    ctx->partial[tid] += total;
+}
+
+
+/**
+ * ||g|| trên mọi groups
+*/
+static inline float neon_optim_grad_norm(const NeonOptimizer* opt, int num_threads) {
+    double total = 0.0;
+
+    for (size_t gi = 0; gi < opt->n_groups; gi++) {
+        size_t n = opt->grads[gi]->size;
+        if (n == 0) continue;
+
+        NeonOptimNormCtx ctx;
+        ctx.data = opt->grads[gi]->data;
+        memset(ctx.partial, 0, sizeof(ctx.partial));
+
+        int threads = neon_threads_for(n, num_threads, NEON_OPTIM_MIN_PER_THREAD);
+        neon_parallel_for(n, threads, neon_optim_norm_worker, &ctx);
+        for (int t = 0; t < threads; t++) total += ctx.partial[t];
+    }
+
+    return (float)sqrt(total);
+}
+
+
+
+// FUSED KERNELS
+/**
+ * 1 / (sqrt(v) + eps) bằng rsqrt + reciprocal estimate (2 bước Newton mỗi cái)
+ * v = 0 → sqrt = 0 * rsqrt(tiny) = 0
+*/
+static NEON_INLINE float32x4_t neon_optim_inv_denom(float32x4_t v, float32x4_t eps) {
+    float32x4_t vs = vmaxq_f32(v, vdupq_n_f32(1e-30f));
+    float32x4_t r = vrsqrteq_f32(vs);
+    r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(vs, r), r));
+    r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(vs, r), r));
+
+    float32x4_t d = vfmaq_f32(eps, v, r);
+    float32x4_t inv = vrecpeq_f32(d);
+    inv = vmulq_f32(inv, vrecpsq_f32(d, inv));
+    inv = vmulq_f32(inv, vrecpsq_f32(d, inv));
+    return inv;
+}
+
+
+typedef struct {
+    const NeonOptimizer* opt;
+    float* w;
+    const float* g;
+    float* m;
+    float* v;
+    float clip; // hệ số nhân g
+    float step_size; // lr / (1 - β1^t)
+    float inv_bc1; // 1 / (1 - β1^t)
+    float inv_bc2; // 1 / (1 - β2^t)
+    float trust; // LAMB pass 2
+    int pass;
+    double w_norm[NEON_MAX_THREADS];
+    double r_norm[NEON_MAX_THREADS];
+} NeonOptimStepCtx;
+
+
+static void neon_optim_sgd_worker(NeonOptimStepCtx* ctx, size_t begin, size_t end) {
+    const NeonOptimConfig* c = &ctx->opt->config;
+    float* w = ctx->w;
+    const float* g = ctx->g;
+    float* buf = ctx->m;
+
+    float32x4_t clip = vdupq_n_f32(ctx->clip);
+    float32x4_t wd = vdupq_n_f32(c->weight_decay);
+    float32x4_t mu = vdupq_n_f32(c->beta1);
+    float32x4_t nlr = vdupq_n_f32(-c->lr);
+
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        float32x4_t vw = vld1q_f32(w + i);
+        float32x4_t vg = vfmaq_f32(vmulq_f32(vld1q_f32(g + i), clip), wd, vw);
+        float32x4_t vb = vfmaq_f32(vg, mu, vld1q_f32(buf + i));
+        vst1q_f32(buf + i, vb);
+        float32x4_t upd = c->nesterov ? vfmaq_f32(vg, mu, vb) : vb;
+        vst1q_f32(w + i, vfmaq_f32(vw, nlr, upd));
+    }
+    for (; i < end; i++) {
+        float gi = g[i] * ctx->clip + c->weight_decay * w[i];
+        buf[i] = c->beta1 * buf[i] + gi;
+        float upd = c->nesterov ? gi + c->beta1 * buf[i] : buf[i];
+        w[i] -= c->lr * upd;
+    }
+}
+
+
+/**
+ * Adam (L2 vào g) / AdamW (decoupled weight decay)
+*/
+static void neon_optim_adam_worker(NeonOptimStepCtx* ctx, size_t begin, size_t end) {
+    const NeonOptimConfig* c = &ctx->opt->config;
+    const int decoupled = (ctx->opt->type == OPTIM_ADAMW);
+    float* w = ctx->w;
+    const float* g = ctx->g;
+    float* m = ctx->m;
+    float* v = ctx->v;
+
+    float l2 = decoupled ? 0.0f : c->weight_decay;
+    float decay = decoupled ? 1.0f - c->lr * c->weight_decay : 1.0f;
+
+    float32x4_t clip = vdupq_n_f32(ctx->clip);
+    float32x4_t vl2 = vdupq_n_f32(l2);
+    float32x4_t vdecay = vdupq_n_f32(decay);
+    float32x4_t b1 = vdupq_n_f32(c->beta1), nb1 = vdupq_n_f32(1.0f - c->beta1);
+    float32x4_t b2 = vdupq_n_f32(c->beta2), nb2 = vdupq_n_f32(1.0f - c->beta2);
+    float32x4_t inv_bc2 = vdupq_n_f32(ctx->inv_bc2);
+    float32x4_t eps = vdupq_n_f32(c->eps);
+    float32x4_t nstep = vdupq_n_f32(-ctx->step_size);
+
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        float32x4_t vw = vld1q_f32(w + i);
+        float32x4_t vg = vfmaq_f32(vmulq_f32(vld1q_f32(g + i), clip), vl2, vw);
+        float32x4_t vm = vfmaq_f32(vmulq_f32(nb1, vg), b1, vld1q_f32(m + i));
+        float32x4_t vv = vfmaq_f32(vmulq_f32(nb2, vmulq_f32(vg, vg)), b2, vld1q_f32(v + i));
+        vst1q_f32(m + i, vm);
+        vst1q_f32(v + i, vv);
+
+        float32x4_t inv = neon_optim_inv_denom(vmulq_f32(vv, inv_bc2), eps);
+        vst1q_f32(w + i, vfmaq_f32(vmulq_f32(vw, vdecay), nstep, vmulq_f32(vm, inv)));
+    }
+    for (; i < end; i++) {
+        float gi = g[i] * ctx->clip + l2 * w[i];
+        m[i] = c->beta1 * m[i] + (1.0f - c->beta1) * gi;
+        v[i] = c->beta2 * v[i] + (1.0f - c->beta2) * gi * gi;
+        float denom = sqrtf(v[i] * ctx->inv_bc2) + c->eps;
+        w[i] = w[i] * decay - ctx->step_size * m[i] / denom;
+    }
+}
+
+
+/**
+ * LAMB: r = m̂ / (sqrt(v̂) + eps) + wd * w,  w -= lr * (||w|| / ||r||) * r
+ * pass 0: cập nhật m, v, cộng ||w||², ||r||²;  pass 1: ghi w với trust ratio
+*/
+static void neon_optim_lamb_worker(NeonOptimStepCtx* ctx, size_t begin, size_t end, int tid) {
+    const NeonOptimConfig* c = &ctx->opt->config;
+    float* w = ctx->w;
+    const float* g = ctx->g;
+    float* m = ctx->m;
+    float* v = ctx->v;
+
+    float bc1 = ctx->inv_bc1;
+    float32x4_t clip = vdupq_n_f32(ctx->clip);
+    float32x4_t b1 = vdupq_n_f32(c->beta1), nb1 = vdupq_n_f32(1.0f - c->beta1);
+    float32x4_t b2 = vdupq_n_f32(c->beta2), nb2 = vdupq_n_f32(1.0f - c->beta2);
+    float32x4_t inv_bc1 = vdupq_n_f32(bc1);
+    float32x4_t inv_bc2 = vdupq_n_f32(ctx->inv_bc2);
+    float32x4_t eps = vdupq_n_f32(c->eps);
+    float32x4_t wd = vdupq_n_f32(c->weight_decay);
+    float32x4_t nstep = vdupq_n_f32(-c->lr * ctx->trust);
+
+    float32x4_t aw = vdupq_n_f32(0.0f), ar = vdupq_n_f32(0.0f);
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        float32x4_t vw = vld1q_f32(w + i);
+        float32x4_t vm, vv;
+
+        if (ctx->pass == 0) {
+            float32x4_t vg = vmulq_f32(vld1q_f32(g + i), clip);
+            vm = vfmaq_f32(vmulq_f32(nb1, vg), b1, vld1q_f32(m + i));
+            vv = vfmaq_f32(vmulq_f32(nb2, vmulq_f32(vg, vg)), b2, vld1q_f32(v + i));
+            vst1q_f32(m + i, vm);
+            vst1q_f32(v + i, vv);
+        } else {
+            vm = vld1q_f32(m + i);
+            vv = vld1q_f32(v + i);
+        }
+
+        float32x4_t inv = neon_optim_inv_denom(vmulq_f32(vv, inv_bc2), eps);
+        float32x4_t r = vfmaq_f32(vmulq_f32(vmulq_f32(vm, inv_bc1), inv), wd, vw);
+
+        if (ctx->pass == 0) {
+            aw = vfmaq_f32(aw, vw, vw);
+            ar = vfmaq_f32(ar, r, r);
+        } else {
+            vst1q_f32(w + i, vfmaq_f32(vw, nstep, r));
+        }
+    }
+
+    double sw = (double)vaddvq_f32(aw), sr = (double)vaddvq_f32(ar);
+    for (; i < end; i++) {
+        if (ctx->pass == 0) {
+            float gi = g[i] * ctx->clip;
+            m[i] = c->beta1 * m[i] + (1.0f - c->beta1) * gi;
+            v[i] = c->beta2 * v[i] + (1.0f - c->beta2) * gi * gi;
+        }
+        float r = m[i] * bc1 / (sqrtf(v[i] * ctx->inv_bc2) + c->eps) + c->weight_decay * w[i];
+        if (ctx->pass == 0) {
+            sw += (double)w[i] * w[i];
+            sr += (double)r * r;
+        } else {
+            w[i] -= c->lr * ctx->trust * r;
+        }
+    }
+
+    ctx->w_norm[tid] += sw;
+    ctx->r_norm[tid] += sr;
+}
+
+
+static void neon_optim_step_worker(void* arg, size_t begin, size_t end, int tid) {
+    NeonOptimStepCtx* ctx = (NeonOptimStepCtx*)arg;
+
+    switch (ctx->opt->type) {
+        case OPTIM_SGD:
+            neon_optim_sgd_worker(ctx, begin, end);
+            break;
+        case OPTIM_ADAM:
+        case OPTIM_ADAMW:
+            neon_optim_adam_worker(ctx, begin, end);
+            break;
+        case OPTIM_LAMB:
+            neon_optim_lamb_worker(ctx, begin, end, tid);
+            break;
+    }
+}
+
+
+
+// STEP
+/**
+ * 1 optimizer step trên mọi groups (grads không bị thay đổi, caller tự zero)
+ * @return: NEON_SUCCESS, NEON_ERROR_INVALID_PARAM nếu grad norm không hữu hạn (bỏ qua step)
+*/
+static inline int neon_optim_step(NeonOptimizer* opt, int num_threads) {
+    if (opt == NULL) return NEON_ERROR_NULL_POINTER;
+
+    const NeonOptimConfig* c = &opt->config;
+    float clip = 1.0f;
+
+    if (c->max_grad_norm > 0.0f) {
+        float norm = neon_optim_grad_norm(opt, num_threads);
+        opt->last_grad_norm = norm;
+        if (!isfinite(norm)) return NEON_ERROR_INVALID_PARAM;
+        if (norm > c->max_grad_norm) clip = c->max_grad_norm / (norm + 1e-6f);
+    }
+
+    opt->step++;
+    double bc1 = 1.0 - pow((double)c->beta1, (double)opt->step);
+    double bc2 = 1.0 - pow((double)c->beta2, (double)opt->step);
+
+    NeonOptimStepCtx ctx;
+    ctx.opt = opt;
+    ctx.clip = clip;
+    ctx.step_size = (opt->type == OPTIM_SGD) ? c->lr : (float)(c->lr / bc1);
+    ctx.inv_bc1 = (opt->type == OPTIM_SGD) ? 1.0f : (float)(1.0 / bc1);
+    ctx.inv_bc2 = (opt->type == OPTIM_SGD) ? 1.0f : (float)(1.0 / bc2);
+    ctx.trust = 1.0f;
+
+    for (size_t gi = 0; gi < opt->n_groups; gi++) {
+        size_t n = opt->params[gi]->size;
+        if (n == 0) continue;
+
+        ctx.w = opt->params[gi]->data;
+        ctx.g = opt->grads[gi]->data;
+        ctx.m = opt->m[gi];
+        ctx.v = opt->v[gi];
+        ctx.pass = 0;
+        memset(ctx.w_norm, 0, sizeof(ctx.w_norm));
+        memset(ctx.r_norm, 0, sizeof(ctx.r_norm));
+
+        int threads = neon_threads_for(n, num_threads, NEON_OPTIM_MIN_PER_THREAD);
+        neon_parallel_for(n, threads, neon_optim_step_worker, &ctx);
+
+        if (opt->type == OPTIM_LAMB) {
+            double wn = 0.0, rn = 0.0;
+            for (int t = 0; t < threads; t++) {
+                wn += ctx.w_norm[t];
+                rn += ctx.r_norm[t];
+            }
+            ctx.trust = (wn > 0.0 && rn > 0.0) ? (float)sqrt(wn / rn) : 1.0f;
+            ctx.pass = 1;
+            neon_parallel_for(n, threads, neon_optim_step_worker, &ctx);
+            ctx.trust = 1.0f;
+        }
+    }
+
+    return NEON_SUCCESS;
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_OPTIM_H
@@ -0,0 +1,983 @@
+#ifndef NEON_POINTCLOUD_H
+#define NEON_POINTCLOUD_H
+
+#include "neon_types.h"
+#include "memory_align.h"
+#include "neon_thread.h"
+#include "neon_scan.h"
+#include "neon_topk.h"
+#include "neon_smallmat.h"
+#include <math.h>
+#include <string.h>
+
+
+/**
+ * POINT CLOUD (lidar, ~2M points / sweep)
+ *
+ * SoA: x[n], y[n], z[n] → 1 vld1q_f32 = 4 điểm cùng 1 trục, không cần shuffle
+ *   Sensor thường xuất AoS xyz → neon_pointcloud_from_xyz (vld3q_f32 deinterleave 1 lần)
+ *
+ * TRANSFORM: neon_mat4_transform_points (neon_smallmat.h), 9 FMAs / 4 điểm, chia threads
+ *
+ * FILTER (range, box): mask 4 điểm → compact cả 3 trục bằng neon_compact_store_f32x4 (neon_scan.h)
+ *   → không branch, in-place, NaN (điểm lỗi) luôn bị loại vì mọi so sánh với NaN = false
+ *
+ * VOXEL DOWNSAMPLE:
+ *   Key vectorized: floor(p / leaf) (vcvtmq_s32_f32) → 3 x 21 bits → uint64 (vmovl + vshlq)
+ *   Hash table open addressing (Fibonacci hash, linear probing) key → voxel, cộng dồn sum / count
+ *   Output = centroid mỗi voxel theo thứ tự gặp lần đầu
+ *
+ * KD-TREE: split median theo trục có extent lớn nhất, leaf <= 32 điểm
+ *   Điểm được sắp lại theo thứ tự leaf (SoA liên tục) → leaf scan 4 điểm / vòng,
+ *   chỉ khi có lane < worst distance (vmaxvq_u32) mới vào heap (neon_topk.h, lưu -dist)
+ *
+ * NORMALS: k-NN → covariance 3x3 → eigenvector của eigenvalue nhỏ nhất (analytic, không lặp)
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define NEON_POINTCLOUD_MIN_PER_THREAD 65536
+#define NEON_KDTREE_LEAF 32
+#define NEON_VOXEL_CHUNK 1024
+#define NEON_VOXEL_BITS 21
+
+
+typedef struct
+{
+    float* x;
+    float* y;
+    float* z;
+    size_t n;
+    size_t capacity;
+} NeonPointCloud;
+
+
+
+// CREATE / DESTROY
+static inline int neon_pointcloud_reserve(NeonPointCloud* pc, size_t capacity) {
+    if (pc == NULL) return NEON_ERROR_NULL_POINTER;
+    if (capacity <= pc->capacity) return NEON_SUCCESS;
+
+    float* x = (float*)neon_malloc(capacity * sizeof(float));
+    float* y = (float*)neon_malloc(capacity * sizeof(float));
+    float* z = (float*)neon_malloc(capacity * sizeof(float));
+    if (x == NULL || y == NULL || z == NULL) {
+        neon_free(x);
+        neon_free(y);
+        neon_free(z);
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    if (pc->n > 0) {
+        memcpy(x, pc->x, pc->n * sizeof(float));
+        memcpy(y, pc->y, pc->n * sizeof(float));
+        memcpy(z, pc->z, pc->n * sizeof(float));
+    }
+    neon_free(pc->x);
+    neon_free(pc->y);
+    neon_free(pc->z);
+
+    pc->x = x;
+    pc->y = y;
+    pc->z = z;
+    pc->capacity = capacity;
+    return NEON_SUCCESS;
+}
+
+
+static inline int neon_pointcloud_create(NeonPointCloud* pc, size_t capacity) {
+    if (pc == NULL) return NEON_ERROR_NULL_POINTER;
+
+    pc->x = NULL;
+    pc->y = NULL;
+    pc->z = NULL;
+    pc->n = 0;
+    pc->capacity = 0;
+    return neon_pointcloud_reserve(pc, MAX(capacity, (size_t)4));
+}
+
+
+static inline void neon_pointcloud_destroy(NeonPointCloud* pc) {
+    if (pc == NULL) return;
+
+    neon_free(pc->x);
+    neon_free(pc->y);
+    neon_free(pc->z);
+    pc->x = NULL;
+    pc->y = NULL;
+    pc->z = NULL;
+    pc->n = 0;
+    pc->capacity = 0;
+}
+
+
+/**
+ * AoS xyz [n x 3] → SoA (thay nội dung pc)
+*/
+static inline int neon_pointcloud_from_xyz(NeonPointCloud* pc, const float* xyz, size_t n) {
+    if (pc == NULL || xyz == NULL) return NEON_ERROR_NULL_POINTER;
+
+    int err = neon_pointcloud_reserve(pc, n);
+    if (err != NEON_SUCCESS) return err;
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float32x4x3_t p = vld3q_f32(xyz + i * 3);
+        vst1q_f32(pc->x + i, p.val[0]);
+        vst1q_f32(pc->y + i, p.val[1]);
+        vst1q_f32(pc->z + i, p.val[2]);
+    }
+    for (; i < n; i++) {
+        pc->x[i] = xyz[i * 3];
+        pc->y[i] = xyz[i * 3 + 1];
+        pc->z[i] = xyz[i * 3 + 2];
+    }
+
+    pc->n = n;
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * SoA → AoS xyz [n x 3]
+*/
+static inline void neon_pointcloud_to_xyz(const NeonPointCloud* pc, float* xyz) {
+    size_t i = 0;
+    for (; i + 4 <= pc->n; i += 4) {
+        float32x4x3_t p;
+        p.val[0] = vld1q_f32(pc->x + i);
+        p.val[1] = vld1q_f32(pc->y + i);
+        p.val[2] = vld1q_f32(pc->z + i);
+        vst3q_f32(xyz + i * 3, p);
+    }
+    for (; i < pc->n; i++) {
+        xyz[i * 3] = pc->x[i];
+        xyz[i * 3 + 1] = pc->y[i];
+        xyz[i * 3 + 2] = pc->z[i];
+    }
+}
+
+
+
+// TRANSFORM
+typedef struct {
+    const NeonPointCloud* src;
+    NeonPointCloud* dst;
+    const float* M;
+} NeonPointTransformCtx;
+
+
+static void neon_pointcloud_transform_worker(void* arg, size_t begin, size_t end, int tid) {
+    (void)tid;
+    NeonPointTransformCtx* ctx = (NeonPointTransformCtx*)arg;
+
+    neon_mat4_transform_points(ctx->M,
+                               ctx->src->x + begin, ctx->src->y + begin, ctx->src->z + begin,
+                               ctx->dst->x + begin, ctx->dst->y + begin, ctx->dst->z + begin,
+                               end - begin);
+}
+
+
+/**
+ * dst = M * src (M row-major 4x4 rigid / affine), dst có thể trùng src
+*/
+static inline int neon_pointcloud_transform(const NeonPointCloud* src, const float* M, NeonPointCloud* dst, int num_threads) {
+    if (src == NULL || M == NULL || dst == NULL) return NEON_ERROR_NULL_POINTER;
+
+    size_t n = src->n;
+    if (dst != src) {
+        int err = neon_pointcloud_reserve(dst, n);
+        if (err != NEON_SUCCESS) return err;
+    }
+
+    NeonPointTransformCtx ctx;
+    ctx.src = src;
+    ctx.dst = dst;
+    ctx.M = M;
+
+    num_threads = neon_threads_for(n, num_threads, NEON_POINTCLOUD_MIN_PER_THREAD);
+    neon_parallel_for(n, num_threads, neon_pointcloud_transform_worker, &ctx);
+    dst->n = n;
+    return NEON_SUCCESS;
+}
+
+
+
+// FILTER (MASK + COMPACT)
+/**
+ * Ghi các lane có mask của 4 điểm vào vị trí count (cả 3 trục + index)
+*/
+static NEON_INLINE uint32_t neon_pointcloud_compact4(
+    NeonPointCloud* pc,
+    size_t count,
+    float32x4_t x,
+    float32x4_t y,
+    float32x4_t z,
+    uint32x4_t keep,
+    int32x4_t vidx,
+    int32_t* out_indices
+) {
+    if (out_indices != NULL) neon_compact_store_s32x4(out_indices + count, vidx, keep);
+    neon_compact_store_f32x4(pc->x + count, x, keep);
+    neon_compact_store_f32x4(pc->y + count, y, keep);
+    return neon_compact_store_f32x4(pc->z + count, z, keep);
+}
+
+
+/**
+ * Giữ điểm có min_range <= ||p|| <= max_range (in-place)
+ * @param out_indices: [n] index gốc của điểm được giữ (attributes như intensity), có thể NULL
+ * @return: số điểm còn lại
+*/
+static inline size_t neon_pointcloud_filter_range(NeonPointCloud* pc, float min_range, float max_range, int32_t* out_indices) {
+    float32x4_t lo = vdupq_n_f32(min_range * min_range);
+    float32x4_t hi = vdupq_n_f32(max_range * max_range);
+    int32x4_t vidx = {0, 1, 2, 3};
+    int32x4_t four = vdupq_n_s32(4);
+
+    size_t n = pc->n;
+    size_t count = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t x = vld1q_f32(pc->x + i);
+        float32x4_t y = vld1q_f32(pc->y + i);
+        float32x4_t z = vld1q_f32(pc->z + i);
+        float32x4_t r2 = vfmaq_f32(vfmaq_f32(vmulq_f32(x, x), y, y), z, z);
+        uint32x4_t keep = vandq_u32(vcgeq_f32(r2, lo), vcleq_f32(r2, hi));
+
+        count += neon_pointcloud_compact4(pc, count, x, y, z, keep, vidx, out_indices);
+        vidx = vaddq_s32(vidx, four);
+    }
+
+    for (; i < n; i++) {
+        float x = pc->x[i], y = pc->y[i], z = pc->z[i];
+        float r2 = x * x + y * y + z * z;
+        if (r2 >= min_range * min_range && r2 <= max_range * max_range) {
+            if (out_indices != NULL) out_indices[count] = (int32_t)i;
+            pc->x[count] = x;
+            pc->y[count] = y;
+            pc->z[count] = z;
+            count++;
+        }
+    }
+
+    pc->n = count;
+    return count;
+}
+
+
+/**
+ * Giữ điểm trong box [lo, hi] (inside != 0) hoặc ngoài box (inside = 0, ví dụ bỏ thân xe)
+ * NaN luôn bị loại ở cả 2 mode
+*/
+static inline size_t neon_pointcloud_crop_box(
+    NeonPointCloud* pc,
+    const float* lo,
+    const float* hi,
+    int inside,
+    int32_t* out_indices
+) {
+    float32x4_t lx = vdupq_n_f32(lo[0]), ly = vdupq_n_f32(lo[1]), lz = vdupq_n_f32(lo[2]);
+    float32x4_t hx = vdupq_n_f32(hi[0]), hy = vdupq_n_f32(hi[1]), hz = vdupq_n_f32(hi[2]);
+    int32x4_t vidx = {0, 1, 2, 3};
+    int32x4_t four = vdupq_n_s32(4);
+
+    size_t n = pc->n;
+    size_t count = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t x = vld1q_f32(pc->x + i);
+        float32x4_t y = vld1q_f32(pc->y + i);
+        float32x4_t z = vld1q_f32(pc->z + i);
+
+        uint32x4_t in = vandq_u32(vcgeq_f32(x, lx), vcleq_f32(x, hx));
+        in = vandq_u32(in, vandq_u32(vcgeq_f32(y, ly), vcleq_f32(y, hy)));
+        in = vandq_u32(in, vandq_u32(vcgeq_f32(z, lz), vcleq_f32(z, hz)));
+
+        uint32x4_t keep = in;
+        if (!inside) {
+            // ngoài box và không NaN (x == x)
+            uint32x4_t valid = vandq_u32(vandq_u32(vceqq_f32(x, x), vceqq_f32(y, y)), vceqq_f32(z, z));
+            keep = vbicq_u32(valid, in);
+        }
+
+        count += neon_pointcloud_compact4(pc, count, x, y, z, keep, vidx, out_indices);
+        vidx = vaddq_s32(vidx, four);
+    }
+
+    for (; i < n; i++) {
+        float x = pc->x[i], y = pc->y[i], z = pc->z[i];
+        int in = x >= lo[0] && x <= hi[0] && y >= lo[1] && y <= hi[1] && z >= lo[2] && z <= hi[2];
+        int valid = x == x && y == y && z == z;
+        if (inside ? in : (valid && !in)) {
+            if (out_indices != NULL) out_indices[count] = (int32_t)i;
+            pc->x[count] = x;
+            pc->y[count] = y;
+            pc->z[count] = z;
+            count++;
+        }
+    }
+
+    pc->n = count;
+    return count;
+}
+
+
+
+// VOXEL DOWNSAMPLE
+/**
+ * keys[i] = (ix << 42) | (iy << 21) | iz, i* = floor(p / leaf) + 2^20, clamp [0, 2^21)
+ * → leaf 5 cm phủ ±52 km mỗi trục
+*/
+static inline void neon_voxel_keys(const float* x, const float* y, const float* z, size_t n, float leaf, uint64_t* keys) {
+    const float inv = 1.0f / leaf;
+    const int32_t offset = 1 << (NEON_VOXEL_BITS - 1);
+
+    float32x4_t vinv = vdupq_n_f32(inv);
+    int32x4_t voff = vdupq_n_s32(offset);
+    int32x4_t vlo = vdupq_n_s32(-offset);
+    int32x4_t vhi = vdupq_n_s32(offset - 1);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int32x4_t ix = vminq_s32(vmaxq_s32(vcvtmq_s32_f32(vmulq_f32(vld1q_f32(x + i), vinv)), vlo), vhi);
+        int32x4_t iy = vminq_s32(vmaxq_s32(vcvtmq_s32_f32(vmulq_f32(vld1q_f32(y + i), vinv)), vlo), vhi);
+        int32x4_t iz = vminq_s32(vmaxq_s32(vcvtmq_s32_f32(vmulq_f32(vld1q_f32(z + i), vinv)), vlo), vhi);
+        uint32x4_t ux = vreinterpretq_u32_s32(vaddq_s32(ix, voff));
+        uint32x4_t uy = vreinterpretq_u32_s32(vaddq_s32(iy, voff));
+        uint32x4_t uz = vreinterpretq_u32_s32(vaddq_s32(iz, voff));
+
+        uint64x2_t lo = vorrq_u64(vorrq_u64(vshlq_n_u64(vmovl_u32(vget_low_u32(ux)), 2 * NEON_VOXEL_BITS),
+                                            vshlq_n_u64(vmovl_u32(vget_low_u32(uy)), NEON_VOXEL_BITS)),
+                                  vmovl_u32(vget_low_u32(uz)));
+        uint64x2_t hi = vorrq_u64(vorrq_u64(vshlq_n_u64(vmovl_high_u32(ux), 2 * NEON_VOXEL_BITS),
+                                            vshlq_n_u64(vmovl_high_u32(uy), NEON_VOXEL_BITS)),
+                                  vmovl_high_u32(uz));
+        vst1q_u64(keys + i, lo);
+        vst1q_u64(keys + i + 2, hi);
+    }
+
+    for (; i < n; i++) {
+        // Clamp trước khi convert (float → int ngoài range là UB, vcvtmq thì saturate)
+        float fx = floorf(x[i] * inv), fy = floorf(y[i] * inv), fz = floorf(z[i] * inv);
+        int32_t ix = (fx > (float)-offset) ? (int32_t)MIN(fx, (float)(offset - 1)) + offset : 0;
+        int32_t iy = (fy > (float)-offset) ? (int32_t)MIN(fy, (float)(offset - 1)) + offset : 0;
+        int32_t iz = (fz > (float)-offset) ? (int32_t)MIN(fz, (float)(offset - 1)) + offset : 0;
+        keys[i] = ((uint64_t)ix << (2 * NEON_VOXEL_BITS)) | ((uint64_t)iy << NEON_VOXEL_BITS) | (uint64_t)iz;
+    }
+}
+
+
+/**
+ * dst = centroid của các điểm trong mỗi voxel cạnh leaf (dst có thể trùng src)
+ * Điểm NaN bị bỏ qua
+*/
+static inline int neon_pointcloud_voxel_downsample(const NeonPointCloud* src, float leaf, NeonPointCloud* dst) {
+    if (src == NULL || dst == NULL) return NEON_ERROR_NULL_POINTER;
+    if (!(leaf > 0.0f)) return NEON_ERROR_INVALID_PARAM;
+
+    const size_t n = src->n;
+    size_t cap = 16;
+    while (cap < n * 2) cap *= 2;
+    int shift = 64;
+    for (size_t c = cap; c > 1; c >>= 1) shift--;
+
+    uint64_t* table_keys = (uint64_t*)neon_malloc(cap * sizeof(uint64_t));
+    uint32_t* table_slot = (uint32_t*)neon_malloc(cap * sizeof(uint32_t));
+    float* acc = (float*)neon_malloc((n * 4 + 4) * sizeof(float)); // [sx, sy, sz, count] mỗi voxel
+
+    if (table_keys == NULL || table_slot == NULL || acc == NULL) {
+        neon_free(table_keys);
+        neon_free(table_slot);
+        neon_free(acc);
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    memset(table_keys, 0xFF, cap * sizeof(uint64_t)); // UINT64_MAX = trống (key thật < 2^63)
+
+    uint64_t keys[NEON_VOXEL_CHUNK];
+    size_t n_voxels = 0;
+
+    for (size_t base = 0; base < n; base += NEON_VOXEL_CHUNK) {
+        size_t m = MIN((size_t)NEON_VOXEL_CHUNK, n - base);
+        neon_voxel_keys(src->x + base, src->y + base, src->z + base, m, leaf, keys);
+
+        for (size_t i = 0; i < m; i++) {
+            float px = src->x[base + i], py = src->y[base + i], pz = src->z[base + i];
+            if (px != px || py != py || pz != pz) continue;
+
+            uint64_t key = keys[i];
+            size_t h = (size_t)((key * 0x9E3779B97F4A7C15ull) >> shift);
+            while (table_keys[h] != key && table_keys[h] != UINT64_MAX) {
+                h = (h + 1) & (cap - 1);
+            }
+
+            float* a;
+            if (table_keys[h] == UINT64_MAX) {
+                table_keys[h] = key;
+                table_slot[h] = (uint32_t)n_voxels;
+                a = acc + n_voxels * 4;
+                vst1q_f32(a, vdupq_n_f32(0.0f));
+                n_voxels++;
+            } else {
+                a = acc + (size_t)table_slot[h] * 4;
+            }
+
+            float32x4_t p = {px, py, pz, 1.0f};
+            vst1q_f32(a, vaddq_f32(vld1q_f32(a), p));
+        }
+    }
+
+    int err = NEON_SUCCESS;
+    if (dst != src) err = neon_pointcloud_reserve(dst, n_voxels);
+
+    if (err == NEON_SUCCESS) {
+        for (size_t v = 0; v < n_voxels; v++) {
+            float32x4_t a = vld1q_f32(acc + v * 4);
+            float32x4_t c = vdivq_f32(a, vdupq_laneq_f32(a, 3));
+            dst->x[v] = vgetq_lane_f32(c, 0);
+            dst->y[v] = vgetq_lane_f32(c, 1);
+            dst->z[v] = vgetq_lane_f32(c, 2);
+        }
+        dst->n = n_voxels;
+    }
+
+    neon_free(table_keys);
+    neon_free(table_slot);
+    neon_free(acc);
+    return err;
+}
+
+
+
+// KD-TREE
+typedef struct {
+    float split;
+    int32_t dim; // -1 = leaf
+    uint32_t left; // leaf: begin
+    uint32_t right; // leaf: end
+} NeonKdNode;
+
+
+typedef struct
+{
+    float* x; // điểm sắp theo thứ tự leaf
+    float* y;
+    float* z;
+    int32_t* ids; // index trong cloud gốc
+    NeonKdNode* nodes;
+    size_t n;
+    size_t n_nodes;
+} NeonKdTree;
+
+
+static NEON_INLINE float neon_kdtree_coord(const NeonPointCloud* pc, int32_t i, int dim) {
+    return (dim == 0) ? pc->x[i] : (dim == 1) ? pc->y[i] : pc->z[i];
+}
+
+
+/**
+ * Quickselect: perm[mid] = phần tử thứ mid theo trục dim trong [begin, end)
+*/
+static inline void neon_kdtree_select(const NeonPointCloud* pc, int32_t* perm, size_t begin, size_t end, size_t mid, int dim) {
+    while (end - begin > 1) {
+        size_t a = begin, b = begin + (end - begin) / 2, c = end - 1;
+        float va = neon_kdtree_coord(pc, perm[a], dim);
+        float vb = neon_kdtree_coord(pc, perm[b], dim);
+        float vc = neon_kdtree_coord(pc, perm[c], dim);
+        float pivot = (va < vb) ? ((vb < vc) ? vb : MAX(va, vc)) : ((va < vc) ? va : MAX(vb, vc));
+
+        // 3-way partition: [< pivot][== pivot][> pivot]
+        size_t lt = begin, i = begin, gt = end;
+        while (i < gt) {
+            float v = neon_kdtree_coord(pc, perm[i], dim);
+            if (v < pivot) {
+                int32_t t = perm[lt]; perm[lt] = perm[i]; perm[i] = t;
+                lt++;
+                i++;
+            } else if (v > pivot) {
+                gt--;
+                int32_t t = perm[gt]; perm[gt] = perm[i]; perm[i] = t;
+            } else {
+                i++;
+            }
+        }
+
+        if (mid < lt) end = lt;
+        else if (mid >= gt) begin = gt;
+        else return;
+    }
+}
+
+
+static inline uint32_t neon_kdtree_build_node(NeonKdTree* t, const NeonPointCloud* pc, int32_t* perm, size_t begin, size_t end) {
+    uint32_t id = (uint32_t)t->n_nodes++;
+    NeonKdNode* node = &t->nodes[id];
+
+    float lo[3] = {INFINITY, INFINITY, INFINITY};
+    float hi[3] = {-INFINITY, -INFINITY, -INFINITY};
+    if (end - begin > NEON_KDTREE_LEAF) {
+        for (size_t i = begin; i < end; i++) {
+            int32_t p = perm[i];
+            lo[0] = MIN(lo[0], pc->x[p]); hi[0] = MAX(hi[0], pc->x[p]);
+            lo[1] = MIN(lo[1], pc->y[p]); hi[1] = MAX(hi[1], pc->y[p]);
+            lo[2] = MIN(lo[2], pc->z[p]); hi[2] = MAX(hi[2], pc->z[p]);
+        }
+    }
+
+    int dim = 0;
+    float extent = hi[0] - lo[0];
+    if (hi[1] - lo[1] > extent) { dim = 1; extent = hi[1] - lo[1]; }
+    if (hi[2] - lo[2] > extent) { dim = 2; extent = hi[2] - lo[2]; }
+
+    // Leaf: đủ nhỏ hoặc mọi điểm trùng nhau
+    if (end - begin <= NEON_KDTREE_LEAF || !(extent > 0.0f)) {
+        node->dim = -1;
+        node->split = 0.0f;
+        node->left = (uint32_t)begin;
+        node->right = (uint32_t)end;
+        return id;
+    }
+
+    size_t mid = begin + (end - begin) / 2;
+    neon_kdtree_select(pc, perm, begin, end, mid, dim);
+
+    float split = neon_kdtree_coord(pc, perm[mid], dim);
+    uint32_t left = neon_kdtree_build_node(t, pc, perm, begin, mid);
+    uint32_t right = neon_kdtree_build_node(t, pc, perm, mid, end);
+
+    node->dim = dim;
+    node->split = split;
+    node->left = left;
+    node->right = right;
+    return id;
+}
+
+
+/**
+ * Build kd-tree trên pc (copy điểm, pc có thể thay đổi sau đó)
+ * Điểm NaN phải được lọc trước (neon_pointcloud_filter_range)
+*/
+static inline int neon_kdtree_build(NeonKdTree* t, const NeonPointCloud* pc) {
+    if (t == NULL || pc == NULL) return NEON_ERROR_NULL_POINTER;
+    if (pc->n == 0 || pc->n > 0x7FFFFFFF) return NEON_ERROR_INVALID_SIZE;
+
+    const size_t n = pc->n;
+    size_t max_nodes = 2 * (n / (NEON_KDTREE_LEAF / 2) + 1);
+
+    t->x = (float*)neon_malloc(n * sizeof(float));
+    t->y = (float*)neon_malloc(n * sizeof(float));
+    t->z = (float*)neon_malloc(n * sizeof(float));
+    t->ids = (int32_t*)neon_malloc(n * sizeof(int32_t));
+    t->nodes = (NeonKdNode*)neon_malloc(max_nodes * sizeof(NeonKdNode));
+    t->n = n;
+    t->n_nodes = 0;
+
+    if (t->x == NULL || t->y == NULL || t->z == NULL || t->ids == NULL || t->nodes == NULL) {
+        neon_free(t->x);
+        neon_free(t->y);
+        neon_free(t->z);
+        neon_free(t->ids);
+        neon_free(t->nodes);
+        t->x = t->y = t->z = NULL;
+        t->ids = NULL;
+        t->nodes = NULL;
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    for (size_t i = 0; i < n; i++) t->ids[i] = (int32_t)i;
+    neon_kdtree_build_node(t, pc, t->ids, 0, n);
+
+    for (size_t i = 0; i < n; i++) {
+        int32_t p = t->ids[i];
+        t->x[i] = pc->x[p];
+        t->y[i] = pc->y[p];
+        t->z[i] = pc->z[p];
+    }
+    return NEON_SUCCESS;
+}
+
+
+static inline void neon_kdtree_destroy(NeonKdTree* t) {
+    if (t == NULL) return;
+
+    neon_free(t->x);
+    neon_free(t->y);
+    neon_free(t->z);
+    neon_free(t->ids);
+    neon_free(t->nodes);
+    t->x = t->y = t->z = NULL;
+    t->ids = NULL;
+    t->nodes = NULL;
+    t->n = 0;
+    t->n_nodes = 0;
+}
+
+
+/**
+ * k-NN đệ quy, heap (heap_v = -dist², heap_i = vị trí trong tree) đủ k phần tử, khởi tạo -inf
+*/
+static void neon_kdtree_knn_node(
+    const NeonKdTree* t,
+    uint32_t node_id,
+    float qx,
+    float qy,
+    float qz,
+    size_t k,
+    float* heap_v,
+    int32_t* heap_i
+) {
+    const NeonKdNode* node = &t->nodes[node_id];
+
+    if (node->dim < 0) {
+        float32x4_t vqx = vdupq_n_f32(qx), vqy = vdupq_n_f32(qy), vqz = vdupq_n_f32(qz);
+        size_t j = node->left;
+        size_t end = node->right;
+
+        for (; j + 4 <= end; j += 4) {
+            float32x4_t dx = vsubq_f32(vld1q_f32(t->x + j), vqx);
+            float32x4_t dy = vsubq_f32(vld1q_f32(t->y + j), vqy);
+            float32x4_t dz = vsubq_f32(vld1q_f32(t->z + j), vqz);
+            float32x4_t d = vfmaq_f32(vfmaq_f32(vmulq_f32(dx, dx), dy, dy), dz, dz);
+
+            if (vmaxvq_u32(vcltq_f32(d, vdupq_n_f32(-heap_v[0]))) == 0) continue;
+
+            float dd[4];
+            vst1q_f32(dd, d);
+            for (int l = 0; l < 4; l++) {
+                if (-dd[l] > heap_v[0]) neon_topk_push(heap_v, heap_i, k, -dd[l], (int32_t)(j + l));
+            }
+        }
+        for (; j < end; j++) {
+            float dx = t->x[j] - qx, dy = t->y[j] - qy, dz = t->z[j] - qz;
+            float d = dx * dx + dy * dy + dz * dz;
+            if (-d > heap_v[0]) neon_topk_push(heap_v, heap_i, k, -d, (int32_t)j);
+        }
+        return;
+    }
+
+    float q = (node->dim == 0) ? qx : (node->dim == 1) ? qy : qz;
+    float diff = q - node->split;
+    uint32_t near_id = (diff < 0.0f) ? node->left : node->right;
+    uint32_t far_id = (diff < 0.0f) ? node->right : node->left;
+
+    neon_kdtree_knn_node(t, near_id, qx, qy, qz, k, heap_v, heap_i);
+    if (diff * diff < -heap_v[0]) {
+        neon_kdtree_knn_node(t, far_id, qx, qy, qz, k, heap_v, heap_i);
+    }
+}
+
+
+/**
+ * k điểm gần q nhất, out_dist (khoảng cách bình phương) tăng dần
+ * @param out_ids: vị trí trong tree (t->x / t->ids), dùng t->ids[...] để ra index gốc
+ * @return: min(k, n)
+*/
+static inline size_t neon_kdtree_knn_local(const NeonKdTree* t, const float* q, size_t k, float* out_dist, int32_t* out_ids) {
+    if (k == 0 || t->n == 0) return 0;
+
+    for (size_t i = 0; i < k; i++) {
+        out_dist[i] = -INFINITY;
+        out_ids[i] = -1;
+    }
+
+    neon_kdtree_knn_node(t, 0, q[0], q[1], q[2], k, out_dist, out_ids);
+    neon_topk_heap_sort_desc(out_dist, out_ids, k);
+
+    size_t count = MIN(k, t->n);
+    for (size_t i = 0; i < count; i++) out_dist[i] = -out_dist[i];
+    return count;
+}
+
+
+/**
+ * k-NN, out_ids là index trong cloud gốc
+*/
+static inline size_t neon_kdtree_knn(const NeonKdTree* t, const float* q, size_t k, float* out_dist, int32_t* out_ids) {
+    size_t count = neon_kdtree_knn_local(t, q, k, out_dist, out_ids);
+    for (size_t i = 0; i < count; i++) out_ids[i] = t->ids[out_ids[i]];
+    return count;
+}
+
+
+static size_t neon_kdtree_radius_node(
+    const NeonKdTree* t,
+    uint32_t node_id,
+    const float* q,
+    float r2,
+    int32_t* out_ids,
+    size_t max_out,
+    size_t count
+) {
+    const NeonKdNode* node = &t->nodes[node_id];
+
+    if (node->dim < 0) {
+        float32x4_t vqx = vdupq_n_f32(q[0]), vqy = vdupq_n_f32(q[1]), vqz = vdupq_n_f32(q[2]);
+        float32x4_t vr2 = vdupq_n_f32(r2);
+        size_t j = node->left;
+        size_t end = node->right;
+
+        for (; j + 4 <= end; j += 4) {
+            float32x4_t dx = vsubq_f32(vld1q_f32(t->x + j), vqx);
+            float32x4_t dy = vsubq_f32(vld1q_f32(t->y + j), vqy);
+            float32x4_t dz = vsubq_f32(vld1q_f32(t->z + j), vqz);
+            float32x4_t d = vfmaq_f32(vfmaq_f32(vmulq_f32(dx, dx), dy, dy), dz, dz);
+            uint32x4_t m = vcleq_f32(d, vr2);
+
+            uint32_t bits = neon_mask_bits_u32x4(m);
+            if (bits == 0) continue;
+
+            if (count + 4 <= max_out) {
+                int32x4_t vid = vld1q_s32(t->ids + j);
+                count += neon_compact_store_s32x4(out_ids + count, vid, m);
+            } else {
+                for (int l = 0; l < 4; l++) {
+                    if (bits & (1u << l)) {
+                        if (count < max_out) out_ids[count] = t->ids[j + l];
+                        count++;
+                    }
+                }
+            }
+        }
+        for (; j < end; j++) {
+            float dx = t->x[j] - q[0], dy = t->y[j] - q[1], dz = t->z[j] - q[2];
+            if (dx * dx + dy * dy + dz * dz <= r2) {
+                if (count < max_out) out_ids[count] = t->ids[j];
+                count++;
+            }
+        }
+        return count;
+    }
+
+    float diff = q[node->dim] - node->split;
+    if (diff <= 0.0f || diff * diff <= r2) count = neon_kdtree_radius_node(t, node->left, q, r2, out_ids, max_out, count);
+    if (diff >= 0.0f || diff * diff <= r2) count = neon_kdtree_radius_node(t, node->right, q, r2, out_ids, max_out, count);
+    return count;
+}
+
+
+/**
+ * Mọi điểm có ||p - q|| <= radius (không sắp xếp), ghi tối đa max_out ids gốc
+ * @return: tổng số điểm tìm thấy (> max_out nghĩa là out_ids bị cắt)
+*/
+static inline size_t neon_kdtree_radius(const NeonKdTree* t, const float* q, float radius, int32_t* out_ids, size_t max_out) {
+    if (t->n == 0) return 0;
+    return neon_kdtree_radius_node(t, 0, q, radius * radius, out_ids, max_out, 0);
+}
+
+
+
+// NORMALS
+/**
+ * Eigenvector của eigenvalue nhỏ nhất, ma trận đối xứng 3x3 [a00 a01 a02 a11 a12 a22]
+ * Eigenvalues analytic (trigonometric), vector = cross product lớn nhất của 2 hàng (A - λI)
+ * @return: λ_min / (λ0 + λ1 + λ2) (curvature)
+*/
+static inline float neon_sym3_smallest_eigvec(const double* c, float* out) {
+    double a00 = c[0], a01 = c[1], a02 = c[2], a11 = c[3], a12 = c[4], a22 = c[5];
+    double trace = a00 + a11 + a22;
+    double p1 = a01 * a01 + a02 * a02 + a12 * a12;
+    double q = trace / 3.0;
+    double p2 = (a00 - q) * (a00 - q) + (a11 - q) * (a11 - q) + (a22 - q) * (a22 - q) + 2.0 * p1;
+
+    out[0] = 0.0f;
+    out[1] = 0.0f;
+    out[2] = 1.0f;
+    if (!(p2 > 1e-30 * (trace * trace + 1e-300))) return (trace > 0.0) ? 1.0f / 3.0f : 0.0f;
+
+    double p = sqrt(p2 / 6.0);
+    double b00 = (a00 - q) / p, b11 = (a11 - q) / p, b22 = (a22 - q) / p;
+    double b01 = a01 / p, b02 = a02 / p, b12 = a12 / p;
+    double r = 0.5 * (b00 * (b11 * b22 - b12 * b12) - b01 * (b01 * b22 - b12 * b02) + b02 * (b01 * b12 - b11 * b02));
+    r = CLAMP(r, -1.0, 1.0);
+    double phi = acos(r) / 3.0;
+    double lambda = q + 2.0 * p * cos(phi + 2.0943951023931957); // + 2π/3 → nhỏ nhất
+
+    double r0[3] = {a00 - lambda, a01, a02};
+    double r1[3] = {a01, a11 - lambda, a12};
+    double r2[3] = {a02, a12, a22 - lambda};
+    double c01[3] = {r0[1] * r1[2] - r0[2] * r1[1], r0[2] * r1[0] - r0[0] * r1[2], r0[0] * r1[1] - r0[1] * r1[0]};
+    double c02[3] = {r0[1] * r2[2] - r0[2] * r2[1], r0[2] * r2[0] - r0[0] * r2[2], r0[0] * r2[1] - r0[1] * r2[0]};
+    double c12[3] = {r1[1] * r2[2] - r1[2] * r2[1], r1[2] * r2[0] - r1[0] * r2[2], r1[0] * r2[1] - r1[1] * r2[0]};
+    double d01 = c01[0] * c01[0] + c01[1] * c01[1] + c01[2] * c01[2];
+    double d02 = c02[0] * c02[0] + c02[1] * c02[1] + c02[2] * c02[2];
+    double d12 = c12[0] * c12[0] + c12[1] * c12[1] + c12[2] * c12[2];
+
+    const double* best = c01;
+    double dmax = d01;
+    if (d02 > dmax) { best = c02; dmax = d02; }
+    if (d12 > dmax) { best = c12; dmax = d12; }
+
+    if (dmax > 0.0) {
+        double inv = 1.0 / sqrt(dmax);
+        out[0] = (float)(best[0] * inv);
+        out[1] = (float)(best[1] * inv);
+        out[2] = (float)(best[2] * inv);
+    }
+
+    return (trace > 0.0) ? (float)(MAX(lambda, 0.0) / trace) : 0.0f;
+}
+
+
+typedef struct {
+    const NeonPointCloud* pc;
+    const NeonKdTree* tree;
+    size_t k;
+    const float* viewpoint;
+    float* nx;
+    float* ny;
+    float* nz;
+    float* curvature;
+    int error[NEON_MAX_THREADS];
+} NeonNormalsCtx;
+
+
+static void neon_normals_worker(void* arg, size_t begin, size_t end, int tid) {
+    NeonNormalsCtx* ctx = (NeonNormalsCtx*)arg;
+    const NeonKdTree* t = ctx->tree;
+    const size_t k = ctx->k;
+
+    float* dist = (float*)neon_malloc(k * 4 * sizeof(float)); // dist | px | py | pz
+    int32_t* ids = (int32_t*)neon_malloc(k * sizeof(int32_t));
+    if (dist == NULL || ids == NULL) {
+        neon_free(dist);
+        neon_free(ids);
+        ctx->error[tid] = NEON_ERROR_OUT_OF_MEMORY;
+        return;
+    }
+    float* px = dist + k;
+    float* py = dist + 2 * k;
+    float* pz = dist + 3 * k;
+
+    for (size_t i = begin; i < end; i++) {
+        float q[3] = {ctx->pc->x[i], ctx->pc->y[i], ctx->pc->z[i]};
+        size_t m = neon_kdtree_knn_local(t, q, k, dist, ids);
+
+        for (size_t j = 0; j < m; j++) {
+            px[j] = t->x[ids[j]];
+            py[j] = t->y[ids[j]];
+            pz[j] = t->z[ids[j]];
+        }
+
+        // Mean
+        float32x4_t sx = vdupq_n_f32(0.0f), sy = vdupq_n_f32(0.0f), sz = vdupq_n_f32(0.0f);
+        size_t j = 0;
+        for (; j + 4 <= m; j += 4) {
+            sx = vaddq_f32(sx, vld1q_f32(px + j));
+            sy = vaddq_f32(sy, vld1q_f32(py + j));
+            sz = vaddq_f32(sz, vld1q_f32(pz + j));
+        }
+        float mx = vaddvq_f32(sx), my = vaddvq_f32(sy), mz = vaddvq_f32(sz);
+        for (; j < m; j++) {
+            mx += px[j];
+            my += py[j];
+            mz += pz[j];
+        }
+        float inv_m = 1.0f / (float)m;
+        mx *= inv_m;
+        my *= inv_m;
+        mz *= inv_m;
+
+        // Covariance (centered)
+        float32x4_t vmx = vdupq_n_f32(mx), vmy = vdupq_n_f32(my), vmz = vdupq_n_f32(mz);
+        float32x4_t cxx = vdupq_n_f32(0.0f), cxy = vdupq_n_f32(0.0f), cxz = vdupq_n_f32(0.0f);
+        float32x4_t cyy = vdupq_n_f32(0.0f), cyz = vdupq_n_f32(0.0f), czz = vdupq_n_f32(0.0f);
+        j = 0;
+        for (; j + 4 <= m; j += 4) {
+            float32x4_t dx = vsubq_f32(vld1q_f32(px + j), vmx);
+            float32x4_t dy = vsubq_f32(vld1q_f32(py + j), vmy);
+            float32x4_t dz = vsubq_f32(vld1q_f32(pz + j), vmz);
+            cxx = vfmaq_f32(cxx, dx, dx);
+            cxy = vfmaq_f32(cxy, dx, dy);
+            cxz = vfmaq_f32(cxz, dx, dz);
+            cyy = vfmaq_f32(cyy, dy, dy);
+            cyz = vfmaq_f32(cyz, dy, dz);
+            czz = vfmaq_f32(czz, dz, dz);
+        }
+        double cov[6] = {vaddvq_f32(cxx), vaddvq_f32(cxy), vaddvq_f32(cxz),
+                         vaddvq_f32(cyy), vaddvq_f32(cyz), vaddvq_f32(czz)};
+        for (; j < m; j++) {
+            double dx = px[j] - mx, dy = py[j] - my, dz = pz[j] - mz;
+            cov[0] += dx * dx;
+            cov[1] += dx * dy;
+            cov[2] += dx * dz;
+            cov[3] += dy * dy;
+            cov[4] += dy * dz;
+            cov[5] += dz * dz;
+        }
+
+        float nrm[3];
+        float curv = neon_sym3_smallest_eigvec(cov, nrm);
+
+        // Hướng normal về phía viewpoint (sensor)
+        if (ctx->viewpoint != NULL) {
+            float dot = nrm[0] * (ctx->viewpoint[0] - q[0]) + nrm[1] * (ctx->viewpoint[1] - q[1]) + nrm[2] * (ctx->viewpoint[2] - q[2]);
+            if (dot < 0.0f) {
+                nrm[0] = -nrm[0];
+                nrm[1] = -nrm[1];
+                nrm[2] = -nrm[2];
+            }
+        }
+
+        ctx->nx[i] = nrm[0];
+        ctx->ny[i] = nrm[1];
+        ctx->nz[i] = nrm[2];
+        if (ctx->curvature != NULL) ctx->curvature[i] = curv;
+    }
+
+    neon_free(dist);
+    neon_free(ids);
+}
+
+
+/**
+ * Normal mỗi điểm của pc từ k neighbors trong tree (thường tree build trên chính pc)
+ *
+ * @param viewpoint: [3] vị trí sensor để định hướng normal, NULL = không định hướng
+ * @param curvature: [n] λ_min / Σλ, có thể NULL
+*/
+static inline int neon_pointcloud_normals(
+    const NeonPointCloud* pc,
+    const NeonKdTree* tree,
+    size_t k,
+    const float* viewpoint,
+    float* nx,
+    float* ny,
+    float* nz,
+    float* curvature,
+    int num_threads
+) {
+    if (pc == NULL || tree == NULL || nx == NULL || ny == NULL || nz == NULL) return NEON_ERROR_NULL_POINTER;
+    if (k < 3) return NEON_ERROR_INVALID_PARAM;
+
+    NeonNormalsCtx ctx;
+    ctx.pc = pc;
+    ctx.tree = tree;
+    ctx.k = k;
+    ctx.viewpoint = viewpoint;
+    ctx.nx = nx;
+    ctx.ny = ny;
+    ctx.nz = nz;
+    ctx.curvature = curvature;
+    memset(ctx.error, 0, sizeof(ctx.error));
+
+    num_threads = neon_threads_for(pc->n, num_threads, 1024);
+    neon_parallel_for(pc->n, num_threads, neon_normals_worker, &ctx);
+
+    for (int t = 0; t < num_threads; t++) {
+        if (ctx.error[t] != NEON_SUCCESS) return ctx.error[t];
+    }
+    return NEON_SUCCESS;
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_POINTCLOUD_H
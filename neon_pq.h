@@ -0,0 +1,531 @@
+#ifndef NEON_PQ_H
+#define NEON_PQ_H
+
+#include "neon_types.h"
+#include "memory_align.h"
+#include "neon_thread.h"
+#include "neon_topk.h"
+#include "neon_kmeans.h"
+#include <math.h>
+#include <string.h>
+
+
+/**
+ * PRODUCT QUANTIZATION + 4-BIT FAST SCAN
+ *
+ * Vector dim D chia thành M subspaces (dsub = D / M), mỗi subspace 1 codebook 16 centroids (neon_kmeans.h)
+ *   → mỗi vector = M codes 4-bit = M / 2 bytes (D = 128, M = 32: 512 bytes → 16 bytes)
+ *
+ * ASYMMETRIC DISTANCE (ADC): query giữ nguyên f32
+ *   LUT[m][c] = ||q_m - centroid[m][c]||²  (M x 16 floats, tính 1 lần / query)
+ *   dist(q, x) ≈ Σ_m LUT[m][code_m(x)]
+ *
+ * FAST SCAN (LUT nằm trong register, không gather từ memory):
+ *   LUT quantize uint8: (LUT[m][c] - min_m) * scale, scale chung cho mọi m
+ *   → 16 entries của 1 subspace = đúng 1 uint8x16_t → vqtbl1q_u8(lut_m, codes) = 16 lookups / lệnh
+ *   Layout codes theo block 16 vectors: byte v của pair p = code[v][2p] | code[v][2p + 1] << 4
+ *     → 1 load 16 bytes = 2 subspaces x 16 vectors, unpack bằng vandq_u8 / vshrq_n_u8
+ *   Cộng dồn uint16 (vaddw_u8): M <= 256 → tổng <= 65280, không tràn
+ *   Mỗi vòng 2 blocks (32 vectors) dùng chung 1 lần load LUT
+ *
+ * TOP-K: heap của neon_topk.h trên -dist, block có 16 dist >= threshold bị bỏ qua (vcltq_u16 + vmaxvq)
+ *   Fast scan lấy k * rerank candidates theo dist đã quantize, rerank bằng LUT f32
+ *
+ * Throughput: M = 32 → 16 bytes / vector, mỗi 16 bytes code = 2 x vqtbl1q_u8 + 4 x vaddw
+ *   → scan bị giới hạn bởi bandwidth đọc codes, chia blocks cho nhiều threads
+ *
+ * Index dùng int32 ids (như neon_topk.h) → shard khi > 2^31 vectors
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define NEON_PQ_KSUB 16 // 4-bit codes
+#define NEON_PQ_BLOCK 16 // vectors / block
+#define NEON_PQ_MIN_BLOCKS_PER_THREAD 2048
+
+
+typedef struct
+{
+    float* centroids; // [M x 16 x dsub]
+    uint8_t* codes; // [num_blocks x pairs x 16] (layout fast scan)
+    size_t dim;
+    size_t M;
+    size_t dsub;
+    size_t pairs; // (M + 1) / 2, subspace lẻ cuối cùng ghép với LUT = 0
+    size_t n;
+    size_t capacity; // vectors, bội của 16
+} NeonPQ;
+
+
+
+// HELPERS
+/**
+ * ||a - b||² với dsub nhỏ
+*/
+static NEON_INLINE float neon_pq_l2(const float* a, const float* b, size_t d) {
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    size_t j = 0;
+    for (; j + 4 <= d; j += 4) {
+        float32x4_t diff = vsubq_f32(vld1q_f32(a + j), vld1q_f32(b + j));
+        acc = vfmaq_f32(acc, diff, diff);
+    }
+    float s = vaddvq_f32(acc);
+    for (; j < d; j++) {
+        float diff = a[j] - b[j];
+        s += diff * diff;
+    }
+    return s;
+}
+
+
+/**
+ * Centroid gần nhất trong 16
+*/
+static inline uint8_t neon_pq_nearest(const float* x, const float* centroids, size_t dsub) {
+    uint8_t best = 0;
+    float best_d = INFINITY;
+    for (int c = 0; c < NEON_PQ_KSUB; c++) {
+        float d = neon_pq_l2(x, centroids + (size_t)c * dsub, dsub);
+        if (d < best_d) {
+            best_d = d;
+            best = (uint8_t)c;
+        }
+    }
+    return best;
+}
+
+
+static NEON_INLINE uint8_t* neon_pq_code_byte(const NeonPQ* pq, size_t i, size_t m) {
+    size_t block = i / NEON_PQ_BLOCK;
+    return pq->codes + (block * pq->pairs + m / 2) * NEON_PQ_BLOCK + (i % NEON_PQ_BLOCK);
+}
+
+
+static NEON_INLINE uint8_t neon_pq_get_code(const NeonPQ* pq, size_t i, size_t m) {
+    uint8_t b = *neon_pq_code_byte(pq, i, m);
+    return (m & 1) ? (uint8_t)(b >> 4) : (uint8_t)(b & 0x0F);
+}
+
+
+
+// CREATE / DESTROY
+/**
+ * @param M: số subspaces, dim % M == 0, M <= 256
+*/
+static inline int neon_pq_create(NeonPQ* pq, size_t dim, size_t M) {
+    if (pq == NULL) return NEON_ERROR_NULL_POINTER;
+    if (dim == 0 || M == 0 || M > 256 || dim % M != 0) return NEON_ERROR_INVALID_SIZE;
+
+    pq->centroids = (float*)neon_malloc(M * NEON_PQ_KSUB * (dim / M) * sizeof(float));
+    if (pq->centroids == NULL) return NEON_ERROR_OUT_OF_MEMORY;
+    memset(pq->centroids, 0, M * NEON_PQ_KSUB * (dim / M) * sizeof(float));
+
+    pq->codes = NULL;
+    pq->dim = dim;
+    pq->M = M;
+    pq->dsub = dim / M;
+    pq->pairs = (M + 1) / 2;
+    pq->n = 0;
+    pq->capacity = 0;
+    return NEON_SUCCESS;
+}
+
+
+static inline void neon_pq_destroy(NeonPQ* pq) {
+    if (pq == NULL) return;
+
+    neon_free(pq->centroids);
+    aligned_free(pq->codes);
+    pq->centroids = NULL;
+    pq->codes = NULL;
+    pq->n = 0;
+    pq->capacity = 0;
+}
+
+
+
+// TRAIN
+/**
+ * Train codebooks từ data [n x dim] (n >= 16)
+ * Mỗi subspace: k-means (neon_kmeans.h) 16 centroids trên sub-vectors [n x dsub]
+*/
+static inline int neon_pq_train(NeonPQ* pq, const float* data, size_t n, int iterations, uint64_t seed, int num_threads) {
+    if (pq == NULL || data == NULL) return NEON_ERROR_NULL_POINTER;
+    if (n < NEON_PQ_KSUB) return NEON_ERROR_INVALID_SIZE;
+
+    NeonKMeans km;
+    int err = neon_kmeans_create(&km, NEON_PQ_KSUB, pq->dsub);
+    if (err != NEON_SUCCESS) return err;
+
+    float* sub = (float*)neon_malloc(n * pq->dsub * sizeof(float));
+    if (sub == NULL) {
+        neon_kmeans_destroy(&km);
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    for (size_t m = 0; m < pq->M && err == NEON_SUCCESS; m++) {
+        for (size_t i = 0; i < n; i++) {
+            memcpy(sub + i * pq->dsub, data + i * pq->dim + m * pq->dsub, pq->dsub * sizeof(float));
+        }
+        err = neon_kmeans_fit(&km, sub, n, iterations, 0.0f, seed + m, NULL, num_threads);
+        if (err == NEON_SUCCESS) {
+            memcpy(pq->centroids + m * NEON_PQ_KSUB * pq->dsub, km.centroids, NEON_PQ_KSUB * pq->dsub * sizeof(float));
+        }
+    }
+
+    neon_free(sub);
+    neon_kmeans_destroy(&km);
+    return err;
+}
+
+
+
+// ENCODE / ADD
+static inline int neon_pq_reserve(NeonPQ* pq, size_t n) {
+    if (n <= pq->capacity) return NEON_SUCCESS;
+
+    size_t capacity = MAX(pq->capacity * 2, (size_t)1024);
+    while (capacity < n) capacity *= 2;
+
+    size_t block_bytes = pq->pairs * NEON_PQ_BLOCK;
+    uint8_t* codes = (uint8_t*)aligned_malloc(capacity / NEON_PQ_BLOCK * block_bytes, NEON_CACHE_LINE);
+    if (codes == NULL) return NEON_ERROR_OUT_OF_MEMORY;
+
+    size_t old_bytes = pq->capacity / NEON_PQ_BLOCK * block_bytes;
+    if (pq->codes != NULL) memcpy(codes, pq->codes, old_bytes);
+    memset(codes + old_bytes, 0, capacity / NEON_PQ_BLOCK * block_bytes - old_bytes);
+
+    aligned_free(pq->codes);
+    pq->codes = codes;
+    pq->capacity = capacity;
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * Encode và thêm data [n x dim], id = thứ tự thêm vào
+*/
+static inline int neon_pq_add(NeonPQ* pq, const float* data, size_t n) {
+    if (pq == NULL || data == NULL) return NEON_ERROR_NULL_POINTER;
+    if (pq->n + n > 0x7FFFFFFF) return NEON_ERROR_INVALID_SIZE;
+
+    int err = neon_pq_reserve(pq, pq->n + n);
+    if (err != NEON_SUCCESS) return err;
+
+    for (size_t i = 0; i < n; i++) {
+        const float* x = data + i * pq->dim;
+        size_t id = pq->n + i;
+
+        for (size_t m = 0; m < pq->M; m++) {
+            uint8_t c = neon_pq_nearest(x + m * pq->dsub, pq->centroids + m * NEON_PQ_KSUB * pq->dsub, pq->dsub);
+            uint8_t* b = neon_pq_code_byte(pq, id, m);
+            *b = (m & 1) ? (uint8_t)((*b & 0x0F) | (c << 4)) : (uint8_t)((*b & 0xF0) | c);
+        }
+    }
+
+    pq->n += n;
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * Vector đã encode → f32 [dim]
+*/
+static inline void neon_pq_decode(const NeonPQ* pq, size_t i, float* out) {
+    for (size_t m = 0; m < pq->M; m++) {
+        const float* c = pq->centroids + (m * NEON_PQ_KSUB + neon_pq_get_code(pq, i, m)) * pq->dsub;
+        memcpy(out + m * pq->dsub, c, pq->dsub * sizeof(float));
+    }
+}
+
+
+
+// LOOKUP TABLES
+/**
+ * lut [M x 16] = ||q_m - centroid[m][c]||²
+*/
+static inline void neon_pq_compute_lut(const NeonPQ* pq, const float* query, float* lut) {
+    for (size_t m = 0; m < pq->M; m++) {
+        const float* q = query + m * pq->dsub;
+        const float* cent = pq->centroids + m * NEON_PQ_KSUB * pq->dsub;
+        for (int c = 0; c < NEON_PQ_KSUB; c++) {
+            lut[m * NEON_PQ_KSUB + c] = neon_pq_l2(q, cent + (size_t)c * pq->dsub, pq->dsub);
+        }
+    }
+}
+
+
+/**
+ * LUT f32 → uint8 [pairs * 2 x 16]
+ *   q = round((lut - min_m) * scale), dist ≈ Σ q / scale + bias
+*/
+static inline void neon_pq_quantize_lut(const NeonPQ* pq, const float* lut, uint8_t* lut_u8, float* scale, float* bias) {
+    float delta = 0.0f;
+    float b = 0.0f;
+
+    for (size_t m = 0; m < pq->M; m++) {
+        float32x4_t lo = vld1q_f32(lut + m * NEON_PQ_KSUB);
+        float32x4_t hi = lo;
+        for (int c = 4; c < NEON_PQ_KSUB; c += 4) {
+            float32x4_t v = vld1q_f32(lut + m * NEON_PQ_KSUB + c);
+            lo = vminq_f32(lo, v);
+            hi = vmaxq_f32(hi, v);
+        }
+        float mn = vminvq_f32(lo);
+        delta = MAX(delta, vmaxvq_f32(hi) - mn);
+        b += mn;
+    }
+
+    float s = (delta > 0.0f) ? 255.0f / delta : 0.0f;
+
+    for (size_t m = 0; m < pq->M; m++) {
+        const float* src = lut + m * NEON_PQ_KSUB;
+        float mn = src[0];
+        for (int c = 1; c < NEON_PQ_KSUB; c++) mn = MIN(mn, src[c]);
+
+        for (int c = 0; c < NEON_PQ_KSUB; c += 4) {
+            float32x4_t v = vmulq_n_f32(vsubq_f32(vld1q_f32(src + c), vdupq_n_f32(mn)), s);
+            uint32x4_t q = vminq_u32(vcvtnq_u32_f32(v), vdupq_n_u32(255));
+            uint16x4_t q16 = vmovn_u32(q);
+            uint8x8_t q8 = vmovn_u16(vcombine_u16(q16, q16));
+            vst1_lane_u32((uint32_t*)(lut_u8 + m * NEON_PQ_KSUB + c), vreinterpret_u32_u8(q8), 0);
+        }
+    }
+
+    if (pq->M & 1) {
+        memset(lut_u8 + pq->M * NEON_PQ_KSUB, 0, NEON_PQ_KSUB);
+    }
+
+    *scale = s;
+    *bias = b;
+}
+
+
+
+// FAST SCAN
+/**
+ * 1 cặp subspaces cho 1 block: 16 codes bytes → cộng vào acc (lanes 0-7, 8-15)
+*/
+static NEON_INLINE void neon_pq_scan_pair(
+    uint8x16_t codes,
+    uint8x16_t lut0,
+    uint8x16_t lut1,
+    uint16x8_t* acc_lo,
+    uint16x8_t* acc_hi
+) {
+    uint8x16_t d0 = vqtbl1q_u8(lut0, vandq_u8(codes, vdupq_n_u8(0x0F)));
+    uint8x16_t d1 = vqtbl1q_u8(lut1, vshrq_n_u8(codes, 4));
+    *acc_lo = vaddw_u8(vaddw_u8(*acc_lo, vget_low_u8(d0)), vget_low_u8(d1));
+    *acc_hi = vaddw_high_u8(vaddw_high_u8(*acc_hi, d0), d1);
+}
+
+
+/**
+ * Push các lanes có dist < threshold (heap lưu -dist, chỉ id < n)
+*/
+static inline uint16_t neon_pq_push_block(
+    const uint16_t* dist,
+    size_t base,
+    size_t n,
+    float* heap_vals,
+    int32_t* heap_ids,
+    size_t k,
+    uint16_t threshold
+) {
+    for (size_t j = 0; j < NEON_PQ_BLOCK && base + j < n; j++) {
+        if (dist[j] < threshold) {
+            neon_topk_push(heap_vals, heap_ids, k, -(float)dist[j], (int32_t)(base + j));
+            threshold = (heap_ids[0] < 0) ? 0xFFFF : (uint16_t)(-heap_vals[0]);
+        }
+    }
+    return threshold;
+}
+
+
+/**
+ * Scan blocks [b0, b1), giữ k dist nhỏ nhất (quantized)
+ * @param heap_vals, heap_ids: [k], kết quả -dist / id (id = -1 nếu chưa đủ)
+*/
+static inline void neon_pq_scan_blocks(
+    const NeonPQ* pq,
+    const uint8_t* lut_u8,
+    size_t b0,
+    size_t b1,
+    size_t k,
+    float* heap_vals,
+    int32_t* heap_ids
+) {
+    for (size_t i = 0; i < k; i++) {
+        heap_vals[i] = -INFINITY;
+        heap_ids[i] = -1;
+    }
+
+    const size_t pairs = pq->pairs;
+    const size_t block_bytes = pairs * NEON_PQ_BLOCK;
+    uint16_t threshold = 0xFFFF;
+    uint16_t dist[2 * NEON_PQ_BLOCK] ALIGN_NEON;
+
+    size_t b = b0;
+    for (; b + 2 <= b1; b += 2) {
+        const uint8_t* c0 = pq->codes + b * block_bytes;
+        const uint8_t* c1 = c0 + block_bytes;
+        NEON_PREFETCH(c1 + block_bytes * 2);
+
+        uint16x8_t a0 = vdupq_n_u16(0), a1 = vdupq_n_u16(0);
+        uint16x8_t a2 = vdupq_n_u16(0), a3 = vdupq_n_u16(0);
+
+        for (size_t p = 0; p < pairs; p++) {
+            uint8x16_t l0 = vld1q_u8(lut_u8 + (2 * p) * NEON_PQ_KSUB);
+            uint8x16_t l1 = vld1q_u8(lut_u8 + (2 * p + 1) * NEON_PQ_KSUB);
+            neon_pq_scan_pair(vld1q_u8(c0 + p * NEON_PQ_BLOCK), l0, l1, &a0, &a1);
+            neon_pq_scan_pair(vld1q_u8(c1 + p * NEON_PQ_BLOCK), l0, l1, &a2, &a3);
+        }
+
+        uint16x8_t th = vdupq_n_u16(threshold);
+        uint16x8_t below = vorrq_u16(vorrq_u16(vcltq_u16(a0, th), vcltq_u16(a1, th)),
+                                     vorrq_u16(vcltq_u16(a2, th), vcltq_u16(a3, th)));
+        if (LIKELY(vmaxvq_u16(below) == 0)) continue;
+
+        vst1q_u16(dist, a0);
+        vst1q_u16(dist + 8, a1);
+        vst1q_u16(dist + 16, a2);
+        vst1q_u16(dist + 24, a3);
+        threshold = neon_pq_push_block(dist, b * NEON_PQ_BLOCK, pq->n, heap_vals, heap_ids, k, threshold);
+        threshold = neon_pq_push_block(dist + 16, (b + 1) * NEON_PQ_BLOCK, pq->n, heap_vals, heap_ids, k, threshold);
+    }
+
+    for (; b < b1; b++) {
+        const uint8_t* c0 = pq->codes + b * block_bytes;
+        uint16x8_t a0 = vdupq_n_u16(0), a1 = vdupq_n_u16(0);
+
+        for (size_t p = 0; p < pairs; p++) {
+            uint8x16_t l0 = vld1q_u8(lut_u8 + (2 * p) * NEON_PQ_KSUB);
+            uint8x16_t l1 = vld1q_u8(lut_u8 + (2 * p + 1) * NEON_PQ_KSUB);
+            neon_pq_scan_pair(vld1q_u8(c0 + p * NEON_PQ_BLOCK), l0, l1, &a0, &a1);
+        }
+
+        vst1q_u16(dist, a0);
+        vst1q_u16(dist + 8, a1);
+        threshold = neon_pq_push_block(dist, b * NEON_PQ_BLOCK, pq->n, heap_vals, heap_ids, k, threshold);
+    }
+}
+
+
+typedef struct
+{
+    const NeonPQ* pq;
+    const uint8_t* lut_u8;
+    size_t k;
+    float* cand_values; // [num_threads * k]
+    int32_t* cand_ids;
+} NeonPQScanCtx;
+
+
+static void neon_pq_scan_worker(void* arg, size_t begin, size_t end, int tid) {
+    NeonPQScanCtx* ctx = (NeonPQScanCtx*)arg;
+    neon_pq_scan_blocks(ctx->pq, ctx->lut_u8, begin, end, ctx->k,
+                        ctx->cand_values + (size_t)tid * ctx->k,
+                        ctx->cand_ids + (size_t)tid * ctx->k);
+}
+
+
+/**
+ * ADC f32 của vector i với LUT f32
+*/
+static inline float neon_pq_adc(const NeonPQ* pq, const float* lut, size_t i) {
+    float d = 0.0f;
+    for (size_t m = 0; m < pq->M; m++) {
+        d += lut[m * NEON_PQ_KSUB + neon_pq_get_code(pq, i, m)];
+    }
+    return d;
+}
+
+
+/**
+ * Top-k vectors gần query nhất (L2²)
+ *
+ * @param rerank: fast scan lấy k * rerank candidates, rerank bằng ADC f32 (>= 1)
+ * @param out_dist: [k] tăng dần (ADC)
+ * @param out_ids: [k]
+ * @param out_count: min(k, n)
+*/
+static inline int neon_pq_search(
+    const NeonPQ* pq,
+    const float* query,
+    size_t k,
+    size_t rerank,
+    float* out_dist,
+    int32_t* out_ids,
+    size_t* out_count,
+    int num_threads
+) {
+    if (pq == NULL || query == NULL || out_dist == NULL || out_ids == NULL || out_count == NULL) {
+        return NEON_ERROR_NULL_POINTER;
+    }
+
+    *out_count = 0;
+    if (k == 0 || pq->n == 0) return NEON_SUCCESS;
+    if (k > pq->n) k = pq->n;
+
+    size_t kk = MIN(pq->n, k * MAX(rerank, (size_t)1));
+    size_t num_blocks = (pq->n + NEON_PQ_BLOCK - 1) / NEON_PQ_BLOCK;
+    num_threads = neon_threads_for(num_blocks, num_threads, NEON_PQ_MIN_BLOCKS_PER_THREAD);
+
+    size_t lut_floats = pq->M * NEON_PQ_KSUB;
+    float* lut = (float*)neon_malloc(lut_floats * sizeof(float));
+    uint8_t* lut_u8 = (uint8_t*)neon_malloc(pq->pairs * 2 * NEON_PQ_KSUB);
+    float* cand_values = (float*)neon_malloc((size_t)num_threads * kk * sizeof(float));
+    int32_t* cand_ids = (int32_t*)neon_malloc((size_t)num_threads * kk * sizeof(int32_t));
+
+    if (lut == NULL || lut_u8 == NULL || cand_values == NULL || cand_ids == NULL) {
+        neon_free(lut);
+        neon_free(lut_u8);
+        neon_free(cand_values);
+        neon_free(cand_ids);
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    float scale, bias;
+    neon_pq_compute_lut(pq, query, lut);
+    neon_pq_quantize_lut(pq, lut, lut_u8, &scale, &bias);
+
+    NeonPQScanCtx ctx;
+    ctx.pq = pq;
+    ctx.lut_u8 = lut_u8;
+    ctx.k = kk;
+    ctx.cand_values = cand_values;
+    ctx.cand_ids = cand_ids;
+    neon_parallel_for(num_blocks, num_threads, neon_pq_scan_worker, &ctx);
+
+    // Gom candidates hợp lệ của mọi thread, rerank bằng ADC f32 (-dist để dùng top-k lớn nhất)
+    size_t total = 0;
+    for (size_t i = 0; i < (size_t)num_threads * kk; i++) {
+        if (cand_ids[i] < 0) continue;
+        cand_ids[total] = cand_ids[i];
+        cand_values[total] = -neon_pq_adc(pq, lut, (size_t)cand_ids[i]);
+        total++;
+    }
+
+    size_t count = neon_topk_merge(cand_values, cand_ids, total, k, out_dist, out_ids);
+    for (size_t i = 0; i < count; i++) {
+        out_dist[i] = -out_dist[i];
+    }
+
+    neon_free(lut);
+    neon_free(lut_u8);
+    neon_free(cand_values);
+    neon_free(cand_ids);
+
+    *out_count = count;
+    return NEON_SUCCESS;
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_PQ_H
@@ -0,0 +1,486 @@
+#ifndef NEON_QUANT4_H
+#define NEON_QUANT4_H
+
+#include "neon_types.h"
+#include "memory_align.h"
+#include "neon_thread.h"
+#include <math.h>
+#include <string.h>
+
+#if defined(__ARM_FEATURE_DOTPROD)
+    #define NEON_HAS_DOTPROD 1
+#else
+    #define NEON_HAS_DOTPROD 0
+#endif
+
+
+/**
+ * INT4 GROUP-QUANTIZED WEIGHTS (LLM decode)
+ *
+ * Decode (batch 1-8) là GEMV → bị giới hạn bởi bandwidth đọc weights, không phải FLOPs
+ *   f32: 32 bits / weight, int8: 8 bits + scale, int4 group 32: 4 + 1 = 5 bits, group 128: 4.25 bits
+ *   → int4 đọc ~1.6-1.9x ít bytes hơn int8 mỗi token
+ *
+ * FORMAT:
+ *   W [rows x cols], mỗi row chia thành groups liên tiếp group_size phần tử (32 / 64 / 128)
+ *   Mỗi group: 1 scale f32, mỗi phần tử 1 nibble = index vào bảng 16 levels int8
+ *   Pack theo block 32 phần tử = 16 bytes: byte b = q[b] | q[b + 16] << 4
+ *     → unpack: vandq_u8(v, 0x0F) = phần tử 0-15, vshrq_n_u8(v, 4) = phần tử 16-31 (liên tục)
+ *
+ * DEQUANT bằng LOOKUP: vqtbl1q_s8(levels, nibbles) → 16 x int8 trong 1 lệnh
+ *   levels tuyến tính [-8..7] (kiểu Q4_0) hoặc codebook không đều (NF4 x 127)
+ *   → đổi codebook không đổi kernel
+ *
+ * GEMV / SKINNY GEMM (Y[batch x rows] = X[batch x cols] * W^T):
+ *   a) DOTPROD (ARMv8.2): X quantize int8 theo block 32 (scale riêng)
+ *      vdotq_s32(w_i8, x_i8): 16 MACs / lệnh, cộng dồn f32 với scale_w * scale_x mỗi block
+ *   b) Không có dotprod: int8 → f32 (vmovl + vcvtq) rồi vfmaq_f32 với X gốc
+ *   Weight block unpack 1 lần, dùng lại cho tất cả batch rows (tối đa NEON_Q4_MAX_BATCH / lượt)
+ *   Chia rows cho threads: mỗi thread stream 1 đoạn weights riêng
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define NEON_Q4_BLOCK 32 // phần tử / block pack (16 bytes)
+#define NEON_Q4_MAX_BATCH 8 // số activation rows dùng chung 1 lần unpack weights
+#define NEON_Q4_MIN_ROWS_PER_THREAD 16
+
+
+static const int8_t NEON_Q4_LEVELS_LINEAR[16] ALIGN_NEON = {
+    -8, -7, -6, -5, -4, -3, -2, -1, 0, 1, 2, 3, 4, 5, 6, 7
+};
+
+// NF4 (normal float 4-bit) levels x 127
+static const int8_t NEON_Q4_LEVELS_NF4[16] ALIGN_NEON = {
+    -127, -88, -67, -50, -36, -23, -12, 0, 10, 20, 31, 43, 56, 71, 92, 127
+};
+
+
+typedef struct
+{
+    uint8_t* data; // [rows x cols / 2] nibbles
+    float* scales; // [rows x cols / group_size]
+    size_t rows;
+    size_t cols;
+    size_t group_size;
+    int8_t levels[16] ALIGN_NEON; // nibble → int8
+} NeonQ4Matrix;
+
+
+
+// CREATE / DESTROY
+/**
+ * @param group_size: bội của 32, chia hết cols (thường 32 / 64 / 128)
+ * @param levels: 16 int8 levels, NULL = NEON_Q4_LEVELS_LINEAR
+*/
+static inline int neon_q4_create(NeonQ4Matrix* m, size_t rows, size_t cols, size_t group_size, const int8_t* levels) {
+    if (m == NULL) return NEON_ERROR_NULL_POINTER;
+    if (rows == 0 || cols == 0) return NEON_ERROR_INVALID_SIZE;
+    if (group_size == 0 || group_size % NEON_Q4_BLOCK != 0) return NEON_ERROR_INVALID_PARAM;
+    if (cols % group_size != 0) return NEON_ERROR_INVALID_SIZE;
+
+    m->data = (uint8_t*)aligned_malloc(rows * cols / 2, NEON_CACHE_LINE);
+    m->scales = (float*)neon_malloc(rows * (cols / group_size) * sizeof(float));
+    if (m->data == NULL || m->scales == NULL) {
+        aligned_free(m->data);
+        neon_free(m->scales);
+        m->data = NULL;
+        m->scales = NULL;
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    m->rows = rows;
+    m->cols = cols;
+    m->group_size = group_size;
+    memcpy(m->levels, levels ? levels : NEON_Q4_LEVELS_LINEAR, sizeof(m->levels));
+
+    return NEON_SUCCESS;
+}
+
+
+static inline void neon_q4_destroy(NeonQ4Matrix* m) {
+    if (m == NULL) return;
+
+    aligned_free(m->data);
+    neon_free(m->scales);
+    m->data = NULL;
+    m->scales = NULL;
+    m->rows = 0;
+    m->cols = 0;
+}
+
+
+/**
+ * Tổng bytes weights + scales (để so sánh bandwidth với int8 / f32)
+*/
+static inline size_t neon_q4_bytes(const NeonQ4Matrix* m) {
+    return m->rows * m->cols / 2 + m->rows * (m->cols / m->group_size) * sizeof(float);
+}
+
+
+
+// PACK / UNPACK
+/**
+ * 16 bytes → 32 x int8: lo = phần tử 0-15, hi = phần tử 16-31
+*/
+static NEON_INLINE void neon_q4_unpack32(const uint8_t* p, int8x16_t levels, int8x16_t* lo, int8x16_t* hi) {
+    uint8x16_t v = vld1q_u8(p);
+    *lo = vqtbl1q_s8(levels, vandq_u8(v, vdupq_n_u8(0x0F)));
+    *hi = vqtbl1q_s8(levels, vshrq_n_u8(v, 4));
+}
+
+
+/**
+ * 32 nibbles (q[0..32), mỗi byte 0-15) → 16 bytes
+*/
+static NEON_INLINE void neon_q4_pack32(const uint8_t* q, uint8_t* p) {
+    uint8x16_t lo = vld1q_u8(q);
+    uint8x16_t hi = vld1q_u8(q + 16);
+    vst1q_u8(p, vorrq_u8(lo, vshlq_n_u8(hi, 4)));
+}
+
+
+/**
+ * 4 floats (đã chia scale) → index level gần nhất (so sánh với cả 16 levels)
+*/
+static NEON_INLINE uint32x4_t neon_q4_nearest(float32x4_t x, const float* levels_f) {
+    float32x4_t best = vdupq_n_f32(INFINITY);
+    uint32x4_t idx = vdupq_n_u32(0);
+
+    for (uint32_t k = 0; k < 16; k++) {
+        float32x4_t d = vabdq_f32(x, vdupq_n_f32(levels_f[k]));
+        uint32x4_t closer = vcltq_f32(d, best);
+        best = vbslq_f32(closer, d, best);
+        idx = vbslq_u32(closer, vdupq_n_u32(k), idx);
+    }
+
+    return idx;
+}
+
+
+
+// QUANTIZE / DEQUANTIZE
+/**
+ * W [rows x cols] f32 → int4
+ * scale group = max|w| / min(level dương lớn nhất, |level âm nhỏ nhất|)
+*/
+static inline int neon_q4_quantize(NeonQ4Matrix* m, const float* w) {
+    if (m == NULL || w == NULL || m->data == NULL) return NEON_ERROR_NULL_POINTER;
+
+    float levels_f[16];
+    int lmin = 0, lmax = 0;
+    for (int k = 0; k < 16; k++) {
+        levels_f[k] = (float)m->levels[k];
+        lmin = MIN(lmin, (int)m->levels[k]);
+        lmax = MAX(lmax, (int)m->levels[k]);
+    }
+    int lrange = MIN(lmax, -lmin);
+    if (lrange <= 0) return NEON_ERROR_INVALID_PARAM;
+
+    const size_t groups = m->cols / m->group_size;
+    uint8_t q[NEON_Q4_BLOCK] ALIGN_NEON;
+
+    for (size_t r = 0; r < m->rows; r++) {
+        const float* row = w + r * m->cols;
+        uint8_t* dst = m->data + r * m->cols / 2;
+
+        for (size_t g = 0; g < groups; g++) {
+            const float* src = row + g * m->group_size;
+
+            float32x4_t vmax = vdupq_n_f32(0.0f);
+            for (size_t j = 0; j < m->group_size; j += 4) {
+                vmax = vmaxq_f32(vmax, vabsq_f32(vld1q_f32(src + j)));
+            }
+            float amax = vmaxvq_f32(vmax);
+            float scale = amax / (float)lrange;
+            float inv = (scale > 0.0f) ? 1.0f / scale : 0.0f;
+            m->scales[r * groups + g] = scale;
+
+            for (size_t b = 0; b < m->group_size; b += NEON_Q4_BLOCK) {
+                for (size_t j = 0; j < NEON_Q4_BLOCK; j += 4) {
+                    float32x4_t x = vmulq_n_f32(vld1q_f32(src + b + j), inv);
+                    uint32x4_t idx = neon_q4_nearest(x, levels_f);
+                    uint16x4_t i16 = vmovn_u32(idx);
+                    uint8x8_t i8 = vmovn_u16(vcombine_u16(i16, i16));
+                    vst1_lane_u32((uint32_t*)(q + j), vreinterpret_u32_u8(i8), 0);
+                }
+                neon_q4_pack32(q, dst + (g * m->group_size + b) / 2);
+            }
+        }
+    }
+
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * Row r → f32 [cols]
+*/
+static inline void neon_q4_dequantize_row(const NeonQ4Matrix* m, size_t r, float* out) {
+    const int8x16_t levels = vld1q_s8(m->levels);
+    const uint8_t* src = m->data + r * m->cols / 2;
+    const float* scales = m->scales + r * (m->cols / m->group_size);
+    const size_t per_group = m->group_size / NEON_Q4_BLOCK;
+
+    for (size_t blk = 0; blk < m->cols / NEON_Q4_BLOCK; blk++) {
+        int8x16_t lo, hi;
+        neon_q4_unpack32(src + blk * 16, levels, &lo, &hi);
+        float s = scales[blk / per_group];
+        float* dst = out + blk * NEON_Q4_BLOCK;
+
+        int16x8_t h0 = vmovl_s8(vget_low_s8(lo));
+        int16x8_t h1 = vmovl_high_s8(lo);
+        int16x8_t h2 = vmovl_s8(vget_low_s8(hi));
+        int16x8_t h3 = vmovl_high_s8(hi);
+
+        vst1q_f32(dst, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(h0))), s));
+        vst1q_f32(dst + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_high_s16(h0)), s));
+        vst1q_f32(dst + 8, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(h1))), s));
+        vst1q_f32(dst + 12, vmulq_n_f32(vcvtq_f32_s32(vmovl_high_s16(h1)), s));
+        vst1q_f32(dst + 16, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(h2))), s));
+        vst1q_f32(dst + 20, vmulq_n_f32(vcvtq_f32_s32(vmovl_high_s16(h2)), s));
+        vst1q_f32(dst + 24, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(h3))), s));
+        vst1q_f32(dst + 28, vmulq_n_f32(vcvtq_f32_s32(vmovl_high_s16(h3)), s));
+    }
+}
+
+
+/**
+ * Activation f32 → int8 theo block 32: q = round(x / s), s = max|x| / 127
+ * @param n: bội của 32
+*/
+static inline void neon_q8_quantize_blocks(const float* x, size_t n, int8_t* q, float* scales) {
+    for (size_t blk = 0; blk < n / NEON_Q4_BLOCK; blk++) {
+        const float* src = x + blk * NEON_Q4_BLOCK;
+
+        float32x4_t v[8];
+        float32x4_t vmax = vdupq_n_f32(0.0f);
+        for (int k = 0; k < 8; k++) {
+            v[k] = vld1q_f32(src + 4 * k);
+            vmax = vmaxq_f32(vmax, vabsq_f32(v[k]));
+        }
+
+        float amax = vmaxvq_f32(vmax);
+        float s = amax / 127.0f;
+        float inv = (amax > 0.0f) ? 127.0f / amax : 0.0f;
+        scales[blk] = s;
+
+        for (int k = 0; k < 8; k += 2) {
+            int32x4_t a = vcvtnq_s32_f32(vmulq_n_f32(v[k], inv));
+            int32x4_t b = vcvtnq_s32_f32(vmulq_n_f32(v[k + 1], inv));
+            int16x4_t a16 = vqmovn_s32(a);
+            int16x4_t b16 = vqmovn_s32(b);
+            int8x8_t ab = vqmovn_s16(vcombine_s16(a16, b16));
+            vst1_s8(q + blk * NEON_Q4_BLOCK + 4 * k, ab);
+        }
+    }
+}
+
+
+
+// GEMV / SKINNY GEMM
+typedef struct
+{
+    const NeonQ4Matrix* m;
+    const float* x; // [batch x cols] (f32 path)
+    const int8_t* xq; // [batch x cols] (dotprod path)
+    const float* xs; // [batch x cols / 32]
+    size_t batch;
+    float* y; // [batch x rows]
+} NeonQ4GemmCtx;
+
+
+#if NEON_HAS_DOTPROD
+/**
+ * Rows [r0, r1): int4 x int8 bằng vdotq_s32
+*/
+static inline void neon_q4_gemm_rows_dot(const NeonQ4GemmCtx* c, size_t r0, size_t r1) {
+    const NeonQ4Matrix* m = c->m;
+    const int8x16_t levels = vld1q_s8(m->levels);
+    const size_t cols = m->cols;
+    const size_t blocks = cols / NEON_Q4_BLOCK;
+    const size_t per_group = m->group_size / NEON_Q4_BLOCK;
+    const size_t groups = cols / m->group_size;
+
+    for (size_t r = r0; r < r1; r++) {
+        const uint8_t* w = m->data + r * cols / 2;
+        const float* ws = m->scales + r * groups;
+
+        for (size_t b0 = 0; b0 < c->batch; b0 += NEON_Q4_MAX_BATCH) {
+            size_t nb = MIN((size_t)NEON_Q4_MAX_BATCH, c->batch - b0);
+            float32x4_t acc[NEON_Q4_MAX_BATCH];
+            for (size_t b = 0; b < nb; b++) acc[b] = vdupq_n_f32(0.0f);
+
+            for (size_t blk = 0; blk < blocks; blk++) {
+                NEON_PREFETCH(w + blk * 16 + 512);
+
+                int8x16_t wlo, whi;
+                neon_q4_unpack32(w + blk * 16, levels, &wlo, &whi);
+                float sw = ws[blk / per_group];
+
+                for (size_t b = 0; b < nb; b++) {
+                    const int8_t* xb = c->xq + (b0 + b) * cols + blk * NEON_Q4_BLOCK;
+                    int32x4_t s = vdotq_s32(vdupq_n_s32(0), wlo, vld1q_s8(xb));
+                    s = vdotq_s32(s, whi, vld1q_s8(xb + 16));
+                    acc[b] = vfmaq_n_f32(acc[b], vcvtq_f32_s32(s), sw * c->xs[(b0 + b) * blocks + blk]);
+                }
+            }
+
+            for (size_t b = 0; b < nb; b++) {
+                c->y[(b0 + b) * m->rows + r] = vaddvq_f32(acc[b]);
+            }
+        }
+    }
+}
+#endif
+
+
+/**
+ * Rows [r0, r1): int4 → f32 trong registers, vfmaq_f32 với X gốc
+*/
+static inline void neon_q4_gemm_rows_f32(const NeonQ4GemmCtx* c, size_t r0, size_t r1) {
+    const NeonQ4Matrix* m = c->m;
+    const int8x16_t levels = vld1q_s8(m->levels);
+    const size_t cols = m->cols;
+    const size_t blocks = cols / NEON_Q4_BLOCK;
+    const size_t per_group = m->group_size / NEON_Q4_BLOCK;
+    const size_t groups = cols / m->group_size;
+
+    for (size_t r = r0; r < r1; r++) {
+        const uint8_t* w = m->data + r * cols / 2;
+        const float* ws = m->scales + r * groups;
+
+        for (size_t b0 = 0; b0 < c->batch; b0 += NEON_Q4_MAX_BATCH) {
+            size_t nb = MIN((size_t)NEON_Q4_MAX_BATCH, c->batch - b0);
+            float32x4_t acc[NEON_Q4_MAX_BATCH];
+            for (size_t b = 0; b < nb; b++) acc[b] = vdupq_n_f32(0.0f);
+
+            for (size_t blk = 0; blk < blocks; blk++) {
+                NEON_PREFETCH(w + blk * 16 + 512);
+
+                int8x16_t lo, hi;
+                neon_q4_unpack32(w + blk * 16, levels, &lo, &hi);
+                float sw = ws[blk / per_group];
+
+                int16x8_t h[4];
+                h[0] = vmovl_s8(vget_low_s8(lo));
+                h[1] = vmovl_high_s8(lo);
+                h[2] = vmovl_s8(vget_low_s8(hi));
+                h[3] = vmovl_high_s8(hi);
+
+                float32x4_t f[8];
+                for (int k = 0; k < 4; k++) {
+                    f[2 * k] = vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(h[k]))), sw);
+                    f[2 * k + 1] = vmulq_n_f32(vcvtq_f32_s32(vmovl_high_s16(h[k])), sw);
+                }
+
+                for (size_t b = 0; b < nb; b++) {
+                    const float* xb = c->x + (b0 + b) * cols + blk * NEON_Q4_BLOCK;
+                    float32x4_t a = acc[b];
+                    for (int k = 0; k < 8; k++) {
+                        a = vfmaq_f32(a, f[k], vld1q_f32(xb + 4 * k));
+                    }
+                    acc[b] = a;
+                }
+            }
+
+            for (size_t b = 0; b < nb; b++) {
+                c->y[(b0 + b) * m->rows + r] = vaddvq_f32(acc[b]);
+            }
+        }
+    }
+}
+
+
+static void neon_q4_gemm_worker_f32(void* ctx, size_t begin, size_t end, int thread_id) {
+    (void)thread_id;
+    neon_q4_gemm_rows_f32((const NeonQ4GemmCtx*)ctx, begin, end);
+}
+
+
+#if NEON_HAS_DOTPROD
+static void neon_q4_gemm_worker_dot(void* ctx, size_t begin, size_t end, int thread_id) {
+    (void)thread_id;
+    neon_q4_gemm_rows_dot((const NeonQ4GemmCtx*)ctx, begin, end);
+}
+#endif
+
+
+/**
+ * Y[batch x rows] = X[batch x cols] * W^T, chỉ dùng f32 FMA (kết quả sát với W đã dequant)
+*/
+static inline int neon_q4_gemm_f32(const NeonQ4Matrix* m, const float* x, size_t batch, float* y, int num_threads) {
+    if (m == NULL || x == NULL || y == NULL || m->data == NULL) return NEON_ERROR_NULL_POINTER;
+    if (batch == 0) return NEON_SUCCESS;
+
+    NeonQ4GemmCtx ctx;
+    ctx.m = m;
+    ctx.x = x;
+    ctx.xq = NULL;
+    ctx.xs = NULL;
+    ctx.batch = batch;
+    ctx.y = y;
+
+    num_threads = neon_threads_for(m->rows, num_threads, NEON_Q4_MIN_ROWS_PER_THREAD);
+    return neon_parallel_for(m->rows, num_threads, neon_q4_gemm_worker_f32, &ctx);
+}
+
+
+/**
+ * Y[batch x rows] = X[batch x cols] * W^T
+ * Có dotprod: X quantize int8 theo block 32 trước (sai số ~ 1/254 max|x| mỗi block)
+*/
+static inline int neon_q4_gemm(const NeonQ4Matrix* m, const float* x, size_t batch, float* y, int num_threads) {
+#if NEON_HAS_DOTPROD
+    if (m == NULL || x == NULL || y == NULL || m->data == NULL) return NEON_ERROR_NULL_POINTER;
+    if (batch == 0) return NEON_SUCCESS;
+
+    const size_t blocks = m->cols / NEON_Q4_BLOCK;
+    int8_t* xq = (int8_t*)neon_malloc(batch * m->cols);
+    float* xs = (float*)neon_malloc(batch * blocks * sizeof(float));
+    if (xq == NULL || xs == NULL) {
+        neon_free(xq);
+        neon_free(xs);
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    for (size_t b = 0; b < batch; b++) {
+        neon_q8_quantize_blocks(x + b * m->cols, m->cols, xq + b * m->cols, xs + b * blocks);
+    }
+
+    NeonQ4GemmCtx ctx;
+    ctx.m = m;
+    ctx.x = x;
+    ctx.xq = xq;
+    ctx.xs = xs;
+    ctx.batch = batch;
+    ctx.y = y;
+
+    num_threads = neon_threads_for(m->rows, num_threads, NEON_Q4_MIN_ROWS_PER_THREAD);
+    int err = neon_parallel_for(m->rows, num_threads, neon_q4_gemm_worker_dot, &ctx);
+
+    neon_free(xq);
+    neon_free(xs);
+    return err;
+#else
+    return neon_q4_gemm_f32(m, x, batch, y, num_threads);
+#endif
+}
+
+
+/**
+ * y[rows] = W * x[cols]
+*/
+static inline int neon_q4_gemv(const NeonQ4Matrix* m, const float* x, float* y, int num_threads) {
+    return neon_q4_gemm(m, x, 1, y, num_threads);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_QUANT4_H
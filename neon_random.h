@@ -0,0 +1,477 @@
+#ifndef NEON_RANDOM_H
+#define NEON_RANDOM_H
+
+#include "neon_types.h"
+#include "memory_align.h"
+#include "neon_thread.h"
+#include <math.h>
+#include <string.h>
+
+
+/**
+ * COUNTER-BASED RNG: PHILOX4x32-10
+ *
+ * rand() / xorshift: state tuần tự → không chia được cho threads, kết quả phụ thuộc số threads
+ * Philox: output = bijection(counter, key), không có state ngoài counter
+ *   → phần tử thứ i của stream tính độc lập: chia việc tuỳ ý, kết quả giống hệt với mọi số threads
+ *
+ * counter 128 bit = (block lo, block hi, stream lo, stream hi), key 64 bit = seed
+ *   mỗi block cho 4 x uint32
+ * Round: 2 phép nhân 32x32 → 64 (lấy hi và lo) + xor với key
+ *   NEON: vmull_u32 cho 2 tích 64 bit, vuzp1q / vuzp2q tách lo / hi
+ *   4 blocks liên tiếp theo SoA (x0[4], x1[4], x2[4], x3[4]), vst4q ghi lại đúng thứ tự block
+ *
+ * FILLS (mỗi call dùng các blocks kế tiếp của stream, offset làm tròn lên bội 4 blocks):
+ *   uniform: 24 bit cao → float [lo, hi)
+ *   normal: Box-Muller, cặp (u1, u2) → 2 giá trị, log và sincos vector hoá (đa thức kiểu Cephes)
+ *   dropout: so sánh uint32 trực tiếp với ngưỡng p * 2^32 (không cần đổi sang float)
+ *     backward sinh lại mask từ bản sao state lúc forward → không cần lưu mask
+ *
+ * Streams theo thread: neon_philox_substream(rng, i) → stream độc lập, tái lập được từ (seed, stream, i)
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define NEON_PHILOX_M0 0xD2511F53u
+#define NEON_PHILOX_M1 0xCD9E8D57u
+#define NEON_PHILOX_W0 0x9E3779B9u
+#define NEON_PHILOX_W1 0xBB67AE85u
+#define NEON_PHILOX_ROUNDS 10
+
+#define NEON_RANDOM_MIN_QUADS 1024 // 1 quad = 4 blocks = 16 values
+
+
+typedef struct
+{
+    uint64_t seed;
+    uint64_t stream;
+    uint64_t offset; // block kế tiếp (1 block = 4 x uint32)
+} NeonPhilox;
+
+
+static inline void neon_philox_init(NeonPhilox* rng, uint64_t seed, uint64_t stream) {
+    rng->seed = seed;
+    rng->stream = stream;
+    rng->offset = 0;
+}
+
+
+/**
+ * Stream con thứ index (vd 1 stream / thread / worker của data loader)
+ * stream id trộn bằng splitmix64 → không trùng với stream gốc hay các stream con khác (xác suất ~2^-64)
+*/
+static inline NeonPhilox neon_philox_substream(const NeonPhilox* rng, uint64_t index) {
+    uint64_t z = rng->stream + (index + 1) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+
+    NeonPhilox sub;
+    sub.seed = rng->seed;
+    sub.stream = z;
+    sub.offset = 0;
+    return sub;
+}
+
+
+static inline void neon_philox_skip(NeonPhilox* rng, uint64_t blocks) {
+    rng->offset += blocks;
+}
+
+
+
+// PHILOX CORE
+/**
+ * Scalar: 1 block (reference, dùng cho vài giá trị lẻ)
+*/
+static inline void neon_philox4x32(const uint32_t ctr[4], const uint32_t key[2], uint32_t out[4]) {
+    uint32_t c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+    uint32_t k0 = key[0], k1 = key[1];
+
+    for (int r = 0; r < NEON_PHILOX_ROUNDS; r++) {
+        uint64_t p0 = (uint64_t)NEON_PHILOX_M0 * c0;
+        uint64_t p1 = (uint64_t)NEON_PHILOX_M1 * c2;
+        uint32_t n0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+        uint32_t n2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+        c1 = (uint32_t)p1;
+        c3 = (uint32_t)p0;
+        c0 = n0;
+        c2 = n2;
+        k0 += NEON_PHILOX_W0;
+        k1 += NEON_PHILOX_W1;
+    }
+
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+
+/**
+ * hi, lo của a * m (32x32 → 64) cho 4 lanes
+ * vmull_u32 → [lo0, hi0, lo1, hi1] và [lo2, hi2, lo3, hi3]
+*/
+static NEON_INLINE void neon_philox_mulhilo(uint32x4_t a, uint32x2_t m, uint32x4_t* hi, uint32x4_t* lo) {
+    uint32x4_t p01 = vreinterpretq_u32_u64(vmull_u32(vget_low_u32(a), m));
+    uint32x4_t p23 = vreinterpretq_u32_u64(vmull_u32(vget_high_u32(a), m));
+    *lo = vuzp1q_u32(p01, p23);
+    *hi = vuzp2q_u32(p01, p23);
+}
+
+
+/**
+ * 4 blocks liên tiếp (block, block+1, block+2, block+3) của stream
+ * val[j] lane l = word j của block (block + l) → vst4q ghi đúng thứ tự tuần tự
+*/
+static NEON_INLINE uint32x4x4_t neon_philox_quad(uint64_t seed, uint64_t stream, uint64_t block) {
+    uint32_t lo[4], hi[4];
+    for (int l = 0; l < 4; l++) {
+        uint64_t b = block + (uint64_t)l;
+        lo[l] = (uint32_t)b;
+        hi[l] = (uint32_t)(b >> 32);
+    }
+
+    uint32x4_t x0 = vld1q_u32(lo);
+    uint32x4_t x1 = vld1q_u32(hi);
+    uint32x4_t x2 = vdupq_n_u32((uint32_t)stream);
+    uint32x4_t x3 = vdupq_n_u32((uint32_t)(stream >> 32));
+
+    uint32_t k0 = (uint32_t)seed, k1 = (uint32_t)(seed >> 32);
+    const uint32x2_t m0 = vdup_n_u32(NEON_PHILOX_M0);
+    const uint32x2_t m1 = vdup_n_u32(NEON_PHILOX_M1);
+
+    for (int r = 0; r < NEON_PHILOX_ROUNDS; r++) {
+        uint32x4_t hi0, lo0, hi1, lo1;
+        neon_philox_mulhilo(x0, m0, &hi0, &lo0);
+        neon_philox_mulhilo(x2, m1, &hi1, &lo1);
+
+        x0 = veorq_u32(veorq_u32(hi1, x1), vdupq_n_u32(k0));
+        x2 = veorq_u32(veorq_u32(hi0, x3), vdupq_n_u32(k1));
+        x1 = lo1;
+        x3 = lo0;
+        k0 += NEON_PHILOX_W0;
+        k1 += NEON_PHILOX_W1;
+    }
+
+    uint32x4x4_t out;
+    out.val[0] = x0;
+    out.val[1] = x1;
+    out.val[2] = x2;
+    out.val[3] = x3;
+    return out;
+}
+
+
+
+// DISTRIBUTIONS
+/**
+ * 24 bit cao → [0, 1)
+*/
+static NEON_INLINE float32x4_t neon_random_u01_f32x4(uint32x4_t u) {
+    return vmulq_f32(vcvtq_f32_u32(vshrq_n_u32(u, 8)), vdupq_n_f32(1.0f / 16777216.0f));
+}
+
+
+/**
+ * 24 bit cao → (0, 1] (cho log của Box-Muller)
+*/
+static NEON_INLINE float32x4_t neon_random_u01_open_f32x4(uint32x4_t u) {
+    uint32x4_t v = vaddq_u32(vshrq_n_u32(u, 8), vdupq_n_u32(1));
+    return vmulq_f32(vcvtq_f32_u32(v), vdupq_n_f32(1.0f / 16777216.0f));
+}
+
+
+/**
+ * ln(x), x > 0 hữu hạn và normal
+ * x = m * 2^e, m ∈ [sqrt(0.5), sqrt(2)) → ln(m) bằng đa thức bậc 9 (Cephes logf)
+*/
+static NEON_INLINE float32x4_t neon_log_f32x4(float32x4_t x) {
+    uint32x4_t bits = vreinterpretq_u32_f32(x);
+    int32x4_t e = vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(bits, 23)), vdupq_n_s32(126));
+    float32x4_t m = vreinterpretq_f32_u32(vorrq_u32(vandq_u32(bits, vdupq_n_u32(0x007FFFFFu)), vdupq_n_u32(0x3F000000u))); // [0.5, 1)
+
+    uint32x4_t small = vcltq_f32(m, vdupq_n_f32(0.707106781186547524f));
+    e = vaddq_s32(e, vreinterpretq_s32_u32(small)); // small = -1
+    float32x4_t f = vsubq_f32(vaddq_f32(m, vreinterpretq_f32_u32(vandq_u32(small, vreinterpretq_u32_f32(m)))), vdupq_n_f32(1.0f));
+    float32x4_t ef = vcvtq_f32_s32(e);
+
+    float32x4_t p = vdupq_n_f32(7.0376836292e-2f);
+    p = vfmaq_f32(vdupq_n_f32(-1.1514610310e-1f), p, f);
+    p = vfmaq_f32(vdupq_n_f32(1.1676998740e-1f), p, f);
+    p = vfmaq_f32(vdupq_n_f32(-1.2420140846e-1f), p, f);
+    p = vfmaq_f32(vdupq_n_f32(1.4249322787e-1f), p, f);
+    p = vfmaq_f32(vdupq_n_f32(-1.6668057665e-1f), p, f);
+    p = vfmaq_f32(vdupq_n_f32(2.0000714765e-1f), p, f);
+    p = vfmaq_f32(vdupq_n_f32(-2.4999993993e-1f), p, f);
+    p = vfmaq_f32(vdupq_n_f32(3.3333331174e-1f), p, f);
+
+    float32x4_t z = vmulq_f32(f, f);
+    float32x4_t y = vmulq_f32(vmulq_f32(p, z), f);
+    y = vfmaq_f32(y, ef, vdupq_n_f32(-2.12194440e-4f));
+    y = vfmsq_f32(y, z, vdupq_n_f32(0.5f));
+    float32x4_t r = vaddq_f32(f, y);
+    return vfmaq_f32(r, ef, vdupq_n_f32(0.693359375f));
+}
+
+
+/**
+ * sin(2πt), cos(2πt) với t ∈ [0, 1) (đơn vị vòng → giảm range chính xác, không cần Cody-Waite)
+ * q = round(4t), a = 2π(t - q/4) ∈ [-π/4, π/4], đổi chỗ / dấu theo q mod 4
+*/
+static NEON_INLINE void neon_sincos_turns_f32x4(float32x4_t t, float32x4_t* s, float32x4_t* c) {
+    float32x4_t qf = vrndnq_f32(vmulq_f32(t, vdupq_n_f32(4.0f)));
+    float32x4_t a = vmulq_f32(vfmsq_f32(t, qf, vdupq_n_f32(0.25f)), vdupq_n_f32(6.28318530717958648f));
+    uint32x4_t q = vreinterpretq_u32_s32(vcvtq_s32_f32(qf));
+    float32x4_t z = vmulq_f32(a, a);
+
+    float32x4_t ps = vdupq_n_f32(-1.9515295891e-4f);
+    ps = vfmaq_f32(vdupq_n_f32(8.3321608736e-3f), ps, z);
+    ps = vfmaq_f32(vdupq_n_f32(-1.6666654611e-1f), ps, z);
+    float32x4_t sp = vfmaq_f32(a, vmulq_f32(ps, z), a);
+
+    float32x4_t pc = vdupq_n_f32(2.443315711809948e-5f);
+    pc = vfmaq_f32(vdupq_n_f32(-1.388731625493765e-3f), pc, z);
+    pc = vfmaq_f32(vdupq_n_f32(4.166664568298827e-2f), pc, z);
+    float32x4_t cp = vfmaq_f32(vfmsq_f32(vdupq_n_f32(1.0f), z, vdupq_n_f32(0.5f)), vmulq_f32(pc, z), z);
+
+    // q lẻ: đổi sin / cos; sin âm khi q & 2, cos âm khi (q + 1) & 2
+    uint32x4_t swap = vtstq_u32(q, vdupq_n_u32(1));
+    float32x4_t sv = vbslq_f32(swap, cp, sp);
+    float32x4_t cv = vbslq_f32(swap, sp, cp);
+    uint32x4_t sign_s = vshlq_n_u32(vandq_u32(q, vdupq_n_u32(2)), 30);
+    uint32x4_t sign_c = vshlq_n_u32(vandq_u32(vaddq_u32(q, vdupq_n_u32(1)), vdupq_n_u32(2)), 30);
+
+    *s = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(sv), sign_s));
+    *c = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(cv), sign_c));
+}
+
+
+/**
+ * Box-Muller: (u1, u2) → r * cos(2πu2), r * sin(2πu2), r = sqrt(-2 ln u1), u1 ∈ (0, 1]
+*/
+static NEON_INLINE void neon_box_muller_f32x4(uint32x4_t a, uint32x4_t b, float32x4_t* z0, float32x4_t* z1) {
+    float32x4_t u1 = neon_random_u01_open_f32x4(a);
+    float32x4_t u2 = neon_random_u01_f32x4(b);
+
+    float32x4_t r = vsqrtq_f32(vmulq_f32(neon_log_f32x4(u1), vdupq_n_f32(-2.0f)));
+    float32x4_t s, c;
+    neon_sincos_turns_f32x4(u2, &s, &c);
+
+    *z0 = vmulq_f32(r, c);
+    *z1 = vmulq_f32(r, s);
+}
+
+
+
+// FILL WORKERS
+typedef enum {
+    RANDOM_FILL_U32 = 0,
+    RANDOM_FILL_UNIFORM = 1,
+    RANDOM_FILL_NORMAL = 2,
+    RANDOM_FILL_DROPOUT = 3
+} RandomFillType;
+
+
+typedef struct {
+    RandomFillType type;
+    uint64_t seed;
+    uint64_t stream;
+    uint64_t block0;
+    size_t n;
+
+    uint32_t* out_u32;
+    float* out;
+    const float* in; // dropout
+    float a; // uniform: lo, normal: mean, dropout: scale
+    float b; // uniform: hi - lo, normal: std
+    uint32_t threshold; // dropout: giữ nếu u >= threshold
+} NeonRandomCtx;
+
+
+/**
+ * 16 giá trị của 1 quad theo thứ tự tuần tự (dst có thể là buffer tạm cho quad cuối)
+*/
+static NEON_INLINE void neon_random_quad_store(const NeonRandomCtx* ctx, uint64_t block, const float* in, void* dst) {
+    uint32x4x4_t u = neon_philox_quad(ctx->seed, ctx->stream, block);
+
+    if (ctx->type == RANDOM_FILL_U32) {
+        vst4q_u32((uint32_t*)dst, u);
+        return;
+    }
+
+    float32x4x4_t r;
+    if (ctx->type == RANDOM_FILL_UNIFORM) {
+        float32x4_t lo = vdupq_n_f32(ctx->a), range = vdupq_n_f32(ctx->b);
+        for (int j = 0; j < 4; j++) r.val[j] = vfmaq_f32(lo, neon_random_u01_f32x4(u.val[j]), range);
+    } else if (ctx->type == RANDOM_FILL_NORMAL) {
+        float32x4_t mean = vdupq_n_f32(ctx->a), std = vdupq_n_f32(ctx->b);
+        neon_box_muller_f32x4(u.val[0], u.val[1], &r.val[0], &r.val[1]);
+        neon_box_muller_f32x4(u.val[2], u.val[3], &r.val[2], &r.val[3]);
+        for (int j = 0; j < 4; j++) r.val[j] = vfmaq_f32(mean, r.val[j], std);
+    } else {
+        // vld4q tách x theo cùng layout SoA với u
+        float32x4x4_t x = vld4q_f32(in);
+        float32x4_t scale = vdupq_n_f32(ctx->a);
+        uint32x4_t th = vdupq_n_u32(ctx->threshold);
+        for (int j = 0; j < 4; j++) {
+            uint32x4_t keep = vcgeq_u32(u.val[j], th);
+            r.val[j] = vreinterpretq_f32_u32(vandq_u32(keep, vreinterpretq_u32_f32(vmulq_f32(x.val[j], scale))));
+        }
+    }
+    vst4q_f32((float*)dst, r);
+}
+
+
+static void neon_random_worker(void* arg, size_t begin, size_t end, int tid) {
+    (void)tid;
+    NeonRandomCtx* ctx = (NeonRandomCtx*)arg;
+    size_t elem = (ctx->type == RANDOM_FILL_U32) ? sizeof(uint32_t) : sizeof(float);
+
+    for (size_t q = begin; q < end; q++) {
+        size_t i = q * 16;
+        uint64_t block = ctx->block0 + (uint64_t)q * 4;
+        size_t count = MIN((size_t)16, ctx->n - i);
+        const float* in = (ctx->type == RANDOM_FILL_DROPOUT) ? ctx->in + i : NULL;
+        void* dst = (ctx->type == RANDOM_FILL_U32) ? (void*)(ctx->out_u32 + i) : (void*)(ctx->out + i);
+
+        if (LIKELY(count == 16)) {
+            neon_random_quad_store(ctx, block, in, dst);
+        } else {
+            float tmp_in[16], tmp_out[16];
+            if (in != NULL) {
+                memset(tmp_in, 0, sizeof(tmp_in));
+                memcpy(tmp_in, in, count * sizeof(float));
+                in = tmp_in;
+            }
+            neon_random_quad_store(ctx, block, in, tmp_out);
+            memcpy(dst, tmp_out, count * elem);
+        }
+    }
+}
+
+
+/**
+ * Chạy fill, tiến offset của rng thêm số blocks đã dùng (bội của 4)
+*/
+static inline void neon_random_run(NeonPhilox* rng, NeonRandomCtx* ctx, int num_threads) {
+    size_t quads = (ctx->n + 15) / 16;
+    ctx->seed = rng->seed;
+    ctx->stream = rng->stream;
+    ctx->block0 = (rng->offset + 3) & ~(uint64_t)3;
+
+    if (quads > 0) {
+        int threads = neon_threads_for(quads, num_threads, NEON_RANDOM_MIN_QUADS);
+        neon_parallel_for(quads, threads, neon_random_worker, ctx);
+    }
+    rng->offset = ctx->block0 + (uint64_t)quads * 4;
+}
+
+
+
+// PUBLIC API
+static inline int neon_random_u32(NeonPhilox* rng, uint32_t* out, size_t n, int num_threads) {
+    if (rng == NULL || (out == NULL && n > 0)) return NEON_ERROR_NULL_POINTER;
+
+    NeonRandomCtx ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.type = RANDOM_FILL_U32;
+    ctx.n = n;
+    ctx.out_u32 = out;
+    neon_random_run(rng, &ctx, num_threads);
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * out[i] ~ U[lo, hi)
+*/
+static inline int neon_random_uniform_f32(NeonPhilox* rng, float* out, size_t n, float lo, float hi, int num_threads) {
+    if (rng == NULL || (out == NULL && n > 0)) return NEON_ERROR_NULL_POINTER;
+    if (!(hi >= lo)) return NEON_ERROR_INVALID_PARAM;
+
+    NeonRandomCtx ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.type = RANDOM_FILL_UNIFORM;
+    ctx.n = n;
+    ctx.out = out;
+    ctx.a = lo;
+    ctx.b = hi - lo;
+    neon_random_run(rng, &ctx, num_threads);
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * out[i] ~ N(mean, std²)
+*/
+static inline int neon_random_normal_f32(NeonPhilox* rng, float* out, size_t n, float mean, float std, int num_threads) {
+    if (rng == NULL || (out == NULL && n > 0)) return NEON_ERROR_NULL_POINTER;
+    if (!(std >= 0.0f)) return NEON_ERROR_INVALID_PARAM;
+
+    NeonRandomCtx ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.type = RANDOM_FILL_NORMAL;
+    ctx.n = n;
+    ctx.out = out;
+    ctx.a = mean;
+    ctx.b = std;
+    neon_random_run(rng, &ctx, num_threads);
+    return NEON_SUCCESS;
+}
+
+
+static inline int neon_random_uniform_buffer(NeonPhilox* rng, AlignedBuffer* buffer, float lo, float hi, int num_threads) {
+    if (buffer == NULL) return NEON_ERROR_NULL_POINTER;
+    return neon_random_uniform_f32(rng, buffer->data, buffer->size, lo, hi, num_threads);
+}
+
+
+static inline int neon_random_normal_buffer(NeonPhilox* rng, AlignedBuffer* buffer, float mean, float std, int num_threads) {
+    if (buffer == NULL) return NEON_ERROR_NULL_POINTER;
+    return neon_random_normal_f32(rng, buffer->data, buffer->size, mean, std, num_threads);
+}
+
+
+
+// DROPOUT
+/**
+ * Inverted dropout: y = x / (1 - p) với xác suất 1 - p, còn lại 0 (y có thể trùng x)
+ * Lưu bản sao *rng trước khi gọi để backward sinh lại đúng mask
+*/
+static inline int neon_dropout_f32(NeonPhilox* rng, const float* x, float* y, size_t n, float p, int num_threads) {
+    if (rng == NULL || ((x == NULL || y == NULL) && n > 0)) return NEON_ERROR_NULL_POINTER;
+    if (!(p >= 0.0f && p < 1.0f)) return NEON_ERROR_INVALID_PARAM;
+
+    NeonRandomCtx ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.type = RANDOM_FILL_DROPOUT;
+    ctx.n = n;
+    ctx.in = x;
+    ctx.out = y;
+    ctx.a = 1.0f / (1.0f - p);
+    ctx.threshold = (uint32_t)MIN((double)p * 4294967296.0, 4294967295.0);
+    neon_random_run(rng, &ctx, num_threads);
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * dx = dy * mask / (1 - p), mask sinh lại từ state lúc forward (forward_state không bị thay đổi)
+*/
+static inline int neon_dropout_backward_f32(const NeonPhilox* forward_state, const float* dy, float* dx, size_t n, float p, int num_threads) {
+    if (forward_state == NULL) return NEON_ERROR_NULL_POINTER;
+
+    NeonPhilox rng = *forward_state;
+    return neon_dropout_f32(&rng, dy, dx, n, p, num_threads);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_RANDOM_H
@@ -0,0 +1,459 @@
+#ifndef NEON_SCAN_H
+#define NEON_SCAN_H
+
+#include "neon_types.h"
+#include "memory_align.h"
+#include "neon_utils.h"
+#include "neon_thread.h"
+
+
+/**
+ * PREFIX SUM (SCAN) VÀ STREAM COMPACTION
+ *
+ * Inclusive scan: out[i] = in[0] + ... + in[i]
+ * Exclusive scan: out[i] = in[0] + ... + in[i-1],  out[0] = 0
+ *
+ * IN-REGISTER SCAN (2 bước):
+ *   v                  = [a,     b,     c,         d          ]
+ *   v + trn1(0, v)     = [a,     a+b,   c,         c+d        ]
+ *   + broadcast lane 1 = [a,     a+b,   (a+b)+c,   (a+b)+(c+d)]
+ *   lanes 0-2 cộng đúng thứ tự tuần tự, chỉ lane 3 khác thứ tự
+ *   + carry (broadcast tổng của vector trước)
+ *
+ * Exclusive = inclusive cục bộ dịch lên 1 lane + carry (không trừ lại src: sai với inf / NaN)
+ *
+ * STREAM COMPACTION ("giữ phần tử có mask = 1"):
+ *   Scalar có branch → mispredict khi mask ngẫu nhiên (~50%)
+ *   NEON: mask 4 lanes → 4 bit → tra bảng shuffle 16 entries → vqtbl1q_u8
+ *         đẩy các lane được giữ về đầu vector, store cả vector, tiến con trỏ popcount(bits)
+ *   Hoàn toàn không branch
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+// IN-REGISTER SCAN
+static NEON_INLINE float32x4_t neon_scan_f32x4(float32x4_t v) {
+    float32x4_t zero = vdupq_n_f32(0.0f);
+    v = vaddq_f32(v, vtrn1q_f32(zero, v)); // [0, a, 0, c]
+    v = vaddq_f32(v, vextq_f32(zero, vdupq_laneq_f32(v, 1), 2)); // [0, 0, a+b, a+b]
+    return v;
+}
+
+static NEON_INLINE int32x4_t neon_scan_s32x4(int32x4_t v) {
+    int32x4_t zero = vdupq_n_s32(0);
+    v = vaddq_s32(v, vextq_s32(zero, v, 3));
+    v = vaddq_s32(v, vextq_s32(zero, v, 2));
+    return v;
+}
+
+
+
+// SEQUENTIAL SCAN
+/**
+ * Inclusive scan float, bắt đầu cộng từ init
+ * dst có thể trùng src
+ * @return: tổng cuối cùng (init + sum(src))
+*/
+static inline float neon_inclusive_scan_f32(const float* src, float* dst, size_t n, float init) {
+    float32x4_t carry = vdupq_n_f32(init);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        float32x4_t s0 = neon_scan_f32x4(vld1q_f32(src + i));
+        float32x4_t s1 = neon_scan_f32x4(vld1q_f32(src + i + 4));
+
+        s0 = vaddq_f32(s0, carry);
+        s1 = vaddq_f32(s1, vdupq_laneq_f32(s0, 3));
+        carry = vdupq_laneq_f32(s1, 3);
+
+        vst1q_f32(dst + i, s0);
+        vst1q_f32(dst + i + 4, s1);
+    }
+
+    float acc = vgetq_lane_f32(carry, 0);
+    for (; i < n; i++) {
+        acc += src[i];
+        dst[i] = acc;
+    }
+
+    return acc;
+}
+
+
+/**
+ * Exclusive scan float: dst[i] = init + src[0] + ... + src[i-1]
+ * @return: init + sum(src)
+*/
+static inline float neon_exclusive_scan_f32(const float* src, float* dst, size_t n, float init) {
+    float32x4_t carry = vdupq_n_f32(init);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        // inclusive - src[i] sai với inf / NaN và khi triệt tiêu (1 + 1e30 - 1e30) → dịch lên 1 lane
+        float32x4_t incl = neon_scan_f32x4(vld1q_f32(src + i));
+        vst1q_f32(dst + i, vaddq_f32(vextq_f32(vdupq_n_f32(0.0f), incl, 3), carry));
+        carry = vaddq_f32(carry, vdupq_laneq_f32(incl, 3));
+    }
+
+    float acc = vgetq_lane_f32(carry, 0);
+    for (; i < n; i++) {
+        float v = src[i];
+        dst[i] = acc;
+        acc += v;
+    }
+
+    return acc;
+}
+
+
+/**
+ * Inclusive scan int32 (không lo overflow, wrap-around như unsigned)
+*/
+static inline int32_t neon_inclusive_scan_s32(const int32_t* src, int32_t* dst, size_t n, int32_t init) {
+    int32x4_t carry = vdupq_n_s32(init);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        int32x4_t s0 = neon_scan_s32x4(vld1q_s32(src + i));
+        int32x4_t s1 = neon_scan_s32x4(vld1q_s32(src + i + 4));
+
+        s0 = vaddq_s32(s0, carry);
+        s1 = vaddq_s32(s1, vdupq_laneq_s32(s0, 3));
+        carry = vdupq_laneq_s32(s1, 3);
+
+        vst1q_s32(dst + i, s0);
+        vst1q_s32(dst + i + 4, s1);
+    }
+
+    uint32_t acc = (uint32_t)vgetq_lane_s32(carry, 0);
+    for (; i < n; i++) {
+        acc += (uint32_t)src[i];
+        dst[i] = (int32_t)acc;
+    }
+
+    return (int32_t)acc;
+}
+
+
+/**
+ * Exclusive scan int32 - ví dụ counts → CSR row_ptr
+*/
+static inline int32_t neon_exclusive_scan_s32(const int32_t* src, int32_t* dst, size_t n, int32_t init) {
+    int32x4_t carry = vdupq_n_s32(init);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int32x4_t v = vld1q_s32(src + i);
+        int32x4_t s = vaddq_s32(neon_scan_s32x4(v), carry);
+        vst1q_s32(dst + i, vsubq_s32(s, v));
+        carry = vdupq_laneq_s32(s, 3);
+    }
+
+    uint32_t acc = (uint32_t)vgetq_lane_s32(carry, 0);
+    for (; i < n; i++) {
+        uint32_t v = (uint32_t)src[i];
+        dst[i] = (int32_t)acc;
+        acc += v;
+    }
+
+    return (int32_t)acc;
+}
+
+
+
+// PARALLEL SCAN (reduce-then-scan)
+/**
+ * 2 passes:
+ *   Pass 1: mỗi thread tính tổng đoạn của mình (chỉ đọc)
+ *   Giữa:   exclusive scan trên num_threads tổng (scalar, rất nhỏ)
+ *   Pass 2: mỗi thread scan đoạn của mình với init = offset của đoạn
+ *
+ * Đọc src 2 lần, ghi dst 1 lần. Chỉ đáng dùng khi n lớn (vài trăm nghìn trở lên)
+*/
+typedef struct {
+    const void* src;
+    void* dst;
+    int is_int;
+    int exclusive;
+    double f_partial[NEON_MAX_THREADS];
+    int32_t i_partial[NEON_MAX_THREADS];
+} NeonScanParallelCtx;
+
+
+static void neon_scan_reduce_worker(void* arg, size_t begin, size_t end, int tid) {
+    NeonScanParallelCtx* ctx = (NeonScanParallelCtx*)arg;
+
+    if (ctx->is_int) {
+        const int32_t* src = (const int32_t*)ctx->src + begin;
+        size_t n = end - begin;
+        int32x4_t acc = vdupq_n_s32(0);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) acc = vaddq_s32(acc, vld1q_s32(src + i));
+        uint32_t s = (uint32_t)vaddvq_s32(acc);
+        for (; i < n; i++) s += (uint32_t)src[i];
+        ctx->i_partial[tid] = (int32_t)s;
+    } else {
+        const float* src = (const float*)ctx->src + begin;
+        size_t n = end - begin;
+        float32x4_t acc = vdupq_n_f32(0.0f);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) acc = vaddq_f32(acc, vld1q_f32(src + i));
+        float s = neon_sum_f32x4(acc);
+        for (; i < n; i++) s += src[i];
+        ctx->f_partial[tid] = s;
+    }
+}
+
+
+static void neon_scan_apply_worker(void* arg, size_t begin, size_t end, int tid) {
+    NeonScanParallelCtx* ctx = (NeonScanParallelCtx*)arg;
+    size_t n = end - begin;
+
+    if (ctx->is_int) {
+        const int32_t* src = (const int32_t*)ctx->src + begin;
+        int32_t* dst = (int32_t*)ctx->dst + begin;
+        if (ctx->exclusive) neon_exclusive_scan_s32(src, dst, n, ctx->i_partial[tid]);
+        else neon_inclusive_scan_s32(src, dst, n, ctx->i_partial[tid]);
+    } else {
+        const float* src = (const float*)ctx->src + begin;
+        float* dst = (float*)ctx->dst + begin;
+        if (ctx->exclusive) neon_exclusive_scan_f32(src, dst, n, (float)ctx->f_partial[tid]);
+        else neon_inclusive_scan_f32(src, dst, n, (float)ctx->f_partial[tid]);
+    }
+}
+
+
+static inline void neon_scan_parallel(NeonScanParallelCtx* ctx, size_t n, int num_threads) {
+    neon_parallel_for(n, num_threads, neon_scan_reduce_worker, ctx);
+
+    // Tổng từng đoạn → offset (exclusive scan). Offset float cộng dồn bằng double
+    double f_acc = 0.0;
+    uint32_t i_acc = 0;
+    for (int t = 0; t < num_threads; t++) {
+        double f = ctx->f_partial[t];
+        int32_t v = ctx->i_partial[t];
+        ctx->f_partial[t] = f_acc;
+        ctx->i_partial[t] = (int32_t)i_acc;
+        f_acc += f;
+        i_acc += (uint32_t)v;
+    }
+
+    neon_parallel_for(n, num_threads, neon_scan_apply_worker, ctx);
+}
+
+
+/**
+ * Parallel scan float
+ * @param exclusive: 0 = inclusive, 1 = exclusive
+*/
+static inline void neon_scan_parallel_f32(const float* src, float* dst, size_t n, int exclusive, int num_threads) {
+    num_threads = neon_threads_for(n, num_threads, 1 << 16);
+    if (num_threads <= 1) {
+        if (exclusive) neon_exclusive_scan_f32(src, dst, n, 0.0f);
+        else neon_inclusive_scan_f32(src, dst, n, 0.0f);
+        return;
+    }
+
+    NeonScanParallelCtx ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.src = src;
+    ctx.dst = dst;
+    ctx.is_int = 0;
+    ctx.exclusive = exclusive;
+    neon_scan_parallel(&ctx, n, num_threads);
+}
+
+
+/**
+ * Parallel scan int32
+*/
+static inline void neon_scan_parallel_s32(const int32_t* src, int32_t* dst, size_t n, int exclusive, int num_threads) {
+    num_threads = neon_threads_for(n, num_threads, 1 << 16);
+    if (num_threads <= 1) {
+        if (exclusive) neon_exclusive_scan_s32(src, dst, n, 0);
+        else neon_inclusive_scan_s32(src, dst, n, 0);
+        return;
+    }
+
+    NeonScanParallelCtx ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.src = src;
+    ctx.dst = dst;
+    ctx.is_int = 1;
+    ctx.exclusive = exclusive;
+    neon_scan_parallel(&ctx, n, num_threads);
+}
+
+
+
+// STREAM COMPACTION
+/**
+ * Shuffle table: bits (4 bit, lane i giữ nếu bit i = 1) → byte indices cho vqtbl1q_u8
+ * 0x80 = ngoài range → vqtbl1q_u8 trả về 0
+*/
+static const uint8_t NEON_COMPACT_LUT[16][16] ALIGN_NEON = {
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80}, // 0000
+    {0, 1, 2, 3, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80}, // 0001
+    {4, 5, 6, 7, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80}, // 0010
+    {0, 1, 2, 3, 4, 5, 6, 7, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80}, // 0011
+    {8, 9, 10, 11, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80}, // 0100
+    {0, 1, 2, 3, 8, 9, 10, 11, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80}, // 0101
+    {4, 5, 6, 7, 8, 9, 10, 11, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80}, // 0110
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 0x80, 0x80, 0x80, 0x80}, // 0111
+    {12, 13, 14, 15, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80}, // 1000
+    {0, 1, 2, 3, 12, 13, 14, 15, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80}, // 1001
+    {4, 5, 6, 7, 12, 13, 14, 15, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80}, // 1010
+    {0, 1, 2, 3, 4, 5, 6, 7, 12, 13, 14, 15, 0x80, 0x80, 0x80, 0x80}, // 1011
+    {8, 9, 10, 11, 12, 13, 14, 15, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80}, // 1100
+    {0, 1, 2, 3, 8, 9, 10, 11, 12, 13, 14, 15, 0x80, 0x80, 0x80, 0x80}, // 1101
+    {4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0x80, 0x80, 0x80, 0x80}, // 1110
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}, // 1111
+};
+
+
+/**
+ * Mask 4 lanes (0 / 0xFFFFFFFF, ví dụ từ neon_cmpgt_f32x4) → 4 bit
+*/
+static NEON_INLINE uint32_t neon_mask_bits_u32x4(uint32x4_t mask) {
+    static const int32_t shifts[4] = {0, 1, 2, 3};
+    uint32x4_t bits = vshlq_u32(vshrq_n_u32(mask, 31), vld1q_s32(shifts));
+    return vaddvq_u32(bits);
+}
+
+
+/**
+ * Ghi các lane có mask vào dst (liền nhau), trả về số lane được ghi
+ *
+ * LƯU Ý: luôn store cả 4 lanes → dst phải còn chỗ cho 4 floats
+ * (các lane thừa sẽ bị ghi đè bởi lần store sau)
+*/
+static NEON_INLINE uint32_t neon_compact_store_f32x4(float* dst, float32x4_t v, uint32x4_t mask) {
+    uint32_t bits = neon_mask_bits_u32x4(mask);
+    uint8x16_t shuffle = vld1q_u8(NEON_COMPACT_LUT[bits]);
+    uint8x16_t packed = vqtbl1q_u8(vreinterpretq_u8_f32(v), shuffle);
+    vst1q_f32(dst, vreinterpretq_f32_u8(packed));
+    return (uint32_t)__builtin_popcount(bits);
+}
+
+static NEON_INLINE uint32_t neon_compact_store_s32x4(int32_t* dst, int32x4_t v, uint32x4_t mask) {
+    uint32_t bits = neon_mask_bits_u32x4(mask);
+    uint8x16_t shuffle = vld1q_u8(NEON_COMPACT_LUT[bits]);
+    uint8x16_t packed = vqtbl1q_u8(vreinterpretq_u8_s32(v), shuffle);
+    vst1q_s32(dst, vreinterpretq_s32_u8(packed));
+    return (uint32_t)__builtin_popcount(bits);
+}
+
+
+/**
+ * Giữ src[i] > threshold, ghi vào dst (liền nhau) và index vào out_indices (có thể NULL)
+ *
+ * dst/out_indices cần n phần tử (trường hợp giữ tất cả)
+ * Vì count <= i nên store 4 lanes tại dst + count không bao giờ vượt dst + n,
+ * và dst == src (in-place) cũng an toàn
+ *
+ * @return: số phần tử được giữ
+*/
+static inline size_t neon_compact_gt_f32(
+    const float* src,
+    size_t n,
+    float threshold,
+    float* dst,
+    int32_t* out_indices
+) {
+    float32x4_t vth = vdupq_n_f32(threshold);
+    int32x4_t vidx = {0, 1, 2, 3};
+    int32x4_t four = vdupq_n_s32(4);
+
+    size_t count = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t v = vld1q_f32(src + i);
+        uint32x4_t m = neon_cmpgt_f32x4(v, vth);
+
+        if (out_indices != NULL) {
+            neon_compact_store_s32x4(out_indices + count, vidx, m);
+        }
+        count += neon_compact_store_f32x4(dst + count, v, m);
+        vidx = vaddq_s32(vidx, four);
+    }
+
+    for (; i < n; i++) {
+        float v = src[i];
+        if (v > threshold) {
+            if (out_indices != NULL) out_indices[count] = (int32_t)i;
+            dst[count++] = v;
+        }
+    }
+
+    return count;
+}
+
+
+/**
+ * Compaction theo mask có sẵn: keep[i] != 0 → giữ src[i]
+ * keep dạng uint8 (0/1 hoặc 0/0xFF), ví dụ từ NMS hoặc filter phức tạp hơn
+*/
+static inline size_t neon_compact_mask_f32(
+    const float* src,
+    const uint8_t* keep,
+    size_t n,
+    float* dst
+) {
+    size_t count = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        // 4 bytes mask → 4 lanes u32: load 32 bit, widen u8 → u16 → u32
+        uint8x8_t k8 = vreinterpret_u8_u32(vld1_lane_u32((const uint32_t*)(const void*)(keep + i), vdup_n_u32(0), 0));
+        uint32x4_t k32 = vmovl_u16(vget_low_u16(vmovl_u8(k8)));
+        uint32x4_t m = vtstq_u32(k32, k32); // != 0 → 0xFFFFFFFF
+
+        count += neon_compact_store_f32x4(dst + count, vld1q_f32(src + i), m);
+    }
+
+    for (; i < n; i++) {
+        if (keep[i]) dst[count++] = src[i];
+    }
+
+    return count;
+}
+
+
+/**
+ * Compaction int32 theo mask (ví dụ giữ id của survivors)
+*/
+static inline size_t neon_compact_mask_s32(
+    const int32_t* src,
+    const uint8_t* keep,
+    size_t n,
+    int32_t* dst
+) {
+    size_t count = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        uint8x8_t k8 = vreinterpret_u8_u32(vld1_lane_u32((const uint32_t*)(const void*)(keep + i), vdup_n_u32(0), 0));
+        uint32x4_t k32 = vmovl_u16(vget_low_u16(vmovl_u8(k8)));
+        uint32x4_t m = vtstq_u32(k32, k32);
+
+        count += neon_compact_store_s32x4(dst + count, vld1q_s32(src + i), m);
+    }
+
+    for (; i < n; i++) {
+        if (keep[i]) dst[count++] = src[i];
+    }
+
+    return count;
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_SCAN_H
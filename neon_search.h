@@ -0,0 +1,319 @@
+#ifndef NEON_SEARCH_H
+#define NEON_SEARCH_H
+
+#include "neon_types.h"
+#include "memory_align.h"
+#include <math.h>
+
+
+/**
+ * VECTORIZED SEARCHING (lower_bound trên sorted float arrays)
+ *
+ * lower_bound(x) = index đầu tiên i sao cho sorted[i] >= x (n nếu không có)
+ *
+ * VẤN ĐỀ với std::lower_bound:
+ *   - Branch "x < sorted[mid]" ngẫu nhiên → mispredict ~50% mỗi bước
+ *   - Mỗi bước phụ thuộc bước trước → CPU chờ từng cache miss một
+ *
+ * GIẢI PHÁP:
+ * 1. Branchless: base += (sorted[base + half] < x) ? half : 0  → compiler sinh csel
+ * 2. Batch: 8 queries chạy song song (2 x uint32x4_t), so sánh bằng vcltq_f32
+ *    → 8 cache misses độc lập cùng lúc thay vì 1
+ * 3. Prefetch 2 vị trí có thể truy cập ở bước sau
+ * 4. Eytzinger layout (BFS order của cây nhị phân):
+ *    node k có con 2k và 2k+1 → 4 levels tiếp theo (16 nodes) nằm trong 1 cache line
+ *    → prefetch trước 4 levels, gần như hết cache miss
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+// BRANCHLESS BINARY SEARCH
+/**
+ * lower_bound branchless (1 query)
+*/
+static inline size_t neon_lower_bound_f32(const float* sorted, size_t n, float x) {
+    if (n == 0) return 0;
+
+    const float* base = sorted;
+    size_t len = n;
+
+    while (len > 1) {
+        size_t half = len / 2;
+        base = (base[half - 1] < x) ? base + half : base;
+        len -= half;
+    }
+
+    return (size_t)(base - sorted) + (*base < x);
+}
+
+
+/**
+ * Batched lower_bound: 8 queries mỗi lần, interleaved
+ *
+ * Mọi query trong batch có cùng số bước (len giảm giống nhau), chỉ khác base
+ * → giữ 8 base trong 2 uint32x4_t, gather 8 giá trị, vcltq_f32, cộng half theo mask
+ *
+ * @param out: [m] kết quả (int32, giả định n < 2^31)
+*/
+static inline void neon_lower_bound_batch_f32(
+    const float* sorted,
+    size_t n,
+    const float* queries,
+    size_t m,
+    int32_t* out
+) {
+    if (n == 0) {
+        for (size_t q = 0; q < m; q++) out[q] = 0;
+        return;
+    }
+
+    size_t q = 0;
+    for (; q + 8 <= m; q += 8) {
+        float32x4_t x0 = vld1q_f32(queries + q);
+        float32x4_t x1 = vld1q_f32(queries + q + 4);
+        uint32x4_t b0 = vdupq_n_u32(0);
+        uint32x4_t b1 = vdupq_n_u32(0);
+
+        uint32_t idx[8] ALIGN_NEON;
+        size_t len = n;
+
+        while (len > 1) {
+            uint32_t half = (uint32_t)(len / 2);
+            uint32x4_t vhalf = vdupq_n_u32(half);
+
+            // Gather sorted[base + half - 1]
+            vst1q_u32(idx, vaddq_u32(b0, vdupq_n_u32(half - 1)));
+            vst1q_u32(idx + 4, vaddq_u32(b1, vdupq_n_u32(half - 1)));
+
+            float g[8] ALIGN_NEON;
+            for (int j = 0; j < 8; j++) {
+                g[j] = sorted[idx[j]];
+            }
+
+            len -= half;
+
+            // Prefetch 2 khả năng của bước tiếp theo
+            size_t next_half = len / 2;
+            if (next_half > 0) {
+                for (int j = 0; j < 8; j++) {
+                    NEON_PREFETCH(sorted + idx[j] + 1 - half + next_half - 1);
+                    NEON_PREFETCH(sorted + idx[j] + 1 + next_half - 1);
+                }
+            }
+
+            uint32x4_t m0 = vcltq_f32(vld1q_f32(g), x0);
+            uint32x4_t m1 = vcltq_f32(vld1q_f32(g + 4), x1);
+            b0 = vaddq_u32(b0, vandq_u32(m0, vhalf));
+            b1 = vaddq_u32(b1, vandq_u32(m1, vhalf));
+        }
+
+        // Bước cuối: + (sorted[base] < x)
+        vst1q_u32(idx, b0);
+        vst1q_u32(idx + 4, b1);
+        float g[8] ALIGN_NEON;
+        for (int j = 0; j < 8; j++) {
+            g[j] = sorted[idx[j]];
+        }
+
+        uint32x4_t one = vdupq_n_u32(1);
+        b0 = vaddq_u32(b0, vandq_u32(vcltq_f32(vld1q_f32(g), x0), one));
+        b1 = vaddq_u32(b1, vandq_u32(vcltq_f32(vld1q_f32(g + 4), x1), one));
+
+        vst1q_s32(out + q, vreinterpretq_s32_u32(b0));
+        vst1q_s32(out + q + 4, vreinterpretq_s32_u32(b1));
+    }
+
+    for (; q < m; q++) {
+        out[q] = (int32_t)neon_lower_bound_f32(sorted, n, queries[q]);
+    }
+}
+
+
+/**
+ * Batched lower_bound trên AlignedBuffer đã sort (dùng buf->size phần tử)
+*/
+static inline void neon_lower_bound_batch_buffer(
+    const AlignedBuffer* sorted,
+    const float* queries,
+    size_t m,
+    int32_t* out
+) {
+    neon_lower_bound_batch_f32(sorted->data, sorted->size, queries, m, out);
+}
+
+
+
+// EYTZINGER INDEX
+/**
+ * Cây nhị phân đầy đủ lưu theo BFS: keys[1] = root, con của k là 2k, 2k+1
+ * Pad thêm +INF để cây đầy đủ (size = 2^levels - 1) → mọi search đúng `levels` bước,
+ * không cần check biên
+ *
+ * ranks[k] = vị trí của keys[k] trong sorted array gốc (pad → n)
+ * keys align 64 bytes → keys[16k .. 16k+15] nằm gọn trong 1 cache line
+*/
+typedef struct
+{
+    float* keys; // [size + 1], keys[0] không dùng
+    int32_t* ranks; // [size + 1]
+    size_t n; // số phần tử thật
+    size_t size; // 2^levels - 1
+    int32_t levels;
+} EytzingerIndex;
+
+
+static inline size_t neon_eytzinger_fill(
+    const float* sorted, size_t n, size_t size,
+    float* keys, int32_t* ranks, size_t i, size_t k
+) {
+    if (k <= size) {
+        i = neon_eytzinger_fill(sorted, n, size, keys, ranks, i, 2 * k);
+        keys[k] = (i < n) ? sorted[i] : INFINITY;
+        ranks[k] = (int32_t)MIN(i, n);
+        i++;
+        i = neon_eytzinger_fill(sorted, n, size, keys, ranks, i, 2 * k + 1);
+    }
+    return i;
+}
+
+
+/**
+ * Build Eytzinger index từ sorted AlignedBuffer (dùng sorted->size phần tử)
+ * @return: NEON_SUCCESS hoặc error code
+*/
+static inline int neon_eytzinger_build(const AlignedBuffer* sorted, EytzingerIndex* index) {
+    if (sorted == NULL || index == NULL) return NEON_ERROR_NULL_POINTER;
+    if (sorted->data == NULL && sorted->size > 0) return NEON_ERROR_NULL_POINTER;
+
+    int32_t levels = 0;
+    size_t size = 0;
+    while (size < sorted->size) {
+        levels++;
+        size = ((size_t)1 << levels) - 1;
+    }
+    if (levels == 0) {
+        levels = 1;
+        size = 1;
+    }
+
+    // Thêm 16 phần tử cuối để prefetch keys + 16k không cần check biên
+    size_t alloc = ALIGN_UP((size + 1) * sizeof(float)) + 16 * sizeof(float);
+    index->keys = (float*)aligned_malloc(alloc, NEON_CACHE_LINE);
+    index->ranks = (int32_t*)neon_malloc((size + 1) * sizeof(int32_t));
+
+    if (index->keys == NULL || index->ranks == NULL) {
+        aligned_free(index->keys);
+        neon_free(index->ranks);
+        index->keys = NULL;
+        index->ranks = NULL;
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    index->n = sorted->size;
+    index->size = size;
+    index->levels = levels;
+    index->keys[0] = NAN;
+    index->ranks[0] = (int32_t)sorted->size; // k = 0 sau khi decode → không có phần tử >= x
+
+    neon_eytzinger_fill(sorted->data, sorted->size, size, index->keys, index->ranks, 0, 1);
+
+    return NEON_SUCCESS;
+}
+
+
+static inline void neon_eytzinger_destroy(EytzingerIndex* index) {
+    if (index == NULL) return;
+
+    aligned_free(index->keys);
+    neon_free(index->ranks);
+    index->keys = NULL;
+    index->ranks = NULL;
+    index->n = 0;
+    index->size = 0;
+}
+
+
+/**
+ * Decode: sau `levels` bước k nằm ở tầng lá ảo; bỏ các bit 1 cuối (các lần rẽ phải)
+ * và 1 bit 0 → node cuối cùng rẽ trái = phần tử nhỏ nhất >= x
+*/
+static NEON_INLINE size_t neon_eytzinger_decode(size_t k) {
+    return k >> __builtin_ffsll((long long)~k);
+}
+
+
+/**
+ * lower_bound trên Eytzinger index (1 query)
+*/
+static inline size_t neon_eytzinger_lower_bound(const EytzingerIndex* index, float x) {
+    size_t k = 1;
+
+    for (int32_t l = 0; l < index->levels; l++) {
+        NEON_PREFETCH(index->keys + MIN(k * 16, index->size));
+        k = 2 * k + (index->keys[k] < x);
+    }
+
+    return (size_t)index->ranks[neon_eytzinger_decode(k)];
+}
+
+
+/**
+ * Batched lower_bound trên Eytzinger index: 8 queries interleaved
+ * Mỗi bước: gather keys[k] cho 8 lanes, k = 2k + (key < x) bằng vcltq/vshlq
+*/
+static inline void neon_eytzinger_lower_bound_batch(
+    const EytzingerIndex* index,
+    const float* queries,
+    size_t m,
+    int32_t* out
+) {
+    const float* keys = index->keys;
+
+    size_t q = 0;
+    for (; q + 8 <= m; q += 8) {
+        float32x4_t x0 = vld1q_f32(queries + q);
+        float32x4_t x1 = vld1q_f32(queries + q + 4);
+        uint32x4_t k0 = vdupq_n_u32(1);
+        uint32x4_t k1 = vdupq_n_u32(1);
+        uint32x4_t one = vdupq_n_u32(1);
+
+        uint32_t k[8] ALIGN_NEON;
+
+        for (int32_t l = 0; l < index->levels; l++) {
+            vst1q_u32(k, k0);
+            vst1q_u32(k + 4, k1);
+
+            float g[8] ALIGN_NEON;
+            for (int j = 0; j < 8; j++) {
+                g[j] = keys[k[j]];
+                NEON_PREFETCH(keys + MIN((size_t)k[j] * 16, index->size));
+            }
+
+            uint32x4_t m0 = vandq_u32(vcltq_f32(vld1q_f32(g), x0), one);
+            uint32x4_t m1 = vandq_u32(vcltq_f32(vld1q_f32(g + 4), x1), one);
+            k0 = vaddq_u32(vshlq_n_u32(k0, 1), m0);
+            k1 = vaddq_u32(vshlq_n_u32(k1, 1), m1);
+        }
+
+        vst1q_u32(k, k0);
+        vst1q_u32(k + 4, k1);
+        for (int j = 0; j < 8; j++) {
+            out[q + j] = index->ranks[neon_eytzinger_decode(k[j])];
+        }
+    }
+
+    for (; q < m; q++) {
+        out[q] = (int32_t)neon_eytzinger_lower_bound(index, queries[q]);
+    }
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_SEARCH_H
@@ -0,0 +1,259 @@
+#ifndef NEON_SMALLMAT_H
+#define NEON_SMALLMAT_H
+
+#include "neon_types.h"
+#include "memory_align.h"
+
+
+/**
+ * BATCHED SMALL MATRICES (2x2 → 8x8, f32) - robotics, graphics, lidar
+ *
+ * GEMM tổng quát (pack, tile, biên) quá nặng cho 1 ma trận 3x3 / 4x4
+ * → xử lý 4 ma trận cùng lúc, mỗi lane của float32x4_t là 1 ma trận
+ *
+ * SoA LAYOUT (batch count ma trận N x N):
+ *   Phần tử (r, c) của ma trận b nằm ở M[(r * N + c) * stride + b]   (stride >= count)
+ *   → N * N "planes", 1 vld1q_f32 = cùng 1 phần tử của 4 ma trận, không cần shuffle
+ *   Vector batch: x[k * stride + b]
+ *
+ * SIZE CỐ ĐỊNH: mỗi N có 1 bộ hàm riêng sinh bằng macro (neon_mat3_mul_batch, neon_mat4_inverse_batch, ...)
+ *   → mọi vòng lặp có bound là hằng số, compiler unroll hết, ma trận nằm trong registers
+ *   (N <= 4: A, B nằm gọn trong 32 Q registers; N lớn hơn spill một phần xuống stack/L1)
+ *
+ * In-place được (C trùng A / B): mỗi nhóm 4 ma trận load hết trước khi store
+ * count không chia hết cho 4: nhóm cuối load / store qua buffer tạm
+ *
+ * Transform điểm bằng 1 ma trận (lidar): neon_mat4_transform_points, SoA x / y / z
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+// HELPERS
+static NEON_INLINE float32x4_t neon_smallmat_load(const float* p, size_t rem) {
+    if (LIKELY(rem >= 4)) return vld1q_f32(p);
+
+    float tmp[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (size_t i = 0; i < rem; i++) tmp[i] = p[i];
+    return vld1q_f32(tmp);
+}
+
+
+static NEON_INLINE void neon_smallmat_store(float* p, float32x4_t v, size_t rem) {
+    if (LIKELY(rem >= 4)) {
+        vst1q_f32(p, v);
+        return;
+    }
+
+    float tmp[4];
+    vst1q_f32(tmp, v);
+    for (size_t i = 0; i < rem; i++) p[i] = tmp[i];
+}
+
+
+/**
+ * AoS [count x n x n] (row-major từng ma trận) → SoA planes
+*/
+static inline void neon_smallmat_to_soa(const float* src, float* dst, size_t n, size_t count, size_t stride) {
+    size_t nn = n * n;
+    for (size_t b = 0; b < count; b++) {
+        for (size_t e = 0; e < nn; e++) {
+            dst[e * stride + b] = src[b * nn + e];
+        }
+    }
+}
+
+
+/**
+ * SoA planes → AoS [count x n x n]
+*/
+static inline void neon_smallmat_from_soa(const float* src, float* dst, size_t n, size_t count, size_t stride) {
+    size_t nn = n * n;
+    for (size_t b = 0; b < count; b++) {
+        for (size_t e = 0; e < nn; e++) {
+            dst[b * nn + e] = src[e * stride + b];
+        }
+    }
+}
+
+
+
+// PER-SIZE KERNELS
+/**
+ * neon_matN_mul_batch: C = A * B
+ * neon_matN_mulv_batch: y = A * x
+ * neon_matN_transpose_batch: C = A^T
+ * neon_matN_inverse_batch: C = A^-1 (Gauss-Jordan, partial pivoting theo từng lane bằng vbslq)
+ *   @return: số ma trận singular (pivot = 0), các ma trận đó có output inf / nan
+*/
+#define NEON_SMALLMAT_DEFINE(N)                                                         \
+static inline void neon_mat##N##_mul_batch(                                             \
+    const float* A, const float* B, float* C, size_t count, size_t stride               \
+) {                                                                                     \
+    for (size_t b = 0; b < count; b += 4) {                                             \
+        size_t rem = count - b;                                                         \
+        float32x4_t a[N * N], m[N * N];                                                 \
+        for (int e = 0; e < N * N; e++) {                                               \
+            a[e] = neon_smallmat_load(A + (size_t)e * stride + b, rem);                 \
+            m[e] = neon_smallmat_load(B + (size_t)e * stride + b, rem);                 \
+        }                                                                               \
+        for (int r = 0; r < N; r++) {                                                   \
+            for (int c = 0; c < N; c++) {                                               \
+                float32x4_t s = vmulq_f32(a[r * N], m[c]);                              \
+                for (int k = 1; k < N; k++) s = vfmaq_f32(s, a[r * N + k], m[k * N + c]); \
+                neon_smallmat_store(C + (size_t)(r * N + c) * stride + b, s, rem);      \
+            }                                                                           \
+        }                                                                               \
+    }                                                                                   \
+}                                                                                       \
+                                                                                        \
+static inline void neon_mat##N##_mulv_batch(                                            \
+    const float* A, const float* x, float* y, size_t count, size_t stride               \
+) {                                                                                     \
+    for (size_t b = 0; b < count; b += 4) {                                             \
+        size_t rem = count - b;                                                         \
+        float32x4_t v[N], out[N];                                                       \
+        for (int k = 0; k < N; k++) v[k] = neon_smallmat_load(x + (size_t)k * stride + b, rem); \
+        for (int r = 0; r < N; r++) {                                                   \
+            float32x4_t s = vmulq_f32(neon_smallmat_load(A + (size_t)(r * N) * stride + b, rem), v[0]); \
+            for (int k = 1; k < N; k++) {                                               \
+                s = vfmaq_f32(s, neon_smallmat_load(A + (size_t)(r * N + k) * stride + b, rem), v[k]); \
+            }                                                                           \
+            out[r] = s;                                                                 \
+        }                                                                               \
+        for (int r = 0; r < N; r++) neon_smallmat_store(y + (size_t)r * stride + b, out[r], rem); \
+    }                                                                                   \
+}                                                                                       \
+                                                                                        \
+static inline void neon_mat##N##_transpose_batch(                                       \
+    const float* A, float* C, size_t count, size_t stride                               \
+) {                                                                                     \
+    for (size_t b = 0; b < count; b += 4) {                                             \
+        size_t rem = count - b;                                                         \
+        float32x4_t a[N * N];                                                           \
+        for (int e = 0; e < N * N; e++) a[e] = neon_smallmat_load(A + (size_t)e * stride + b, rem); \
+        for (int r = 0; r < N; r++) {                                                   \
+            for (int c = 0; c < N; c++) {                                               \
+                neon_smallmat_store(C + (size_t)(r * N + c) * stride + b, a[c * N + r], rem); \
+            }                                                                           \
+        }                                                                               \
+    }                                                                                   \
+}                                                                                       \
+                                                                                        \
+static inline size_t neon_mat##N##_inverse_batch(                                       \
+    const float* A, float* C, size_t count, size_t stride                               \
+) {                                                                                     \
+    size_t singular = 0;                                                                \
+    for (size_t b = 0; b < count; b += 4) {                                             \
+        size_t rem = count - b;                                                         \
+        float32x4_t a[N * N], v[N * N];                                                 \
+        for (int e = 0; e < N * N; e++) {                                               \
+            a[e] = neon_smallmat_load(A + (size_t)e * stride + b, rem);                 \
+            v[e] = vdupq_n_f32((e / N == e % N) ? 1.0f : 0.0f);                         \
+        }                                                                               \
+        uint32x4_t bad = vdupq_n_u32(0);                                                \
+        for (int k = 0; k < N; k++) {                                                   \
+            /* Pivot: đưa |a[i][k]| lớn nhất lên hàng k, swap riêng từng lane */         \
+            for (int i = k + 1; i < N; i++) {                                           \
+                uint32x4_t sw = vcgtq_f32(vabsq_f32(a[i * N + k]), vabsq_f32(a[k * N + k])); \
+                for (int j = 0; j < N; j++) {                                           \
+                    float32x4_t t = vbslq_f32(sw, a[i * N + j], a[k * N + j]);          \
+                    a[i * N + j] = vbslq_f32(sw, a[k * N + j], a[i * N + j]);           \
+                    a[k * N + j] = t;                                                   \
+                    t = vbslq_f32(sw, v[i * N + j], v[k * N + j]);                      \
+                    v[i * N + j] = vbslq_f32(sw, v[k * N + j], v[i * N + j]);           \
+                    v[k * N + j] = t;                                                   \
+                }                                                                       \
+            }                                                                           \
+            float32x4_t piv = a[k * N + k];                                             \
+            bad = vorrq_u32(bad, vceqq_f32(piv, vdupq_n_f32(0.0f)));                    \
+            float32x4_t inv = vdivq_f32(vdupq_n_f32(1.0f), piv);                        \
+            for (int j = 0; j < N; j++) {                                               \
+                a[k * N + j] = vmulq_f32(a[k * N + j], inv);                            \
+                v[k * N + j] = vmulq_f32(v[k * N + j], inv);                            \
+            }                                                                           \
+            for (int i = 0; i < N; i++) {                                               \
+                if (i == k) continue;                                                   \
+                float32x4_t f = a[i * N + k];                                           \
+                for (int j = 0; j < N; j++) {                                           \
+                    a[i * N + j] = vfmsq_f32(a[i * N + j], f, a[k * N + j]);            \
+                    v[i * N + j] = vfmsq_f32(v[i * N + j], f, v[k * N + j]);            \
+                }                                                                       \
+            }                                                                           \
+        }                                                                               \
+        for (int e = 0; e < N * N; e++) neon_smallmat_store(C + (size_t)e * stride + b, v[e], rem); \
+        uint32_t lanes[4];                                                              \
+        vst1q_u32(lanes, bad);                                                          \
+        for (size_t l = 0; l < MIN(rem, (size_t)4); l++) singular += (lanes[l] != 0);   \
+    }                                                                                   \
+    return singular;                                                                    \
+}
+
+NEON_SMALLMAT_DEFINE(2)
+NEON_SMALLMAT_DEFINE(3)
+NEON_SMALLMAT_DEFINE(4)
+NEON_SMALLMAT_DEFINE(5)
+NEON_SMALLMAT_DEFINE(6)
+NEON_SMALLMAT_DEFINE(7)
+NEON_SMALLMAT_DEFINE(8)
+
+#undef NEON_SMALLMAT_DEFINE
+
+
+
+// POINT TRANSFORM
+/**
+ * p' = R * p + t với 1 ma trận affine M (row-major 4x4, chỉ dùng 3 hàng đầu)
+ * Điểm SoA: x[n], y[n], z[n] → ox, oy, oz (in-place được)
+ *
+ * 8 điểm / vòng: 9 FMAs mỗi 4 điểm (translation làm accumulator ban đầu), hệ số M broadcast sẵn trong registers
+*/
+static inline void neon_mat4_transform_points(
+    const float* M,
+    const float* x,
+    const float* y,
+    const float* z,
+    float* ox,
+    float* oy,
+    float* oz,
+    size_t n
+) {
+    float32x4_t m00 = vdupq_n_f32(M[0]), m01 = vdupq_n_f32(M[1]), m02 = vdupq_n_f32(M[2]), m03 = vdupq_n_f32(M[3]);
+    float32x4_t m10 = vdupq_n_f32(M[4]), m11 = vdupq_n_f32(M[5]), m12 = vdupq_n_f32(M[6]), m13 = vdupq_n_f32(M[7]);
+    float32x4_t m20 = vdupq_n_f32(M[8]), m21 = vdupq_n_f32(M[9]), m22 = vdupq_n_f32(M[10]), m23 = vdupq_n_f32(M[11]);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        float32x4_t x0 = vld1q_f32(x + i), x1 = vld1q_f32(x + i + 4);
+        float32x4_t y0 = vld1q_f32(y + i), y1 = vld1q_f32(y + i + 4);
+        float32x4_t z0 = vld1q_f32(z + i), z1 = vld1q_f32(z + i + 4);
+
+        float32x4_t rx0 = vfmaq_f32(vfmaq_f32(vfmaq_f32(m03, m00, x0), m01, y0), m02, z0);
+        float32x4_t rx1 = vfmaq_f32(vfmaq_f32(vfmaq_f32(m03, m00, x1), m01, y1), m02, z1);
+        float32x4_t ry0 = vfmaq_f32(vfmaq_f32(vfmaq_f32(m13, m10, x0), m11, y0), m12, z0);
+        float32x4_t ry1 = vfmaq_f32(vfmaq_f32(vfmaq_f32(m13, m10, x1), m11, y1), m12, z1);
+        float32x4_t rz0 = vfmaq_f32(vfmaq_f32(vfmaq_f32(m23, m20, x0), m21, y0), m22, z0);
+        float32x4_t rz1 = vfmaq_f32(vfmaq_f32(vfmaq_f32(m23, m20, x1), m21, y1), m22, z1);
+
+        vst1q_f32(ox + i, rx0); vst1q_f32(ox + i + 4, rx1);
+        vst1q_f32(oy + i, ry0); vst1q_f32(oy + i + 4, ry1);
+        vst1q_f32(oz + i, rz0); vst1q_f32(oz + i + 4, rz1);
+    }
+
+    for (; i < n; i++) {
+        float px = x[i], py = y[i], pz = z[i];
+        ox[i] = M[0] * px + M[1] * py + M[2] * pz + M[3];
+        oy[i] = M[4] * px + M[5] * py + M[6] * pz + M[7];
+        oz[i] = M[8] * px + M[9] * py + M[10] * pz + M[11];
+    }
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_SMALLMAT_H
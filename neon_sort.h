@@ -0,0 +1,764 @@
+#ifndef NEON_SORT_H
+#define NEON_SORT_H
+
+#include "neon_types.h"
+#include "memory_align.h"
+#include "neon_thread.h"
+
+
+/**
+ * SIMD SORT (int32 keys, float keys, key-value)
+ *
+ * 3 tầng:
+ *
+ * 1. IN-REGISTER SORTING NETWORK (16 keys = 4 Q registers)
+ *    - Sorting network 4 phần tử chạy theo cột: 5 cặp vminq/vmaxq
+ *      → mỗi lane (cột) đã sort
+ *    - Transpose 4x4 (vtrn1q/vtrn2q) → mỗi register là 1 run 4 phần tử đã sort
+ *    - Bitonic merge 4+4 → 8, rồi 8+8 → 16 (chỉ min/max + permute, không branch)
+ *
+ * 2. VECTORIZED MERGE: merge 2 sorted runs, mỗi bước 1 bitonic merge 4+4
+ *    Load 4 phần tử tiếp theo từ run có head nhỏ hơn → 1 branch / 4 outputs
+ *
+ * 3. PARALLEL: mỗi thread sort 1 đoạn, sau đó merge từng cặp run,
+ *    mỗi merge chia output cho các thread bằng co-rank (merge path)
+ *
+ * FLOAT: map float → int32 giữ nguyên thứ tự (flip bits của số âm) vào buffer int32 riêng,
+ *        sort bằng int32 network rồi map ngược lại (không truy cập float qua int32_t* → đúng strict aliasing)
+ *        Thứ tự: -NaN < -inf < ... < -0 < +0 < ... < +inf < +NaN
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define NEON_SORT_BLOCK 16
+
+
+
+// FLOAT <-> SORTABLE INT32
+/**
+ * key = bits ^ ((bits >> 31) & 0x7FFFFFFF)
+ * Số dương giữ nguyên, số âm đảo 31 bit thấp → so sánh signed int đúng thứ tự float
+ * Phép biến đổi là involution (áp dụng 2 lần = ban đầu)
+*/
+static NEON_INLINE int32x4_t neon_sort_key_f32x4(int32x4_t bits) {
+    int32x4_t m = vandq_s32(vshrq_n_s32(bits, 31), vdupq_n_s32(0x7FFFFFFF));
+    return veorq_s32(bits, m);
+}
+
+static inline void neon_sort_f32_to_keys(const float* src, int32_t* keys, size_t n, int descending) {
+    int32x4_t flip = vdupq_n_s32(descending ? -1 : 0);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int32x4_t bits = vreinterpretq_s32_f32(vld1q_f32(src + i));
+        vst1q_s32(keys + i, veorq_s32(neon_sort_key_f32x4(bits), flip));
+    }
+    for (; i < n; i++) {
+        int32_t b;
+        memcpy(&b, src + i, sizeof(b));
+        b ^= (b >> 31) & 0x7FFFFFFF;
+        keys[i] = descending ? ~b : b;
+    }
+}
+
+static inline void neon_sort_keys_to_f32(const int32_t* keys, float* dst, size_t n, int descending) {
+    int32x4_t flip = vdupq_n_s32(descending ? -1 : 0);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int32x4_t bits = neon_sort_key_f32x4(veorq_s32(vld1q_s32(keys + i), flip));
+        vst1q_f32(dst + i, vreinterpretq_f32_s32(bits));
+    }
+    for (; i < n; i++) {
+        int32_t b = descending ? ~keys[i] : keys[i];
+        b ^= (b >> 31) & 0x7FFFFFFF;
+        memcpy(dst + i, &b, sizeof(b));
+    }
+}
+
+
+
+// IN-REGISTER PRIMITIVES (keys only)
+#define NEON_SORT_CMPSWAP(a, b) do {        \
+    int32x4_t _t = vminq_s32((a), (b));     \
+    (b) = vmaxq_s32((a), (b));              \
+    (a) = _t;                               \
+} while (0)
+
+
+/**
+ * Reverse 4 lanes: [a,b,c,d] → [d,c,b,a]
+*/
+static NEON_INLINE int32x4_t neon_sort_reverse_s32(int32x4_t v) {
+    v = vrev64q_s32(v);
+    return vextq_s32(v, v, 2);
+}
+
+
+/**
+ * Transpose 4x4: r[i][j] → r[j][i]
+*/
+static NEON_INLINE void neon_sort_transpose4_s32(int32x4_t* r0, int32x4_t* r1, int32x4_t* r2, int32x4_t* r3) {
+    int32x4_t t0 = vtrn1q_s32(*r0, *r1);
+    int32x4_t t1 = vtrn2q_s32(*r0, *r1);
+    int32x4_t t2 = vtrn1q_s32(*r2, *r3);
+    int32x4_t t3 = vtrn2q_s32(*r2, *r3);
+
+    *r0 = vreinterpretq_s32_s64(vtrn1q_s64(vreinterpretq_s64_s32(t0), vreinterpretq_s64_s32(t2)));
+    *r1 = vreinterpretq_s32_s64(vtrn1q_s64(vreinterpretq_s64_s32(t1), vreinterpretq_s64_s32(t3)));
+    *r2 = vreinterpretq_s32_s64(vtrn2q_s64(vreinterpretq_s64_s32(t0), vreinterpretq_s64_s32(t2)));
+    *r3 = vreinterpretq_s32_s64(vtrn2q_s64(vreinterpretq_s64_s32(t1), vreinterpretq_s64_s32(t3)));
+}
+
+
+/**
+ * Sort 2 bitonic sequences 4 phần tử độc lập (x và y) cùng lúc
+ *
+ * Bước 1 (distance 2): so sánh lane 0,1 với lane 2,3
+ * Bước 2 (distance 1): so sánh lane 0 với 1, 2 với 3
+ * Ghép x và y vào chung register để mỗi bước chỉ tốn 1 cặp min/max
+*/
+static NEON_INLINE void neon_sort_bitonic_clean4_s32(int32x4_t* x, int32x4_t* y) {
+    int32x4_t p = vcombine_s32(vget_low_s32(*x), vget_low_s32(*y));
+    int32x4_t q = vcombine_s32(vget_high_s32(*x), vget_high_s32(*y));
+    int32x4_t a = vminq_s32(p, q); // [x0', x1', y0', y1']
+    int32x4_t b = vmaxq_s32(p, q); // [x2', x3', y2', y3']
+
+    int32x4_t e = vtrn1q_s32(a, b);
+    int32x4_t o = vtrn2q_s32(a, b);
+    int32x4_t mn = vminq_s32(e, o);
+    int32x4_t mx = vmaxq_s32(e, o);
+
+    *x = vzip1q_s32(mn, mx);
+    *y = vzip2q_s32(mn, mx);
+}
+
+
+/**
+ * Bitonic merge 2 sorted 4-vectors → lo (4 nhỏ nhất), hi (4 lớn nhất), cả 2 sorted
+*/
+static NEON_INLINE void neon_sort_merge4_s32(int32x4_t a, int32x4_t b, int32x4_t* lo, int32x4_t* hi) {
+    int32x4_t br = neon_sort_reverse_s32(b);
+    *lo = vminq_s32(a, br);
+    *hi = vmaxq_s32(a, br);
+    neon_sort_bitonic_clean4_s32(lo, hi);
+}
+
+
+/**
+ * Bitonic merge 2 sorted 8-sequences (a0:a1, b0:b1) → 16 sorted (o0..o3)
+*/
+static NEON_INLINE void neon_sort_merge8_s32(
+    int32x4_t a0, int32x4_t a1, int32x4_t b0, int32x4_t b1,
+    int32x4_t* o0, int32x4_t* o1, int32x4_t* o2, int32x4_t* o3
+) {
+    int32x4_t r0 = neon_sort_reverse_s32(b1);
+    int32x4_t r1 = neon_sort_reverse_s32(b0);
+
+    int32x4_t l0 = vminq_s32(a0, r0);
+    int32x4_t l1 = vminq_s32(a1, r1);
+    int32x4_t h0 = vmaxq_s32(a0, r0);
+    int32x4_t h1 = vmaxq_s32(a1, r1);
+
+    // distance 4
+    NEON_SORT_CMPSWAP(l0, l1);
+    NEON_SORT_CMPSWAP(h0, h1);
+
+    neon_sort_bitonic_clean4_s32(&l0, &l1);
+    neon_sort_bitonic_clean4_s32(&h0, &h1);
+
+    *o0 = l0;
+    *o1 = l1;
+    *o2 = h0;
+    *o3 = h1;
+}
+
+
+/**
+ * Sort 16 keys in-place (hoàn toàn trong registers)
+*/
+static inline void neon_sort_block16_s32(int32_t* data) {
+    int32x4_t r0 = vld1q_s32(data);
+    int32x4_t r1 = vld1q_s32(data + 4);
+    int32x4_t r2 = vld1q_s32(data + 8);
+    int32x4_t r3 = vld1q_s32(data + 12);
+
+    // Sorting network 4 phần tử theo cột
+    NEON_SORT_CMPSWAP(r0, r1);
+    NEON_SORT_CMPSWAP(r2, r3);
+    NEON_SORT_CMPSWAP(r0, r2);
+    NEON_SORT_CMPSWAP(r1, r3);
+    NEON_SORT_CMPSWAP(r1, r2);
+
+    neon_sort_transpose4_s32(&r0, &r1, &r2, &r3);
+
+    int32x4_t a0, a1, b0, b1;
+    neon_sort_merge4_s32(r0, r1, &a0, &a1);
+    neon_sort_merge4_s32(r2, r3, &b0, &b1);
+
+    neon_sort_merge8_s32(a0, a1, b0, b1, &r0, &r1, &r2, &r3);
+
+    vst1q_s32(data, r0);
+    vst1q_s32(data + 4, r1);
+    vst1q_s32(data + 8, r2);
+    vst1q_s32(data + 12, r3);
+}
+
+
+static inline void neon_sort_insertion_s32(int32_t* data, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        int32_t v = data[i];
+        size_t j = i;
+        while (j > 0 && data[j - 1] > v) {
+            data[j] = data[j - 1];
+            j--;
+        }
+        data[j] = v;
+    }
+}
+
+
+
+// VECTORIZED MERGE (keys only)
+/**
+ * Merge 2 sorted arrays a[na], b[nb] → out[na + nb]
+ *
+ * hi = 4 phần tử lớn nhất đã load nhưng chưa ghi
+ * Mỗi bước: load 4 từ run có head nhỏ hơn, merge4(v, hi) → ghi lo, giữ hi
+ * Khi 1 run còn < 4: scalar merge phần còn lại (hi + tail a + tail b)
+*/
+static inline void neon_merge_s32(const int32_t* a, size_t na, const int32_t* b, size_t nb, int32_t* out) {
+    size_t ia = 0, ib = 0, io = 0;
+
+    if (na >= 4 && nb >= 4) {
+        int32x4_t lo, hi;
+        neon_sort_merge4_s32(vld1q_s32(a), vld1q_s32(b), &lo, &hi);
+        vst1q_s32(out, lo);
+        ia = 4;
+        ib = 4;
+        io = 4;
+
+        while (ia + 4 <= na && ib + 4 <= nb) {
+            int32x4_t v;
+            if (a[ia] < b[ib]) {
+                v = vld1q_s32(a + ia);
+                ia += 4;
+            } else {
+                v = vld1q_s32(b + ib);
+                ib += 4;
+            }
+            neon_sort_merge4_s32(v, hi, &lo, &hi);
+            vst1q_s32(out + io, lo);
+            io += 4;
+        }
+
+        // 3-way scalar merge: hi (4), a[ia..), b[ib..)
+        int32_t h[4];
+        vst1q_s32(h, hi);
+        size_t ih = 0;
+
+        while (ih < 4) {
+            int32_t best = h[ih];
+            int src = 0;
+            if (ia < na && a[ia] < best) { best = a[ia]; src = 1; }
+            if (ib < nb && b[ib] < best) { best = b[ib]; src = 2; }
+
+            out[io++] = best;
+            if (src == 0) ih++;
+            else if (src == 1) ia++;
+            else ib++;
+        }
+    }
+
+    while (ia < na && ib < nb) {
+        out[io++] = (b[ib] < a[ia]) ? b[ib++] : a[ia++];
+    }
+    while (ia < na) out[io++] = a[ia++];
+    while (ib < nb) out[io++] = b[ib++];
+}
+
+
+
+// KEY-VALUE PRIMITIVES
+/**
+ * Key-value: mọi permute áp dụng giống nhau cho keys và values,
+ * min/max thay bằng compare mask + vbslq để value đi theo key
+*/
+#define NEON_SORT_CMPSWAP_KV(ak, av, bk, bv) do {          \
+    uint32x4_t _m = vcltq_s32((bk), (ak));                 \
+    int32x4_t _lk = vbslq_s32(_m, (bk), (ak));             \
+    int32x4_t _lv = vbslq_s32(_m, (bv), (av));             \
+    (bk) = vbslq_s32(_m, (ak), (bk));                      \
+    (bv) = vbslq_s32(_m, (av), (bv));                      \
+    (ak) = _lk;                                            \
+    (av) = _lv;                                            \
+} while (0)
+
+
+static NEON_INLINE void neon_sort_bitonic_clean4_kv(int32x4_t* xk, int32x4_t* xv, int32x4_t* yk, int32x4_t* yv) {
+    int32x4_t pk = vcombine_s32(vget_low_s32(*xk), vget_low_s32(*yk));
+    int32x4_t pv = vcombine_s32(vget_low_s32(*xv), vget_low_s32(*yv));
+    int32x4_t qk = vcombine_s32(vget_high_s32(*xk), vget_high_s32(*yk));
+    int32x4_t qv = vcombine_s32(vget_high_s32(*xv), vget_high_s32(*yv));
+    NEON_SORT_CMPSWAP_KV(pk, pv, qk, qv);
+
+    int32x4_t ek = vtrn1q_s32(pk, qk), ev = vtrn1q_s32(pv, qv);
+    int32x4_t ok = vtrn2q_s32(pk, qk), ov = vtrn2q_s32(pv, qv);
+    NEON_SORT_CMPSWAP_KV(ek, ev, ok, ov);
+
+    *xk = vzip1q_s32(ek, ok);
+    *xv = vzip1q_s32(ev, ov);
+    *yk = vzip2q_s32(ek, ok);
+    *yv = vzip2q_s32(ev, ov);
+}
+
+
+static NEON_INLINE void neon_sort_merge4_kv(
+    int32x4_t ak, int32x4_t av, int32x4_t bk, int32x4_t bv,
+    int32x4_t* lok, int32x4_t* lov, int32x4_t* hik, int32x4_t* hiv
+) {
+    int32x4_t lk = ak, lv = av;
+    int32x4_t hk = neon_sort_reverse_s32(bk);
+    int32x4_t hv = neon_sort_reverse_s32(bv);
+    NEON_SORT_CMPSWAP_KV(lk, lv, hk, hv);
+    neon_sort_bitonic_clean4_kv(&lk, &lv, &hk, &hv);
+
+    *lok = lk;
+    *lov = lv;
+    *hik = hk;
+    *hiv = hv;
+}
+
+
+static inline void neon_sort_block16_kv(int32_t* keys, int32_t* vals) {
+    int32x4_t k0 = vld1q_s32(keys), v0 = vld1q_s32(vals);
+    int32x4_t k1 = vld1q_s32(keys + 4), v1 = vld1q_s32(vals + 4);
+    int32x4_t k2 = vld1q_s32(keys + 8), v2 = vld1q_s32(vals + 8);
+    int32x4_t k3 = vld1q_s32(keys + 12), v3 = vld1q_s32(vals + 12);
+
+    NEON_SORT_CMPSWAP_KV(k0, v0, k1, v1);
+    NEON_SORT_CMPSWAP_KV(k2, v2, k3, v3);
+    NEON_SORT_CMPSWAP_KV(k0, v0, k2, v2);
+    NEON_SORT_CMPSWAP_KV(k1, v1, k3, v3);
+    NEON_SORT_CMPSWAP_KV(k1, v1, k2, v2);
+
+    neon_sort_transpose4_s32(&k0, &k1, &k2, &k3);
+    neon_sort_transpose4_s32(&v0, &v1, &v2, &v3);
+
+    // 4+4 → 8 (2 lần)
+    int32x4_t a0k, a0v, a1k, a1v, b0k, b0v, b1k, b1v;
+    neon_sort_merge4_kv(k0, v0, k1, v1, &a0k, &a0v, &a1k, &a1v);
+    neon_sort_merge4_kv(k2, v2, k3, v3, &b0k, &b0v, &b1k, &b1v);
+
+    // 8+8 → 16
+    int32x4_t r0k = neon_sort_reverse_s32(b1k), r0v = neon_sort_reverse_s32(b1v);
+    int32x4_t r1k = neon_sort_reverse_s32(b0k), r1v = neon_sort_reverse_s32(b0v);
+    NEON_SORT_CMPSWAP_KV(a0k, a0v, r0k, r0v);
+    NEON_SORT_CMPSWAP_KV(a1k, a1v, r1k, r1v);
+    NEON_SORT_CMPSWAP_KV(a0k, a0v, a1k, a1v);
+    NEON_SORT_CMPSWAP_KV(r0k, r0v, r1k, r1v);
+    neon_sort_bitonic_clean4_kv(&a0k, &a0v, &a1k, &a1v);
+    neon_sort_bitonic_clean4_kv(&r0k, &r0v, &r1k, &r1v);
+
+    vst1q_s32(keys, a0k);
+    vst1q_s32(vals, a0v);
+    vst1q_s32(keys + 4, a1k);
+    vst1q_s32(vals + 4, a1v);
+    vst1q_s32(keys + 8, r0k);
+    vst1q_s32(vals + 8, r0v);
+    vst1q_s32(keys + 12, r1k);
+    vst1q_s32(vals + 12, r1v);
+}
+
+
+static inline void neon_sort_insertion_kv(int32_t* keys, int32_t* vals, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        int32_t k = keys[i];
+        int32_t v = vals[i];
+        size_t j = i;
+        while (j > 0 && keys[j - 1] > k) {
+            keys[j] = keys[j - 1];
+            vals[j] = vals[j - 1];
+            j--;
+        }
+        keys[j] = k;
+        vals[j] = v;
+    }
+}
+
+
+static inline void neon_merge_kv(
+    const int32_t* ak, const int32_t* av, size_t na,
+    const int32_t* bk, const int32_t* bv, size_t nb,
+    int32_t* ok, int32_t* ov
+) {
+    size_t ia = 0, ib = 0, io = 0;
+
+    if (na >= 4 && nb >= 4) {
+        int32x4_t lk, lv, hk, hv;
+        neon_sort_merge4_kv(vld1q_s32(ak), vld1q_s32(av), vld1q_s32(bk), vld1q_s32(bv), &lk, &lv, &hk, &hv);
+        vst1q_s32(ok, lk);
+        vst1q_s32(ov, lv);
+        ia = 4;
+        ib = 4;
+        io = 4;
+
+        while (ia + 4 <= na && ib + 4 <= nb) {
+            int32x4_t vk, vv;
+            if (ak[ia] < bk[ib]) {
+                vk = vld1q_s32(ak + ia);
+                vv = vld1q_s32(av + ia);
+                ia += 4;
+            } else {
+                vk = vld1q_s32(bk + ib);
+                vv = vld1q_s32(bv + ib);
+                ib += 4;
+            }
+            neon_sort_merge4_kv(vk, vv, hk, hv, &lk, &lv, &hk, &hv);
+            vst1q_s32(ok + io, lk);
+            vst1q_s32(ov + io, lv);
+            io += 4;
+        }
+
+        int32_t hkey[4], hval[4];
+        vst1q_s32(hkey, hk);
+        vst1q_s32(hval, hv);
+        size_t ih = 0;
+
+        while (ih < 4) {
+            int src = 0;
+            int32_t best = hkey[ih];
+            if (ia < na && ak[ia] < best) { best = ak[ia]; src = 1; }
+            if (ib < nb && bk[ib] < best) { best = bk[ib]; src = 2; }
+
+            ok[io] = best;
+            if (src == 0) ov[io] = hval[ih++];
+            else if (src == 1) ov[io] = av[ia++];
+            else ov[io] = bv[ib++];
+            io++;
+        }
+    }
+
+    while (ia < na && ib < nb) {
+        if (bk[ib] < ak[ia]) {
+            ok[io] = bk[ib];
+            ov[io++] = bv[ib++];
+        } else {
+            ok[io] = ak[ia];
+            ov[io++] = av[ia++];
+        }
+    }
+    while (ia < na) {
+        ok[io] = ak[ia];
+        ov[io++] = av[ia++];
+    }
+    while (ib < nb) {
+        ok[io] = bk[ib];
+        ov[io++] = bv[ib++];
+    }
+}
+
+
+
+// MERGE SORT DRIVERS
+/**
+ * Sort keys (vals == NULL) hoặc key-value, dùng tmp buffers cùng kích thước
+ * Block sort 16 → merge passes (width 16, 32, 64, ...) ping-pong giữa data và tmp
+*/
+static inline void neon_sort_run(int32_t* keys, int32_t* vals, size_t n, int32_t* tmp_keys, int32_t* tmp_vals) {
+    size_t i = 0;
+    for (; i + NEON_SORT_BLOCK <= n; i += NEON_SORT_BLOCK) {
+        if (vals == NULL) neon_sort_block16_s32(keys + i);
+        else neon_sort_block16_kv(keys + i, vals + i);
+    }
+    if (vals == NULL) neon_sort_insertion_s32(keys + i, n - i);
+    else neon_sort_insertion_kv(keys + i, vals + i, n - i);
+
+    int32_t* src_k = keys;
+    int32_t* src_v = vals;
+    int32_t* dst_k = tmp_keys;
+    int32_t* dst_v = tmp_vals;
+
+    for (size_t width = NEON_SORT_BLOCK; width < n; width *= 2) {
+        for (size_t lo = 0; lo < n; lo += 2 * width) {
+            size_t mid = MIN(lo + width, n);
+            size_t hi = MIN(lo + 2 * width, n);
+
+            if (vals == NULL) {
+                neon_merge_s32(src_k + lo, mid - lo, src_k + mid, hi - mid, dst_k + lo);
+            } else {
+                neon_merge_kv(src_k + lo, src_v + lo, mid - lo, src_k + mid, src_v + mid, hi - mid,
+                              dst_k + lo, dst_v + lo);
+            }
+        }
+
+        int32_t* t = src_k; src_k = dst_k; dst_k = t;
+        t = src_v; src_v = dst_v; dst_v = t;
+    }
+
+    if (src_k != keys) {
+        memcpy(keys, src_k, n * sizeof(int32_t));
+        if (vals != NULL) memcpy(vals, src_v, n * sizeof(int32_t));
+    }
+}
+
+
+/**
+ * Sort int32 tăng dần (in-place)
+ * @return: NEON_SUCCESS hoặc NEON_ERROR_OUT_OF_MEMORY
+*/
+static inline int neon_sort_s32(int32_t* data, size_t n) {
+    if (data == NULL) return NEON_ERROR_NULL_POINTER;
+    if (n <= NEON_SORT_BLOCK) {
+        if (n == NEON_SORT_BLOCK) neon_sort_block16_s32(data);
+        else neon_sort_insertion_s32(data, n);
+        return NEON_SUCCESS;
+    }
+
+    int32_t* tmp = (int32_t*)neon_malloc(n * sizeof(int32_t));
+    if (tmp == NULL) return NEON_ERROR_OUT_OF_MEMORY;
+
+    neon_sort_run(data, NULL, n, tmp, NULL);
+
+    neon_free(tmp);
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * Sort key-value theo key tăng dần (vals đi theo keys, không stable)
+*/
+static inline int neon_sort_kv_s32(int32_t* keys, int32_t* vals, size_t n) {
+    if (keys == NULL || vals == NULL) return NEON_ERROR_NULL_POINTER;
+    if (n <= 1) return NEON_SUCCESS;
+
+    int32_t* tmp_k = (int32_t*)neon_malloc(n * sizeof(int32_t));
+    int32_t* tmp_v = (int32_t*)neon_malloc(n * sizeof(int32_t));
+    if (tmp_k == NULL || tmp_v == NULL) {
+        neon_free(tmp_k);
+        neon_free(tmp_v);
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    neon_sort_run(keys, vals, n, tmp_k, tmp_v);
+
+    neon_free(tmp_k);
+    neon_free(tmp_v);
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * Sort float (in-place, cần thêm buffer keys n x int32)
+ * @param descending: 0 = tăng dần, 1 = giảm dần (ví dụ ranking scores)
+*/
+static inline int neon_sort_f32(float* data, size_t n, int descending) {
+    if (data == NULL) return NEON_ERROR_NULL_POINTER;
+    if (n < 2) return NEON_SUCCESS;
+
+    int32_t* keys = (int32_t*)neon_malloc(n * sizeof(int32_t));
+    if (keys == NULL) return NEON_ERROR_OUT_OF_MEMORY;
+
+    neon_sort_f32_to_keys(data, keys, n, descending);
+    int err = neon_sort_s32(keys, n);
+    if (err == NEON_SUCCESS) neon_sort_keys_to_f32(keys, data, n, descending);
+
+    neon_free(keys);
+    return err;
+}
+
+
+/**
+ * Sort (score, index) pairs theo score - dùng cho batch ranking
+*/
+static inline int neon_sort_kv_f32(float* scores, int32_t* indices, size_t n, int descending) {
+    if (scores == NULL || indices == NULL) return NEON_ERROR_NULL_POINTER;
+    if (n < 2) return NEON_SUCCESS;
+
+    int32_t* keys = (int32_t*)neon_malloc(n * sizeof(int32_t));
+    if (keys == NULL) return NEON_ERROR_OUT_OF_MEMORY;
+
+    neon_sort_f32_to_keys(scores, keys, n, descending);
+    int err = neon_sort_kv_s32(keys, indices, n);
+    if (err == NEON_SUCCESS) neon_sort_keys_to_f32(keys, scores, n, descending);
+
+    neon_free(keys);
+    return err;
+}
+
+
+
+// PARALLEL SORT
+/**
+ * Co-rank (merge path): tìm i sao cho merge(a, b)[0..k) = merge(a[0..i), b[0..k-i))
+ *
+ * Điều kiện: a[i-1] <= b[k-i]  và  b[k-i-1] < a[i]  (tie → lấy a trước)
+ * Binary search trên i → O(log(na)), mỗi thread tự tìm đoạn của mình
+*/
+static inline size_t neon_merge_corank(size_t k, const int32_t* a, size_t na, const int32_t* b, size_t nb) {
+    size_t lo = (k > nb) ? k - nb : 0;
+    size_t hi = MIN(k, na);
+
+    while (lo < hi) {
+        size_t i = lo + (hi - lo) / 2;
+        size_t j = k - i;
+
+        if (j > 0 && i < na && b[j - 1] >= a[i]) {
+            lo = i + 1; // lấy thêm từ a
+        } else if (i > 0 && j < nb && a[i - 1] > b[j]) {
+            hi = i - 1; // lấy bớt từ a
+        } else {
+            return i;
+        }
+    }
+
+    return lo;
+}
+
+
+typedef struct {
+    int32_t* keys;
+    int32_t* vals;
+    int32_t* tmp_keys;
+    int32_t* tmp_vals;
+    size_t n;
+    size_t chunk;
+
+    // Merge step
+    const int32_t* ak; const int32_t* av; size_t na;
+    const int32_t* bk; const int32_t* bv; size_t nb;
+    int32_t* ok; int32_t* ov;
+} NeonSortParallelCtx;
+
+
+static void neon_sort_chunk_worker(void* arg, size_t begin, size_t end, int tid) {
+    NeonSortParallelCtx* ctx = (NeonSortParallelCtx*)arg;
+    (void)tid;
+
+    for (size_t c = begin; c < end; c++) {
+        size_t lo = c * ctx->chunk;
+        size_t hi = MIN(lo + ctx->chunk, ctx->n);
+        neon_sort_run(ctx->keys + lo, ctx->vals ? ctx->vals + lo : NULL, hi - lo,
+                      ctx->tmp_keys + lo, ctx->vals ? ctx->tmp_vals + lo : NULL);
+    }
+}
+
+
+static void neon_merge_parallel_worker(void* arg, size_t begin, size_t end, int tid) {
+    NeonSortParallelCtx* ctx = (NeonSortParallelCtx*)arg;
+    (void)tid;
+
+    size_t i0 = neon_merge_corank(begin, ctx->ak, ctx->na, ctx->bk, ctx->nb);
+    size_t i1 = neon_merge_corank(end, ctx->ak, ctx->na, ctx->bk, ctx->nb);
+    size_t j0 = begin - i0;
+    size_t j1 = end - i1;
+
+    if (ctx->ov == NULL) {
+        neon_merge_s32(ctx->ak + i0, i1 - i0, ctx->bk + j0, j1 - j0, ctx->ok + begin);
+    } else {
+        neon_merge_kv(ctx->ak + i0, ctx->av + i0, i1 - i0, ctx->bk + j0, ctx->bv + j0, j1 - j0,
+                      ctx->ok + begin, ctx->ov + begin);
+    }
+}
+
+
+/**
+ * Parallel sort: keys (vals == NULL) hoặc key-value
+ *
+ * 1. Chia thành num_threads chunks, mỗi thread sort 1 chunk
+ * 2. Merge từng cặp chunk; mỗi merge chia output cho tất cả threads theo co-rank
+ *    → merge cuối cùng (lớn nhất) vẫn dùng hết các core
+*/
+static inline int neon_sort_parallel_s32(int32_t* keys, int32_t* vals, size_t n, int num_threads) {
+    if (keys == NULL) return NEON_ERROR_NULL_POINTER;
+
+    num_threads = neon_threads_for(n, num_threads, 1 << 15);
+    if (num_threads <= 1) {
+        return vals ? neon_sort_kv_s32(keys, vals, n) : neon_sort_s32(keys, n);
+    }
+
+    NeonSortParallelCtx ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.keys = keys;
+    ctx.vals = vals;
+    ctx.n = n;
+    ctx.chunk = (n + (size_t)num_threads - 1) / (size_t)num_threads;
+    ctx.tmp_keys = (int32_t*)neon_malloc(n * sizeof(int32_t));
+    ctx.tmp_vals = vals ? (int32_t*)neon_malloc(n * sizeof(int32_t)) : NULL;
+
+    if (ctx.tmp_keys == NULL || (vals != NULL && ctx.tmp_vals == NULL)) {
+        neon_free(ctx.tmp_keys);
+        neon_free(ctx.tmp_vals);
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    size_t num_chunks = (n + ctx.chunk - 1) / ctx.chunk;
+    neon_parallel_for(num_chunks, num_threads, neon_sort_chunk_worker, &ctx);
+
+    int32_t* src_k = keys;
+    int32_t* src_v = vals;
+    int32_t* dst_k = ctx.tmp_keys;
+    int32_t* dst_v = ctx.tmp_vals;
+
+    for (size_t width = ctx.chunk; width < n; width *= 2) {
+        for (size_t lo = 0; lo < n; lo += 2 * width) {
+            size_t mid = MIN(lo + width, n);
+            size_t hi = MIN(lo + 2 * width, n);
+
+            ctx.ak = src_k + lo;
+            ctx.av = src_v ? src_v + lo : NULL;
+            ctx.na = mid - lo;
+            ctx.bk = src_k + mid;
+            ctx.bv = src_v ? src_v + mid : NULL;
+            ctx.nb = hi - mid;
+            ctx.ok = dst_k + lo;
+            ctx.ov = dst_v ? dst_v + lo : NULL;
+
+            neon_parallel_for(hi - lo, num_threads, neon_merge_parallel_worker, &ctx);
+        }
+
+        int32_t* t = src_k; src_k = dst_k; dst_k = t;
+        t = src_v; src_v = dst_v; dst_v = t;
+    }
+
+    if (src_k != keys) {
+        memcpy(keys, src_k, n * sizeof(int32_t));
+        if (vals != NULL) memcpy(vals, src_v, n * sizeof(int32_t));
+    }
+
+    neon_free(ctx.tmp_keys);
+    neon_free(ctx.tmp_vals);
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * Parallel sort float (indices == NULL) hoặc (score, index)
+*/
+static inline int neon_sort_parallel_f32(float* scores, int32_t* indices, size_t n, int descending, int num_threads) {
+    if (scores == NULL) return NEON_ERROR_NULL_POINTER;
+    if (n < 2) return NEON_SUCCESS;
+
+    int32_t* keys = (int32_t*)neon_malloc(n * sizeof(int32_t));
+    if (keys == NULL) return NEON_ERROR_OUT_OF_MEMORY;
+
+    neon_sort_f32_to_keys(scores, keys, n, descending);
+    int err = neon_sort_parallel_s32(keys, indices, n, num_threads);
+    if (err == NEON_SUCCESS) neon_sort_keys_to_f32(keys, scores, n, descending);
+
+    neon_free(keys);
+    return err;
+}
+
+
+#undef NEON_SORT_CMPSWAP
+#undef NEON_SORT_CMPSWAP_KV
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_SORT_H
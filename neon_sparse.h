@@ -0,0 +1,455 @@
+#ifndef NEON_SPARSE_H
+#define NEON_SPARSE_H
+
+#include "neon_types.h"
+#include "memory_align.h"
+#include "neon_utils.h"
+#include <math.h>
+
+
+/**
+ * SPARSE KERNELS: CSR SpMV/SpMM và block-sparse (BSR) SpMV/SpMM
+ *
+ * TẠI SAO BLOCK SPARSE?
+ *   CSR: mỗi non-zero cần 1 index + gather x[col] → NEON không có gather,
+ *        phải load từng lane → FMA utilization thấp
+ *   BSR 4x1 / 4x4: 1 index cho 4 (hoặc 16) values, values của 1 cột block
+ *        nằm liền nhau = 1 float32x4_t → dùng thẳng vfmaq_f32
+ *   → mỗi index (và mỗi load x) được chia đều cho 4 hoặc 16 FMA thay vì 1
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+// CREATE / DESTROY
+/**
+ * Free memory của CSR matrix
+*/
+static inline void csr_matrix_destroy(CSRMatrix* mat) {
+    if (mat == NULL) return;
+
+    neon_free(mat->row_ptr);
+    neon_free(mat->col_idx);
+    neon_free(mat->values);
+
+    mat->row_ptr = NULL;
+    mat->col_idx = NULL;
+    mat->values = NULL;
+    mat->nnz = 0;
+}
+
+
+/**
+ * Free memory của BSR matrix
+*/
+static inline void bsr_matrix_destroy(BSRMatrix* mat) {
+    if (mat == NULL) return;
+
+    neon_free(mat->row_ptr);
+    neon_free(mat->col_idx);
+    neon_free(mat->values);
+
+    mat->row_ptr = NULL;
+    mat->col_idx = NULL;
+    mat->values = NULL;
+    mat->nnzb = 0;
+}
+
+
+static int neon_sparse_cmp_float(const void* a, const void* b) {
+    float fa = *(const float*)a;
+    float fb = *(const float*)b;
+    return (fa > fb) - (fa < fb);
+}
+
+
+/**
+ * Magnitude pruning threshold
+ *
+ * Tìm threshold sao cho khoảng `sparsity` (0..1) phần tử có magnitude <= threshold
+ * Ví dụ: sparsity = 0.9 → giữ lại 10% magnitude lớn nhất
+ *
+ * @return: threshold, hoặc -1 nếu sparsity <= 0 (giữ tất cả non-zero)
+*/
+static inline float neon_prune_threshold(const float* magnitudes, size_t size, float sparsity) {
+    if (size == 0 || sparsity <= 0.0f) return -1.0f;
+
+    float* sorted = (float*)neon_malloc(size * sizeof(float));
+    if (sorted == NULL) return -1.0f;
+
+    memcpy(sorted, magnitudes, size * sizeof(float));
+    qsort(sorted, size, sizeof(float), neon_sparse_cmp_float);
+
+    size_t k = (size_t)((double)sparsity * (double)size);
+    float threshold = (k == 0) ? -1.0f : sorted[MIN(k, size) - 1];
+
+    neon_free(sorted);
+    return threshold;
+}
+
+
+
+// CONVERTERS (DENSE → SPARSE)
+/**
+ * Dense (row-major) → CSR với magnitude pruning
+ *
+ * Giữ phần tử có |x| > threshold (threshold tính từ sparsity), luôn bỏ x == 0
+ *
+ * @param sparsity: tỉ lệ phần tử bị prune (0 = chỉ bỏ số 0)
+ * @return: NEON_SUCCESS hoặc error code
+*/
+static inline int neon_csr_from_dense(
+    const float* dense,
+    int32_t rows,
+    int32_t cols,
+    float sparsity,
+    CSRMatrix* out
+) {
+    if (dense == NULL || out == NULL) return NEON_ERROR_NULL_POINTER;
+    if (rows <= 0 || cols <= 0) return NEON_ERROR_INVALID_SIZE;
+
+    size_t total = (size_t)rows * (size_t)cols;
+
+    float* mags = (float*)neon_malloc(total * sizeof(float));
+    if (mags == NULL) return NEON_ERROR_OUT_OF_MEMORY;
+
+    for (size_t i = 0; i < total; i++) {
+        mags[i] = fabsf(dense[i]);
+    }
+
+    float threshold = MAX(neon_prune_threshold(mags, total, sparsity), 0.0f);
+
+    int32_t nnz = 0;
+    for (size_t i = 0; i < total; i++) {
+        nnz += (mags[i] > threshold);
+    }
+
+    out->rows = rows;
+    out->cols = cols;
+    out->nnz = nnz;
+    out->row_ptr = (int32_t*)neon_malloc((size_t)(rows + 1) * sizeof(int32_t));
+    out->col_idx = (int32_t*)neon_malloc((size_t)MAX(nnz, 1) * sizeof(int32_t));
+    out->values = (float*)neon_malloc((size_t)MAX(nnz, 1) * sizeof(float));
+
+    if (out->row_ptr == NULL || out->col_idx == NULL || out->values == NULL) {
+        neon_free(mags);
+        csr_matrix_destroy(out);
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    int32_t k = 0;
+    for (int32_t i = 0; i < rows; i++) {
+        out->row_ptr[i] = k;
+        for (int32_t j = 0; j < cols; j++) {
+            size_t idx = (size_t)i * cols + j;
+            if (mags[idx] > threshold) {
+                out->col_idx[k] = j;
+                out->values[k] = dense[idx];
+                k++;
+            }
+        }
+    }
+    out->row_ptr[rows] = k;
+
+    neon_free(mags);
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * Dense (row-major) → BSR với block magnitude pruning
+ *
+ * Magnitude của block = L2 norm của block
+ * Block ở biên (rows/cols không chia hết) được pad 0
+ *
+ * @param block_w: 1 (block 4x1) hoặc 4 (block 4x4), block_h luôn = 4
+ * @param sparsity: tỉ lệ block bị prune
+*/
+static inline int neon_bsr_from_dense(
+    const float* dense,
+    int32_t rows,
+    int32_t cols,
+    int32_t block_w,
+    float sparsity,
+    BSRMatrix* out
+) {
+    if (dense == NULL || out == NULL) return NEON_ERROR_NULL_POINTER;
+    if (rows <= 0 || cols <= 0) return NEON_ERROR_INVALID_SIZE;
+    if (block_w != 1 && block_w != 4) return NEON_ERROR_INVALID_PARAM;
+
+    const int32_t bh = NEON_F32_LANES;
+    int32_t brows = (rows + bh - 1) / bh;
+    int32_t bcols = (cols + block_w - 1) / block_w;
+    size_t nblocks = (size_t)brows * (size_t)bcols;
+
+    float* norms = (float*)neon_malloc(nblocks * sizeof(float));
+    if (norms == NULL) return NEON_ERROR_OUT_OF_MEMORY;
+
+    for (int32_t bi = 0; bi < brows; bi++) {
+        for (int32_t bj = 0; bj < bcols; bj++) {
+            float ss = 0.0f;
+            for (int32_t r = bi * bh; r < MIN(rows, (bi + 1) * bh); r++) {
+                for (int32_t c = bj * block_w; c < MIN(cols, (bj + 1) * block_w); c++) {
+                    float v = dense[(size_t)r * cols + c];
+                    ss += v * v;
+                }
+            }
+            norms[(size_t)bi * bcols + bj] = sqrtf(ss);
+        }
+    }
+
+    float threshold = MAX(neon_prune_threshold(norms, nblocks, sparsity), 0.0f);
+
+    int32_t nnzb = 0;
+    for (size_t b = 0; b < nblocks; b++) {
+        nnzb += (norms[b] > threshold);
+    }
+
+    size_t block_size = (size_t)bh * block_w;
+
+    out->rows = rows;
+    out->cols = cols;
+    out->block_h = bh;
+    out->block_w = block_w;
+    out->nnzb = nnzb;
+    out->row_ptr = (int32_t*)neon_malloc((size_t)(brows + 1) * sizeof(int32_t));
+    out->col_idx = (int32_t*)neon_malloc((size_t)MAX(nnzb, 1) * sizeof(int32_t));
+    out->values = (float*)neon_malloc((size_t)MAX(nnzb, 1) * block_size * sizeof(float));
+
+    if (out->row_ptr == NULL || out->col_idx == NULL || out->values == NULL) {
+        neon_free(norms);
+        bsr_matrix_destroy(out);
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    int32_t k = 0;
+    for (int32_t bi = 0; bi < brows; bi++) {
+        out->row_ptr[bi] = k;
+        for (int32_t bj = 0; bj < bcols; bj++) {
+            if (!(norms[(size_t)bi * bcols + bj] > threshold)) continue;
+
+            float* blk = out->values + (size_t)k * block_size;
+            for (int32_t j = 0; j < block_w; j++) {
+                for (int32_t r = 0; r < bh; r++) {
+                    int32_t row = bi * bh + r;
+                    int32_t col = bj * block_w + j;
+                    blk[j * bh + r] = (row < rows && col < cols) ? dense[(size_t)row * cols + col] : 0.0f;
+                }
+            }
+
+            out->col_idx[k] = bj;
+            k++;
+        }
+    }
+    out->row_ptr[brows] = k;
+
+    neon_free(norms);
+    return NEON_SUCCESS;
+}
+
+
+
+// CSR KERNELS
+/**
+ * CSR SpMV: y = A * x
+ *
+ * Mỗi row: load 4 values liên tiếp, gather 4 x[col] vào 1 vector bằng vld1q_lane
+ * (NEON không có gather instruction), rồi FMA
+*/
+static inline void neon_csr_spmv(const CSRMatrix* A, const float* x, float* y) {
+    for (int32_t i = 0; i < A->rows; i++) {
+        int32_t start = A->row_ptr[i];
+        int32_t end = A->row_ptr[i + 1];
+
+        float32x4_t acc0 = vdupq_n_f32(0.0f);
+        float32x4_t acc1 = vdupq_n_f32(0.0f);
+
+        int32_t k = start;
+        for (; k + 8 <= end; k += 8) {
+            const int32_t* ci = A->col_idx + k;
+
+            float32x4_t x0 = vdupq_n_f32(0.0f);
+            float32x4_t x1 = vdupq_n_f32(0.0f);
+            x0 = vld1q_lane_f32(x + ci[0], x0, 0);
+            x0 = vld1q_lane_f32(x + ci[1], x0, 1);
+            x0 = vld1q_lane_f32(x + ci[2], x0, 2);
+            x0 = vld1q_lane_f32(x + ci[3], x0, 3);
+            x1 = vld1q_lane_f32(x + ci[4], x1, 0);
+            x1 = vld1q_lane_f32(x + ci[5], x1, 1);
+            x1 = vld1q_lane_f32(x + ci[6], x1, 2);
+            x1 = vld1q_lane_f32(x + ci[7], x1, 3);
+
+            acc0 = neon_fma_f32x4(vld1q_f32(A->values + k), x0, acc0);
+            acc1 = neon_fma_f32x4(vld1q_f32(A->values + k + 4), x1, acc1);
+        }
+
+        float sum = neon_sum_f32x4(vaddq_f32(acc0, acc1));
+        for (; k < end; k++) {
+            sum += A->values[k] * x[A->col_idx[k]];
+        }
+
+        y[i] = sum;
+    }
+}
+
+
+/**
+ * CSR SpMM: C[M x N] = A[M x K] (sparse) * B[K x N] (dense, row-major)
+ *
+ * Mỗi non-zero a(i, k): C[i, :] += a * B[k, :] → vfmaq_n_f32 trên cả hàng
+*/
+static inline void neon_csr_spmm(const CSRMatrix* A, const float* B, float* C, int32_t N) {
+    for (int32_t i = 0; i < A->rows; i++) {
+        float* c_row = C + (size_t)i * N;
+        neon_fill_f32(c_row, 0.0f, (size_t)N);
+
+        for (int32_t k = A->row_ptr[i]; k < A->row_ptr[i + 1]; k++) {
+            float a = A->values[k];
+            const float* b_row = B + (size_t)A->col_idx[k] * N;
+
+            int32_t j = 0;
+            for (; j + 4 <= N; j += 4) {
+                vst1q_f32(c_row + j, vfmaq_n_f32(vld1q_f32(c_row + j), vld1q_f32(b_row + j), a));
+            }
+            for (; j < N; j++) {
+                c_row[j] += a * b_row[j];
+            }
+        }
+    }
+}
+
+
+
+// BLOCK SPARSE KERNELS
+/**
+ * BSR SpMV: y = A * x (block_h = 4, block_w = 1 hoặc 4)
+ *
+ * Block 4x1: y[4 rows] += col_vec * x[c]                → 1 FMA
+ * Block 4x4: y[4 rows] += sum_j col_vec[j] * x[c + j]   → 4 FMA (vfmaq_laneq_f32)
+*/
+static inline void neon_bsr_spmv(const BSRMatrix* A, const float* x, float* y) {
+    const int32_t bw = A->block_w;
+    int32_t brows = (A->rows + 3) / 4;
+
+    for (int32_t bi = 0; bi < brows; bi++) {
+        float32x4_t acc0 = vdupq_n_f32(0.0f);
+        float32x4_t acc1 = vdupq_n_f32(0.0f);
+
+        for (int32_t k = A->row_ptr[bi]; k < A->row_ptr[bi + 1]; k++) {
+            const float* blk = A->values + (size_t)k * 4 * bw;
+            int32_t c = A->col_idx[k] * bw;
+
+            if (bw == 1) {
+                acc0 = vfmaq_n_f32(acc0, vld1q_f32(blk), x[c]);
+            } else {
+                float32x4_t xv;
+                if (c + 4 <= A->cols) {
+                    xv = vld1q_f32(x + c);
+                } else {
+                    float tail[4] ALIGN_NEON = {0.0f, 0.0f, 0.0f, 0.0f};
+                    for (int32_t j = 0; c + j < A->cols; j++) tail[j] = x[c + j];
+                    xv = vld1q_f32(tail);
+                }
+
+                acc0 = vfmaq_laneq_f32(acc0, vld1q_f32(blk), xv, 0);
+                acc1 = vfmaq_laneq_f32(acc1, vld1q_f32(blk + 4), xv, 1);
+                acc0 = vfmaq_laneq_f32(acc0, vld1q_f32(blk + 8), xv, 2);
+                acc1 = vfmaq_laneq_f32(acc1, vld1q_f32(blk + 12), xv, 3);
+            }
+        }
+
+        float32x4_t acc = vaddq_f32(acc0, acc1);
+        int32_t row = bi * 4;
+        if (row + 4 <= A->rows) {
+            vst1q_f32(y + row, acc);
+        } else {
+            float tmp[4] ALIGN_NEON;
+            vst1q_f32(tmp, acc);
+            for (int32_t r = 0; row + r < A->rows; r++) y[row + r] = tmp[r];
+        }
+    }
+}
+
+
+/**
+ * BSR SpMM: C[M x N] = A (block sparse) * B[K x N] (dense, row-major)
+ *
+ * REGISTER BLOCKING: 4 rows x 8 cột C = 8 accumulators
+ * Mỗi cột j của block: 2 loads B (8 floats) + 8 FMA (broadcast từ lane của block)
+ * → tỉ lệ FMA/load cao, giữ FMA pipeline bận kể cả ở 90% sparsity
+*/
+static inline void neon_bsr_spmm(const BSRMatrix* A, const float* B, float* C, int32_t N) {
+    const int32_t bw = A->block_w;
+    int32_t brows = (A->rows + 3) / 4;
+
+    for (int32_t bi = 0; bi < brows; bi++) {
+        int32_t row = bi * 4;
+        int32_t nrows = MIN(4, A->rows - row);
+        int32_t kstart = A->row_ptr[bi];
+        int32_t kend = A->row_ptr[bi + 1];
+
+        int32_t n = 0;
+        for (; n + 8 <= N; n += 8) {
+            float32x4_t c00 = vdupq_n_f32(0.0f), c01 = vdupq_n_f32(0.0f);
+            float32x4_t c10 = vdupq_n_f32(0.0f), c11 = vdupq_n_f32(0.0f);
+            float32x4_t c20 = vdupq_n_f32(0.0f), c21 = vdupq_n_f32(0.0f);
+            float32x4_t c30 = vdupq_n_f32(0.0f), c31 = vdupq_n_f32(0.0f);
+
+            for (int32_t k = kstart; k < kend; k++) {
+                const float* blk = A->values + (size_t)k * 4 * bw;
+                int32_t c = A->col_idx[k] * bw;
+
+                for (int32_t j = 0; j < bw && c + j < A->cols; j++) {
+                    float32x4_t a = vld1q_f32(blk + j * 4);
+                    const float* b_row = B + (size_t)(c + j) * N + n;
+                    float32x4_t b0 = vld1q_f32(b_row);
+                    float32x4_t b1 = vld1q_f32(b_row + 4);
+
+                    c00 = vfmaq_laneq_f32(c00, b0, a, 0);
+                    c01 = vfmaq_laneq_f32(c01, b1, a, 0);
+                    c10 = vfmaq_laneq_f32(c10, b0, a, 1);
+                    c11 = vfmaq_laneq_f32(c11, b1, a, 1);
+                    c20 = vfmaq_laneq_f32(c20, b0, a, 2);
+                    c21 = vfmaq_laneq_f32(c21, b1, a, 2);
+                    c30 = vfmaq_laneq_f32(c30, b0, a, 3);
+                    c31 = vfmaq_laneq_f32(c31, b1, a, 3);
+                }
+            }
+
+            float32x4_t out[8] = {c00, c01, c10, c11, c20, c21, c30, c31};
+            for (int32_t r = 0; r < nrows; r++) {
+                vst1q_f32(C + (size_t)(row + r) * N + n, out[r * 2]);
+                vst1q_f32(C + (size_t)(row + r) * N + n + 4, out[r * 2 + 1]);
+            }
+        }
+
+        // Cột còn lại (N không chia hết cho 8): scalar
+        for (; n < N; n++) {
+            float acc[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+            for (int32_t k = kstart; k < kend; k++) {
+                const float* blk = A->values + (size_t)k * 4 * bw;
+                int32_t c = A->col_idx[k] * bw;
+
+                for (int32_t j = 0; j < bw && c + j < A->cols; j++) {
+                    float b = B[(size_t)(c + j) * N + n];
+                    for (int32_t r = 0; r < 4; r++) acc[r] += blk[j * 4 + r] * b;
+                }
+            }
+
+            for (int32_t r = 0; r < nrows; r++) {
+                C[(size_t)(row + r) * N + n] = acc[r];
+            }
+        }
+    }
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_SPARSE_H
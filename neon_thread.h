@@ -0,0 +1,143 @@
+#ifndef NEON_THREAD_H
+#define NEON_THREAD_H
+
+#include "neon_types.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+    #include <pthread.h>
+    #include <unistd.h>
+    #define NEON_HAS_PTHREAD 1
+#else
+    #define NEON_HAS_PTHREAD 0
+#endif
+
+
+/**
+ * MULTI-THREADING HELPER
+ *
+ * NEON tăng tốc trong 1 core, còn multi-thread tăng tốc theo số core
+ * Kernel dạng "chia array thành N đoạn, mỗi thread 1 đoạn, merge kết quả"
+ * dùng chung neon_parallel_for thay vì tự tạo pthread.
+ *
+ * Example:
+ *   void work(void* ctx, size_t begin, size_t end, int tid) { ... }
+ *   neon_parallel_for(n, neon_num_threads(), work, &ctx);
+ *
+ * Windows: chạy tuần tự trên thread hiện tại (chưa hỗ trợ)
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define NEON_MAX_THREADS 64
+
+
+/**
+ * Work function: xử lý [begin, end), thread_id ∈ [0, num_threads)
+*/
+typedef void (*NeonParallelFn)(void* ctx, size_t begin, size_t end, int thread_id);
+
+
+/**
+ * Số core đang online (tối thiểu 1, tối đa NEON_MAX_THREADS)
+*/
+static inline int neon_num_threads(void) {
+#if NEON_HAS_PTHREAD
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (int)CLAMP(n, 1, NEON_MAX_THREADS);
+#else
+    return 1;
+#endif
+}
+
+
+/**
+ * Thread count thực tế cho n items: không tạo thread khi mỗi thread có < min_chunk items
+*/
+static inline int neon_threads_for(size_t n, int num_threads, size_t min_chunk) {
+    if (num_threads < 1) num_threads = 1;
+    if (num_threads > NEON_MAX_THREADS) num_threads = NEON_MAX_THREADS;
+    if (min_chunk == 0) min_chunk = 1;
+
+    size_t max_useful = n / min_chunk;
+    if (max_useful < 1) max_useful = 1;
+    return (int)MIN((size_t)num_threads, max_useful);
+}
+
+
+typedef struct {
+    NeonParallelFn fn;
+    void* ctx;
+    size_t begin;
+    size_t end;
+    int thread_id;
+} NeonThreadTask;
+
+
+static void* neon_thread_entry(void* arg) {
+    NeonThreadTask* task = (NeonThreadTask*)arg;
+    task->fn(task->ctx, task->begin, task->end, task->thread_id);
+    return NULL;
+}
+
+
+/**
+ * Chia [0, n) thành num_threads đoạn liên tiếp gần bằng nhau
+ * Thread 0 chạy trên thread gọi hàm, các đoạn còn lại chạy trên pthread mới
+ *
+ * @return: NEON_SUCCESS (nếu tạo thread thất bại thì đoạn đó chạy tuần tự)
+*/
+static inline int neon_parallel_for(size_t n, int num_threads, NeonParallelFn fn, void* ctx) {
+    if (fn == NULL) return NEON_ERROR_NULL_POINTER;
+    if (n == 0) return NEON_SUCCESS;
+
+    num_threads = neon_threads_for(n, num_threads, 1);
+
+    NeonThreadTask tasks[NEON_MAX_THREADS];
+    size_t chunk = n / (size_t)num_threads;
+    size_t rem = n % (size_t)num_threads;
+    size_t pos = 0;
+
+    for (int t = 0; t < num_threads; t++) {
+        size_t len = chunk + ((size_t)t < rem ? 1 : 0);
+        tasks[t].fn = fn;
+        tasks[t].ctx = ctx;
+        tasks[t].begin = pos;
+        tasks[t].end = pos + len;
+        tasks[t].thread_id = t;
+        pos += len;
+    }
+
+#if NEON_HAS_PTHREAD
+    pthread_t threads[NEON_MAX_THREADS];
+    int started[NEON_MAX_THREADS] = {0};
+
+    for (int t = 1; t < num_threads; t++) {
+        started[t] = (pthread_create(&threads[t], NULL, neon_thread_entry, &tasks[t]) == 0);
+        if (!started[t]) {
+            neon_thread_entry(&tasks[t]);
+        }
+    }
+
+    neon_thread_entry(&tasks[0]);
+
+    for (int t = 1; t < num_threads; t++) {
+        if (started[t]) pthread_join(threads[t], NULL);
+    }
+#else
+    for (int t = 0; t < num_threads; t++) {
+        neon_thread_entry(&tasks[t]);
+    }
+#endif
+
+    return NEON_SUCCESS;
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_THREAD_H
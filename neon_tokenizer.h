@@ -0,0 +1,775 @@
+#ifndef NEON_TOKENIZER_H
+#define NEON_TOKENIZER_H
+
+#include "neon_types.h"
+#include "memory_align.h"
+#include "neon_bytes.h"
+#include "neon_checksum.h"
+#include <string.h>
+
+
+/**
+ * TOKENIZER FRONT END (pre-tokenize + BPE)
+ *
+ * Tokenization chạy trước GEMM đầu tiên → nằm trong time-to-first-token, tăng tuyến tính theo prompt
+ *
+ * 1. PRE-TOKENIZE (tách text thành pieces kiểu GPT-2, rút gọn):
+ *   Class mỗi byte: LETTER / DIGIT / SPACE / PUNCT, byte >= 0x80 (UTF-8) tính là LETTER
+ *   → 16 bytes / lần: bảng 128 entries, vqtbl4q_u8 (0-63) + vqtbx4q_u8 (64-127)
+ *   Split tại vị trí class[i] != class[i-1]: so sánh với vextq_u8(prev, cls, 15)
+ *   → block không có split (giữa 1 từ dài / 1 dãy số) bỏ qua bằng 1 vmaxvq_u8
+ *   Dấu ' ' cuối cùng của dãy space gắn vào piece sau (" world", " 123", " ,")
+ *   Không xử lý contraction ('s, 't) và Unicode letter classes như regex gốc
+ *
+ * 2. MERGE TABLE (pair (left, right) → rank, merged id), open addressing:
+ *   1 group = 4 keys u64 + 4 ranks + 4 merged ids = 64 bytes = 1 cache line
+ *   Probe: 2 x vceqq_u64 so sánh 4 keys 1 lần, thường chỉ chạm 1 cache line / lookup
+ *
+ * 3. VOCAB (bytes → id), open addressing kiểu Swiss table:
+ *   ctrl: 16 tags 7-bit / group (0x80 = trống), tag = 7 bit cao của neon_hash64
+ *   Probe: vceqq_u8(ctrl, tag) → chỉ memcmp các slot trùng tag, group còn slot trống → dừng
+ *   Dùng làm fast path: piece có sẵn trong vocab → 1 lookup, không cần chạy BPE
+ *
+ * 4. BPE: merge cặp có rank thấp nhất (trái nhất nếu trùng), cache rank từng cặp,
+ *   sau mỗi merge chỉ lookup lại 2 cặp kề, argmin rank bằng vminvq_u32
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+typedef enum {
+    TOKEN_CLASS_LETTER = 0x01,
+    TOKEN_CLASS_DIGIT = 0x02,
+    TOKEN_CLASS_SPACE = 0x04,
+    TOKEN_CLASS_PUNCT = 0x08
+} TokenClass;
+
+
+#define NEON_MERGE_WAYS 4
+#define NEON_MERGE_EMPTY 0xFFFFFFFFFFFFFFFFull
+#define NEON_VOCAB_GROUP 16
+#define NEON_VOCAB_EMPTY 0x80
+#define NEON_TOKEN_NONE 0xFFFFFFFFu
+#define NEON_BPE_STACK 128
+
+
+static const uint8_t NEON_TOKEN_CLASS_TABLE[128] ALIGN_NEON = {
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x04, 0x04, 0x04, 0x04, 0x04, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x04, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x08, 0x08, 0x08, 0x08, 0x08
+};
+
+
+
+// BYTE CLASSIFICATION
+static NEON_INLINE uint8_t neon_token_class(uint8_t c) {
+    return (c < 128) ? NEON_TOKEN_CLASS_TABLE[c] : (uint8_t)TOKEN_CLASS_LETTER;
+}
+
+
+typedef struct
+{
+    uint8x16x4_t lo; // entries 0-63
+    uint8x16x4_t hi; // entries 64-127
+} NeonTokenClassTable;
+
+
+static NEON_INLINE NeonTokenClassTable neon_token_class_table_load(void) {
+    NeonTokenClassTable t;
+    for (int k = 0; k < 4; k++) {
+        t.lo.val[k] = vld1q_u8(NEON_TOKEN_CLASS_TABLE + 16 * k);
+        t.hi.val[k] = vld1q_u8(NEON_TOKEN_CLASS_TABLE + 64 + 16 * k);
+    }
+    return t;
+}
+
+
+/**
+ * 16 bytes → 16 class
+ *   c < 64: vqtbl4q_u8, 64 <= c < 128: vqtbx4q_u8(c - 64), c >= 128: cả 2 trả 0 → OR LETTER
+*/
+static NEON_INLINE uint8x16_t neon_token_classify_u8x16(const NeonTokenClassTable* t, uint8x16_t c) {
+    uint8x16_t k = vqtbl4q_u8(t->lo, c);
+    k = vqtbx4q_u8(k, t->hi, vsubq_u8(c, vdupq_n_u8(64)));
+
+    uint8x16_t high = vreinterpretq_u8_s8(vshrq_n_s8(vreinterpretq_s8_u8(c), 7));
+    return vorrq_u8(k, vandq_u8(high, vdupq_n_u8(TOKEN_CLASS_LETTER)));
+}
+
+
+/**
+ * classes[i] = TokenClass của src[i]
+*/
+static inline void neon_token_classify(const uint8_t* src, size_t n, uint8_t* classes) {
+    const NeonTokenClassTable t = neon_token_class_table_load();
+
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        vst1q_u8(classes + i, neon_token_classify_u8x16(&t, vld1q_u8(src + i)));
+    }
+    for (; i < n; i++) {
+        classes[i] = neon_token_class(src[i]);
+    }
+}
+
+
+
+// PRE-TOKENIZE
+/**
+ * Ghi split tại i; nếu byte trước là ' ' thì dời split về i - 1 (space gắn vào piece sau)
+*/
+static NEON_INLINE size_t neon_pretok_emit(const uint8_t* src, size_t i, uint32_t* splits, size_t count) {
+    size_t pos = (i > 0 && src[i - 1] == ' ') ? i - 1 : i;
+    if (count == 0 || pos > splits[count - 1]) {
+        splits[count++] = (uint32_t)pos;
+    }
+    return count;
+}
+
+
+/**
+ * Tách text thành pieces
+ * @param splits: tối thiểu n + 1 phần tử; piece k = [splits[k], splits[k + 1]), splits[count] = n
+ * @return: số pieces
+*/
+static inline size_t neon_pretokenize(const uint8_t* src, size_t n, uint32_t* splits) {
+    if (n == 0) {
+        splits[0] = 0;
+        return 0;
+    }
+
+    const NeonTokenClassTable t = neon_token_class_table_load();
+    uint8x16_t prev = vdupq_n_u8(0); // class 0 không tồn tại → luôn split tại byte 0
+    size_t count = 0;
+
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        NEON_PREFETCH(src + i + 256);
+
+        uint8x16_t cls = neon_token_classify_u8x16(&t, vld1q_u8(src + i));
+        neon_i8x16 change = vmvnq_u8(vceqq_u8(cls, vextq_u8(prev, cls, 15)));
+        prev = cls;
+
+        if (!neon_any_u8x16(change)) continue;
+
+        uint64_t mask = neon_mask_u8x16(change);
+        while (mask) {
+            size_t lane = neon_mask_first(mask);
+            mask &= ~(0xFull << (lane * 4));
+            count = neon_pretok_emit(src, i + lane, splits, count);
+        }
+    }
+
+    uint8_t last = vgetq_lane_u8(prev, 15);
+    for (; i < n; i++) {
+        uint8_t k = neon_token_class(src[i]);
+        if (k != last) {
+            count = neon_pretok_emit(src, i, splits, count);
+        }
+        last = k;
+    }
+
+    splits[count] = (uint32_t)n;
+    return count;
+}
+
+
+
+// MERGE TABLE
+typedef struct
+{
+    uint64_t keys[NEON_MERGE_WAYS]; // (left << 32) | right, NEON_MERGE_EMPTY = trống
+    uint32_t ranks[NEON_MERGE_WAYS];
+    uint32_t merged[NEON_MERGE_WAYS];
+} NeonMergeGroup;
+
+
+typedef struct
+{
+    NeonMergeGroup* groups; // 64-byte aligned, num_groups = lũy thừa 2
+    size_t num_groups;
+    size_t count;
+} NeonMergeTable;
+
+
+static NEON_INLINE uint64_t neon_merge_key(uint32_t left, uint32_t right) {
+    return ((uint64_t)left << 32) | right;
+}
+
+
+/**
+ * Mask 16 bit / lane của các key bằng key
+*/
+static NEON_INLINE uint64_t neon_merge_match(const NeonMergeGroup* g, uint64x2_t key) {
+    uint32x2_t lo = vmovn_u64(vceqq_u64(vld1q_u64(g->keys), key));
+    uint32x2_t hi = vmovn_u64(vceqq_u64(vld1q_u64(g->keys + 2), key));
+    uint16x4_t m = vmovn_u32(vcombine_u32(lo, hi));
+    return vget_lane_u64(vreinterpret_u64_u16(m), 0);
+}
+
+
+static inline NeonMergeGroup* neon_merge_alloc_groups(size_t num_groups) {
+    NeonMergeGroup* groups = (NeonMergeGroup*)aligned_malloc(num_groups * sizeof(NeonMergeGroup), NEON_CACHE_LINE);
+    if (groups != NULL) {
+        memset(groups, 0xFF, num_groups * sizeof(NeonMergeGroup));
+    }
+    return groups;
+}
+
+
+/**
+ * @param capacity: số merges dự kiến (bảng tự grow khi load > 75%)
+*/
+static inline int neon_merge_table_create(NeonMergeTable* t, size_t capacity) {
+    if (t == NULL) return NEON_ERROR_NULL_POINTER;
+
+    size_t need = (capacity * 4 / 3 + NEON_MERGE_WAYS - 1) / NEON_MERGE_WAYS;
+    size_t num_groups = 1;
+    while (num_groups < need) num_groups <<= 1;
+
+    t->groups = neon_merge_alloc_groups(num_groups);
+    if (t->groups == NULL) return NEON_ERROR_OUT_OF_MEMORY;
+
+    t->num_groups = num_groups;
+    t->count = 0;
+    return NEON_SUCCESS;
+}
+
+
+static inline void neon_merge_table_destroy(NeonMergeTable* t) {
+    if (t == NULL) return;
+
+    aligned_free(t->groups);
+    t->groups = NULL;
+    t->num_groups = 0;
+    t->count = 0;
+}
+
+
+/**
+ * Tìm pair (left, right)
+ * @return: 1 nếu có (ghi rank, merged), 0 nếu không
+*/
+static inline int neon_merge_lookup(
+    const NeonMergeTable* t,
+    uint32_t left,
+    uint32_t right,
+    uint32_t* rank,
+    uint32_t* merged
+) {
+    uint64_t key = neon_merge_key(left, right);
+    const uint64x2_t vkey = vdupq_n_u64(key);
+    const uint64x2_t vempty = vdupq_n_u64(NEON_MERGE_EMPTY);
+    const size_t mask = t->num_groups - 1;
+
+    size_t gi = (size_t)neon_hash_avalanche(key) & mask;
+    for (size_t probe = 0; probe < t->num_groups; probe++) {
+        const NeonMergeGroup* g = &t->groups[gi];
+
+        uint64_t hit = neon_merge_match(g, vkey);
+        if (LIKELY(hit)) {
+            size_t lane = (size_t)(__builtin_ctzll(hit) >> 4);
+            *rank = g->ranks[lane];
+            *merged = g->merged[lane];
+            return 1;
+        }
+        if (neon_merge_match(g, vempty)) return 0;
+
+        gi = (gi + 1) & mask;
+    }
+
+    return 0;
+}
+
+
+/**
+ * Đặt key vào slot trống đầu tiên (key chưa có trong bảng)
+*/
+static inline void neon_merge_place(NeonMergeGroup* groups, size_t num_groups, uint64_t key, uint32_t rank, uint32_t merged) {
+    const uint64x2_t vempty = vdupq_n_u64(NEON_MERGE_EMPTY);
+    const size_t mask = num_groups - 1;
+
+    size_t gi = (size_t)neon_hash_avalanche(key) & mask;
+    for (;;) {
+        NeonMergeGroup* g = &groups[gi];
+        uint64_t empty = neon_merge_match(g, vempty);
+        if (empty) {
+            size_t lane = (size_t)(__builtin_ctzll(empty) >> 4);
+            g->keys[lane] = key;
+            g->ranks[lane] = rank;
+            g->merged[lane] = merged;
+            return;
+        }
+        gi = (gi + 1) & mask;
+    }
+}
+
+
+static inline int neon_merge_table_grow(NeonMergeTable* t) {
+    size_t num_groups = t->num_groups * 2;
+    NeonMergeGroup* groups = neon_merge_alloc_groups(num_groups);
+    if (groups == NULL) return NEON_ERROR_OUT_OF_MEMORY;
+
+    for (size_t g = 0; g < t->num_groups; g++) {
+        const NeonMergeGroup* src = &t->groups[g];
+        for (int w = 0; w < NEON_MERGE_WAYS; w++) {
+            if (src->keys[w] != NEON_MERGE_EMPTY) {
+                neon_merge_place(groups, num_groups, src->keys[w], src->ranks[w], src->merged[w]);
+            }
+        }
+    }
+
+    aligned_free(t->groups);
+    t->groups = groups;
+    t->num_groups = num_groups;
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * Thêm / cập nhật merge (left, right) → merged với rank (thấp = merge trước)
+*/
+static inline int neon_merge_insert(NeonMergeTable* t, uint32_t left, uint32_t right, uint32_t rank, uint32_t merged) {
+    if (t == NULL || t->groups == NULL) return NEON_ERROR_NULL_POINTER;
+
+    uint64_t key = neon_merge_key(left, right);
+    if (key == NEON_MERGE_EMPTY) return NEON_ERROR_INVALID_PARAM;
+
+    uint32_t old_rank, old_merged;
+    if (neon_merge_lookup(t, left, right, &old_rank, &old_merged)) {
+        NeonMergeGroup* groups = t->groups;
+        const size_t mask = t->num_groups - 1;
+        for (size_t gi = (size_t)neon_hash_avalanche(key) & mask;; gi = (gi + 1) & mask) {
+            for (int w = 0; w < NEON_MERGE_WAYS; w++) {
+                if (groups[gi].keys[w] == key) {
+                    groups[gi].ranks[w] = rank;
+                    groups[gi].merged[w] = merged;
+                    return NEON_SUCCESS;
+                }
+            }
+        }
+    }
+
+    if ((t->count + 1) * 4 > t->num_groups * NEON_MERGE_WAYS * 3) {
+        int err = neon_merge_table_grow(t);
+        if (err != NEON_SUCCESS) return err;
+    }
+
+    neon_merge_place(t->groups, t->num_groups, key, rank, merged);
+    t->count++;
+    return NEON_SUCCESS;
+}
+
+
+
+// VOCAB
+typedef struct
+{
+    uint32_t offset; // vị trí trong arena
+    uint32_t length;
+    uint32_t id;
+} NeonVocabEntry;
+
+
+typedef struct
+{
+    uint8_t* ctrl; // num_groups * 16 tags, NEON_VOCAB_EMPTY = trống
+    NeonVocabEntry* entries;
+    uint8_t* arena; // bytes của tất cả tokens, nối liền
+    size_t arena_size;
+    size_t arena_capacity;
+    size_t num_groups; // lũy thừa 2
+    size_t count;
+} NeonVocab;
+
+
+static NEON_INLINE uint8_t neon_vocab_tag(uint64_t h) {
+    return (uint8_t)(h >> 57);
+}
+
+
+static inline int neon_vocab_alloc_slots(size_t num_groups, uint8_t** ctrl, NeonVocabEntry** entries) {
+    size_t slots = num_groups * NEON_VOCAB_GROUP;
+    *ctrl = (uint8_t*)neon_malloc(slots);
+    *entries = (NeonVocabEntry*)neon_malloc(slots * sizeof(NeonVocabEntry));
+    if (*ctrl == NULL || *entries == NULL) {
+        neon_free(*ctrl);
+        neon_free(*entries);
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+    memset(*ctrl, NEON_VOCAB_EMPTY, slots);
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * @param capacity: số tokens dự kiến (bảng tự grow khi load > 7/8)
+*/
+static inline int neon_vocab_create(NeonVocab* v, size_t capacity) {
+    if (v == NULL) return NEON_ERROR_NULL_POINTER;
+
+    size_t need = (capacity * 8 / 7 + NEON_VOCAB_GROUP - 1) / NEON_VOCAB_GROUP;
+    size_t num_groups = 1;
+    while (num_groups < need) num_groups <<= 1;
+
+    int err = neon_vocab_alloc_slots(num_groups, &v->ctrl, &v->entries);
+    if (err != NEON_SUCCESS) return err;
+
+    v->arena_capacity = MAX(capacity * 8, (size_t)256);
+    v->arena = (uint8_t*)neon_malloc(v->arena_capacity);
+    if (v->arena == NULL) {
+        neon_free(v->ctrl);
+        neon_free(v->entries);
+        return NEON_ERROR_OUT_OF_MEMORY;
+    }
+
+    v->arena_size = 0;
+    v->num_groups = num_groups;
+    v->count = 0;
+    return NEON_SUCCESS;
+}
+
+
+static inline void neon_vocab_destroy(NeonVocab* v) {
+    if (v == NULL) return;
+
+    neon_free(v->ctrl);
+    neon_free(v->entries);
+    neon_free(v->arena);
+    v->ctrl = NULL;
+    v->entries = NULL;
+    v->arena = NULL;
+    v->num_groups = 0;
+    v->count = 0;
+}
+
+
+/**
+ * Slot của token s[0..len) (hash h), hoặc SIZE_MAX
+*/
+static inline size_t neon_vocab_find(const NeonVocab* v, const uint8_t* s, size_t len, uint64_t h) {
+    const uint8x16_t tag = vdupq_n_u8(neon_vocab_tag(h));
+    const uint8x16_t empty = vdupq_n_u8(NEON_VOCAB_EMPTY);
+    const size_t mask = v->num_groups - 1;
+
+    size_t gi = (size_t)h & mask;
+    for (size_t probe = 0; probe < v->num_groups; probe++) {
+        uint8x16_t ctrl = vld1q_u8(v->ctrl + gi * NEON_VOCAB_GROUP);
+
+        uint64_t hits = neon_mask_u8x16(vceqq_u8(ctrl, tag));
+        while (hits) {
+            size_t lane = neon_mask_first(hits);
+            hits &= ~(0xFull << (lane * 4));
+
+            size_t slot = gi * NEON_VOCAB_GROUP + lane;
+            const NeonVocabEntry* e = &v->entries[slot];
+            if (e->length == len && neon_memcmp(v->arena + e->offset, s, len) == 0) {
+                return slot;
+            }
+        }
+
+        if (neon_any_u8x16(vceqq_u8(ctrl, empty))) return SIZE_MAX;
+        gi = (gi + 1) & mask;
+    }
+
+    return SIZE_MAX;
+}
+
+
+/**
+ * Tìm token s[0..len)
+ * @return: 1 nếu có (ghi id), 0 nếu không
+*/
+static inline int neon_vocab_lookup(const NeonVocab* v, const uint8_t* s, size_t len, uint32_t* id) {
+    size_t slot = neon_vocab_find(v, s, len, neon_hash64(s, len, 0));
+    if (slot == SIZE_MAX) return 0;
+
+    *id = v->entries[slot].id;
+    return 1;
+}
+
+
+static inline void neon_vocab_place(uint8_t* ctrl, NeonVocabEntry* entries, size_t num_groups, uint64_t h, NeonVocabEntry e) {
+    const uint8x16_t empty = vdupq_n_u8(NEON_VOCAB_EMPTY);
+    const size_t mask = num_groups - 1;
+
+    size_t gi = (size_t)h & mask;
+    for (;;) {
+        uint64_t free_mask = neon_mask_u8x16(vceqq_u8(vld1q_u8(ctrl + gi * NEON_VOCAB_GROUP), empty));
+        if (free_mask) {
+            size_t slot = gi * NEON_VOCAB_GROUP + neon_mask_first(free_mask);
+            ctrl[slot] = neon_vocab_tag(h);
+            entries[slot] = e;
+            return;
+        }
+        gi = (gi + 1) & mask;
+    }
+}
+
+
+static inline int neon_vocab_grow(NeonVocab* v) {
+    size_t num_groups = v->num_groups * 2;
+    uint8_t* ctrl;
+    NeonVocabEntry* entries;
+
+    int err = neon_vocab_alloc_slots(num_groups, &ctrl, &entries);
+    if (err != NEON_SUCCESS) return err;
+
+    size_t slots = v->num_groups * NEON_VOCAB_GROUP;
+    for (size_t i = 0; i < slots; i++) {
+        if (v->ctrl[i] == NEON_VOCAB_EMPTY) continue;
+
+        const NeonVocabEntry e = v->entries[i];
+        neon_vocab_place(ctrl, entries, num_groups, neon_hash64(v->arena + e.offset, e.length, 0), e);
+    }
+
+    neon_free(v->ctrl);
+    neon_free(v->entries);
+    v->ctrl = ctrl;
+    v->entries = entries;
+    v->num_groups = num_groups;
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * Thêm token s[0..len) → id (token đã có thì cập nhật id)
+*/
+static inline int neon_vocab_insert(NeonVocab* v, const uint8_t* s, size_t len, uint32_t id) {
+    if (v == NULL || v->ctrl == NULL || (s == NULL && len > 0)) return NEON_ERROR_NULL_POINTER;
+
+    uint64_t h = neon_hash64(s, len, 0);
+    size_t slot = neon_vocab_find(v, s, len, h);
+    if (slot != SIZE_MAX) {
+        v->entries[slot].id = id;
+        return NEON_SUCCESS;
+    }
+
+    if (v->arena_size + len > 0xFFFFFFFFu) return NEON_ERROR_INVALID_SIZE;
+
+    if ((v->count + 1) * 8 > v->num_groups * NEON_VOCAB_GROUP * 7) {
+        int err = neon_vocab_grow(v);
+        if (err != NEON_SUCCESS) return err;
+    }
+
+    if (v->arena_size + len > v->arena_capacity) {
+        size_t new_capacity = MAX(v->arena_capacity * 2, v->arena_size + len);
+        uint8_t* arena = (uint8_t*)neon_malloc(new_capacity);
+        if (arena == NULL) return NEON_ERROR_OUT_OF_MEMORY;
+
+        memcpy(arena, v->arena, v->arena_size);
+        neon_free(v->arena);
+        v->arena = arena;
+        v->arena_capacity = new_capacity;
+    }
+
+    NeonVocabEntry e;
+    e.offset = (uint32_t)v->arena_size;
+    e.length = (uint32_t)len;
+    e.id = id;
+
+    if (len > 0) memcpy(v->arena + v->arena_size, s, len);
+    v->arena_size += len;
+
+    neon_vocab_place(v->ctrl, v->entries, v->num_groups, h, e);
+    v->count++;
+    return NEON_SUCCESS;
+}
+
+
+
+// BPE
+/**
+ * Index của rank nhỏ nhất (trái nhất), vminvq_u32 trên 4 lanes / lần
+*/
+static NEON_INLINE size_t neon_bpe_argmin(const uint32_t* ranks, size_t n, uint32_t* best) {
+    size_t i = 0;
+    uint32_t m = NEON_TOKEN_NONE;
+
+    if (n >= 4) {
+        uint32x4_t vm = vld1q_u32(ranks);
+        for (i = 4; i + 4 <= n; i += 4) {
+            vm = vminq_u32(vm, vld1q_u32(ranks + i));
+        }
+        m = vminvq_u32(vm);
+    }
+    for (; i < n; i++) {
+        m = MIN(m, ranks[i]);
+    }
+
+    *best = m;
+    if (m == NEON_TOKEN_NONE) return n;
+
+    size_t j = 0;
+    while (ranks[j] != m) j++;
+    return j;
+}
+
+
+static NEON_INLINE void neon_bpe_pair(const NeonMergeTable* t, const uint32_t* ids, size_t j, uint32_t* ranks, uint32_t* merged) {
+    if (!neon_merge_lookup(t, ids[j], ids[j + 1], &ranks[j], &merged[j])) {
+        ranks[j] = NEON_TOKEN_NONE;
+    }
+}
+
+
+/**
+ * Chạy BPE in-place trên ids[0..*n)
+ * @param n: vào = số ids ban đầu, ra = số ids sau khi merge
+*/
+static inline int neon_bpe_merge(const NeonMergeTable* t, uint32_t* ids, size_t* n) {
+    if (t == NULL || ids == NULL || n == NULL) return NEON_ERROR_NULL_POINTER;
+
+    size_t m = *n;
+    if (m < 2) return NEON_SUCCESS;
+
+    uint32_t stack_buf[2 * NEON_BPE_STACK];
+    uint32_t* buf = stack_buf;
+    if (m - 1 > NEON_BPE_STACK) {
+        buf = (uint32_t*)neon_malloc(2 * (m - 1) * sizeof(uint32_t));
+        if (buf == NULL) return NEON_ERROR_OUT_OF_MEMORY;
+    }
+    uint32_t* ranks = buf;
+    uint32_t* merged = buf + (m - 1 > NEON_BPE_STACK ? m - 1 : NEON_BPE_STACK);
+
+    for (size_t j = 0; j + 1 < m; j++) {
+        neon_bpe_pair(t, ids, j, ranks, merged);
+    }
+
+    while (m > 1) {
+        uint32_t best;
+        size_t j = neon_bpe_argmin(ranks, m - 1, &best);
+        if (best == NEON_TOKEN_NONE) break;
+
+        // ids[j], ids[j + 1] → merged[j], bỏ cặp j + 1
+        ids[j] = merged[j];
+        size_t tail = m - j - 2;
+        memmove(ids + j + 1, ids + j + 2, tail * sizeof(uint32_t));
+        memmove(ranks + j, ranks + j + 1, tail * sizeof(uint32_t));
+        memmove(merged + j, merged + j + 1, tail * sizeof(uint32_t));
+        m--;
+
+        if (j > 0) neon_bpe_pair(t, ids, j - 1, ranks, merged);
+        if (j + 1 < m) neon_bpe_pair(t, ids, j, ranks, merged);
+    }
+
+    if (buf != stack_buf) neon_free(buf);
+
+    *n = m;
+    return NEON_SUCCESS;
+}
+
+
+
+// TOKENIZER
+typedef struct
+{
+    NeonVocab vocab;
+    NeonMergeTable merges;
+    uint32_t byte_ids[256]; // id của token 1 byte (mặc định = giá trị byte)
+} NeonTokenizer;
+
+
+static inline int neon_tokenizer_create(NeonTokenizer* tok, size_t vocab_capacity, size_t merge_capacity) {
+    if (tok == NULL) return NEON_ERROR_NULL_POINTER;
+
+    int err = neon_vocab_create(&tok->vocab, vocab_capacity);
+    if (err != NEON_SUCCESS) return err;
+
+    err = neon_merge_table_create(&tok->merges, merge_capacity);
+    if (err != NEON_SUCCESS) {
+        neon_vocab_destroy(&tok->vocab);
+        return err;
+    }
+
+    for (int b = 0; b < 256; b++) {
+        tok->byte_ids[b] = (uint32_t)b;
+    }
+    return NEON_SUCCESS;
+}
+
+
+static inline void neon_tokenizer_destroy(NeonTokenizer* tok) {
+    if (tok == NULL) return;
+
+    neon_vocab_destroy(&tok->vocab);
+    neon_merge_table_destroy(&tok->merges);
+}
+
+
+/**
+ * Encode 1 piece: vocab hit → 1 id, không thì byte ids + BPE
+ * @param out: tối thiểu len phần tử
+ * @param out_count: số ids đã ghi
+*/
+static inline int neon_tokenize_piece(
+    const NeonTokenizer* tok,
+    const uint8_t* piece,
+    size_t len,
+    uint32_t* out,
+    size_t* out_count
+) {
+    if (tok->vocab.count > 0 && neon_vocab_lookup(&tok->vocab, piece, len, out)) {
+        *out_count = 1;
+        return NEON_SUCCESS;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        out[i] = tok->byte_ids[piece[i]];
+    }
+
+    *out_count = len;
+    return neon_bpe_merge(&tok->merges, out, out_count);
+}
+
+
+/**
+ * Pre-tokenize + encode toàn bộ text
+ * @param out: tối thiểu n phần tử
+ * @param out_count: số ids đã ghi
+*/
+static inline int neon_tokenize(
+    const NeonTokenizer* tok,
+    const uint8_t* text,
+    size_t n,
+    uint32_t* out,
+    size_t* out_count
+) {
+    if (tok == NULL || out == NULL || out_count == NULL || (text == NULL && n > 0)) return NEON_ERROR_NULL_POINTER;
+    if (n >= 0xFFFFFFFFu) return NEON_ERROR_INVALID_SIZE;
+
+    *out_count = 0;
+    if (n == 0) return NEON_SUCCESS;
+
+    uint32_t* splits = (uint32_t*)neon_malloc((n + 1) * sizeof(uint32_t));
+    if (splits == NULL) return NEON_ERROR_OUT_OF_MEMORY;
+
+    size_t num_pieces = neon_pretokenize(text, n, splits);
+    size_t total = 0;
+    int err = NEON_SUCCESS;
+
+    for (size_t p = 0; p < num_pieces; p++) {
+        size_t count;
+        err = neon_tokenize_piece(tok, text + splits[p], splits[p + 1] - splits[p], out + total, &count);
+        if (err != NEON_SUCCESS) break;
+        total += count;
+    }
+
+    neon_free(splits);
+    *out_count = total;
+    return err;
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_TOKENIZER_H
@@ -0,0 +1,286 @@
+#ifndef NEON_TOPK_H
+#define NEON_TOPK_H
+
+#include "neon_types.h"
+#include "memory_align.h"
+#include "neon_utils.h"
+#include "neon_thread.h"
+
+
+/**
+ * TOP-K SELECTION
+ *
+ * Tìm k scores lớn nhất trong n (n >> k, ví dụ n = 10M, k = 100)
+ * Full sort: O(n log n) → lãng phí
+ *
+ * THRESHOLD FILTERING:
+ *   - Giữ min-heap k phần tử tốt nhất, heap[0] = phần tử thứ k (threshold)
+ *   - Mỗi 16 scores: 4 x neon_cmpgt_f32x4 với threshold, OR các mask lại
+ *   - Không lane nào > threshold (trường hợp phổ biến khi n >> k) → bỏ qua cả 16
+ *   - Chỉ những lane vượt threshold mới vào heap (scalar, O(log k))
+ *
+ * Sau vài nghìn phần tử đầu threshold đã cao, gần như mọi vector đều bị skip
+ * → throughput ≈ memory bandwidth
+ *
+ * Heap khởi tạo bằng -inf (index -1) thay vì k scores đầu: threshold không bao giờ là NaN
+ * → NaN (và -inf) không bao giờ > threshold nên bị bỏ qua, số kết quả có thể < k
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+// MIN-HEAP (value, index)
+static inline void neon_topk_sift_down(float* vals, int32_t* idx, size_t k, size_t pos) {
+    float v = vals[pos];
+    int32_t id = idx[pos];
+
+    for (;;) {
+        size_t child = 2 * pos + 1;
+        if (child >= k) break;
+        if (child + 1 < k && vals[child + 1] < vals[child]) child++;
+        if (!(vals[child] < v)) break;
+
+        vals[pos] = vals[child];
+        idx[pos] = idx[child];
+        pos = child;
+    }
+
+    vals[pos] = v;
+    idx[pos] = id;
+}
+
+
+static inline void neon_topk_heapify(float* vals, int32_t* idx, size_t k) {
+    for (size_t i = k / 2; i-- > 0;) {
+        neon_topk_sift_down(vals, idx, k, i);
+    }
+}
+
+
+/**
+ * Sort heap → giảm dần (heap sort in-place)
+*/
+static inline void neon_topk_heap_sort_desc(float* vals, int32_t* idx, size_t k) {
+    for (size_t end = k; end > 1; end--) {
+        float tv = vals[0];
+        int32_t ti = idx[0];
+        vals[0] = vals[end - 1];
+        idx[0] = idx[end - 1];
+        vals[end - 1] = tv;
+        idx[end - 1] = ti;
+        neon_topk_sift_down(vals, idx, end - 1, 0);
+    }
+}
+
+
+/**
+ * Push 1 candidate (đã biết > heap[0]) vào heap
+*/
+static NEON_INLINE void neon_topk_push(float* vals, int32_t* idx, size_t k, float v, int32_t id) {
+    vals[0] = v;
+    idx[0] = id;
+    neon_topk_sift_down(vals, idx, k, 0);
+}
+
+
+
+/**
+ * Top-k với threshold filtering
+ *
+ * @param scores: [n] scores
+ * @param index_base: cộng vào index output (dùng khi xử lý 1 đoạn của array lớn hơn)
+ * @param out_values: [k] giảm dần
+ * @param out_indices: [k] index tương ứng
+ * @return: số phần tử hợp lệ ≤ min(k, n) (bỏ qua NaN và -inf), các slot còn lại = -inf / -1
+*/
+static inline size_t neon_topk_f32_offset(
+    const float* scores,
+    size_t n,
+    size_t k,
+    int32_t index_base,
+    float* out_values,
+    int32_t* out_indices
+) {
+    if (k == 0 || n == 0) return 0;
+    if (k > n) k = n;
+
+    // Heap toàn -inf: k scores đầu có thể chứa NaN, NaN ở heap[0] sẽ chặn mọi phép so sánh sau đó
+    for (size_t i = 0; i < k; i++) {
+        out_values[i] = -INFINITY;
+        out_indices[i] = -1;
+    }
+
+    float threshold = -INFINITY;
+    float32x4_t vth = vdupq_n_f32(threshold);
+
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        NEON_PREFETCH(scores + i + 64);
+
+        float32x4_t v0 = vld1q_f32(scores + i);
+        float32x4_t v1 = vld1q_f32(scores + i + 4);
+        float32x4_t v2 = vld1q_f32(scores + i + 8);
+        float32x4_t v3 = vld1q_f32(scores + i + 12);
+
+        uint32x4_t m = vorrq_u32(
+            vorrq_u32(neon_cmpgt_f32x4(v0, vth), neon_cmpgt_f32x4(v1, vth)),
+            vorrq_u32(neon_cmpgt_f32x4(v2, vth), neon_cmpgt_f32x4(v3, vth))
+        );
+
+        // Fast path: không lane nào vượt threshold
+        if (LIKELY(vmaxvq_u32(m) == 0)) continue;
+
+        for (size_t j = i; j < i + 16; j++) {
+            if (scores[j] > threshold) {
+                neon_topk_push(out_values, out_indices, k, scores[j], index_base + (int32_t)j);
+                threshold = out_values[0];
+            }
+        }
+        vth = vdupq_n_f32(threshold);
+    }
+
+    for (; i < n; i++) {
+        if (scores[i] > threshold) {
+            neon_topk_push(out_values, out_indices, k, scores[i], index_base + (int32_t)i);
+            threshold = out_values[0];
+        }
+    }
+
+    neon_topk_heap_sort_desc(out_values, out_indices, k);
+
+    // Slot chưa được điền (-inf, -1) nằm cuối sau khi sort
+    size_t count = k;
+    while (count > 0 && out_indices[count - 1] < 0) count--;
+    return count;
+}
+
+
+/**
+ * Top-k: out_values giảm dần, out_indices là index trong scores
+*/
+static inline size_t neon_topk_f32(
+    const float* scores,
+    size_t n,
+    size_t k,
+    float* out_values,
+    int32_t* out_indices
+) {
+    return neon_topk_f32_offset(scores, n, k, 0, out_values, out_indices);
+}
+
+
+/**
+ * Merge nhiều top-k lists (mỗi list đã có values/indices) thành 1 top-k
+ *
+ * @param values, indices: các list nối liền nhau, tổng cộng total phần tử
+ * @return: số phần tử hợp lệ ≤ min(k, total)
+*/
+static inline size_t neon_topk_merge(
+    const float* values,
+    const int32_t* indices,
+    size_t total,
+    size_t k,
+    float* out_values,
+    int32_t* out_indices
+) {
+    if (k > total) k = total;
+    if (k == 0) return 0;
+
+    // Top-k trên values, index trả về là vị trí trong candidates → map tại chỗ sang index gốc
+    // (không cần buffer tạm → merge không thể fail vì hết memory)
+    size_t count = neon_topk_f32_offset(values, total, k, 0, out_values, out_indices);
+    for (size_t i = 0; i < count; i++) {
+        out_indices[i] = indices[out_indices[i]];
+    }
+
+    return count;
+}
+
+
+
+// PARALLEL TOP-K
+typedef struct {
+    const float* scores;
+    size_t k;
+    float* cand_values; // [num_threads * k]
+    int32_t* cand_indices;
+    size_t* cand_counts; // [num_threads]
+} NeonTopkParallelCtx;
+
+
+static void neon_topk_parallel_worker(void* arg, size_t begin, size_t end, int tid) {
+    NeonTopkParallelCtx* ctx = (NeonTopkParallelCtx*)arg;
+    ctx->cand_counts[tid] = neon_topk_f32_offset(
+        ctx->scores + begin, end - begin, ctx->k, (int32_t)begin,
+        ctx->cand_values + (size_t)tid * ctx->k,
+        ctx->cand_indices + (size_t)tid * ctx->k
+    );
+}
+
+
+/**
+ * Parallel top-k: mỗi thread tìm top-k trên 1 đoạn, sau đó merge
+ * Merge chỉ xử lý num_threads * k candidates → không đáng kể so với n
+ *
+ * @return: số phần tử hợp lệ ≤ min(k, n)
+*/
+static inline size_t neon_topk_f32_parallel(
+    const float* scores,
+    size_t n,
+    size_t k,
+    float* out_values,
+    int32_t* out_indices,
+    int num_threads
+) {
+    if (k == 0 || n == 0) return 0;
+
+    // Mỗi thread cần đủ nhiều phần tử hơn k thì threshold filtering mới hiệu quả
+    num_threads = neon_threads_for(n, num_threads, MAX(k * 16, (size_t)65536));
+    if (num_threads <= 1) {
+        return neon_topk_f32(scores, n, k, out_values, out_indices);
+    }
+
+    NeonTopkParallelCtx ctx;
+    ctx.scores = scores;
+    ctx.k = k;
+    ctx.cand_values = (float*)neon_malloc((size_t)num_threads * k * sizeof(float));
+    ctx.cand_indices = (int32_t*)neon_malloc((size_t)num_threads * k * sizeof(int32_t));
+    ctx.cand_counts = (size_t*)neon_malloc((size_t)num_threads * sizeof(size_t));
+
+    if (ctx.cand_values == NULL || ctx.cand_indices == NULL || ctx.cand_counts == NULL) {
+        neon_free(ctx.cand_values);
+        neon_free(ctx.cand_indices);
+        neon_free(ctx.cand_counts);
+        return neon_topk_f32(scores, n, k, out_values, out_indices);
+    }
+
+    neon_parallel_for(n, num_threads, neon_topk_parallel_worker, &ctx);
+
+    // Nén các list (thread có đoạn ngắn hơn k sẽ có ít candidates hơn)
+    size_t total = 0;
+    for (int t = 0; t < num_threads; t++) {
+        size_t cnt = ctx.cand_counts[t];
+        memmove(ctx.cand_values + total, ctx.cand_values + (size_t)t * k, cnt * sizeof(float));
+        memmove(ctx.cand_indices + total, ctx.cand_indices + (size_t)t * k, cnt * sizeof(int32_t));
+        total += cnt;
+    }
+
+    size_t result = neon_topk_merge(ctx.cand_values, ctx.cand_indices, total, k, out_values, out_indices);
+
+    neon_free(ctx.cand_values);
+    neon_free(ctx.cand_indices);
+    neon_free(ctx.cand_counts);
+
+    return result;
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_TOPK_H
@@ -27,10 +27,16 @@ typedef float32x2_t neon_f32x2; // 2 floats = 64 bits
 typedef int32x4_t neon_i32x4;
 typedef uint8x16_t neon_i8x16;
 
+#ifdef __aarch64__
+typedef float64x2_t neon_f64x2; // 2 doubles = 128 bits (chỉ có trên ARMv8/AArch64)
+#endif
+
 
 
 #define NEON_ALIGNMENT 16 // NEON yêu cầu data align 16-byte
 #define NEON_F32_LANES 4 // Số float32 trong 1 Q register
+#define NEON_F64_LANES 2 // Số float64 trong 1 Q register
+#define NEON_CACHE_LINE 64 // Cache line size (bytes) trên hầu hết ARM cores
 
 
 #if defined(__ARM_NEON) || defined(__ARM_NEON__)
@@ -122,6 +128,43 @@ typedef struct
 } PoolParams;
 
 
+/**
+ * Sparse matrix - CSR (Compressed Sparse Row)
+ *
+ * Row i có các non-zero tại values[row_ptr[i] .. row_ptr[i+1])
+ * với cột tương ứng col_idx[...]
+*/
+typedef struct
+{
+    int32_t rows;
+    int32_t cols;
+    int32_t nnz;
+    int32_t* row_ptr; // rows + 1 phần tử
+    int32_t* col_idx; // nnz phần tử
+    float* values; // nnz phần tử
+} CSRMatrix;
+
+
+/**
+ * Sparse matrix - Block sparse (BSR)
+ *
+ * Giống CSR nhưng mỗi non-zero là 1 block block_h x block_w (4x1 hoặc 4x4)
+ * block_h = 4 = NEON_F32_LANES → mỗi cột của block vừa 1 Q register
+ * values lưu column-major trong block: block b, cột j = values[(b * block_w + j) * 4 ...]
+*/
+typedef struct
+{
+    int32_t rows;
+    int32_t cols;
+    int32_t block_h;
+    int32_t block_w;
+    int32_t nnzb; // số block khác 0
+    int32_t* row_ptr; // ceil(rows / block_h) + 1 phần tử
+    int32_t* col_idx; // chỉ số block-column (cột thật = col_idx * block_w)
+    float* values; // nnzb * block_h * block_w phần tử
+} BSRMatrix;
+
+
 // PERFORMANCE METRICS
 typedef struct
 {
@@ -0,0 +1,521 @@
+#ifndef NEON_UTF8_H
+#define NEON_UTF8_H
+
+#include "neon_types.h"
+#include "neon_bytes.h"
+
+
+/**
+ * UTF-8 VALIDATION & TRANSCODING
+ *
+ * VALIDATION (lookup-table, không branch theo từng byte):
+ *   Mọi lỗi UTF-8 đều xác định được từ 3 nibble: (byte trước).hi, (byte trước).lo, (byte hiện tại).hi
+ *   → 3 lần vqtbl1q_u8, AND lại: khác 0 = lỗi (mỗi bit = 1 loại lỗi)
+ *
+ *     prev1 = vextq_u8(prev_block, block, 15)   (byte đứng trước mỗi lane)
+ *     err   = T1[prev1 >> 4] & T2[prev1 & 0xF] & T3[block >> 4]
+ *
+ *   Bit TWO_CONTS: 2 continuation liên tiếp — hợp lệ khi và chỉ khi đang ở byte thứ 3/4
+ *   của sequence 3/4 bytes → XOR với (prev2 >= 0xE0 | prev3 >= 0xF0) & 0x80
+ *
+ *   Block toàn ASCII (vmaxvq_u8 < 0x80): chỉ cần kiểm tra block trước không dừng giữa chừng
+ *   → bỏ qua cả block: không tra bảng, không tính prev1/prev2/prev3
+ *
+ * TRANSCODING:
+ *   16 bytes ASCII → vmovl_u8 (→ UTF-16) / vmovl_u16 (→ UTF-32), không decode
+ *   Block có ký tự non-ASCII: decode scalar (strict: từ chối overlong, surrogate, > U+10FFFF)
+ *   UTF-16/32 → UTF-8: 8 / 4 code units ASCII → vmovn narrow về bytes
+ *
+ * Dung lượng dst (worst case): UTF-8 → UTF-16/32: n units; UTF-16 → UTF-8: 3n; UTF-32 → UTF-8: 4n
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+// VALIDATION TABLES
+#define NEON_UTF8_TOO_SHORT (1 << 0) // lead byte không có đủ continuation
+#define NEON_UTF8_TOO_LONG (1 << 1) // continuation sau ASCII
+#define NEON_UTF8_OVERLONG_3 (1 << 2) // E0 80..9F
+#define NEON_UTF8_TOO_LARGE (1 << 3) // F4 90.. / F5..FF
+#define NEON_UTF8_SURROGATE (1 << 4) // ED A0..BF
+#define NEON_UTF8_OVERLONG_2 (1 << 5) // C0, C1
+#define NEON_UTF8_TOO_LARGE_1000 (1 << 6)
+#define NEON_UTF8_OVERLONG_4 (1 << 6) // F0 80..8F
+#define NEON_UTF8_TWO_CONTS (1 << 7) // 2 continuation liên tiếp
+#define NEON_UTF8_CARRY (NEON_UTF8_TOO_SHORT | NEON_UTF8_TOO_LONG | NEON_UTF8_TWO_CONTS)
+
+
+static const uint8_t NEON_UTF8_BYTE1_HIGH[16] ALIGN_NEON = {
+    // 0x0_ - 0x7_: ASCII
+    NEON_UTF8_TOO_LONG, NEON_UTF8_TOO_LONG, NEON_UTF8_TOO_LONG, NEON_UTF8_TOO_LONG,
+    NEON_UTF8_TOO_LONG, NEON_UTF8_TOO_LONG, NEON_UTF8_TOO_LONG, NEON_UTF8_TOO_LONG,
+    // 0x8_ - 0xB_: continuation
+    NEON_UTF8_TWO_CONTS, NEON_UTF8_TWO_CONTS, NEON_UTF8_TWO_CONTS, NEON_UTF8_TWO_CONTS,
+    // 0xC_: lead 2 bytes
+    NEON_UTF8_TOO_SHORT | NEON_UTF8_OVERLONG_2,
+    // 0xD_
+    NEON_UTF8_TOO_SHORT,
+    // 0xE_: lead 3 bytes
+    NEON_UTF8_TOO_SHORT | NEON_UTF8_OVERLONG_3 | NEON_UTF8_SURROGATE,
+    // 0xF_: lead 4 bytes
+    NEON_UTF8_TOO_SHORT | NEON_UTF8_TOO_LARGE | NEON_UTF8_TOO_LARGE_1000 | NEON_UTF8_OVERLONG_4
+};
+
+
+static const uint8_t NEON_UTF8_BYTE1_LOW[16] ALIGN_NEON = {
+    NEON_UTF8_CARRY | NEON_UTF8_OVERLONG_3 | NEON_UTF8_OVERLONG_2 | NEON_UTF8_OVERLONG_4, // _0
+    NEON_UTF8_CARRY | NEON_UTF8_OVERLONG_2, // _1
+    NEON_UTF8_CARRY,
+    NEON_UTF8_CARRY,
+    NEON_UTF8_CARRY | NEON_UTF8_TOO_LARGE, // _4
+    NEON_UTF8_CARRY | NEON_UTF8_TOO_LARGE | NEON_UTF8_TOO_LARGE_1000,
+    NEON_UTF8_CARRY | NEON_UTF8_TOO_LARGE | NEON_UTF8_TOO_LARGE_1000,
+    NEON_UTF8_CARRY | NEON_UTF8_TOO_LARGE | NEON_UTF8_TOO_LARGE_1000,
+    NEON_UTF8_CARRY | NEON_UTF8_TOO_LARGE | NEON_UTF8_TOO_LARGE_1000,
+    NEON_UTF8_CARRY | NEON_UTF8_TOO_LARGE | NEON_UTF8_TOO_LARGE_1000,
+    NEON_UTF8_CARRY | NEON_UTF8_TOO_LARGE | NEON_UTF8_TOO_LARGE_1000,
+    NEON_UTF8_CARRY | NEON_UTF8_TOO_LARGE | NEON_UTF8_TOO_LARGE_1000,
+    NEON_UTF8_CARRY | NEON_UTF8_TOO_LARGE | NEON_UTF8_TOO_LARGE_1000,
+    NEON_UTF8_CARRY | NEON_UTF8_TOO_LARGE | NEON_UTF8_TOO_LARGE_1000 | NEON_UTF8_SURROGATE, // _D
+    NEON_UTF8_CARRY | NEON_UTF8_TOO_LARGE | NEON_UTF8_TOO_LARGE_1000,
+    NEON_UTF8_CARRY | NEON_UTF8_TOO_LARGE | NEON_UTF8_TOO_LARGE_1000
+};
+
+
+static const uint8_t NEON_UTF8_BYTE2_HIGH[16] ALIGN_NEON = {
+    // 0x0_ - 0x7_: ASCII sau lead byte
+    NEON_UTF8_TOO_SHORT, NEON_UTF8_TOO_SHORT, NEON_UTF8_TOO_SHORT, NEON_UTF8_TOO_SHORT,
+    NEON_UTF8_TOO_SHORT, NEON_UTF8_TOO_SHORT, NEON_UTF8_TOO_SHORT, NEON_UTF8_TOO_SHORT,
+    // 0x8_
+    NEON_UTF8_TOO_LONG | NEON_UTF8_OVERLONG_2 | NEON_UTF8_TWO_CONTS | NEON_UTF8_OVERLONG_3 |
+        NEON_UTF8_TOO_LARGE_1000 | NEON_UTF8_OVERLONG_4,
+    // 0x9_
+    NEON_UTF8_TOO_LONG | NEON_UTF8_OVERLONG_2 | NEON_UTF8_TWO_CONTS | NEON_UTF8_OVERLONG_3 | NEON_UTF8_TOO_LARGE,
+    // 0xA_, 0xB_
+    NEON_UTF8_TOO_LONG | NEON_UTF8_OVERLONG_2 | NEON_UTF8_TWO_CONTS | NEON_UTF8_SURROGATE | NEON_UTF8_TOO_LARGE,
+    NEON_UTF8_TOO_LONG | NEON_UTF8_OVERLONG_2 | NEON_UTF8_TWO_CONTS | NEON_UTF8_SURROGATE | NEON_UTF8_TOO_LARGE,
+    // 0xC_ - 0xF_: lead byte sau lead byte
+    NEON_UTF8_TOO_SHORT, NEON_UTF8_TOO_SHORT, NEON_UTF8_TOO_SHORT, NEON_UTF8_TOO_SHORT
+};
+
+
+/**
+ * Lane cuối của block là lead byte chưa đủ continuation:
+ *   byte 15 >= 0xC0, byte 14 >= 0xE0, byte 13 >= 0xF0
+*/
+static const uint8_t NEON_UTF8_INCOMPLETE_MAX[16] ALIGN_NEON = {
+    255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1
+};
+
+
+
+// VALIDATION
+typedef struct
+{
+    uint8x16_t error; // OR tích lũy
+    uint8x16_t prev_block;
+    uint8x16_t prev_incomplete;
+} NeonUtf8Checker;
+
+
+static NEON_INLINE void neon_utf8_checker_init(NeonUtf8Checker* c) {
+    c->error = vdupq_n_u8(0);
+    c->prev_block = vdupq_n_u8(0);
+    c->prev_incomplete = vdupq_n_u8(0);
+}
+
+
+static NEON_INLINE void neon_utf8_check_block(NeonUtf8Checker* c, uint8x16_t block) {
+    // ASCII fast path
+    if (vmaxvq_u8(block) < 0x80) {
+        c->error = vorrq_u8(c->error, c->prev_incomplete);
+        c->prev_incomplete = vdupq_n_u8(0);
+        c->prev_block = block;
+        return;
+    }
+
+    const uint8x16_t t1 = vld1q_u8(NEON_UTF8_BYTE1_HIGH);
+    const uint8x16_t t2 = vld1q_u8(NEON_UTF8_BYTE1_LOW);
+    const uint8x16_t t3 = vld1q_u8(NEON_UTF8_BYTE2_HIGH);
+
+    uint8x16_t prev1 = vextq_u8(c->prev_block, block, 15);
+    uint8x16_t prev2 = vextq_u8(c->prev_block, block, 14);
+    uint8x16_t prev3 = vextq_u8(c->prev_block, block, 13);
+
+    uint8x16_t special = vandq_u8(
+        vandq_u8(vqtbl1q_u8(t1, vshrq_n_u8(prev1, 4)), vqtbl1q_u8(t2, vandq_u8(prev1, vdupq_n_u8(0x0F)))),
+        vqtbl1q_u8(t3, vshrq_n_u8(block, 4))
+    );
+
+    // Byte thứ 3/4 của sequence dài: bắt buộc TWO_CONTS (0x80), ngoài ra TWO_CONTS là lỗi
+    uint8x16_t must23 = vorrq_u8(vcgeq_u8(prev2, vdupq_n_u8(0xE0)), vcgeq_u8(prev3, vdupq_n_u8(0xF0)));
+    uint8x16_t must23_80 = vandq_u8(must23, vdupq_n_u8(0x80));
+
+    c->error = vorrq_u8(c->error, veorq_u8(must23_80, special));
+    c->prev_incomplete = vcgtq_u8(block, vld1q_u8(NEON_UTF8_INCOMPLETE_MAX));
+    c->prev_block = block;
+}
+
+
+/**
+ * @return: 1 nếu s[0..n) là UTF-8 hợp lệ, 0 nếu không
+*/
+static inline int neon_utf8_validate(const uint8_t* s, size_t n) {
+    NeonUtf8Checker c;
+    neon_utf8_checker_init(&c);
+
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        NEON_PREFETCH(s + i + 512);
+
+        uint8x16_t b0 = vld1q_u8(s + i);
+        uint8x16_t b1 = vld1q_u8(s + i + 16);
+        uint8x16_t b2 = vld1q_u8(s + i + 32);
+        uint8x16_t b3 = vld1q_u8(s + i + 48);
+
+        // 64 bytes ASCII: 1 lần kiểm tra
+        uint8x16_t any = vorrq_u8(vorrq_u8(b0, b1), vorrq_u8(b2, b3));
+        if (vmaxvq_u8(any) < 0x80) {
+            c.error = vorrq_u8(c.error, c.prev_incomplete);
+            c.prev_incomplete = vdupq_n_u8(0);
+            c.prev_block = b3;
+            continue;
+        }
+
+        neon_utf8_check_block(&c, b0);
+        neon_utf8_check_block(&c, b1);
+        neon_utf8_check_block(&c, b2);
+        neon_utf8_check_block(&c, b3);
+    }
+
+    for (; i + 16 <= n; i += 16) {
+        neon_utf8_check_block(&c, vld1q_u8(s + i));
+    }
+
+    if (i < n) {
+        // Tail pad bằng 0 (ASCII) → sequence dở dang bị bắt bởi TOO_SHORT
+        uint8_t tail[16] ALIGN_NEON = {0};
+        memcpy(tail, s + i, n - i);
+        neon_utf8_check_block(&c, vld1q_u8(tail));
+    }
+
+    c.error = vorrq_u8(c.error, c.prev_incomplete);
+    return vmaxvq_u8(c.error) == 0;
+}
+
+
+/**
+ * Số byte ASCII liên tiếp ở đầu s (= n nếu toàn bộ là ASCII)
+*/
+static inline size_t neon_ascii_prefix_length(const uint8_t* s, size_t n) {
+    size_t i = 0;
+
+    for (; i + 64 <= n; i += 64) {
+        uint8x16_t any = vorrq_u8(
+            vorrq_u8(vld1q_u8(s + i), vld1q_u8(s + i + 16)),
+            vorrq_u8(vld1q_u8(s + i + 32), vld1q_u8(s + i + 48))
+        );
+        if (vmaxvq_u8(any) >= 0x80) break;
+    }
+
+    for (; i + 16 <= n; i += 16) {
+        uint64_t mask = neon_mask_u8x16(vcgeq_u8(vld1q_u8(s + i), vdupq_n_u8(0x80)));
+        if (mask) return i + neon_mask_first(mask);
+    }
+
+    for (; i < n; i++) {
+        if (s[i] >= 0x80) return i;
+    }
+
+    return n;
+}
+
+
+static inline int neon_is_ascii(const uint8_t* s, size_t n) {
+    return neon_ascii_prefix_length(s, n) == n;
+}
+
+
+/**
+ * Số code point trong UTF-8 hợp lệ = số byte không phải continuation (0x80-0xBF)
+ * (int8)b > -65 ↔ b không thuộc 0x80..0xBF
+*/
+static inline size_t neon_utf8_count_chars(const uint8_t* s, size_t n) {
+    size_t total = 0;
+    size_t i = 0;
+
+    while (i + 16 <= n) {
+        uint8x16_t acc = vdupq_n_u8(0);
+        size_t blocks = MIN((n - i) / 16, (size_t)255);
+        for (size_t b = 0; b < blocks; b++, i += 16) {
+            int8x16_t v = vreinterpretq_s8_u8(vld1q_u8(s + i));
+            acc = vsubq_u8(acc, vcgtq_s8(v, vdupq_n_s8(-65)));
+        }
+        total += vaddlvq_u8(acc);
+    }
+
+    for (; i < n; i++) {
+        total += ((int8_t)s[i] > -65);
+    }
+
+    return total;
+}
+
+
+
+// SCALAR DECODE / ENCODE
+/**
+ * Decode 1 code point (strict)
+ * @return: số byte đã dùng (1-4), 0 nếu không hợp lệ
+*/
+static inline size_t neon_utf8_decode_one(const uint8_t* p, size_t avail, uint32_t* cp) {
+    uint8_t b0 = p[0];
+
+    if (b0 < 0x80) {
+        *cp = b0;
+        return 1;
+    }
+
+    if (b0 < 0xC2) return 0; // continuation hoặc overlong C0/C1
+
+    if (b0 < 0xE0) {
+        if (avail < 2 || (p[1] & 0xC0) != 0x80) return 0;
+        *cp = ((uint32_t)(b0 & 0x1F) << 6) | (p[1] & 0x3F);
+        return 2;
+    }
+
+    if (b0 < 0xF0) {
+        if (avail < 3 || (p[1] & 0xC0) != 0x80 || (p[2] & 0xC0) != 0x80) return 0;
+        uint32_t c = ((uint32_t)(b0 & 0x0F) << 12) | ((uint32_t)(p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+        if (c < 0x800 || (c >= 0xD800 && c <= 0xDFFF)) return 0;
+        *cp = c;
+        return 3;
+    }
+
+    if (b0 < 0xF5) {
+        if (avail < 4 || (p[1] & 0xC0) != 0x80 || (p[2] & 0xC0) != 0x80 || (p[3] & 0xC0) != 0x80) return 0;
+        uint32_t c = ((uint32_t)(b0 & 0x07) << 18) | ((uint32_t)(p[1] & 0x3F) << 12) |
+                     ((uint32_t)(p[2] & 0x3F) << 6) | (p[3] & 0x3F);
+        if (c < 0x10000 || c > 0x10FFFF) return 0;
+        *cp = c;
+        return 4;
+    }
+
+    return 0;
+}
+
+
+/**
+ * Encode 1 code point (caller đảm bảo hợp lệ)
+ * @return: số byte ghi ra
+*/
+static NEON_INLINE size_t neon_utf8_encode_one(uint32_t c, uint8_t* out) {
+    if (c < 0x80) {
+        out[0] = (uint8_t)c;
+        return 1;
+    }
+    if (c < 0x800) {
+        out[0] = (uint8_t)(0xC0 | (c >> 6));
+        out[1] = (uint8_t)(0x80 | (c & 0x3F));
+        return 2;
+    }
+    if (c < 0x10000) {
+        out[0] = (uint8_t)(0xE0 | (c >> 12));
+        out[1] = (uint8_t)(0x80 | ((c >> 6) & 0x3F));
+        out[2] = (uint8_t)(0x80 | (c & 0x3F));
+        return 3;
+    }
+    out[0] = (uint8_t)(0xF0 | (c >> 18));
+    out[1] = (uint8_t)(0x80 | ((c >> 12) & 0x3F));
+    out[2] = (uint8_t)(0x80 | ((c >> 6) & 0x3F));
+    out[3] = (uint8_t)(0x80 | (c & 0x3F));
+    return 4;
+}
+
+
+
+// UTF-8 → UTF-16 / UTF-32
+/**
+ * @param dst: tối thiểu n phần tử
+ * @param out_len: số code units ghi ra
+ * @return: NEON_SUCCESS hoặc NEON_ERROR_INVALID_PARAM nếu input không hợp lệ
+*/
+static inline int neon_utf8_to_utf32(const uint8_t* src, size_t n, uint32_t* dst, size_t* out_len) {
+    if (src == NULL || dst == NULL || out_len == NULL) return NEON_ERROR_NULL_POINTER;
+
+    size_t i = 0;
+    size_t o = 0;
+
+    while (i < n) {
+        if (i + 16 <= n) {
+            uint8x16_t v = vld1q_u8(src + i);
+            if (vmaxvq_u8(v) < 0x80) {
+                uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+                uint16x8_t hi = vmovl_high_u8(v);
+                vst1q_u32(dst + o, vmovl_u16(vget_low_u16(lo)));
+                vst1q_u32(dst + o + 4, vmovl_high_u16(lo));
+                vst1q_u32(dst + o + 8, vmovl_u16(vget_low_u16(hi)));
+                vst1q_u32(dst + o + 12, vmovl_high_u16(hi));
+                i += 16;
+                o += 16;
+                continue;
+            }
+        }
+
+        // Decode tới hết block 16 bytes hiện tại (sequence có thể vượt qua biên block)
+        size_t block_end = MIN(i + 16, n);
+        while (i < block_end) {
+            uint32_t cp;
+            size_t len = neon_utf8_decode_one(src + i, n - i, &cp);
+            if (len == 0) {
+                *out_len = o;
+                return NEON_ERROR_INVALID_PARAM;
+            }
+            dst[o++] = cp;
+            i += len;
+        }
+    }
+
+    *out_len = o;
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * Code point > U+FFFF → surrogate pair
+ * @param dst: tối thiểu n phần tử
+*/
+static inline int neon_utf8_to_utf16(const uint8_t* src, size_t n, uint16_t* dst, size_t* out_len) {
+    if (src == NULL || dst == NULL || out_len == NULL) return NEON_ERROR_NULL_POINTER;
+
+    size_t i = 0;
+    size_t o = 0;
+
+    while (i < n) {
+        if (i + 16 <= n) {
+            uint8x16_t v = vld1q_u8(src + i);
+            if (vmaxvq_u8(v) < 0x80) {
+                vst1q_u16(dst + o, vmovl_u8(vget_low_u8(v)));
+                vst1q_u16(dst + o + 8, vmovl_high_u8(v));
+                i += 16;
+                o += 16;
+                continue;
+            }
+        }
+
+        size_t block_end = MIN(i + 16, n);
+        while (i < block_end) {
+            uint32_t cp;
+            size_t len = neon_utf8_decode_one(src + i, n - i, &cp);
+            if (len == 0) {
+                *out_len = o;
+                return NEON_ERROR_INVALID_PARAM;
+            }
+            if (cp < 0x10000) {
+                dst[o++] = (uint16_t)cp;
+            } else {
+                cp -= 0x10000;
+                dst[o++] = (uint16_t)(0xD800 | (cp >> 10));
+                dst[o++] = (uint16_t)(0xDC00 | (cp & 0x3FF));
+            }
+            i += len;
+        }
+    }
+
+    *out_len = o;
+    return NEON_SUCCESS;
+}
+
+
+
+// UTF-16 / UTF-32 → UTF-8
+/**
+ * @param dst: tối thiểu 3n bytes
+ * @return: NEON_ERROR_INVALID_PARAM nếu có surrogate không thành cặp
+*/
+static inline int neon_utf16_to_utf8(const uint16_t* src, size_t n, uint8_t* dst, size_t* out_len) {
+    if (src == NULL || dst == NULL || out_len == NULL) return NEON_ERROR_NULL_POINTER;
+
+    size_t i = 0;
+    size_t o = 0;
+
+    while (i < n) {
+        if (i + 8 <= n) {
+            uint16x8_t v = vld1q_u16(src + i);
+            if (vmaxvq_u16(v) < 0x80) {
+                vst1_u8(dst + o, vmovn_u16(v));
+                i += 8;
+                o += 8;
+                continue;
+            }
+        }
+
+        size_t block_end = MIN(i + 8, n);
+        while (i < block_end) {
+            uint32_t c = src[i++];
+
+            if (c >= 0xD800 && c <= 0xDFFF) {
+                if (c >= 0xDC00 || i >= n || src[i] < 0xDC00 || src[i] > 0xDFFF) {
+                    *out_len = o;
+                    return NEON_ERROR_INVALID_PARAM;
+                }
+                c = 0x10000 + ((c - 0xD800) << 10) + (src[i++] - 0xDC00);
+            }
+
+            o += neon_utf8_encode_one(c, dst + o);
+        }
+    }
+
+    *out_len = o;
+    return NEON_SUCCESS;
+}
+
+
+/**
+ * @param dst: tối thiểu 4n bytes
+ * @return: NEON_ERROR_INVALID_PARAM nếu có surrogate hoặc code point > U+10FFFF
+*/
+static inline int neon_utf32_to_utf8(const uint32_t* src, size_t n, uint8_t* dst, size_t* out_len) {
+    if (src == NULL || dst == NULL || out_len == NULL) return NEON_ERROR_NULL_POINTER;
+
+    size_t i = 0;
+    size_t o = 0;
+
+    while (i < n) {
+        if (i + 8 <= n) {
+            uint32x4_t a = vld1q_u32(src + i);
+            uint32x4_t b = vld1q_u32(src + i + 4);
+            if (vmaxvq_u32(vorrq_u32(a, b)) < 0x80) {
+                uint16x8_t w = vcombine_u16(vmovn_u32(a), vmovn_u32(b));
+                vst1_u8(dst + o, vmovn_u16(w));
+                i += 8;
+                o += 8;
+                continue;
+            }
+        }
+
+        size_t block_end = MIN(i + 8, n);
+        for (; i < block_end; i++) {
+            uint32_t c = src[i];
+            if (c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF)) {
+                *out_len = o;
+                return NEON_ERROR_INVALID_PARAM;
+            }
+            o += neon_utf8_encode_one(c, dst + o);
+        }
+    }
+
+    *out_len = o;
+    return NEON_SUCCESS;
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NEON_UTF8_H
@@ -0,0 +1,115 @@
+/**
+ * Benchmark neon_accumulate.h: thời gian + sai số của các cách cộng dồn fp32
+ *
+ * sum: fp32 / pairwise / Kahan / fp64 accumulator
+ * dot: fp32 (neon_inner_product_f32) / Dot2 (Kahan) / fp64 accumulator
+ * 2 kích thước: nằm trong L1/L2 (đo chi phí tính toán) và lớn hơn LLC (đo giới hạn bandwidth)
+ *
+ * Build (aarch64):
+ *   cc -O3 -I.. bench_accumulate.c -o bench_accumulate -lpthread -lm
+ *   ./bench_accumulate [large_n]
+ *
+ * KHÔNG build với -ffast-math (xoá compensation của Kahan)
+*/
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 199309L
+#endif
+#include "neon_accumulate.h"
+#include "neon_distance.h"
+#include "memory_align.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+
+static volatile double sink;
+
+#define BENCH_MIN_TIME 0.25
+
+
+typedef double (*SumFn)(const float* a, const float* b, size_t n);
+
+static double run_sum_f32(const float* a, const float* b, size_t n) { (void)b; return neon_sum_f32(a, n); }
+static double run_sum_pairwise(const float* a, const float* b, size_t n) { (void)b; return neon_sum_f32_pairwise(a, n); }
+static double run_sum_kahan(const float* a, const float* b, size_t n) { (void)b; return neon_sum_f32_kahan(a, n); }
+static double run_sum_f64acc(const float* a, const float* b, size_t n) { (void)b; return neon_sum_f32_f64acc(a, n); }
+static double run_dot_f32(const float* a, const float* b, size_t n) { return neon_inner_product_f32(a, b, n); }
+static double run_dot_kahan(const float* a, const float* b, size_t n) { return neon_dot_product_kahan(a, b, n); }
+static double run_dot_f64acc(const float* a, const float* b, size_t n) { return neon_dot_product_f64acc(a, b, n); }
+
+
+/**
+ * Lặp đến khi đủ BENCH_MIN_TIME, in ns / element, GB/s và sai số tương đối so với reference
+*/
+static void bench(const char* name, SumFn fn, const float* a, const float* b, size_t n, int streams, long double ref) {
+    double result = fn(a, b, n); // warm-up
+    size_t reps = 0;
+    double t0 = now_sec(), t;
+
+    do {
+        sink = fn(a, b, n);
+        reps++;
+        t = now_sec() - t0;
+    } while (t < BENCH_MIN_TIME);
+
+    double per_call = t / (double)reps;
+    double bytes = (double)n * sizeof(float) * (double)streams;
+    double rel = (ref != 0.0L) ? (double)fabsl(((long double)result - ref) / ref) : fabs(result);
+
+    printf("  %-14s %8.3f ns/elem %8.2f GB/s   rel err %.2e\n",
+           name, per_call * 1e9 / (double)n, bytes / per_call * 1e-9, rel);
+}
+
+
+static void run_size(const float* a, const float* b, size_t n) {
+    long double ref_sum = 0.0L, ref_dot = 0.0L;
+    for (size_t i = 0; i < n; i++) {
+        ref_sum += a[i];
+        ref_dot += (long double)a[i] * b[i];
+    }
+
+    printf("n = %zu (%.1f MiB / array)\n", n, (double)n * sizeof(float) / (1024.0 * 1024.0));
+    bench("sum fp32", run_sum_f32, a, b, n, 1, ref_sum);
+    bench("sum pairwise", run_sum_pairwise, a, b, n, 1, ref_sum);
+    bench("sum kahan", run_sum_kahan, a, b, n, 1, ref_sum);
+    bench("sum f64acc", run_sum_f64acc, a, b, n, 1, ref_sum);
+    bench("dot fp32", run_dot_f32, a, b, n, 2, ref_dot);
+    bench("dot kahan", run_dot_kahan, a, b, n, 2, ref_dot);
+    bench("dot f64acc", run_dot_f64acc, a, b, n, 2, ref_dot);
+    printf("\n");
+}
+
+
+int main(int argc, char** argv) {
+    size_t large = (argc > 1) ? (size_t)atol(argv[1]) : ((size_t)1 << 25);
+    size_t small = 8192;
+    size_t cap = MAX(large, small);
+
+    float* a = (float*)neon_malloc(cap * sizeof(float));
+    float* b = (float*)neon_malloc(cap * sizeof(float));
+    if (a == NULL || b == NULL) {
+        printf("out of memory\n");
+        return 1;
+    }
+
+    // Giá trị dương quanh 1 (sum fp32 trôi rõ rệt) và b có dấu (dot bị triệt tiêu)
+    srand(1);
+    for (size_t i = 0; i < cap; i++) {
+        a[i] = 1.0f + (float)(rand() % 1000) * 1e-4f;
+        b[i] = (float)(rand() % 2001 - 1000) * 1e-3f;
+    }
+
+    run_size(a, b, small);
+    run_size(a, b, large);
+
+    neon_free(a);
+    neon_free(b);
+    return 0;
+}
@@ -0,0 +1,166 @@
+/**
+ * Benchmark neon_bytes.h so với glibc
+ *
+ *   neon_memchr            vs memchr
+ *   neon_memchr2 / 3       vs strpbrk (cùng tập ký tự, buffer kết thúc bằng '\0')
+ *   neon_find_any_of       vs strpbrk
+ *   neon_count_newlines    vs vòng lặp memchr
+ *   neon_memcmp            vs memcmp (2 buffer bằng nhau → so sánh hết)
+ *
+ * Ký tự cần tìm đặt ở byte cuối → mọi hàm đều quét toàn bộ buffer
+ * Kích thước từ 16 bytes (chi phí gọi hàm / setup) đến lớn hơn LLC (bandwidth)
+ *
+ * Build (aarch64):
+ *   cc -O3 -I.. bench_bytes.c -o bench_bytes && ./bench_bytes [max_size]
+*/
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 199309L
+#endif
+#include "neon_bytes.h"
+#include "memory_align.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+
+#define BENCH_MIN_TIME 0.1
+
+static volatile size_t sink;
+
+// volatile → compiler không hoist được memchr / strpbrk ra khỏi vòng lặp đo
+static const uint8_t* volatile g_text;
+static const uint8_t* volatile g_lines;
+static const uint8_t* volatile g_copy;
+static volatile size_t g_n;
+static NeonByteSet g_set;
+
+static const char SET_CHARS[] = ",\"\r\n";
+
+
+static size_t b_neon_memchr(void) { return neon_memchr(g_text, ',', g_n); }
+static size_t b_glibc_memchr(void) {
+    const uint8_t* p = (const uint8_t*)memchr(g_text, ',', g_n);
+    return p ? (size_t)(p - g_text) : g_n;
+}
+static size_t b_neon_memchr2(void) { return neon_memchr2(g_text, ',', '\n', g_n); }
+static size_t b_neon_memchr3(void) { return neon_memchr3(g_text, ',', '\n', '"', g_n); }
+static size_t b_neon_any_of(void) { return neon_find_any_of(g_text, g_n, &g_set); }
+static size_t b_glibc_strpbrk2(void) {
+    const char* p = strpbrk((const char*)g_text, ",\n");
+    return p ? (size_t)((const uint8_t*)p - g_text) : g_n;
+}
+static size_t b_glibc_strpbrk3(void) {
+    const char* p = strpbrk((const char*)g_text, ",\n\"");
+    return p ? (size_t)((const uint8_t*)p - g_text) : g_n;
+}
+static size_t b_glibc_strpbrk4(void) {
+    const char* p = strpbrk((const char*)g_text, SET_CHARS);
+    return p ? (size_t)((const uint8_t*)p - g_text) : g_n;
+}
+static size_t b_neon_count_newlines(void) { return neon_count_newlines(g_lines, g_n); }
+static size_t b_glibc_count_newlines(void) {
+    const uint8_t* p = g_lines;
+    const uint8_t* end = p + g_n;
+    size_t count = 0;
+    while (p < end) {
+        const uint8_t* nl = (const uint8_t*)memchr(p, '\n', (size_t)(end - p));
+        if (nl == NULL) break;
+        count++;
+        p = nl + 1;
+    }
+    return count;
+}
+static size_t b_neon_memcmp(void) { return (size_t)neon_memcmp(g_text, g_copy, g_n); }
+static size_t b_glibc_memcmp(void) { return (size_t)memcmp(g_text, g_copy, g_n); }
+
+
+/**
+ * @return: ns / call
+*/
+static double time_fn(size_t (*fn)(void)) {
+    sink = fn(); // warm-up
+    size_t reps = 0;
+    double t0 = now_sec(), t;
+
+    do {
+        for (int r = 0; r < 16; r++) sink = fn();
+        reps += 16;
+        t = now_sec() - t0;
+    } while (t < BENCH_MIN_TIME);
+
+    return t / (double)reps * 1e9;
+}
+
+
+static void compare(const char* name, size_t (*neon_fn)(void), size_t (*glibc_fn)(void), size_t n) {
+    size_t r0 = neon_fn(), r1 = glibc_fn();
+    if (r0 != r1 && strcmp(name, "memcmp") != 0) {
+        printf("  %-16s MISMATCH neon=%zu glibc=%zu\n", name, r0, r1);
+        return;
+    }
+
+    double tn = time_fn(neon_fn);
+    double tg = time_fn(glibc_fn);
+    printf("  %-16s neon %10.1f ns (%6.2f GB/s)   glibc %10.1f ns (%6.2f GB/s)   ratio %5.2fx\n",
+           name, tn, (double)n / tn, tg, (double)n / tg, tg / tn);
+}
+
+
+int main(int argc, char** argv) {
+    size_t max_size = (argc > 1) ? (size_t)atol(argv[1]) : ((size_t)64 << 20);
+
+    uint8_t* text = (uint8_t*)neon_malloc(max_size + 1);
+    uint8_t* lines = (uint8_t*)neon_malloc(max_size + 1);
+    uint8_t* copy = (uint8_t*)neon_malloc(max_size + 1);
+    if (text == NULL || lines == NULL || copy == NULL) {
+        printf("out of memory\n");
+        return 1;
+    }
+
+    // text: chữ thường, không chứa ký tự cần tìm; lines: 1 '\n' mỗi 80 bytes
+    for (size_t i = 0; i < max_size; i++) {
+        text[i] = (uint8_t)('a' + i % 26);
+        lines[i] = (i % 80 == 79) ? '\n' : (uint8_t)('a' + i % 26);
+    }
+    memcpy(copy, text, max_size);
+    neon_byteset_init(&g_set, (const uint8_t*)SET_CHARS, strlen(SET_CHARS));
+
+    g_text = text;
+    g_lines = lines;
+    g_copy = copy;
+
+    for (size_t n = 16; n <= max_size; n *= 4) {
+        // Match ở byte cuối, '\0' ngay sau cho strpbrk
+        uint8_t saved = text[n - 1];
+        text[n - 1] = ',';
+        copy[n - 1] = ',';
+        text[n] = '\0';
+        g_n = n;
+
+        printf("n = %zu bytes\n", n);
+        compare("memchr", b_neon_memchr, b_glibc_memchr, n);
+        compare("memchr2", b_neon_memchr2, b_glibc_strpbrk2, n);
+        compare("memchr3", b_neon_memchr3, b_glibc_strpbrk3, n);
+        compare("find_any_of", b_neon_any_of, b_glibc_strpbrk4, n);
+        compare("count_newlines", b_neon_count_newlines, b_glibc_count_newlines, n);
+        compare("memcmp", b_neon_memcmp, b_glibc_memcmp, n);
+        printf("\n");
+
+        text[n - 1] = saved;
+        copy[n - 1] = saved;
+        text[n] = (n < max_size) ? (uint8_t)('a' + n % 26) : 0;
+    }
+
+    neon_free(text);
+    neon_free(lines);
+    neon_free(copy);
+    return 0;
+}
@@ -0,0 +1,126 @@
+/**
+ * Benchmark HNSW: recall@k và QPS so với brute force (neon_knn_brute_force làm ground truth)
+ *
+ * Build index trên n vectors ngẫu nhiên, quét ef, in recall@k / QPS của search_batch
+ * và QPS của brute force để so sánh
+ *
+ * Build (aarch64):
+ *   cc -O3 -I.. bench_hnsw.c -o bench_hnsw -lpthread -lm
+ *   ./bench_hnsw [n] [dim] [nq] [k] [threads] [metric: 0 = L2, 1 = IP]
+*/
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 199309L
+#endif
+#include "neon_hnsw.h"
+#include "neon_random.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+
+static void normalize_rows(float* x, size_t n, size_t dim) {
+    for (size_t i = 0; i < n; i++) {
+        float s = sqrtf(neon_norm_sq_f32(x + i * dim, dim));
+        if (s > 0.0f) {
+            for (size_t j = 0; j < dim; j++) x[i * dim + j] /= s;
+        }
+    }
+}
+
+
+int main(int argc, char** argv) {
+    size_t n = (argc > 1) ? (size_t)atol(argv[1]) : 100000;
+    size_t dim = (argc > 2) ? (size_t)atol(argv[2]) : 64;
+    size_t nq = (argc > 3) ? (size_t)atol(argv[3]) : 1000;
+    size_t k = (argc > 4) ? (size_t)atol(argv[4]) : 10;
+    int threads = (argc > 5) ? atoi(argv[5]) : neon_num_threads();
+    DistanceMetric metric = (argc > 6 && atoi(argv[6]) == 1) ? DISTANCE_IP : DISTANCE_L2;
+
+    const size_t M = 16;
+    const size_t ef_construction = 200;
+    const size_t ef_values[] = {10, 20, 40, 80, 160, 320};
+    const size_t num_ef = sizeof(ef_values) / sizeof(ef_values[0]);
+
+    float* base = (float*)neon_malloc(n * dim * sizeof(float));
+    float* queries = (float*)neon_malloc(nq * dim * sizeof(float));
+    float* exact_dist = (float*)neon_malloc(nq * k * sizeof(float));
+    int32_t* exact_ids = (int32_t*)neon_malloc(nq * k * sizeof(int32_t));
+    float* dist = (float*)neon_malloc(nq * k * sizeof(float));
+    int32_t* ids = (int32_t*)neon_malloc(nq * k * sizeof(int32_t));
+    if (base == NULL || queries == NULL || exact_dist == NULL || exact_ids == NULL || dist == NULL || ids == NULL) {
+        printf("out of memory\n");
+        return 1;
+    }
+
+    NeonPhilox rng;
+    neon_philox_init(&rng, 42, 0);
+    neon_random_normal_f32(&rng, base, n * dim, 0.0f, 1.0f, threads);
+    neon_random_normal_f32(&rng, queries, nq * dim, 0.0f, 1.0f, threads);
+    if (metric == DISTANCE_IP) {
+        normalize_rows(base, n, dim);
+        normalize_rows(queries, nq, dim);
+    }
+
+    printf("n=%zu dim=%zu nq=%zu k=%zu threads=%d metric=%s M=%zu ef_construction=%zu\n",
+           n, dim, nq, k, threads, metric == DISTANCE_IP ? "IP" : "L2", M, ef_construction);
+
+    // Ground truth
+    double t0 = now_sec();
+    for (size_t q = 0; q < nq; q++) {
+        size_t count = neon_knn_brute_force(metric, queries + q * dim, base, n, dim, k,
+                                            exact_dist + q * k, exact_ids + q * k, threads);
+        for (size_t j = count; j < k; j++) exact_ids[q * k + j] = -1;
+    }
+    double brute_time = now_sec() - t0;
+    printf("brute force: %.3f s, QPS %.0f\n", brute_time, (double)nq / brute_time);
+
+    // Build
+    NeonHnsw h;
+    int err = neon_hnsw_create(&h, dim, metric, M, ef_construction, n, 1234);
+    if (err != NEON_SUCCESS) {
+        printf("create failed: %d\n", err);
+        return 1;
+    }
+
+    t0 = now_sec();
+    err = neon_hnsw_add(&h, base, n, threads);
+    double build_time = now_sec() - t0;
+    if (err != NEON_SUCCESS) {
+        printf("build failed: %d\n", err);
+        return 1;
+    }
+    printf("build: %.3f s (%.0f inserts/s), max_level=%d\n", build_time, (double)n / build_time, h.max_level);
+
+    // Sweep ef
+    printf("\n%6s %10s %12s %12s\n", "ef", "recall@k", "QPS", "speedup");
+    for (size_t e = 0; e < num_ef; e++) {
+        size_t ef = MAX(ef_values[e], k);
+
+        t0 = now_sec();
+        err = neon_hnsw_search_batch(&h, queries, nq, k, ef, dist, ids, threads);
+        double t = now_sec() - t0;
+        if (err != NEON_SUCCESS) {
+            printf("search failed: %d\n", err);
+            return 1;
+        }
+
+        float recall = neon_hnsw_recall(ids, exact_ids, nq, k);
+        printf("%6zu %10.4f %12.0f %11.1fx\n", ef, recall, (double)nq / t, brute_time / t);
+    }
+
+    neon_hnsw_destroy(&h);
+    neon_free(base);
+    neon_free(queries);
+    neon_free(exact_dist);
+    neon_free(exact_ids);
+    neon_free(dist);
+    neon_free(ids);
+    return 0;
+}
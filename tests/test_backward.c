@@ -0,0 +1,270 @@
+/**
+ * Gradient check (central difference) cho các backward kernels trong neon_backward.h
+ *
+ * Loss = Σ w ⊙ f(x) với w ngẫu nhiên cố định → dy = w
+ * Kích thước lẻ (d = 13, n = 39) để chạy cả phần tail scalar
+ *
+ * Build (aarch64):
+ *   cc -O2 -I.. test_backward.c -o test_backward -lpthread -lm && ./test_backward
+*/
+#include "neon_backward.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+
+#define GC_H 1e-3f
+#define GC_TOL 2e-3f
+
+static int failures = 0;
+
+
+static float frand(void) {
+    return (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+
+static void fill(float* x, size_t n, float scale) {
+    for (size_t i = 0; i < n; i++) x[i] = frand() * scale;
+}
+
+
+static double weighted_sum(const float* y, const float* w, size_t n) {
+    double s = 0.0;
+    for (size_t i = 0; i < n; i++) s += (double)y[i] * w[i];
+    return s;
+}
+
+
+static void report(const char* name, float err) {
+    printf("%-20s max rel err %.2e\n", name, err);
+    if (!(err <= GC_TOL)) {
+        printf("FAIL %s\n", name);
+        failures++;
+    }
+}
+
+
+
+// ACTIVATIONS
+typedef struct {
+    void (*forward)(const float*, float*, size_t);
+    size_t n;
+    const float* w;
+    float* y;
+} ActCtx;
+
+
+static float act_loss(void* arg, const float* x) {
+    ActCtx* c = (ActCtx*)arg;
+    c->forward(x, c->y, c->n);
+    return (float)weighted_sum(c->y, c->w, c->n);
+}
+
+
+static void test_activations(void) {
+    enum { N = 39 };
+    struct {
+        const char* name;
+        void (*forward)(const float*, float*, size_t);
+        void (*backward)(const float*, const float*, float*, size_t);
+    } acts[] = {
+        {"relu", neon_relu_f32, neon_relu_backward_f32},
+        {"gelu", neon_gelu_f32, neon_gelu_backward_f32},
+        {"silu", neon_silu_f32, neon_silu_backward_f32},
+    };
+
+    for (size_t a = 0; a < sizeof(acts) / sizeof(acts[0]); a++) {
+        float x[N], w[N], dx[N], y[N];
+        fill(x, N, 4.0f);
+        fill(w, N, 1.0f);
+        // relu không khả vi tại 0: tránh điểm gần kink
+        for (size_t i = 0; i < N; i++) {
+            if (fabsf(x[i]) < 0.05f) x[i] = 0.5f;
+        }
+
+        acts[a].backward(x, w, dx, N);
+        ActCtx c = {acts[a].forward, N, w, y};
+        report(acts[a].name, neon_gradient_check(act_loss, &c, x, N, dx, GC_H, 0));
+    }
+}
+
+
+
+// SOFTMAX
+typedef struct {
+    size_t m, n;
+    const float* w;
+    float* y;
+} SoftmaxCtx;
+
+
+static float softmax_loss(void* arg, const float* x) {
+    SoftmaxCtx* c = (SoftmaxCtx*)arg;
+    neon_softmax_f32(x, c->y, c->m, c->n);
+    return (float)weighted_sum(c->y, c->w, c->m * c->n);
+}
+
+
+static void test_softmax(void) {
+    enum { M = 3, D = 13 };
+    float x[M * D], w[M * D], y[M * D], dx[M * D];
+    fill(x, M * D, 3.0f);
+    fill(w, M * D, 1.0f);
+
+    neon_softmax_f32(x, y, M, D);
+    neon_softmax_backward_f32(y, w, dx, M, D);
+
+    SoftmaxCtx c = {M, D, w, y};
+    report("softmax", neon_gradient_check(softmax_loss, &c, x, M * D, dx, GC_H, 0));
+}
+
+
+typedef struct {
+    size_t m, c;
+    const int32_t* labels;
+} CrossEntropyCtx;
+
+
+static float ce_loss(void* arg, const float* z) {
+    CrossEntropyCtx* c = (CrossEntropyCtx*)arg;
+    return neon_softmax_cross_entropy_f32(z, c->labels, c->m, c->c, NULL);
+}
+
+
+static void test_softmax_cross_entropy(void) {
+    enum { M = 5, C = 13 };
+    float z[M * C], dz[M * C];
+    int32_t labels[M];
+    fill(z, M * C, 3.0f);
+    for (size_t i = 0; i < M; i++) labels[i] = rand() % C;
+
+    neon_softmax_cross_entropy_f32(z, labels, M, C, dz);
+
+    CrossEntropyCtx c = {M, C, labels};
+    report("softmax_ce", neon_gradient_check(ce_loss, &c, z, M * C, dz, GC_H, 0));
+}
+
+
+
+// NORMS
+typedef struct {
+    size_t m, d;
+    const float* x;
+    const float* gamma;
+    const float* beta;
+    const float* w;
+    int wrt; // 0 = x, 1 = gamma
+    int rms;
+    float* y;
+    float* mean;
+    float* rstd;
+} NormCtx;
+
+
+static float norm_loss(void* arg, const float* p) {
+    NormCtx* c = (NormCtx*)arg;
+    const float* x = (c->wrt == 0) ? p : c->x;
+    const float* gamma = (c->wrt == 1) ? p : c->gamma;
+
+    if (c->rms) neon_rmsnorm_f32(x, gamma, 1e-5f, c->y, c->rstd, c->m, c->d);
+    else neon_layernorm_f32(x, gamma, c->beta, 1e-5f, c->y, c->mean, c->rstd, c->m, c->d);
+    return (float)weighted_sum(c->y, c->w, c->m * c->d);
+}
+
+
+static void test_norms(void) {
+    enum { M = 3, D = 13 };
+
+    for (int rms = 0; rms <= 1; rms++) {
+        float x[M * D], gamma[D], beta[D], w[M * D], y[M * D], mean[M], rstd[M];
+        float dx[M * D], dgamma[D], dbeta[D];
+        fill(x, M * D, 2.0f);
+        fill(gamma, D, 1.0f);
+        fill(beta, D, 1.0f);
+        fill(w, M * D, 1.0f);
+        memset(dgamma, 0, sizeof(dgamma));
+        memset(dbeta, 0, sizeof(dbeta));
+
+        if (rms) {
+            neon_rmsnorm_f32(x, gamma, 1e-5f, y, rstd, M, D);
+            neon_rmsnorm_backward_f32(w, x, gamma, rstd, dx, dgamma, M, D);
+        } else {
+            neon_layernorm_f32(x, gamma, beta, 1e-5f, y, mean, rstd, M, D);
+            neon_layernorm_backward_f32(w, x, gamma, mean, rstd, dx, dgamma, dbeta, M, D);
+        }
+
+        NormCtx c = {M, D, x, gamma, beta, w, 0, rms, y, mean, rstd};
+        report(rms ? "rmsnorm dx" : "layernorm dx", neon_gradient_check(norm_loss, &c, x, M * D, dx, GC_H, 0));
+        c.wrt = 1;
+        report(rms ? "rmsnorm dgamma" : "layernorm dgamma", neon_gradient_check(norm_loss, &c, gamma, D, dgamma, GC_H, 0));
+    }
+}
+
+
+
+// LINEAR
+typedef struct {
+    size_t m, k, n;
+    const float* X;
+    const float* W;
+    const float* b;
+    const float* w;
+    int wrt; // 0 = X, 1 = W, 2 = b
+} LinearCtx;
+
+
+static float linear_loss(void* arg, const float* p) {
+    LinearCtx* c = (LinearCtx*)arg;
+    const float* X = (c->wrt == 0) ? p : c->X;
+    const float* W = (c->wrt == 1) ? p : c->W;
+    const float* b = (c->wrt == 2) ? p : c->b;
+
+    double s = 0.0;
+    for (size_t i = 0; i < c->m; i++) {
+        for (size_t j = 0; j < c->n; j++) {
+            double y = b[j];
+            for (size_t q = 0; q < c->k; q++) y += (double)X[i * c->k + q] * W[q * c->n + j];
+            s += y * c->w[i * c->n + j];
+        }
+    }
+    return (float)s;
+}
+
+
+static void test_linear(void) {
+    enum { M = 5, K = 13, N = 7 };
+    float X[M * K], W[K * N], b[N], w[M * N];
+    float dX[M * K], dW[K * N], db[N];
+    fill(X, M * K, 1.0f);
+    fill(W, K * N, 1.0f);
+    fill(b, N, 1.0f);
+    fill(w, M * N, 1.0f);
+    memset(dW, 0, sizeof(dW));
+    memset(db, 0, sizeof(db));
+
+    if (neon_linear_backward_f32(w, X, W, dX, dW, db, M, K, N, 2) != NEON_SUCCESS) {
+        printf("FAIL linear backward error\n");
+        failures++;
+        return;
+    }
+
+    LinearCtx c = {M, K, N, X, W, b, w, 0};
+    report("linear dX", neon_gradient_check(linear_loss, &c, X, M * K, dX, GC_H, 0));
+    c.wrt = 1;
+    report("linear dW", neon_gradient_check(linear_loss, &c, W, K * N, dW, GC_H, 0));
+    c.wrt = 2;
+    report("linear db", neon_gradient_check(linear_loss, &c, b, N, db, GC_H, 0));
+}
+
+
+int main(void) {
+    srand(8);
+    test_activations();
+    test_softmax();
+    test_softmax_cross_entropy();
+    test_norms();
+    test_linear();
+
+    printf("%s (%d failures)\n", failures == 0 ? "OK" : "FAILED", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+/**
+ * Test neon_csv_parse_f32: dòng trống với 1 cột, ký tự lạ sau quote đóng
+ *
+ * Build (aarch64):
+ *   cc -O2 -I.. test_csv.c -o test_csv -lpthread -lm && ./test_csv
+*/
+#include "neon_csv.h"
+#include <stdio.h>
+#include <string.h>
+
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+            failures++; \
+        } \
+    } while (0)
+
+
+static int parse(const char* text, char delimiter, AlignedBuffer* cols, size_t num_columns, size_t* rows) {
+    for (size_t i = 0; i < num_columns; i++) cols[i] = aligned_buffer_create(0);
+    return neon_csv_parse_f32(text, strlen(text), delimiter, 0, cols, num_columns, rows);
+}
+
+
+static void destroy(AlignedBuffer* cols, size_t num_columns) {
+    for (size_t i = 0; i < num_columns; i++) aligned_buffer_destroy(&cols[i]);
+}
+
+
+static void test_single_column_empty_line(void) {
+    AlignedBuffer col[1];
+    size_t rows = 0;
+
+    CHECK(parse("1.5\n\n3\n\r\n-2\n", ',', col, 1, &rows) == NEON_SUCCESS);
+    CHECK(rows == 5);
+    CHECK(col[0].size == 5);
+    if (col[0].size == 5) {
+        CHECK(col[0].data[0] == 1.5f);
+        CHECK(isnan(col[0].data[1]));
+        CHECK(col[0].data[2] == 3.0f);
+        CHECK(isnan(col[0].data[3]));
+        CHECK(col[0].data[4] == -2.0f);
+    }
+    destroy(col, 1);
+}
+
+
+static void test_multi_column_blank_line_skipped(void) {
+    AlignedBuffer cols[2];
+    size_t rows = 0;
+
+    CHECK(parse("1,2\n\n3,4\n", ',', cols, 2, &rows) == NEON_SUCCESS);
+    CHECK(rows == 2);
+    CHECK(cols[0].size == 2 && cols[1].size == 2);
+    destroy(cols, 2);
+}
+
+
+static void test_quoted_fields(void) {
+    AlignedBuffer cols[2];
+    size_t rows = 0;
+
+    CHECK(parse("\"1.5\" ,\"2\"\r\n\"3\",4\n", ',', cols, 2, &rows) == NEON_SUCCESS);
+    CHECK(rows == 2);
+    if (cols[0].size == 2 && cols[1].size == 2) {
+        CHECK(cols[0].data[0] == 1.5f && cols[1].data[0] == 2.0f);
+        CHECK(cols[0].data[1] == 3.0f && cols[1].data[1] == 4.0f);
+    }
+    destroy(cols, 2);
+
+    CHECK(parse("\"abc\"xyz,1\n", ',', cols, 2, &rows) == NEON_ERROR_INVALID_PARAM);
+    destroy(cols, 2);
+
+    CHECK(parse("1,\"2\"x\n", ',', cols, 2, &rows) == NEON_ERROR_INVALID_PARAM);
+    destroy(cols, 2);
+
+    CHECK(parse("\"2\"x", ',', cols, 1, &rows) == NEON_ERROR_INVALID_PARAM);
+    destroy(cols, 1);
+}
+
+
+int main(void) {
+    test_single_column_empty_line();
+    test_multi_column_blank_line_skipped();
+    test_quoted_fields();
+
+    printf("%s (%d failures)\n", failures == 0 ? "OK" : "FAILED", failures);
+    return failures == 0 ? 0 : 1;
+}
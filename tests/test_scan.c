@@ -0,0 +1,170 @@
+/**
+ * Test neon_exclusive_scan_f32 / neon_inclusive_scan_f32 / neon_scan_parallel_*:
+ * inf / NaN, triệt tiêu (1 + 1e30 - 1e30), tail, đường chạy nhiều threads
+ *
+ * Build (aarch64):
+ *   cc -O2 -I.. test_scan.c -o test_scan -lpthread -lm && ./test_scan
+*/
+#include "neon_scan.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+            failures++; \
+        } \
+    } while (0)
+
+
+static void test_cancellation(void) {
+    const float src[4] = {1.0f, 1e30f, -1e30f, 5.0f};
+    float dst[4];
+
+    neon_exclusive_scan_f32(src, dst, 4, 0.0f);
+    CHECK(dst[0] == 0.0f);
+    CHECK(dst[1] == 1.0f);
+    CHECK(dst[2] == 1e30f);
+    CHECK(dst[3] == 0.0f);
+
+    neon_scan_parallel_f32(src, dst, 4, 1, 4);
+    CHECK(dst[0] == 0.0f && dst[1] == 1.0f && dst[2] == 1e30f && dst[3] == 0.0f);
+}
+
+
+static void test_inf_nan(void) {
+    float src[11], dst[11];
+    for (int i = 0; i < 11; i++) src[i] = (float)(i + 1);
+
+    // inf ở lane 0: chỉ các phần tử sau nó là inf
+    src[0] = INFINITY;
+    neon_exclusive_scan_f32(src, dst, 11, 0.0f);
+    CHECK(dst[0] == 0.0f);
+    for (int i = 1; i < 11; i++) CHECK(isinf(dst[i]) && dst[i] > 0.0f);
+
+    // NaN ở giữa vector thứ 2: trước nó hữu hạn, từ sau nó là NaN
+    src[0] = 1.0f;
+    src[5] = NAN;
+    neon_exclusive_scan_f32(src, dst, 11, 0.0f);
+    for (int i = 0; i <= 5; i++) CHECK(isfinite(dst[i]));
+    for (int i = 6; i < 11; i++) CHECK(isnan(dst[i]));
+
+    neon_inclusive_scan_f32(src, dst, 11, 0.0f);
+    for (int i = 0; i < 5; i++) CHECK(isfinite(dst[i]));
+    for (int i = 5; i < 11; i++) CHECK(isnan(dst[i]));
+}
+
+
+/**
+ * Giá trị nguyên nhỏ → mọi tổng riêng đều chính xác trong float, so sánh bằng ==
+*/
+static void test_exact_sizes(void) {
+    size_t sizes[] = {0, 1, 3, 4, 5, 8, 13, 64, 1001};
+    srand(3);
+
+    for (size_t t = 0; t < sizeof(sizes) / sizeof(sizes[0]); t++) {
+        size_t n = sizes[t];
+        float* src = (float*)malloc((n + 1) * sizeof(float));
+        float* dst = (float*)malloc((n + 1) * sizeof(float));
+        for (size_t i = 0; i < n; i++) src[i] = (float)(rand() % 21 - 10);
+
+        float acc = 7.0f;
+        float total = neon_exclusive_scan_f32(src, dst, n, 7.0f);
+        for (size_t i = 0; i < n; i++) {
+            if (dst[i] != acc) {
+                printf("exclusive n=%zu mismatch at %zu\n", n, i);
+                failures++;
+                break;
+            }
+            acc += src[i];
+        }
+        CHECK(total == acc);
+
+        // in-place
+        acc = 0.0f;
+        for (size_t i = 0; i < n; i++) dst[i] = src[i];
+        neon_inclusive_scan_f32(dst, dst, n, 0.0f);
+        for (size_t i = 0; i < n; i++) {
+            acc += src[i];
+            if (dst[i] != acc) {
+                printf("inclusive n=%zu mismatch at %zu\n", n, i);
+                failures++;
+                break;
+            }
+        }
+
+        free(src);
+        free(dst);
+    }
+}
+
+
+static void test_parallel(void) {
+    size_t n = 300001;
+    float* src = (float*)malloc(n * sizeof(float));
+    float* dst = (float*)malloc(n * sizeof(float));
+    int32_t* isrc = (int32_t*)malloc(n * sizeof(int32_t));
+    int32_t* idst = (int32_t*)malloc(n * sizeof(int32_t));
+    srand(4);
+
+    for (size_t i = 0; i < n; i++) {
+        src[i] = (float)(rand() % 9);
+        isrc[i] = rand() % 2001 - 1000;
+    }
+
+    for (int exclusive = 0; exclusive <= 1; exclusive++) {
+        neon_scan_parallel_f32(src, dst, n, exclusive, 4);
+        float acc = 0.0f;
+        for (size_t i = 0; i < n; i++) {
+            if (!exclusive) acc += src[i];
+            if (dst[i] != acc) {
+                printf("parallel f32 exclusive=%d mismatch at %zu\n", exclusive, i);
+                failures++;
+                break;
+            }
+            if (exclusive) acc += src[i];
+        }
+
+        neon_scan_parallel_s32(isrc, idst, n, exclusive, 4);
+        int32_t iacc = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (!exclusive) iacc += isrc[i];
+            if (idst[i] != iacc) {
+                printf("parallel s32 exclusive=%d mismatch at %zu\n", exclusive, i);
+                failures++;
+                break;
+            }
+            if (exclusive) iacc += isrc[i];
+        }
+    }
+
+    // inf ở đầu đoạn của 1 thread: exclusive tại chính vị trí đó vẫn hữu hạn
+    size_t pos = n / 2;
+    src[pos] = INFINITY;
+    neon_scan_parallel_f32(src, dst, n, 1, 4);
+    CHECK(isfinite(dst[pos]));
+    CHECK(isinf(dst[pos + 1]));
+    CHECK(isinf(dst[n - 1]));
+    CHECK(isfinite(dst[pos - 1]));
+
+    free(src);
+    free(dst);
+    free(isrc);
+    free(idst);
+}
+
+
+int main(void) {
+    test_cancellation();
+    test_inf_nan();
+    test_exact_sizes();
+    test_parallel();
+
+    printf("%s (%d failures)\n", failures == 0 ? "OK" : "FAILED", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+/**
+ * Test neon_merge_corank (so với điểm chia của merge tuần tự) và neon_sort_f32
+ *
+ * Build (aarch64):
+ *   cc -O2 -I.. test_sort.c -o test_sort -lpthread -lm && ./test_sort
+*/
+#include "neon_sort.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+            failures++; \
+        } \
+    } while (0)
+
+
+static int cmp_s32(const void* x, const void* y) {
+    int32_t a = *(const int32_t*)x, b = *(const int32_t*)y;
+    return (a > b) - (a < b);
+}
+
+
+static int cmp_f32(const void* x, const void* y) {
+    float a = *(const float*)x, b = *(const float*)y;
+    return (a > b) - (a < b);
+}
+
+
+/**
+ * Merge tuần tự (tie → lấy a trước), trả về số phần tử lấy từ a trong k output đầu
+*/
+static size_t reference_split(size_t k, const int32_t* a, size_t na, const int32_t* b, size_t nb) {
+    size_t i = 0, j = 0;
+    while (i + j < k) {
+        if (j >= nb || (i < na && a[i] <= b[j])) i++;
+        else j++;
+    }
+    return i;
+}
+
+
+static void test_merge_corank(void) {
+    int32_t a[200], b[200];
+    srand(1);
+
+    for (int trial = 0; trial < 500; trial++) {
+        size_t na = (size_t)(rand() % 200);
+        size_t nb = (size_t)(rand() % 200);
+        int range = 1 + rand() % 50; // nhiều giá trị trùng
+
+        for (size_t i = 0; i < na; i++) a[i] = rand() % range - range / 2;
+        for (size_t i = 0; i < nb; i++) b[i] = rand() % range - range / 2;
+        qsort(a, na, sizeof(int32_t), cmp_s32);
+        qsort(b, nb, sizeof(int32_t), cmp_s32);
+
+        for (size_t k = 0; k <= na + nb; k++) {
+            size_t got = neon_merge_corank(k, a, na, b, nb);
+            size_t want = reference_split(k, a, na, b, nb);
+            if (got != want) {
+                printf("corank na=%zu nb=%zu k=%zu: got %zu want %zu\n", na, nb, k, got, want);
+                failures++;
+                break;
+            }
+        }
+    }
+}
+
+
+static void test_sort_f32(void) {
+    size_t sizes[] = {0, 1, 7, 16, 33, 1000, 100003};
+    srand(2);
+
+    for (size_t t = 0; t < sizeof(sizes) / sizeof(sizes[0]); t++) {
+        size_t n = sizes[t];
+        float* data = (float*)malloc((n + 1) * sizeof(float));
+        float* ref = (float*)malloc((n + 1) * sizeof(float));
+
+        for (size_t i = 0; i < n; i++) {
+            data[i] = ((float)rand() / RAND_MAX - 0.5f) * 1000.0f;
+            if (i % 97 == 3) data[i] = -INFINITY;
+            if (i % 89 == 5) data[i] = -0.0f;
+            ref[i] = data[i];
+        }
+        qsort(ref, n, sizeof(float), cmp_f32);
+
+        CHECK(neon_sort_f32(data, n, 0) == NEON_SUCCESS);
+        for (size_t i = 0; i < n; i++) {
+            if (data[i] != ref[i]) {
+                printf("sort_f32 n=%zu mismatch at %zu\n", n, i);
+                failures++;
+                break;
+            }
+        }
+
+        CHECK(neon_sort_f32(data, n, 1) == NEON_SUCCESS);
+        for (size_t i = 0; i < n; i++) {
+            if (data[i] != ref[n - 1 - i]) {
+                printf("sort_f32 desc n=%zu mismatch at %zu\n", n, i);
+                failures++;
+                break;
+            }
+        }
+
+        free(data);
+        free(ref);
+    }
+}
+
+
+int main(void) {
+    test_merge_corank();
+    test_sort_f32();
+
+    printf("%s (%d failures)\n", failures == 0 ? "OK" : "FAILED", failures);
+    return failures == 0 ? 0 : 1;
+}